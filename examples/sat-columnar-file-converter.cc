@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ *
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/satellite-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-columnar-file-converter.cc
+ * \ingroup satellite
+ *
+ * \brief Converter of columnar statistics files to the text format. Columnar
+ * files are written by the statistics with the COLUMNAR_FILE output type, and
+ * are converted to the files the SCATTER_FILE output type writes:
+ *
+ *     ./waf --run="sat-columnar-file-converter --input=stat-per-ut-fwd-app-delay-scatter.bin"
+ *
+ * which writes `stat-per-ut-fwd-app-delay-scatter-<identifier>.txt` files.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-columnar-file-converter");
+
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+  bool multiFileMode = true;
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Columnar statistics file to convert", input);
+  cmd.AddValue ("output", "Name of the text files, without the .txt suffix; "
+                "defaults to the input file name without the .bin suffix", output);
+  cmd.AddValue ("multiFileMode", "Write a text file per identifier, instead "
+                "of a single text file starting each line with the identifier", multiFileMode);
+  cmd.Parse (argc, argv);
+
+  if (input.empty ())
+    {
+      NS_FATAL_ERROR ("No input file given");
+    }
+
+  if (output.empty ())
+    {
+      output = input;
+      const std::string suffix = ".bin";
+      if (output.size () > suffix.size ()
+          && output.compare (output.size () - suffix.size (), suffix.size (), suffix) == 0)
+        {
+          output.erase (output.size () - suffix.size ());
+        }
+    }
+
+  SatColumnarFileReader::ConvertToText (input, output, multiFileMode);
+  std::cout << "Converted " << input << " to " << output << (multiFileMode ? "-*.txt" : ".txt") << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ *
+ */
+
+#include <fstream>
+#include "ns3/core-module.h"
+#include "ns3/satellite-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-fading-external-trace-converter.cc
+ * \ingroup satellite
+ *
+ * \brief Converter of external fading trace files to the flat format read by
+ * SatFadingExternalInputTrace. The flat files are memory mapped when loaded,
+ * so the traces are shared by all the simulations run in parallel on a host
+ * instead of being parsed by each of them.
+ *
+ * Either a single trace file is converted:
+ *
+ *     ./waf --run="sat-fading-external-trace-converter --input=in.bin --output=out.bin --columns=3"
+ *
+ * or all the trace files listed in an index file of SatFadingExternalInputTraceContainer.
+ * The converted files are written with the same names to the output directory:
+ *
+ *     ./waf --run="sat-fading-external-trace-converter --inputDir=data/ext-fadingtraces/input
+ *       --index=BeamId-1_256_UT_fading_fwddwn_trace_index.txt --outputDir=/tmp/flat --columns=3"
+ *
+ * The format of a trace file is detected when it is loaded, so the index files
+ * don't need to be changed after the trace files are replaced by the flat ones.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-fading-external-trace-converter");
+
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+  std::string inputDir;
+  std::string outputDir;
+  std::string index;
+  uint32_t columns = 2;
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Trace file to convert", input);
+  cmd.AddValue ("output", "Converted trace file", output);
+  cmd.AddValue ("inputDir", "Directory of the index file and of the trace files to convert", inputDir);
+  cmd.AddValue ("outputDir", "Directory of the converted trace files", outputDir);
+  cmd.AddValue ("index", "Index file listing the trace files to convert", index);
+  cmd.AddValue ("columns", "Number of columns of the trace files, 2 or 3", columns);
+  cmd.Parse (argc, argv);
+
+  if (columns != 2 && columns != 3)
+    {
+      NS_FATAL_ERROR ("Trace files have 2 or 3 columns, not " << columns);
+    }
+
+  SatFadingExternalInputTrace::TraceFileType_e type = (columns == 2) ? SatFadingExternalInputTrace::FT_TWO_COLUMN
+    : SatFadingExternalInputTrace::FT_THREE_COLUMN;
+
+  if (!input.empty ())
+    {
+      SatFadingExternalInputTrace::ConvertToFlatTrace (type, input, output);
+      std::cout << "Converted " << input << " to " << output << std::endl;
+    }
+
+  if (!index.empty ())
+    {
+      std::ifstream ifs ((inputDir + "/" + index).c_str (), std::ios::in);
+
+      if (!ifs.is_open ())
+        {
+          NS_FATAL_ERROR (inputDir << "/" << index << " index file not found.");
+        }
+
+      double lat, lon, alt;
+      uint32_t id;
+      std::string fileName;
+      uint32_t converted = 0;
+
+      ifs >> id >> fileName >> lat >> lon >> alt;
+
+      while (ifs.good ())
+        {
+          SatFadingExternalInputTrace::ConvertToFlatTrace (type, inputDir + "/" + fileName, outputDir + "/" + fileName);
+          converted++;
+
+          ifs >> id >> fileName >> lat >> lon >> alt;
+        }
+
+      ifs.close ();
+      std::cout << "Converted " << converted << " trace files listed in " << index << " to " << outputDir << std::endl;
+    }
+
+  return 0;
+}
@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ *
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/satellite-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-input-trace-bundle-converter.cc
+ * \ingroup satellite
+ *
+ * \brief Converter of the text input traces of a directory to a trace bundle.
+ * The bundle is memory mapped when loaded, so the traces are neither parsed
+ * by each simulation nor copied. A bundle written to the interference, Rx
+ * power or fading input trace directory is read instead of the text traces
+ * when its name is given to the TraceBundle attribute of the input trace
+ * container:
+ *
+ *     ./waf --run="sat-input-trace-bundle-converter --inputDir=data/interferencetraces/input
+ *       --output=data/interferencetraces/input/bundle.bin"
+ *     ./waf --run="sat-trace-input-interference-example
+ *       --ns3::SatInterferenceInputTraceContainer::TraceBundle=bundle.bin"
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-input-trace-bundle-converter");
+
+int
+main (int argc, char *argv[])
+{
+  std::string inputDir;
+  std::string output;
+  uint32_t columns = 2;
+
+  CommandLine cmd;
+  cmd.AddValue ("inputDir", "Directory of the text traces to convert", inputDir);
+  cmd.AddValue ("output", "Trace bundle file", output);
+  cmd.AddValue ("columns", "Number of columns of the text traces", columns);
+  cmd.Parse (argc, argv);
+
+  if (inputDir.empty () || output.empty ())
+    {
+      NS_FATAL_ERROR ("Both input directory and output file must be given");
+    }
+
+  uint32_t traces = SatInputTraceBundle::CreateBundle (inputDir, output, columns);
+  std::cout << "Bundled " << traces << " traces of " << inputDir << " to " << output << std::endl;
+
+  return 0;
+}
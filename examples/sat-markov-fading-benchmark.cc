@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ *
+ */
+
+#include <chrono>
+#include <vector>
+#include "ns3/core-module.h"
+#include "ns3/satellite-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-markov-fading-benchmark.cc
+ * \ingroup satellite
+ *
+ * \brief Benchmark for the per-reception cost of Markov-fading. The example
+ * creates a number of Markov-fading containers, one per terminal, sharing the
+ * same fading manager as in the simulation scenarios, and requests
+ * the fading of every terminal periodically, as receptions would. The wall
+ * clock time spent in the fading requests is measured for:
+ *
+ *   - the oscillators evaluated on each request (default behaviour),
+ *   - the oscillator bank evaluated on each request,
+ *   - the pre-tabulated fading values with individual oscillators,
+ *   - the pre-tabulated fading values with the oscillator bank.
+ *
+ * This example can be run as it is, without any argument, i.e.:
+ *
+ *     ./waf --run="sat-markov-fading-benchmark"
+ *
+ * or with the command line arguments, e.g.:
+ *
+ *     ./waf --run="sat-markov-fading-benchmark --terminals=500 --interval=1ms"
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-markov-fading-benchmark");
+
+static double g_elevation = 45;
+static double g_velocity = 0;
+static double g_elapsedSeconds = 0;
+static uint64_t g_receptions = 0;
+
+static double GetElevation ()
+{
+  return g_elevation;
+}
+
+static double GetVelocity ()
+{
+  return g_velocity;
+}
+
+static void
+Receive (std::vector< Ptr<SatMarkovContainer> > containers, Time interval)
+{
+  Address macAddress;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+
+  for (uint32_t i = 0; i < containers.size (); i++)
+    {
+      containers[i]->DoGetFading (macAddress, SatEnums::FORWARD_USER_CH);
+      containers[i]->DoGetFading (macAddress, SatEnums::RETURN_USER_CH);
+    }
+
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+
+  g_elapsedSeconds += std::chrono::duration<double> (end - start).count ();
+  g_receptions += 2 * containers.size ();
+
+  Simulator::Schedule (interval, &Receive, containers, interval);
+}
+
+static double
+RunBenchmark (bool useOscillatorBank, bool usePreTabulatedFading, uint32_t terminals, Time interval, Time duration)
+{
+  Config::SetDefault ("ns3::SatBaseFaderConf::UseOscillatorBank", BooleanValue (useOscillatorBank));
+  Config::SetDefault ("ns3::SatMarkovConf::UsePreTabulatedFading", BooleanValue (usePreTabulatedFading));
+
+  Ptr<SatMarkovConf> markovConf = CreateObject<SatMarkovConf> ();
+  Ptr<SatMarkovFadingManager> manager = CreateObject<SatMarkovFadingManager> (markovConf);
+
+  SatBaseFading::ElevationCallback elevationCb = MakeCallback (&GetElevation);
+  SatBaseFading::VelocityCallback velocityCb = MakeCallback (&GetVelocity);
+
+  std::vector< Ptr<SatMarkovContainer> > containers;
+
+  for (uint32_t i = 0; i < terminals; i++)
+    {
+      containers.push_back (CreateObject<SatMarkovContainer> (manager, elevationCb, velocityCb));
+    }
+
+  g_elapsedSeconds = 0;
+  g_receptions = 0;
+
+  Simulator::Schedule (interval, &Receive, containers, interval);
+  Simulator::Stop (duration);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  double costNs = 1e9 * g_elapsedSeconds / g_receptions;
+
+  std::cout << "Oscillator bank: " << (useOscillatorBank ? "yes" : "no ")
+            << ", pre-tabulated: " << (usePreTabulatedFading ? "yes" : "no ")
+            << ", receptions: " << g_receptions
+            << ", total: " << g_elapsedSeconds << " s"
+            << ", per reception: " << costNs << " ns" << std::endl;
+
+  return costNs;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t terminals = 100;
+  Time interval = MicroSeconds (200);
+  Time duration = Seconds (5);
+
+  CommandLine cmd;
+  cmd.AddValue ("terminals", "Number of terminals (fading containers)", terminals);
+  cmd.AddValue ("interval", "Interval between receptions of a terminal", interval);
+  cmd.AddValue ("duration", "Simulated duration of each benchmark run", duration);
+  cmd.Parse (argc, argv);
+
+  /// Set simulation output details
+  Config::SetDefault ("ns3::SatEnvVariables::SimulationCampaignName", StringValue ("example-markov-fading-benchmark"));
+  Config::SetDefault ("ns3::SatEnvVariables::SimulationTag", StringValue (""));
+  Config::SetDefault ("ns3::SatEnvVariables::EnableSimulationOutputOverwrite", BooleanValue (true));
+
+  std::cout << terminals << " terminals, reception interval " << interval.GetMicroSeconds ()
+            << " us, duration " << duration.GetSeconds () << " s" << std::endl;
+
+  double reference = RunBenchmark (false, false, terminals, interval, duration);
+  double bank = RunBenchmark (true, false, terminals, interval, duration);
+  double tabulated = RunBenchmark (false, true, terminals, interval, duration);
+  double tabulatedBank = RunBenchmark (true, true, terminals, interval, duration);
+
+  std::cout << "Speed-up, oscillator bank: " << reference / bank
+            << ", pre-tabulated: " << reference / tabulated
+            << ", pre-tabulated with oscillator bank: " << reference / tabulatedBank << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,61 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ *
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/satellite-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-packet-trace-converter.cc
+ * \ingroup satellite
+ *
+ * \brief Converter of binary packet traces to the text format. Binary packet
+ * traces are written by SatPacketTrace when its BinaryOutput attribute is
+ * enabled, and are converted to the same text the packet trace writes by
+ * default:
+ *
+ *     ./waf --run="sat-packet-trace-converter --input=PacketTrace.bin --output=PacketTrace.log"
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-packet-trace-converter");
+
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Binary packet trace file to convert", input);
+  cmd.AddValue ("output", "Text packet trace file", output);
+  cmd.Parse (argc, argv);
+
+  if (input.empty () || output.empty ())
+    {
+      NS_FATAL_ERROR ("Both input and output files must be given");
+    }
+
+  SatPacketTrace::ConvertToText (input, output);
+  std::cout << "Converted " << input << " to " << output << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ *
+ */
+
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <vector>
+#include "ns3/core-module.h"
+#include "ns3/satellite-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-quantile-sketch-merge.cc
+ * \ingroup satellite
+ *
+ * \brief Merge the quantile sketches saved by independent simulation runs.
+ * Delay statistics with the QUANTILE_FILE output type save the sketch of each
+ * identifier in a `-sketch.txt` file next to the quantiles. This program
+ * merges the sketches of the same identifier found in the given files, and
+ * writes the quantiles of the merged sketches in the same format as the
+ * statistics, e.g.:
+ *
+ *     ./waf --run="sat-quantile-sketch-merge --files=run1/stat-per-ut-fwd-app-delay-quantile-sketch.txt,run2/stat-per-ut-fwd-app-delay-quantile-sketch.txt"
+ *
+ * The merged sketches can also be saved, so that further runs can be merged
+ * later on.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-quantile-sketch-merge");
+
+int
+main (int argc, char *argv[])
+{
+  std::string files;
+  std::string output;
+  std::string sketchOutput;
+
+  CommandLine cmd;
+  cmd.AddValue ("files", "Comma separated list of the sketch files to merge", files);
+  cmd.AddValue ("output", "File of the merged quantiles, standard output if empty", output);
+  cmd.AddValue ("sketchOutput", "File of the merged sketches, not saved if empty", sketchOutput);
+  cmd.Parse (argc, argv);
+
+  if (files.empty ())
+    {
+      NS_FATAL_ERROR ("No sketch file given");
+    }
+
+  // merged sketches, and identifiers in the order they are first found
+  std::map<std::string, SatQuantileSketch> sketches;
+  std::vector<std::string> identifiers;
+
+  std::istringstream fileList (files);
+  std::string fileName;
+
+  while (std::getline (fileList, fileName, ','))
+    {
+      std::ifstream ifs (fileName.c_str ());
+      if (!ifs.is_open ())
+        {
+          NS_FATAL_ERROR ("Cannot open sketch file " << fileName);
+        }
+
+      std::string line;
+      while (std::getline (ifs, line))
+        {
+          if (line.empty () || line[0] == '%')
+            {
+              continue;
+            }
+
+          std::istringstream iss (line);
+          std::string identifier;
+          SatQuantileSketch sketch;
+
+          if (!(iss >> identifier) || !sketch.Read (iss))
+            {
+              NS_FATAL_ERROR ("Invalid sketch in " << fileName << ": " << line);
+            }
+
+          std::map<std::string, SatQuantileSketch>::iterator it = sketches.find (identifier);
+          if (it == sketches.end ())
+            {
+              sketches.insert (std::make_pair (identifier, sketch));
+              identifiers.push_back (identifier);
+            }
+          else
+            {
+              it->second.Merge (sketch);
+            }
+        }
+    }
+
+  std::ofstream ofs;
+  if (!output.empty ())
+    {
+      ofs.open (output.c_str ());
+      if (!ofs.is_open ())
+        {
+          NS_FATAL_ERROR ("Cannot open output file " << output);
+        }
+    }
+  std::ostream &os = output.empty () ? std::cout : ofs;
+
+  os << "% identifier quantile delay_sec" << std::endl;
+  for (uint32_t i = 0; i < identifiers.size (); i++)
+    {
+      const SatQuantileSketch &sketch = sketches[identifiers[i]];
+      if (sketch.GetCount () == 0)
+        {
+          continue;
+        }
+
+      for (uint32_t q = 0; q < SatQuantileCollector::GetNumOfReportedQuantiles (); q++)
+        {
+          const double quantile = SatQuantileCollector::GetReportedQuantile (q);
+          os << identifiers[i] << " " << quantile << " " << sketch.GetQuantile (quantile) << std::endl;
+        }
+    }
+
+  if (!sketchOutput.empty ())
+    {
+      std::ofstream sketchFile (sketchOutput.c_str ());
+      if (!sketchFile.is_open ())
+        {
+          NS_FATAL_ERROR ("Cannot open sketch output file " << sketchOutput);
+        }
+
+      sketchFile << "% identifier sketch" << std::endl;
+      for (uint32_t i = 0; i < identifiers.size (); i++)
+        {
+          sketchFile << identifiers[i] << " ";
+          sketches[identifiers[i]].Print (sketchFile);
+          sketchFile << std::endl;
+        }
+    }
+
+  return 0;
+}
@@ -157,7 +157,9 @@ SatBeamHelper::GetInstanceTypeId (void) const
 }
 
 SatBeamHelper::SatBeamHelper ()
-  : m_printDetailedInformationToCreationTraces (false),
+  : m_rtnLinkCarrierCount (0),
+  m_fwdLinkCarrierCount (0),
+  m_printDetailedInformationToCreationTraces (false),
   m_fadingModel (),
   m_propagationDelayModel (SatEnums::PD_CONSTANT_SPEED),
   m_constantPropagationDelay (Seconds (0.13)),
@@ -181,6 +183,8 @@ SatBeamHelper::SatBeamHelper (Ptr<Node> geoNode,
                               uint32_t fwdLinkCarrierCount,
                               Ptr<SatSuperframeSeq> seq)
   : m_carrierBandwidthConverter (bandwidthConverterCb),
+  m_rtnLinkCarrierCount (rtnLinkCarrierCount),
+  m_fwdLinkCarrierCount (fwdLinkCarrierCount),
   m_superframeSeq (seq),
   m_printDetailedInformationToCreationTraces (false),
   m_fadingModel (SatEnums::FADING_MARKOV),
@@ -305,6 +309,7 @@ SatBeamHelper::SatBeamHelper (Ptr<Node> geoNode,
       {
         /// create default Markov & Loo configurations
         m_markovConf = CreateObject<SatMarkovConf> ();
+        m_markovFadingManager = CreateObject<SatMarkovFadingManager> (m_markovConf);
         break;
       }
     case SatEnums::FADING_OFF:
@@ -312,6 +317,7 @@ SatBeamHelper::SatBeamHelper (Ptr<Node> geoNode,
     default:
       {
         m_markovConf = NULL;
+        m_markovFadingManager = NULL;
         break;
       }
     }
@@ -333,6 +339,7 @@ SatBeamHelper::DoDispose ()
   m_flChannels = NULL;
   m_beamFreqs.clear ();
   m_markovConf = NULL;
+  m_markovFadingManager = NULL;
   m_ncc = NULL;
   m_geoHelper = NULL;
   m_gwHelper = NULL;
@@ -827,16 +834,27 @@ SatBeamHelper::EnablePacketTrace ()
    */
 
   /**
-   * TODO: Currently the packet trace logs all entries updated by the protocol layers. Here
-   * we could restrict the protocol layers from where the traced data are collected from.
-   * This could be controlled by the user using attributes.
+   * The layers whose log level is filtered out by the packet trace
+   * attributes are not connected at all.
    */
-  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
-  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/SatPhy/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
-  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/UserPhy/*/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
-  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/FeederPhy/*/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
-  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/SatMac/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
-  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/SatLlc/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
+  if (m_packetTrace->IsLogLevelTraced (SatEnums::LL_ND))
+    {
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
+    }
+  if (m_packetTrace->IsLogLevelTraced (SatEnums::LL_PHY))
+    {
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/SatPhy/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/UserPhy/*/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/FeederPhy/*/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
+    }
+  if (m_packetTrace->IsLogLevelTraced (SatEnums::LL_MAC))
+    {
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/SatMac/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
+    }
+  if (m_packetTrace->IsLogLevelTraced (SatEnums::LL_LLC))
+    {
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/SatLlc/PacketTrace", MakeCallback (&SatPacketTrace::AddTraceEntry, m_packetTrace));
+    }
 }
 
 std::string
@@ -1062,6 +1080,7 @@ SatBeamHelper::GetChannelPair (uint32_t beamId, uint32_t fwdFrequencyId, uint32_
 					forwardCh->SetFrequencyConverter (m_carrierFreqConverter);
 					forwardCh->SetBandwidthConverter (m_carrierBandwidthConverter);
 					forwardCh->SetFrequencyId (fwdFrequencyId);
+					forwardCh->SetCarrierCount (m_fwdLinkCarrierCount);
 					forwardCh->SetPropagationDelayModel (pDelay);
 					forwardCh->SetFreeSpaceLoss (pFsl);
 				}
@@ -1073,6 +1092,7 @@ SatBeamHelper::GetChannelPair (uint32_t beamId, uint32_t fwdFrequencyId, uint32_
 					returnCh->SetFrequencyConverter (m_carrierFreqConverter);
 					returnCh->SetBandwidthConverter (m_carrierBandwidthConverter);
 					returnCh->SetFrequencyId (rtnFrequencyId);
+					returnCh->SetCarrierCount (m_rtnLinkCarrierCount);
 					returnCh->SetPropagationDelayModel (pDelay);
 					returnCh->SetFreeSpaceLoss (pFsl);
 				}
@@ -1129,10 +1149,19 @@ SatBeamHelper::InstallFadingContainer (Ptr<Node> node) const
             SatBaseFading::VelocityCallback velocityCb = MakeCallback (&SatMobilityObserver::GetVelocity,
                                                                        observer);
 
-            /// create a Markov fading container based on default configuration
-            fadingContainer = CreateObject<SatMarkovContainer> (m_markovConf,
+            /// create a Markov fading container based on default configuration,
+            /// the fading state of all the nodes is kept by the common manager
+            fadingContainer = CreateObject<SatMarkovContainer> (m_markovFadingManager,
                                                                 elevationCb,
                                                                 velocityCb);
+
+            if (m_markovConf->AreSetUpdatesDecoupled ())
+              {
+                /// elevation set is updated on mobility changes instead of on each reception
+                observer->TraceConnectWithoutContext ("PropertyChanged",
+                                                      MakeCallback (&SatMarkovContainer::MobilityChanged,
+                                                                    DynamicCast<SatMarkovContainer> (fadingContainer)));
+              }
             node->AggregateObject (fadingContainer);
             break;
           }
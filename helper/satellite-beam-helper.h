@@ -312,6 +312,9 @@ private:
   CarrierFreqConverter m_carrierFreqConverter;
   SatTypedefs::CarrierBandwidthConverter_t m_carrierBandwidthConverter;
 
+  uint32_t m_rtnLinkCarrierCount;
+  uint32_t m_fwdLinkCarrierCount;
+
   Ptr<SatSuperframeSeq> m_superframeSeq;
 
   ObjectFactory         m_channelFactory;
@@ -361,6 +364,11 @@ private:
    */
   Ptr<SatMarkovConf> m_markovConf;
 
+  /**
+   * Common fading state of the Markov model containers
+   */
+  Ptr<SatMarkovFadingManager> m_markovFadingManager;
+
   /**
    * Propagation delay model
    * - Constant
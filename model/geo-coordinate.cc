@@ -35,7 +35,8 @@ namespace ns3 {
 ATTRIBUTE_HELPER_CPP (GeoCoordinate);
 
 GeoCoordinate::GeoCoordinate (double latitude, double longitude, double altitude, ReferenceEllipsoid_t refEllipsoid)
-  : m_refEllipsoid (refEllipsoid)
+  : m_refEllipsoid (refEllipsoid),
+  m_cartesianValid (false)
 {
   NS_LOG_FUNCTION (this << latitude << longitude << altitude);
 
@@ -43,7 +44,8 @@ GeoCoordinate::GeoCoordinate (double latitude, double longitude, double altitude
 }
 
 GeoCoordinate::GeoCoordinate (double latitude, double longitude, double altitude)
-  : m_refEllipsoid (GeoCoordinate::SPHERE)
+  : m_refEllipsoid (GeoCoordinate::SPHERE),
+  m_cartesianValid (false)
 {
   NS_LOG_FUNCTION (this << latitude << longitude << altitude);
 
@@ -51,7 +53,8 @@ GeoCoordinate::GeoCoordinate (double latitude, double longitude, double altitude
 }
 
 GeoCoordinate::GeoCoordinate (Vector vector)
-  : m_refEllipsoid (GeoCoordinate::SPHERE)
+  : m_refEllipsoid (GeoCoordinate::SPHERE),
+  m_cartesianValid (false)
 {
   NS_LOG_FUNCTION (this << vector);
 
@@ -59,7 +62,8 @@ GeoCoordinate::GeoCoordinate (Vector vector)
 }
 
 GeoCoordinate::GeoCoordinate (Vector vector, ReferenceEllipsoid_t refEllipsoid)
-  : m_refEllipsoid (refEllipsoid)
+  : m_refEllipsoid (refEllipsoid),
+  m_cartesianValid (false)
 {
   NS_LOG_FUNCTION (this << vector);
 
@@ -70,7 +74,8 @@ GeoCoordinate::GeoCoordinate ()
   : m_latitude (NAN),
   m_longitude (NAN),
   m_altitude (NAN),
-  m_refEllipsoid (GeoCoordinate::SPHERE)
+  m_refEllipsoid (GeoCoordinate::SPHERE),
+  m_cartesianValid (false)
 {
   NS_LOG_FUNCTION (this);
 
@@ -102,6 +107,7 @@ GeoCoordinate::Construct (double latitude, double longitude, double altitude)
   m_latitude = latitude;
   m_longitude = longitude;
   m_altitude = altitude;
+  m_cartesianValid = false;
 }
 
 Vector
@@ -109,15 +115,25 @@ GeoCoordinate::ToVector () const
 {
   NS_LOG_FUNCTION (this);
 
-  Vector cartesian;
+  if (m_cartesianValid)
+    {
+      return m_cartesian;
+    }
+
   double latRads = SatUtils::DegreesToRadians (m_latitude);
   double lonRads = SatUtils::DegreesToRadians (m_longitude);
+  double sinLat = std::sin (latRads);
+  double cosLat = std::cos (latRads);
+
+  // radius of the curvature in the prime vertical
+  double rCurvature = m_equatorRadius / std::sqrt (1 - m_e2Param * sinLat * sinLat);
 
-  cartesian.x = ( GetRadiusCurvature (latRads) + m_altitude) * std::cos (latRads) * std::cos (lonRads);
-  cartesian.y = ( GetRadiusCurvature (latRads) + m_altitude) * std::cos (latRads) * std::sin (lonRads);
-  cartesian.z = ( GetRadiusCurvature (latRads) * (1 - m_e2Param) + m_altitude) * std::sin (latRads);
+  m_cartesian.x = ( rCurvature + m_altitude) * cosLat * std::cos (lonRads);
+  m_cartesian.y = ( rCurvature + m_altitude) * cosLat * std::sin (lonRads);
+  m_cartesian.z = ( rCurvature * (1 - m_e2Param) + m_altitude) * sinLat;
+  m_cartesianValid = true;
 
-  return cartesian;
+  return m_cartesian;
 }
 
 void
@@ -176,6 +192,7 @@ void GeoCoordinate::SetLongitude (double longitude)
     }
 
   m_longitude = longitude;
+  m_cartesianValid = false;
 }
 
 void GeoCoordinate::SetLatitude (double latitude)
@@ -188,6 +205,7 @@ void GeoCoordinate::SetLatitude (double latitude)
     }
 
   m_latitude = latitude;
+  m_cartesianValid = false;
 }
 
 void GeoCoordinate::SetAltitude (double altitude)
@@ -200,6 +218,7 @@ void GeoCoordinate::SetAltitude (double altitude)
     }
 
   m_altitude = altitude;
+  m_cartesianValid = false;
 }
 
 void GeoCoordinate::ConstructFromVector (const Vector &v)
@@ -208,68 +227,46 @@ void GeoCoordinate::ConstructFromVector (const Vector &v)
 
   Initialize ();
 
-  // distance from the position point (P) to earth center point (origin O)
-  double op = std::sqrt ( v.x * v.x + v.y * v.y + v.z * v.z );
+  // squared distance from the position point (P) to earth rotation axis
+  double rho2 = v.x * v.x + v.y * v.y;
 
-  if ( op > 0 )
+  if ( rho2 + v.z * v.z > 0 )
     {
-      // longitude calculation
-      double lon = std::atan (v.y / v.x);
+      // longitude scaled between -180 and 180 degrees
+      m_longitude = SatUtils::RadiansToDegrees (std::atan2 (v.y, v.x));
 
-      // scale longitude between - PI and PI (-180 and 180 in degrees)
-      if ( v.x != 0 || v.y != 0 )
+      if ( m_e2Param == 0 )
         {
-          m_longitude = SatUtils::RadiansToDegrees (std::atan (v.y / v.x ));
-
-          if ( v.x < 0 )
-            {
-              if ( v.y > 0)
-                {
-                  m_longitude = 180 + m_longitude;
-                  lon = lon - M_PI;
-                }
-              else
-                {
-                  m_longitude = -180 + m_longitude;
-                  lon = M_PI + lon;
-                }
-            }
+          // sphere, geodetic and geocentric latitudes are the same
+          m_latitude = SatUtils::RadiansToDegrees (std::atan2 (v.z, std::sqrt (rho2)));
+          m_altitude = std::sqrt (rho2 + v.z * v.z) - m_equatorRadius;
+        }
+      else
+        {
+          double a2 = m_equatorRadius * m_equatorRadius;
+          double e4 = m_e2Param * m_e2Param;
+
+          double p = rho2 / a2;
+          double q = (1 - m_e2Param) * v.z * v.z / a2;
+          double r = (p + q - e4) / 6;
+          double s = e4 * p * q / (4 * r * r * r);
+          double t = std::cbrt (1 + s + std::sqrt (s * (2 + s)));
+          double u = r * (1 + t + 1 / t);
+          double w = std::sqrt (u * u + e4 * q);
+          double k0 = m_e2Param * (u + w - q) / (2 * w);
+          double k = std::sqrt (u + w + k0 * k0) - k0;
+          double d = k * std::sqrt (rho2) / (k + m_e2Param);
+          double dz = std::sqrt (d * d + v.z * v.z);
+
+          m_latitude = SatUtils::RadiansToDegrees (2 * std::atan2 (v.z, d + dz));
+          m_altitude = (k + m_e2Param - 1) / k * dz;
         }
 
-      // Geocentric latitude
-      double latG = std::atan (v.z / (std::sqrt ( v.x * v.x + v.y * v.y )));
-
-      // Geocentric latitude (of point Q, Q is intersection point of segment OP and reference ellipsoid)
-      double latQ = std::atan (v.z / ( (1 - m_e2Param ) * (std::sqrt ( v.x * v.x + v.y * v.y ))) );
-
-      // calculate radius of the curvature
-      double rCurvature = GetRadiusCurvature (latQ);
-
-      // x, y, z of point Q
-      double xQ = rCurvature * std::cos (latQ) * std::cos (lon);
-      double yQ = rCurvature * std::cos (latQ) * std::sin (lon);
-      double zQ = rCurvature * (1 - m_e2Param) * std::sin (latQ);
-
-      // distance OQ
-      double oq = std::sqrt ( xQ * xQ + yQ * yQ + zQ * zQ );
-
-      // distance PQ is OP - OQ
-      double pq = op - oq;
-
-      // length of the normal segment from point P of line (PO) to point T.
-      // T is intersection point of linen the PO normal and ellipsoid normal from point Q.
-      double tp = pq * std::sin (latG - latQ);
-
-      m_latitude = SatUtils::RadiansToDegrees (latQ + tp / op * std::cos (latQ - latG));
-
-      m_altitude = pq * std::cos (latQ - latG);
+      // given vector is exact Cartesian presentation of the position, so cache it
+      m_cartesian = v;
+      m_cartesianValid = true;
     }
 }
-double
-GeoCoordinate::GetRadiusCurvature (double latitude) const
-{
-  return ( m_equatorRadius / std::sqrt (1 - m_e2Param * std::sin (latitude) * std::sin (latitude)) );
-}
 
 bool
 GeoCoordinate::IsValidAltitude (double altitude, ReferenceEllipsoid_t refEllipsoid)
@@ -131,7 +131,11 @@ public:
    */
   void SetAltitude (double altitude);
   /**
-   * Converts Geodetic coordinates to Cartesian coordinates
+   * Converts Geodetic coordinates to Cartesian coordinates.
+   *
+   * The result is cached, so consecutive calls on the same object
+   * are not recomputing the conversion until position is changed.
+   *
    * \return Vector containing Cartesian coordinates
    */
   Vector ToVector () const;
@@ -148,12 +152,6 @@ public:
   static constexpr double polarRadius_grs80 = 6356752.314103;     // GRS80 ellipsoide
 
 private:
-  /**
-   * Gets the radius of curvature in the prime vertical
-   * \param latitude latitude in radians at to get the radius of curvature.
-   * \return value of the radius of curvature (meters)
-   */
-  double GetRadiusCurvature (double latitude) const;
   /**
    * Checks if longtitude is in valid range
    *
@@ -185,6 +183,12 @@ private:
   /**
    * Creates Geodetic coordinates from given Cartesian coordinates.
    *
+   * Conversion is done with closed-form (non-iterative) method
+   * by H. Vermeille, "Direct transformation from geocentric coordinates
+   * to geodetic coordinates", Journal of Geodesy (2002) 76: 451-454.
+   * The method is exact for points outside the evolute of the ellipsoid
+   * (i.e. farther than some tens of kilometers from the Earth center).
+   *
    * \param vector reference to vector containing Cartesian coordinates for creation.
    */
   void ConstructFromVector (const Vector &vector);
@@ -228,6 +232,9 @@ private:
   double                m_e2Param;        // First eccentricity squared
   double                m_equatorRadius;  // Semi-major axis A, meters
   double                m_polarRadius;    // Semi-major axis B, meters
+
+  mutable Vector        m_cartesian;      // Cached Cartesian coordinates
+  mutable bool          m_cartesianValid; // Flag telling if m_cartesian is up-to-date
 };
 
 /**
@@ -19,6 +19,7 @@
  */
 
 #include <algorithm>
+#include <set>
 #include <stdlib.h>
 #include "ns3/double.h"
 #include "ns3/log.h"
@@ -271,6 +272,54 @@ GeoCoordinate SatAntennaGainPattern::GetValidRandomPosition () const
   return coord;
 }
 
+std::vector< std::pair<double, double> >
+SatAntennaGainPattern::GetValidCells () const
+{
+  NS_LOG_FUNCTION (this);
+
+  std::set< std::pair<double, double> > validPositions (m_validPositions.begin (), m_validPositions.end ());
+  std::vector< std::pair<double, double> > validCells;
+
+  for (std::vector< std::pair<double, double> >::const_iterator it = m_validPositions.begin (); it != m_validPositions.end (); ++it)
+    {
+      // Upper left, upper right and lower right corners have to be valid too
+      std::pair<double, double> upperLeft (it->first + m_latInterval, it->second);
+      std::pair<double, double> upperRight (it->first + m_latInterval, it->second + m_lonInterval);
+      std::pair<double, double> lowerRight (it->first, it->second + m_lonInterval);
+
+      if (validPositions.count (upperLeft) && validPositions.count (upperRight) && validPositions.count (lowerRight))
+        {
+          validCells.push_back (*it);
+        }
+    }
+
+  return validCells;
+}
+
+std::pair<double, double>
+SatAntennaGainPattern::GetCellSize () const
+{
+  NS_LOG_FUNCTION (this);
+
+  return std::make_pair (m_latInterval, m_lonInterval);
+}
+
+GeoCoordinate
+SatAntennaGainPattern::GetRandomPositionInCells (const std::vector< std::pair<double, double> >& cells, uint32_t& cellIndex) const
+{
+  NS_LOG_FUNCTION (this << cells.size ());
+
+  NS_ASSERT (!cells.empty ());
+
+  cellIndex = m_uniformRandomVariable->GetInteger (0, cells.size () - 1);
+  const std::pair<double, double>& lowerLeftCoord = cells[cellIndex];
+
+  // Pick a random position within a grid square
+  double latOffset = m_uniformRandomVariable->GetValue (0.0, m_latInterval - 0.001);
+  double lonOffset = m_uniformRandomVariable->GetValue (0.0, m_lonInterval - 0.001);
+
+  return GeoCoordinate (lowerLeftCoord.first + latOffset, lowerLeftCoord.second + lonOffset, 0.0);
+}
 
 bool SatAntennaGainPattern::IsValidPosition (GeoCoordinate coord, TracedCallback<double> cb) const
 {
@@ -94,6 +94,31 @@ public:
    */
   bool IsValidPosition (GeoCoordinate coord, TracedCallback<double> cb) const;
 
+  /**
+   * \brief Get the grid cells under this spot-beam coverage. A cell is valid
+   * if all of its four corners are valid positions.
+   * \return Lower left corners {latitude, longitude} of the valid cells
+   */
+  std::vector< std::pair<double, double> > GetValidCells () const;
+
+  /**
+   * \brief Get the size of a grid cell.
+   * \return The interval between latitudes and longitudes {latitude, longitude}
+   */
+  std::pair<double, double> GetCellSize () const;
+
+  /**
+   * \brief Get a random position within a randomly selected cell.
+   *
+   * Uses the same random variable than GetValidRandomPosition, so
+   * the random number stream assignment of the pattern is not changed.
+   *
+   * \param cells Lower left corners {latitude, longitude} of the cells to select from
+   * \param cellIndex Index of the selected cell is stored here
+   * \return A random GeoCoordinate within the selected cell
+   */
+  GeoCoordinate GetRandomPositionInCells (const std::vector< std::pair<double, double> >& cells, uint32_t& cellIndex) const;
+
 private:
   /**
    * \brief Read the antenna gain pattern from a file
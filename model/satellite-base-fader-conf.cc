@@ -29,11 +29,16 @@ TypeId
 SatBaseFaderConf::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatBaseFaderConf")
-    .SetParent<Object> ();
+    .SetParent<Object> ()
+    .AddAttribute ("UseOscillatorBank", "Evaluate the fader oscillators with a vectorizable oscillator bank instead of individual oscillator objects.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatBaseFaderConf::m_useOscillatorBank),
+                   MakeBooleanChecker ());
   return tid;
 }
 
 SatBaseFaderConf::SatBaseFaderConf ()
+  : m_useOscillatorBank (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -43,4 +48,12 @@ SatBaseFaderConf::~SatBaseFaderConf ()
   NS_LOG_FUNCTION (this);
 }
 
+bool
+SatBaseFaderConf::GetUseOscillatorBank () const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_useOscillatorBank;
+}
+
 } // namespace ns3
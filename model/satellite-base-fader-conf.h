@@ -22,6 +22,7 @@
 
 #include "ns3/object.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 
@@ -62,7 +63,18 @@ public:
    */
   virtual std::vector<std::vector<double> > GetParameters (uint32_t set) = 0;
 
+  /**
+   * \brief Function for getting whether the faders evaluate their
+   * oscillators with an oscillator bank
+   * \return use oscillator bank
+   */
+  bool GetUseOscillatorBank () const;
+
 private:
+  /**
+   * \brief Use an oscillator bank instead of individual oscillators
+   */
+  bool m_useOscillatorBank;
 };
 
 } // namespace ns3
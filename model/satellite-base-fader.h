@@ -24,6 +24,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include <vector>
 
 namespace ns3 {
 
@@ -74,6 +75,17 @@ public:
    */
   virtual void UpdateParameters (uint32_t newSet, uint32_t newState) = 0;
 
+  /**
+   * \brief Function for calculating the channel gains of a state at fixed
+   * time steps, used to pre-tabulate the fading values
+   * \param state state
+   * \param startTime time of the first channel gain in seconds
+   * \param timeStep time step between the channel gains in seconds
+   * \param useDecibels whether the channel gains are calculated in dB
+   * \param gains vector filled with the channel gains, its size defines the number of gains
+   */
+  virtual void GetChannelGains (uint32_t state, double startTime, double timeStep, bool useDecibels, std::vector<double>& gains) = 0;
+
 private:
 };
 
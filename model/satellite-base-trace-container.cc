@@ -17,6 +17,10 @@
  *
  * Author: Frans Laakso <frans.laakso@magister.fi>
  */
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/singleton.h"
+#include "satellite-id-mapper.h"
 #include "satellite-base-trace-container.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatBaseTraceContainer");
@@ -29,7 +33,35 @@ TypeId
 SatBaseTraceContainer::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatBaseTraceContainer")
-    .SetParent<Object> ();
+    .SetParent<Object> ()
+    .AddAttribute ("UseBoundedRecorder",
+                   "Record the trace samples with a fixed memory recorder streaming to a binary file, "
+                   "instead of storing them until the end of the simulation. "
+                   "Used by the fading and interference output traces.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatBaseTraceContainer::m_useBoundedRecorder),
+                   MakeBooleanChecker ())
+    .AddAttribute ("RecorderInterval",
+                   "Interval over which the minimum, maximum and mean of the samples are recorded, "
+                   "zero to record the samples as such.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&SatBaseTraceContainer::m_recorderInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("RecorderDecimation",
+                   "Only every Nth trace sample is recorded.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&SatBaseTraceContainer::m_recorderDecimation),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("RecorderBufferSize",
+                   "Number of records buffered before being written to the binary output.",
+                   UintegerValue (1024),
+                   MakeUintegerAccessor (&SatBaseTraceContainer::m_recorderBufferSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("RecorderTextOutput",
+                   "Export the binary output of the recorders to text at the end of the simulation.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&SatBaseTraceContainer::m_recorderTextOutput),
+                   MakeBooleanChecker ());
   return tid;
 }
 
@@ -42,6 +74,11 @@ SatBaseTraceContainer::GetInstanceTypeId (void) const
 }
 
 SatBaseTraceContainer::SatBaseTraceContainer ()
+  : m_useBoundedRecorder (false),
+  m_recorderInterval (Seconds (0)),
+  m_recorderDecimation (1),
+  m_recorderBufferSize (1024),
+  m_recorderTextOutput (true)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -51,4 +88,35 @@ SatBaseTraceContainer::~SatBaseTraceContainer ()
   NS_LOG_FUNCTION (this);
 }
 
+uint32_t
+SatBaseTraceContainer::GetTraceIndex (Address mac, SatEnums::ChannelType_t channelType) const
+{
+  NS_LOG_FUNCTION (this << mac << channelType);
+
+  int32_t traceId = Singleton<SatIdMapper>::Get ()->GetTraceIdWithMac (mac);
+
+  if (traceId < 0)
+    {
+      NS_FATAL_ERROR ("SatBaseTraceContainer::GetTraceIndex - No trace ID for MAC " << mac);
+    }
+
+  return traceId * NUM_CHANNEL_TYPES + channelType;
+}
+
+Ptr<SatOutputTraceRecorder>
+SatBaseTraceContainer::CreateRecorder (std::string fileName) const
+{
+  NS_LOG_FUNCTION (this << fileName);
+
+  Ptr<SatOutputTraceRecorder> recorder = CreateObject<SatOutputTraceRecorder> (fileName + ".bin", m_recorderInterval,
+                                                                               m_recorderDecimation, m_recorderBufferSize);
+
+  if (m_recorderTextOutput)
+    {
+      recorder->EnableTextOutput (fileName);
+    }
+
+  return recorder;
+}
+
 } // namespace ns3
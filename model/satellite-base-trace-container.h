@@ -20,9 +20,13 @@
 #ifndef SATELLITE_BASE_TRACE_CONTAINER_H
 #define SATELLITE_BASE_TRACE_CONTAINER_H
 
+#include <vector>
 #include "ns3/object.h"
+#include "ns3/address.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/satellite-output-trace-recorder.h"
 #include "satellite-enums.h"
 
 namespace ns3 {
@@ -99,6 +103,12 @@ public:
    */
   static const uint32_t POSITION_TRACE_DEFAULT_NUMBER_OF_COLUMNS = 4;
 
+  /**
+   * \brief Number of channel types, for the tables of traces indexed by
+   * node and channel type
+   */
+  static const uint32_t NUM_CHANNEL_TYPES = SatEnums::RETURN_FEEDER_CH + 1;
+
   /**
    * \brief Constructor
    */
@@ -126,9 +136,87 @@ public:
    */
   virtual void Reset () = 0;
 
-private:
+protected:
+  /**
+   * \brief Function for getting the index of the trace of a node in the
+   * tables of traces indexed by trace id and channel type
+   * \param mac MAC address of the node, which must have a trace id
+   * \param channelType channel type
+   * \return index of the trace
+   */
+  uint32_t GetTraceIndex (Address mac, SatEnums::ChannelType_t channelType) const;
+
+  /**
+   * \brief Function for finding the trace of a node in a table of traces
+   * indexed by trace id and channel type. The trace is loaded by the
+   * container on the first lookup and kept in the table.
+   * \param table table of traces
+   * \param container container owning the table
+   * \param addNode function of the container loading the trace of a node
+   * \param key MAC address and channel type of the node
+   * \return trace of the node
+   */
+  template <class C, class T>
+  Ptr<T> FindTrace (std::vector<Ptr<T> > &table, C *container,
+                    Ptr<T> (C::*addNode)(std::pair<Address, SatEnums::ChannelType_t>),
+                    std::pair<Address, SatEnums::ChannelType_t> key) const;
+
+  /**
+   * \brief Create a bounded recorder configured by the recorder attributes
+   * \param fileName base name of the output files, the binary output has
+   * the ".bin" suffix and the optional text output has the base name
+   * \return recorder
+   */
+  Ptr<SatOutputTraceRecorder> CreateRecorder (std::string fileName) const;
+
+  /**
+   * \brief Flag telling whether the samples are recorded with a bounded
+   * recorder instead of being stored until the end of the simulation
+   */
+  bool m_useBoundedRecorder;
+
+  /**
+   * \brief Aggregation interval of the bounded recorders
+   */
+  Time m_recorderInterval;
+
+  /**
+   * \brief Decimation factor of the bounded recorders
+   */
+  uint32_t m_recorderDecimation;
+
+  /**
+   * \brief Number of records buffered by the bounded recorders
+   */
+  uint32_t m_recorderBufferSize;
+
+  /**
+   * \brief Flag telling whether the bounded recorders export text output
+   */
+  bool m_recorderTextOutput;
 };
 
+template <class C, class T>
+Ptr<T>
+SatBaseTraceContainer::FindTrace (std::vector<Ptr<T> > &table, C *container,
+                                  Ptr<T> (C::*addNode)(std::pair<Address, SatEnums::ChannelType_t>),
+                                  std::pair<Address, SatEnums::ChannelType_t> key) const
+{
+  uint32_t index = GetTraceIndex (key.first, key.second);
+
+  if (index >= table.size ())
+    {
+      table.resize (index + 1);
+    }
+
+  if (table[index] == NULL)
+    {
+      table[index] = (container->*addNode)(key);
+    }
+
+  return table[index];
+}
+
 } // namespace ns3
 
 #endif /* SATELLITE_BASE_TRACE_CONTAINER_H */
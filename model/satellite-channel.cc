@@ -32,6 +32,7 @@
 #include "satellite-phy-tx.h"
 #include "satellite-channel.h"
 #include "satellite-mac-tag.h"
+#include "satellite-mobility-model.h"
 #include "ns3/singleton.h"
 #include "ns3/boolean.h"
 #include "satellite-rx-power-output-trace-container.h"
@@ -53,6 +54,7 @@ SatChannel::SatChannel ()
   m_channelType (SatEnums::UNKNOWN_CH),
   m_carrierFreqConverter (),
   m_freqId (),
+  m_carrierCount (0),
   m_propagationDelay (),
   m_freeSpaceLoss (),
   m_rxPowerCalculationMode (SatEnums::RX_PWR_CALCULATION),
@@ -65,7 +67,10 @@ SatChannel::SatChannel ()
    */
   m_enableRxPowerOutputTrace (false),
   m_enableFadingOutputTrace (false),
-  m_enableExternalFadingInputTrace (false)
+  m_enableExternalFadingInputTrace (false),
+  m_enableLinkBudgetCache (false),
+  m_linkBudgetCacheHits (0),
+  m_linkBudgetCacheMisses (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -81,6 +86,10 @@ SatChannel::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_phyRxContainer.clear ();
   m_propagationDelay = 0;
+  m_linkBudgetCache.clear ();
+
+  NS_LOG_INFO ("Link budget cache hits: " << m_linkBudgetCacheHits << ", misses: " << m_linkBudgetCacheMisses);
+
   Channel::DoDispose ();
 }
 
@@ -105,6 +114,12 @@ SatChannel::GetTypeId (void)
                     BooleanValue (false),
                     MakeBooleanAccessor (&SatChannel::m_enableExternalFadingInputTrace),
                     MakeBooleanChecker ())
+    .AddAttribute ( "EnableLinkBudgetCache",
+                    "Cache the antenna gains, free space loss and Rx losses of each transmitter, receiver "
+                    "and carrier until the transmitter or receiver changes course.",
+                    BooleanValue (false),
+                    MakeBooleanAccessor (&SatChannel::m_enableLinkBudgetCache),
+                    MakeBooleanChecker ())
     .AddAttribute ("RxPowerCalculationMode",
                    "Rx Power calculation mode",
                    EnumValue (SatEnums::RX_PWR_CALCULATION),
@@ -332,7 +347,7 @@ SatChannel::StartRx (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx)
 
   rxParams->m_channelType = m_channelType;
 
-  double frequency_hz = m_carrierFreqConverter (m_channelType, m_freqId, rxParams->m_carrierId);
+  double frequency_hz = GetCarrierFrequency (rxParams->m_carrierId);
   rxParams->m_carrierFreq_hz = frequency_hz;
 
   switch (m_rxPowerCalculationMode)
@@ -485,9 +500,8 @@ SatChannel::DoRxPowerCalculation (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyR
 
   Ptr<MobilityModel> txMobility = rxParams->m_phyTx->GetMobility ();
   Ptr<MobilityModel> rxMobility = phyRx->GetMobility ();
+  Ptr<MobilityModel> antennaMobility;
 
-  double txAntennaGain_W = 0.0;
-  double rxAntennaGain_W = 0.0;
   double markovFading = 0.0;
   double extFading = 1.0;
 
@@ -497,16 +511,14 @@ SatChannel::DoRxPowerCalculation (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyR
     case SatEnums::RETURN_FEEDER_CH:
     case SatEnums::FORWARD_USER_CH:
       {
-        txAntennaGain_W = rxParams->m_phyTx->GetAntennaGain (rxMobility);
-        rxAntennaGain_W = phyRx->GetAntennaGain (rxMobility);
+        antennaMobility = rxMobility;
         markovFading = phyRx->GetFadingValue (phyRx->GetDevice ()->GetAddress (), m_channelType);
         break;
       }
     case SatEnums::RETURN_USER_CH:
     case SatEnums::FORWARD_FEEDER_CH:
       {
-        txAntennaGain_W = rxParams->m_phyTx->GetAntennaGain (txMobility);
-        rxAntennaGain_W = phyRx->GetAntennaGain (txMobility);
+        antennaMobility = txMobility;
         markovFading = rxParams->m_phyTx->GetFadingValue (GetSourceAddress (rxParams), m_channelType);
         break;
       }
@@ -538,9 +550,100 @@ SatChannel::DoRxPowerCalculation (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyR
       DoFadingOutputTrace (rxParams, phyRx, markovFading);
     }
 
-  // get (calculate) free space loss and RX power and set it to RX params
-  double rxPower_W = (rxParams->m_txPower_W * txAntennaGain_W) / m_freeSpaceLoss->GetFsl (txMobility, rxMobility, rxParams->m_carrierFreq_hz);
-  rxParams->m_rxPower_W = rxPower_W * rxAntennaGain_W / phyRx->GetLosses () * markovFading / extFading;
+  if (m_enableLinkBudgetCache)
+    {
+      // only the Tx power and the fading change for each packet
+      double linkBudgetGain = GetLinkBudgetGain (rxParams, phyRx, txMobility, rxMobility, antennaMobility);
+      rxParams->m_rxPower_W = rxParams->m_txPower_W * linkBudgetGain * markovFading / extFading;
+    }
+  else
+    {
+      double txAntennaGain_W = rxParams->m_phyTx->GetAntennaGain (antennaMobility);
+      double rxAntennaGain_W = phyRx->GetAntennaGain (antennaMobility);
+
+      // get (calculate) free space loss and RX power and set it to RX params
+      double rxPower_W = (rxParams->m_txPower_W * txAntennaGain_W) / m_freeSpaceLoss->GetFsl (txMobility, rxMobility, rxParams->m_carrierFreq_hz);
+      rxParams->m_rxPower_W = rxPower_W * rxAntennaGain_W / phyRx->GetLosses () * markovFading / extFading;
+    }
+}
+
+double
+SatChannel::GetLinkBudgetGain (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx,
+                               Ptr<MobilityModel> txMobility, Ptr<MobilityModel> rxMobility,
+                               Ptr<MobilityModel> antennaMobility)
+{
+  NS_LOG_FUNCTION (this << rxParams << phyRx);
+
+  // Only the satellite mobility models version the changes of their course
+  Ptr<SatMobilityModel> txSatMobility = DynamicCast<SatMobilityModel> (txMobility);
+  Ptr<SatMobilityModel> rxSatMobility = DynamicCast<SatMobilityModel> (rxMobility);
+  bool cacheable = (txSatMobility != NULL && rxSatMobility != NULL);
+  uint64_t txMobilityVersion = cacheable ? txSatMobility->GetCourseVersion () : 0;
+  uint64_t rxMobilityVersion = cacheable ? rxSatMobility->GetCourseVersion () : 0;
+
+  LinkBudgetKey_t key = std::make_pair (std::make_pair (PeekPointer (rxParams->m_phyTx), PeekPointer (phyRx)), rxParams->m_carrierId);
+  std::map<LinkBudgetKey_t, LinkBudget_t>::iterator it = m_linkBudgetCache.find (key);
+
+  if (cacheable && it != m_linkBudgetCache.end ()
+      && it->second.m_carrierFreq_hz == rxParams->m_carrierFreq_hz
+      && it->second.m_txMobilityVersion == txMobilityVersion
+      && it->second.m_rxMobilityVersion == rxMobilityVersion)
+    {
+      m_linkBudgetCacheHits++;
+      return it->second.m_gain;
+    }
+
+  m_linkBudgetCacheMisses++;
+
+  double txAntennaGain_W = rxParams->m_phyTx->GetAntennaGain (antennaMobility);
+  double rxAntennaGain_W = phyRx->GetAntennaGain (antennaMobility);
+  double gain = txAntennaGain_W * rxAntennaGain_W / phyRx->GetLosses ();
+
+  LinkBudget_t linkBudget;
+  linkBudget.m_txMobilityVersion = txMobilityVersion;
+  linkBudget.m_rxMobilityVersion = rxMobilityVersion;
+
+  if (cacheable && rxParams->m_carrierId < m_carrierFrequencies.size ())
+    {
+      // the antenna gains and the distance are the same for all the carriers,
+      // update the link budgets of all of them
+      std::vector<double> fsl;
+      m_freeSpaceLoss->GetFslBatch (txMobility, rxMobility, m_carrierFrequencies, fsl);
+
+      for (uint32_t i = 0; i < m_carrierFrequencies.size (); i++)
+        {
+          key.second = i;
+          linkBudget.m_gain = gain / fsl[i];
+          linkBudget.m_carrierFreq_hz = m_carrierFrequencies[i];
+          m_linkBudgetCache[key] = linkBudget;
+        }
+
+      return gain / fsl[rxParams->m_carrierId];
+    }
+
+  linkBudget.m_gain = gain / m_freeSpaceLoss->GetFsl (txMobility, rxMobility, rxParams->m_carrierFreq_hz);
+  linkBudget.m_carrierFreq_hz = rxParams->m_carrierFreq_hz;
+
+  if (cacheable)
+    {
+      m_linkBudgetCache[key] = linkBudget;
+    }
+
+  return linkBudget.m_gain;
+}
+
+uint64_t
+SatChannel::GetLinkBudgetCacheHits () const
+{
+  NS_LOG_FUNCTION (this);
+  return m_linkBudgetCacheHits;
+}
+
+uint64_t
+SatChannel::GetLinkBudgetCacheMisses () const
+{
+  NS_LOG_FUNCTION (this);
+  return m_linkBudgetCacheMisses;
 }
 
 double
@@ -645,6 +748,37 @@ SatChannel::SetBandwidthConverter (SatTypedefs::CarrierBandwidthConverter_t conv
   m_carrierBandwidthConverter = converter;
 }
 
+void
+SatChannel::SetCarrierCount (uint32_t carrierCount)
+{
+  NS_LOG_FUNCTION (this << carrierCount);
+
+  m_carrierCount = carrierCount;
+  m_carrierFrequencies.clear ();
+}
+
+double
+SatChannel::GetCarrierFrequency (uint32_t carrierId)
+{
+  NS_LOG_FUNCTION (this << carrierId);
+
+  // the carrier frequencies are static, calculate them on the first use
+  if (m_carrierFrequencies.empty () && m_carrierCount > 0)
+    {
+      for (uint32_t i = 0; i < m_carrierCount; i++)
+        {
+          m_carrierFrequencies.push_back (m_carrierFreqConverter (m_channelType, m_freqId, i));
+        }
+    }
+
+  if (carrierId < m_carrierFrequencies.size ())
+    {
+      return m_carrierFrequencies[carrierId];
+    }
+
+  return m_carrierFreqConverter (m_channelType, m_freqId, carrierId);
+}
+
 SatEnums::ChannelType_t
 SatChannel::GetChannelType ()
 {
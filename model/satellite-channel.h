@@ -22,6 +22,8 @@
 #ifndef SATELLITE_CHANNEL_H
 #define SATELLITE_CHANNEL_H
 
+#include <map>
+#include <vector>
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/channel.h"
@@ -141,6 +143,15 @@ public:
    */
   virtual void SetBandwidthConverter (SatTypedefs::CarrierBandwidthConverter_t converter);
 
+  /**
+   * \brief Set the number of carriers of the channel. When it is known, the
+   * carrier frequencies are calculated once and the link budgets of all the
+   * carriers of a transmitter and receiver are cached together.
+   *
+   * \param carrierCount The number of carriers of the channel.
+   */
+  virtual void SetCarrierCount (uint32_t carrierCount);
+
   /**
    * \brief Get the type of the channel.
    * \return Type of the channel.
@@ -191,7 +202,38 @@ public:
    */
   virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
 
+  /**
+   * \brief Get the number of Rx power calculations which used a cached link budget
+   * \return number of link budget cache hits
+   */
+  uint64_t GetLinkBudgetCacheHits () const;
+
+  /**
+   * \brief Get the number of Rx power calculations which computed the link budget
+   * \return number of link budget cache misses
+   */
+  uint64_t GetLinkBudgetCacheMisses () const;
+
 private:
+  /**
+   * \brief Key of the link budget cache: transmitter, receiver and carrier
+   */
+  typedef std::pair<std::pair<const SatPhyTx*, const SatPhyRx*>, uint32_t> LinkBudgetKey_t;
+
+  /**
+   * \brief Cached link budget of a transmitter, receiver and carrier. The gain
+   * is the product of the terms of the Rx power which change only with the
+   * positions of the transmitter and receiver or with the carrier frequency:
+   * Tx and Rx antenna gains, free space loss and Rx losses.
+   */
+  typedef struct
+  {
+    double m_gain;
+    double m_carrierFreq_hz;
+    uint64_t m_txMobilityVersion;
+    uint64_t m_rxMobilityVersion;
+  } LinkBudget_t;
+
   /**
    * Forwarding mode of the SatChannel:
    * SINGLE_RX = only the proper receiver of the packet shall receive the packet
@@ -224,6 +266,16 @@ private:
    */
   uint32_t m_freqId;
 
+  /**
+   * \brief Number of carriers of the channel, zero if unknown
+   */
+  uint32_t m_carrierCount;
+
+  /**
+   * \brief Center frequencies of the carriers of the channel
+   */
+  std::vector<double> m_carrierFrequencies;
+
   /**
    * \brief Propagation delay model to be used with this channel
    */
@@ -254,6 +306,26 @@ private:
    */
   bool m_enableExternalFadingInputTrace;
 
+  /**
+   * \brief Defines whether the link budgets are cached between Rx power calculations
+   */
+  bool m_enableLinkBudgetCache;
+
+  /**
+   * \brief Cached link budgets
+   */
+  std::map<LinkBudgetKey_t, LinkBudget_t> m_linkBudgetCache;
+
+  /**
+   * \brief Number of Rx power calculations which used a cached link budget
+   */
+  uint64_t m_linkBudgetCacheHits;
+
+  /**
+   * \brief Number of Rx power calculations which computed the link budget
+   */
+  uint64_t m_linkBudgetCacheMisses;
+
   /**
    * Dispose SatChannel.
    */
@@ -303,6 +375,29 @@ private:
    */
   void DoRxPowerCalculation (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx);
 
+  /**
+   * \brief Get the center frequency of a carrier of the channel
+   * \param carrierId Id of the carrier
+   * \return the center frequency of the carrier
+   */
+  double GetCarrierFrequency (uint32_t carrierId);
+
+  /**
+   * \brief Get the link budget gain of the transmitter, receiver and carrier
+   * of the signal, from the cache if the positions and carrier frequency did
+   * not change since it was calculated. When the carriers of the channel are
+   * known, the link budgets of all of them are calculated at once.
+   * \param rxParams Rx parameters
+   * \param phyRx The receiver SatPhyRx entity
+   * \param txMobility Mobility of the transmitter
+   * \param rxMobility Mobility of the receiver
+   * \param antennaMobility Mobility used for the antenna gains (UT or GW)
+   * \return product of the antenna gains divided by the free space loss and Rx losses
+   */
+  double GetLinkBudgetGain (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx,
+                            Ptr<MobilityModel> txMobility, Ptr<MobilityModel> rxMobility,
+                            Ptr<MobilityModel> antennaMobility);
+
   /**
    * \brief Function for getting the external source fading value
    * \param rxParams Rx parameters
@@ -19,9 +19,12 @@
  */
 
 #include <fstream>
+#include <limits>
 #include "ns3/log.h"
 #include "ns3/enum.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
 #include "ns3/string.h"
 #include "ns3/singleton.h"
 #include "ns3/satellite-env-variables.h"
@@ -70,7 +73,18 @@ SatFadingExternalInputTraceContainer::GetTypeId (void)
                    "Maximum distance allowed to fading source in position based mode [m].",
                    DoubleValue (5000),
                    MakeDoubleAccessor (&SatFadingExternalInputTraceContainer::m_maxDistanceToFading),
-                   MakeDoubleChecker<double> ());
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("EnableStreaming",
+                   "Keep only a window of the trace files in memory and load the next chunk in background. "
+                   "Files in the flat format are always memory mapped instead.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatFadingExternalInputTraceContainer::m_enableStreaming),
+                   MakeBooleanChecker ())
+    .AddAttribute ("StreamingChunkLength",
+                   "Number of samples per chunk of the streamed trace files.",
+                   UintegerValue (65536),
+                   MakeUintegerAccessor (&SatFadingExternalInputTraceContainer::m_streamingChunkLength),
+                   MakeUintegerChecker<uint32_t> (1));
   return tid;
 }
 
@@ -82,7 +96,9 @@ TypeId SatFadingExternalInputTraceContainer::GetInstanceTypeId (void) const
 SatFadingExternalInputTraceContainer::SatFadingExternalInputTraceContainer ()
   : m_utInputMode (LIST_MODE),
   m_indexFilesLoaded (false),
-  m_maxDistanceToFading (0)
+  m_maxDistanceToFading (0),
+  m_enableStreaming (false),
+  m_streamingChunkLength (0)
 {
   NS_LOG_FUNCTION (this);
 
@@ -96,6 +112,8 @@ SatFadingExternalInputTraceContainer::~SatFadingExternalInputTraceContainer ()
 
   m_utFadingMap.clear ();
   m_gwFadingMap.clear ();
+  m_loadedTraces.clear ();
+  m_prefetcher = NULL;
 }
 
 void
@@ -110,6 +128,9 @@ SatFadingExternalInputTraceContainer::LoadIndexFiles ()
       ReadIndexFile (m_gwRtnDownIndexFileName, m_gwRtnDownFileNames);
       ReadIndexFile (m_gwFwdUpIndexFileName, m_gwFwdUpFileNames);
 
+      BuildPositionIndex (m_utRtnUpFileNames, m_utRtnUpPositionIndex);
+      BuildPositionIndex (m_utFwdDownFileNames, m_utFwdDownPositionIndex);
+
       m_indexFilesLoaded = true;
     }
 }
@@ -124,8 +145,8 @@ SatFadingExternalInputTraceContainer::CreateUtFadingTrace (uint32_t utId, Ptr<Mo
       LoadIndexFiles ();
     }
 
-  Ptr<SatFadingExternalInputTrace> ftRet = CreateFadingTrace (SatFadingExternalInputTrace::FT_TWO_COLUMN, m_utInputMode, m_utRtnUpFileNames, utId - 1, mobility);
-  Ptr<SatFadingExternalInputTrace> ftFwd = CreateFadingTrace (SatFadingExternalInputTrace::FT_THREE_COLUMN, m_utInputMode, m_utFwdDownFileNames, utId - 1, mobility);
+  Ptr<SatFadingExternalInputTrace> ftRet = CreateFadingTrace (SatFadingExternalInputTrace::FT_TWO_COLUMN, m_utInputMode, m_utRtnUpFileNames, m_utRtnUpPositionIndex, utId - 1, mobility);
+  Ptr<SatFadingExternalInputTrace> ftFwd = CreateFadingTrace (SatFadingExternalInputTrace::FT_THREE_COLUMN, m_utInputMode, m_utFwdDownFileNames, m_utFwdDownPositionIndex, utId - 1, mobility);
 
   // First = RETURN_USER
   // Second = FORWARD_USER
@@ -143,8 +164,9 @@ SatFadingExternalInputTraceContainer::CreateGwFadingTrace (uint32_t gwId, Ptr<Mo
       LoadIndexFiles ();
     }
 
-  Ptr<SatFadingExternalInputTrace> ftRet = CreateFadingTrace (SatFadingExternalInputTrace::FT_TWO_COLUMN, LIST_MODE, m_gwRtnDownFileNames, gwId - 1, mobility);
-  Ptr<SatFadingExternalInputTrace> ftFwd = CreateFadingTrace (SatFadingExternalInputTrace::FT_TWO_COLUMN, LIST_MODE, m_gwFwdUpFileNames, gwId - 1, mobility);
+  // GW traces are always used in list mode, so no position index is needed
+  Ptr<SatFadingExternalInputTrace> ftRet = CreateFadingTrace (SatFadingExternalInputTrace::FT_TWO_COLUMN, LIST_MODE, m_gwRtnDownFileNames, SatPositionKdTree (), gwId - 1, mobility);
+  Ptr<SatFadingExternalInputTrace> ftFwd = CreateFadingTrace (SatFadingExternalInputTrace::FT_TWO_COLUMN, LIST_MODE, m_gwFwdUpFileNames, SatPositionKdTree (), gwId - 1, mobility);
 
   // First = RETURN_FEEDER
   // Second = FORWARD_FEEDR
@@ -229,11 +251,7 @@ SatFadingExternalInputTraceContainer::TestFadingTraces (uint32_t numOfUts, uint3
 
   if ( !m_indexFilesLoaded )
     {
-      ReadIndexFile (m_gwRtnDownIndexFileName, m_gwRtnDownFileNames);
-      ReadIndexFile (m_gwFwdUpIndexFileName, m_gwFwdUpFileNames);
-      ReadIndexFile (m_utRtnUpIndexFileName, m_utRtnUpFileNames);
-      ReadIndexFile (m_utFwdDownIndexFileName, m_utFwdDownFileNames);
-      m_indexFilesLoaded = true;
+      LoadIndexFiles ();
     }
 
   for (uint32_t i = 1; i <= numOfUts; i++)
@@ -337,7 +355,8 @@ SatFadingExternalInputTraceContainer::ReadIndexFile (std::string indexFile, Trac
 
 Ptr<SatFadingExternalInputTrace>
 SatFadingExternalInputTraceContainer::CreateFadingTrace (SatFadingExternalInputTrace::TraceFileType_e fileType, InputMode_t inputMode,
-                                                         TraceFileContainer_t& container, uint32_t id, Ptr<MobilityModel> mobility)
+                                                         TraceFileContainer_t& container, const SatPositionKdTree& positionIndex,
+                                                         uint32_t id, Ptr<MobilityModel> mobility)
 {
   NS_LOG_FUNCTION (this << mobility);
 
@@ -369,7 +388,7 @@ SatFadingExternalInputTraceContainer::CreateFadingTrace (SatFadingExternalInputT
       break;
 
     case POSITION_MODE:
-      fileName = FindSourceBasedOnPosition (container, id, mobility);
+      fileName = FindSourceBasedOnPosition (container, positionIndex, id, mobility);
       break;
 
     default:
@@ -385,8 +404,21 @@ SatFadingExternalInputTraceContainer::CreateFadingTrace (SatFadingExternalInputT
 
   if ( it == m_loadedTraces.end ())
     {
-      // create if not found
-      trace = Create<SatFadingExternalInputTrace> (fileType, m_dataPath + fileName);
+      // create if not found, so that each trace file is loaded only once
+      if (m_enableStreaming)
+        {
+          if (m_prefetcher == NULL)
+            {
+              m_prefetcher = Create<SatFadingTracePrefetcher> ();
+            }
+
+          trace = Create<SatFadingExternalInputTrace> (fileType, m_dataPath + fileName, m_streamingChunkLength, m_prefetcher);
+        }
+      else
+        {
+          trace = Create<SatFadingExternalInputTrace> (fileType, m_dataPath + fileName);
+        }
+      m_loadedTraces.insert (std::make_pair (fileName, trace));
     }
   else
     {
@@ -396,26 +428,36 @@ SatFadingExternalInputTraceContainer::CreateFadingTrace (SatFadingExternalInputT
   return trace;
 }
 
+void
+SatFadingExternalInputTraceContainer::BuildPositionIndex (const TraceFileContainer_t& container, SatPositionKdTree& tree)
+{
+  NS_LOG_FUNCTION (this << container.size ());
+
+  std::vector<Vector> positions;
+  positions.reserve (container.size ());
+
+  for (uint32_t i = 0; i < container.size (); i++)
+    {
+      positions.push_back (container[i].second.ToVector ());
+    }
+
+  tree.Build (positions);
+}
+
 std::string
-SatFadingExternalInputTraceContainer::FindSourceBasedOnPosition (TraceFileContainer_t& container, uint32_t id, Ptr<MobilityModel> mobility)
+SatFadingExternalInputTraceContainer::FindSourceBasedOnPosition (TraceFileContainer_t& container, const SatPositionKdTree& positionIndex, uint32_t id, Ptr<MobilityModel> mobility)
 {
   NS_LOG_FUNCTION (this << mobility);
 
+  NS_ASSERT (positionIndex.GetSize () == container.size ());
+
   std::string fileName;
+  uint32_t item (0);
   double currentDistanceToFading = std::numeric_limits<double>::max ();
-  Vector position = mobility->GetPosition ();
 
-  for (TraceFileContainer_t::iterator it = container.begin (); it != container.end (); it++)
+  if ( positionIndex.FindNearest (mobility->GetPosition (), item, currentDistanceToFading) )
     {
-      Vector fadingPosition = it->second.ToVector ();
-
-      double distanceToFading = CalculateDistance ( position, fadingPosition );
-
-      if ( distanceToFading < currentDistanceToFading )
-        {
-          currentDistanceToFading = distanceToFading;
-          fileName = it->first;
-        }
+      fileName = container.at (item).first;
     }
 
   if ( currentDistanceToFading > m_maxDistanceToFading )
@@ -29,6 +29,8 @@
 #include "satellite-enums.h"
 #include "geo-coordinate.h"
 #include "satellite-fading-external-input-trace.h"
+#include "satellite-fading-trace-prefetcher.h"
+#include "satellite-position-kd-tree.h"
 
 namespace ns3 {
 
@@ -161,6 +163,16 @@ private:
    */
   TraceFileContainer_t  m_gwRtnDownFileNames;
 
+  /**
+   * Position index of UT forward down link trace files
+   */
+  SatPositionKdTree m_utFwdDownPositionIndex;
+
+  /**
+   * Position index of UT return up link trace files
+   */
+  SatPositionKdTree m_utRtnUpPositionIndex;
+
   /**
    * Loaded trace files
    */
@@ -175,6 +187,15 @@ private:
   /// Maximum distance allowed to the external fading trace source
   double m_maxDistanceToFading;
 
+  /// Flag telling whether the legacy trace files are streamed instead of fully loaded
+  bool m_enableStreaming;
+
+  /// Number of samples per chunk of the streamed trace files
+  uint32_t m_streamingChunkLength;
+
+  /// Background loader of the chunks of the streamed trace files
+  Ptr<SatFadingTracePrefetcher> m_prefetcher;
+
   /**
    * Initialize index files
    */
@@ -202,29 +223,40 @@ private:
    */
   void ReadIndexFile (std::string indexFile, TraceFileContainer_t& container);
 
+  /**
+   * Build k-d tree of the trace source positions of the given container.
+   *
+   * \param container Container of trace file info to index
+   * \param tree k-d tree to build
+   */
+  void BuildPositionIndex (const TraceFileContainer_t& container, SatPositionKdTree& tree);
+
   /**
    * Create (or load) fading trace source for the requested UT/GW.
    *
    * \param fileType Type of the trace file
    * \param inputMode used when reading input traces from trace file
    * \param container Container reference to find out needed trace file info
+   * \param positionIndex Position index of the container, used in position mode
    * \param id Id of the node GW or UT (from SatIdMapper)
    * \param mobility Mobility for given node
    * \return Created trace input (or found trace input if queried trace input already created)
    */
   Ptr<SatFadingExternalInputTrace> CreateFadingTrace (SatFadingExternalInputTrace::TraceFileType_e fileType, InputMode_t inputMode,
-                                                      TraceFileContainer_t& container, uint32_t id, Ptr<MobilityModel> mobility);
+                                                      TraceFileContainer_t& container, const SatPositionKdTree& positionIndex,
+                                                      uint32_t id, Ptr<MobilityModel> mobility);
   /**
    *  Find the nearest fading trace source file for the requested UT/GW based on given mobility.
    *  Only external fading sources which are closer than (equal to) maximum allowed distance are accepted.
    *  Maximum allowed distance is defined by attribute.
    *
    * \param container Container reference to find out needed trace file info
+   * \param positionIndex Position index of the container
    * \param id Id of the node GW or UT (from SatIdMapper)
    * \param mobility Mobility for given node
    * \return The name of the nearest external fading source.
    */
-  std::string FindSourceBasedOnPosition (TraceFileContainer_t& container, uint32_t id, Ptr<MobilityModel> mobility);
+  std::string FindSourceBasedOnPosition (TraceFileContainer_t& container, const SatPositionKdTree& positionIndex, uint32_t id, Ptr<MobilityModel> mobility);
 };
 
 } // namespace ns3
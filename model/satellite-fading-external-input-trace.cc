@@ -20,7 +20,16 @@
 
 #include <fstream>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "ns3/simulator.h"
+#include "ns3/ptr.h"
 #include "ns3/log.h"
 #include "satellite-fading-external-input-trace.h"
 #include "satellite-utils.h"
@@ -30,17 +39,50 @@ NS_LOG_COMPONENT_DEFINE ("SatFadingExternalInputTrace");
 namespace ns3 {
 
 
+const char SatFadingExternalInputTrace::FLAT_TRACE_MAGIC[8] = { 'S', 'A', 'T', 'F', 'L', 'A', 'T', '\0' };
+const float SatFadingExternalInputTrace::TIME_INTERVAL_TOLERANCE = 0.0003;
+
 SatFadingExternalInputTrace::SatFadingExternalInputTrace ()
   : m_traceFileType (),
   m_startTime (),
-  m_timeInterval ()
+  m_timeInterval (),
+  m_uniformSampling (),
+  m_columns (),
+  m_rows (),
+  m_times (),
+  m_fading (),
+  m_chunkLength (),
+  m_windowChunk (),
+  m_windowFirstRow (),
+  m_windowRows (),
+  m_prefetcher (),
+  m_prefetchRequested (),
+  m_prefetchChunk (),
+  m_prefetchRows (),
+  m_mappedFile (),
+  m_mappedSize ()
 {
   NS_FATAL_ERROR ("SatFadingExternalInputTrace::SatFadingExternalInputTrace - Constructor not in use");
 }
 
 SatFadingExternalInputTrace::SatFadingExternalInputTrace (TraceFileType_e type, std::string fileName)
   : m_startTime (-1.0),
-  m_timeInterval (-1.0)
+  m_timeInterval (-1.0),
+  m_uniformSampling (false),
+  m_columns (0),
+  m_rows (0),
+  m_times (NULL),
+  m_fading (NULL),
+  m_chunkLength (0),
+  m_windowChunk (0),
+  m_windowFirstRow (0),
+  m_windowRows (0),
+  m_prefetcher (NULL),
+  m_prefetchRequested (false),
+  m_prefetchChunk (0),
+  m_prefetchRows (0),
+  m_mappedFile (NULL),
+  m_mappedSize (0)
 {
   NS_LOG_FUNCTION (this);
 
@@ -48,76 +90,457 @@ SatFadingExternalInputTrace::SatFadingExternalInputTrace (TraceFileType_e type,
   ReadTrace (fileName);
 }
 
+SatFadingExternalInputTrace::SatFadingExternalInputTrace (TraceFileType_e type, std::string fileName,
+                                                          uint32_t chunkLength, Ptr<SatFadingTracePrefetcher> prefetcher)
+  : m_startTime (-1.0),
+  m_timeInterval (-1.0),
+  m_uniformSampling (false),
+  m_columns (0),
+  m_rows (0),
+  m_times (NULL),
+  m_fading (NULL),
+  m_chunkLength (chunkLength),
+  m_windowChunk (0),
+  m_windowFirstRow (0),
+  m_windowRows (0),
+  m_prefetcher (prefetcher),
+  m_prefetchRequested (false),
+  m_prefetchChunk (0),
+  m_prefetchRows (0),
+  m_mappedFile (NULL),
+  m_mappedSize (0)
+{
+  NS_LOG_FUNCTION (this << chunkLength);
+
+  NS_ASSERT_MSG (chunkLength > 0, "Streamed traces need a chunk length");
+  NS_ASSERT_MSG (prefetcher != NULL, "Streamed traces need a prefetcher");
+
+  m_traceFileType = type;
+  ReadTrace (fileName);
+}
+
 
 SatFadingExternalInputTrace::~SatFadingExternalInputTrace ()
 {
   NS_LOG_FUNCTION (this);
-}
 
+  if (m_prefetchRequested)
+    {
+      m_prefetcher->Cancel (this);
+      m_prefetchRequested = false;
+    }
 
-void SatFadingExternalInputTrace::ReadTrace (std::string filePathName)
+  if (m_mappedFile != NULL)
+    {
+      munmap (m_mappedFile, m_mappedSize);
+      m_mappedFile = NULL;
+    }
+}
+
+void
+SatFadingExternalInputTrace::OpenTrace (std::string& filePathName, std::ifstream& ifs)
 {
-  NS_LOG_FUNCTION (this << filePathName);
+  NS_LOG_FUNCTION (filePathName);
 
-  // READ FROM THE SPECIFIED INPUT FILE
-  std::ifstream *ifs = new std::ifstream (filePathName.c_str (), std::ios::in | std::ios::binary);
+  ifs.open (filePathName.c_str (), std::ios::in | std::ios::binary);
 
-  if (!ifs->is_open ())
+  if (!ifs.is_open ())
     {
       // script might be launched by test.py, try a different base path
-      delete ifs;
       filePathName = "../../" + filePathName;
-      ifs = new std::ifstream (filePathName.c_str (), std::ifstream::in);
+      ifs.clear ();
+      ifs.open (filePathName.c_str (), std::ios::in | std::ios::binary);
 
-      if (!ifs->is_open ())
+      if (!ifs.is_open ())
         {
           NS_FATAL_ERROR ("The file " << filePathName << " is not found.");
         }
     }
+}
+
+void SatFadingExternalInputTrace::ReadTrace (std::string filePathName)
+{
+  NS_LOG_FUNCTION (this << filePathName);
 
   // Currently supports two or three column formats
-  uint32_t columns = (m_traceFileType == FT_TWO_COLUMN) ? 2 : 3;
+  m_columns = (m_traceFileType == FT_TWO_COLUMN) ? 2 : 3;
 
-  float temp;
-  int32_t count (0);
-  std::vector<float> values;
-  ifs->read ((char*)&temp, sizeof(float));
-  m_startTime = temp;
+  // READ FROM THE SPECIFIED INPUT FILE
+  std::ifstream ifs;
+  OpenTrace (filePathName, ifs);
+  m_filePathName = filePathName;
 
-  // While state is good
-  while (ifs->good ())
+  FlatTraceHeader_t header;
+  ifs.read ((char*)&header, sizeof (FlatTraceHeader_t));
+
+  if (ifs.gcount () == sizeof (FlatTraceHeader_t)
+      && std::equal (FLAT_TRACE_MAGIC, FLAT_TRACE_MAGIC + sizeof (FLAT_TRACE_MAGIC), header.m_magic))
     {
-      // Store previous value
-      values.push_back (temp);
+      ifs.close ();
 
-      // Read the new value
-      ++count;
-      ifs->read ((char*)&temp, sizeof(float));
+      // Flat files are paged in on demand, there is no need to stream them
+      m_chunkLength = 0;
+      MapFlatTrace (filePathName, header);
+    }
+  else if (m_chunkLength > 0)
+    {
+      ifs.close ();
+      StartStreaming ();
+    }
+  else
+    {
+      ifs.clear ();
+      ReadLegacyTrace (ifs);
+      ifs.close ();
 
-      // Handle previous value
-      if (count % columns == 0)
+      if (m_rows < 2)
         {
-          NS_ASSERT (values.size () == columns);
+          NS_FATAL_ERROR ("The file " << filePathName << " contains less than two fading samples.");
+        }
 
-          m_traceVector.push_back (values);
-          values.clear ();
+      UpdateSampling ();
+    }
+}
 
-          // Calculate the sampling interval
-          if (m_timeInterval < 0.0)
-            {
-              m_timeInterval = temp - m_startTime;
-            }
+void
+SatFadingExternalInputTrace::ReadLegacyTrace (std::ifstream& ifs)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Read the interleaved samples at once and store them column by column
+  ifs.seekg (0, std::ios::end);
+  std::streamoff fileSize = ifs.tellg ();
+  ifs.seekg (0, std::ios::beg);
+
+  m_rows = fileSize / (m_columns * sizeof (float));
+
+  std::vector<float> rows (m_rows * m_columns);
+
+  if (m_rows > 0)
+    {
+      ifs.read ((char*)&rows[0], rows.size () * sizeof (float));
+    }
+
+  m_samples.resize (m_rows * m_columns);
+
+  for (uint32_t i = 0; i < m_rows; i++)
+    {
+      for (uint32_t j = 0; j < m_columns; j++)
+        {
+          m_samples[j * m_rows + i] = rows[i * m_columns + j];
+        }
+    }
+
+  m_windowRows = m_rows;
+  m_times = &m_samples[0] + TIME_INDEX * m_rows;
+  m_fading = &m_samples[0] + FADING_INDEX * m_rows;
+}
+
+void
+SatFadingExternalInputTrace::StartStreaming ()
+{
+  NS_LOG_FUNCTION (this << m_chunkLength);
+
+  m_chunkStream.open (m_filePathName.c_str (), std::ios::in | std::ios::binary);
+
+  if (!m_chunkStream.is_open ())
+    {
+      NS_FATAL_ERROR ("The file " << m_filePathName << " cannot be opened.");
+    }
+
+  m_chunkStream.seekg (0, std::ios::end);
+  std::streamoff fileSize = m_chunkStream.tellg ();
+
+  m_rows = fileSize / (m_columns * sizeof (float));
+
+  if (m_rows < 2)
+    {
+      NS_FATAL_ERROR ("The file " << m_filePathName << " contains less than two fading samples.");
+    }
+
+  // The interval is taken from the first two samples, and the following
+  // samples are checked against it as the chunks are read
+  std::string error;
+  m_windowChunk = 0;
+  m_windowFirstRow = 0;
+  m_windowRows = ReadChunk (m_windowChunk, m_chunkStream, m_samples, error);
+
+  if (m_windowRows == 0)
+    {
+      NS_FATAL_ERROR (error);
+    }
+
+  m_times = &m_samples[0];
+  m_fading = &m_samples[0] + m_windowRows;
+
+  m_startTime = m_times[0];
+  m_timeInterval = m_times[1] - m_times[0];
+  m_uniformSampling = true;
+
+  if (m_timeInterval <= 0.0 || !IsUniformChunk (m_samples, m_windowRows))
+    {
+      NS_FATAL_ERROR ("The file " << m_filePathName << " cannot be streamed, its time samples are not at constant interval.");
+    }
+
+  if (m_chunkLength < m_rows - 1)
+    {
+      m_prefetchChunk = 1;
+      m_prefetchRequested = true;
+      m_prefetcher->Prefetch (this);
+    }
+}
+
+uint32_t
+SatFadingExternalInputTrace::ReadChunk (uint32_t chunk, std::ifstream& ifs, std::vector<float>& samples, std::string& error) const
+{
+  uint32_t firstRow = chunk * m_chunkLength;
+  uint32_t rows = std::min (m_chunkLength + 1, m_rows - firstRow);
+
+  std::vector<float> interleaved (rows * m_columns);
+  ifs.clear ();
+  ifs.seekg ((std::streamoff)firstRow * m_columns * sizeof (float), std::ios::beg);
+  ifs.read ((char*)&interleaved[0], interleaved.size () * sizeof (float));
+
+  if (!ifs.good ())
+    {
+      std::ostringstream oss;
+      oss << "The file " << m_filePathName << " cannot be read.";
+      error = oss.str ();
+      return 0;
+    }
+
+  // Only the time and fading columns are kept
+  samples.resize (2 * rows);
+
+  for (uint32_t i = 0; i < rows; i++)
+    {
+      samples[i] = interleaved[i * m_columns + TIME_INDEX];
+      samples[rows + i] = interleaved[i * m_columns + FADING_INDEX];
+    }
+
+  // The interval is not known yet when the first chunk is read
+  if (m_timeInterval > 0.0 && !IsUniformChunk (samples, rows))
+    {
+      std::ostringstream oss;
+      oss << "The file " << m_filePathName << " cannot be streamed, its time samples are not at constant interval in chunk " << chunk << ".";
+      error = oss.str ();
+      return 0;
+    }
+
+  return rows;
+}
+
+bool
+SatFadingExternalInputTrace::IsUniformChunk (const std::vector<float>& samples, uint32_t rows) const
+{
+  for (uint32_t i = 1; i < rows; i++)
+    {
+      float interval = samples[i] - samples[i - 1];
+
+      if (interval <= 0.0 || std::abs (interval - m_timeInterval) > TIME_INTERVAL_TOLERANCE)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+void
+SatFadingExternalInputTrace::LoadPrefetchChunk ()
+{
+  m_prefetchError.clear ();
+  m_prefetchRows = ReadChunk (m_prefetchChunk, m_chunkStream, m_prefetchSamples, m_prefetchError);
+}
+
+void
+SatFadingExternalInputTrace::MoveWindow (uint32_t chunk)
+{
+  NS_LOG_FUNCTION (this << chunk);
+
+  if (m_prefetchRequested)
+    {
+      m_prefetcher->WaitFor (this);
+      m_prefetchRequested = false;
+    }
+
+  if (m_prefetchChunk == chunk && m_prefetchRows > 0)
+    {
+      m_samples.swap (m_prefetchSamples);
+      m_windowRows = m_prefetchRows;
+    }
+  else if (m_prefetchChunk == chunk && !m_prefetchError.empty ())
+    {
+      // Errors of the prefetcher thread are reported on the simulation thread
+      NS_FATAL_ERROR (m_prefetchError);
+    }
+  else
+    {
+      // The simulation time jumped over the prefetched chunk
+      NS_LOG_INFO ("Chunk " << chunk << " of " << m_filePathName << " not prefetched");
+
+      std::string error;
+      m_windowRows = ReadChunk (chunk, m_chunkStream, m_samples, error);
+
+      if (m_windowRows == 0)
+        {
+          NS_FATAL_ERROR (error);
         }
     }
-  ifs->close ();
-  delete ifs;
+
+  m_prefetchRows = 0;
+  m_prefetchError.clear ();
+  m_windowChunk = chunk;
+  m_windowFirstRow = chunk * m_chunkLength;
+  m_times = &m_samples[0];
+  m_fading = &m_samples[0] + m_windowRows;
+
+  if ((chunk + 1) * m_chunkLength < m_rows - 1)
+    {
+      m_prefetchChunk = chunk + 1;
+      m_prefetchRequested = true;
+      m_prefetcher->Prefetch (this);
+    }
+}
+
+void
+SatFadingExternalInputTrace::MapFlatTrace (std::string filePathName, const FlatTraceHeader_t& header)
+{
+  NS_LOG_FUNCTION (this << filePathName);
+
+  if (header.m_version != FLAT_TRACE_VERSION)
+    {
+      NS_FATAL_ERROR ("The file " << filePathName << " has unsupported flat trace version " << header.m_version);
+    }
+
+  if (header.m_columns < m_columns)
+    {
+      NS_FATAL_ERROR ("The file " << filePathName << " has " << header.m_columns << " columns, " << m_columns << " expected.");
+    }
+
+  // Rows are indexed with 32 bits integers
+  if (header.m_rows < 2 || header.m_rows > std::numeric_limits<uint32_t>::max ())
+    {
+      NS_FATAL_ERROR ("The file " << filePathName << " has an invalid number of fading samples: " << header.m_rows);
+    }
+
+  int fd = open (filePathName.c_str (), O_RDONLY);
+
+  if (fd < 0)
+    {
+      NS_FATAL_ERROR ("The file " << filePathName << " cannot be opened.");
+    }
+
+  struct stat fileStat;
+
+  if (fstat (fd, &fileStat) < 0)
+    {
+      close (fd);
+      NS_FATAL_ERROR ("The file " << filePathName << " cannot be accessed.");
+    }
+
+  m_mappedSize = fileStat.st_size;
+
+  if (m_mappedSize < sizeof (FlatTraceHeader_t)
+      || (m_mappedSize - sizeof (FlatTraceHeader_t)) / sizeof (float) / header.m_columns < header.m_rows)
+    {
+      close (fd);
+      NS_FATAL_ERROR ("The file " << filePathName << " is truncated.");
+    }
+
+  m_mappedFile = mmap (NULL, m_mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+
+  if (m_mappedFile == MAP_FAILED)
+    {
+      m_mappedFile = NULL;
+      NS_FATAL_ERROR ("The file " << filePathName << " cannot be memory mapped.");
+    }
+
+  // The sampling has been checked when the file was converted
+  m_rows = header.m_rows;
+  m_startTime = header.m_startTime;
+  m_timeInterval = header.m_timeInterval;
+  m_uniformSampling = (header.m_uniform != 0);
+  m_windowRows = m_rows;
+
+  const float *columns = (const float*)((const char*)m_mappedFile + sizeof (FlatTraceHeader_t));
+  m_times = columns + TIME_INDEX * m_rows;
+  m_fading = columns + FADING_INDEX * m_rows;
+}
+
+void
+SatFadingExternalInputTrace::UpdateSampling ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_startTime = m_times[0];
+  m_timeInterval = m_times[1] - m_times[0];
+  m_uniformSampling = (m_timeInterval > 0.0);
+
+  for (uint32_t i = 1; m_uniformSampling && i < m_rows; i++)
+    {
+      float interval = m_times[i] - m_times[i - 1];
+      m_uniformSampling = (interval > 0.0 && std::abs (interval - m_timeInterval) <= TIME_INTERVAL_TOLERANCE);
+    }
+
+  NS_LOG_INFO ("Trace of " << m_rows << " samples, start time " << m_startTime
+                           << ", interval " << m_timeInterval << ", uniform " << m_uniformSampling);
+}
+
+uint32_t
+SatFadingExternalInputTrace::FindLowerIndex (float time)
+{
+  NS_LOG_FUNCTION (this << time);
+
+  if (time <= m_startTime)
+    {
+      if (m_windowChunk != 0)
+        {
+          MoveWindow (0);
+        }
+      return 0;
+    }
+
+  uint32_t lowerIndex;
+
+  if (m_uniformSampling)
+    {
+      // Calculate the index to the time sample just before current time
+      lowerIndex = std::min ((uint32_t)(std::floor ((time - m_startTime) / m_timeInterval)), m_rows - 2);
+
+      if (m_chunkLength > 0 && lowerIndex / m_chunkLength != m_windowChunk)
+        {
+          MoveWindow (lowerIndex / m_chunkLength);
+        }
+
+      // Correct the index for the rounding of the sample times
+      uint32_t lastIndex = m_windowRows - 2;
+      lowerIndex -= m_windowFirstRow;
+
+      while (lowerIndex > 0 && m_times[lowerIndex] > time)
+        {
+          lowerIndex--;
+        }
+      while (lowerIndex < lastIndex && m_times[lowerIndex + 1] <= time)
+        {
+          lowerIndex++;
+        }
+    }
+  else
+    {
+      const float *upper = std::upper_bound (m_times, m_times + m_windowRows, time);
+      lowerIndex = std::min ((uint32_t)(upper - m_times - 1), m_windowRows - 2);
+    }
+
+  return lowerIndex;
 }
 
 double
-SatFadingExternalInputTrace::GetFading () const
+SatFadingExternalInputTrace::GetFading ()
 {
   NS_LOG_FUNCTION (this);
-  NS_ASSERT (!m_traceVector.empty ());
+  NS_ASSERT (m_rows > 1);
 
   float simTime = Simulator::Now ().GetSeconds ();
 
@@ -126,34 +549,24 @@ SatFadingExternalInputTrace::GetFading () const
       NS_LOG_ERROR (this << " requested time is smaller than the minimum time value!");
     }
 
-  // Calculate the index to the time sample just before current time
-  uint32_t lowerIndex = (uint32_t)(std::floor (std::abs (simTime - m_startTime) / m_timeInterval));
+  uint32_t lowerIndex = FindLowerIndex (simTime);
 
-  if (lowerIndex >= m_traceVector.size ())
+  if (m_windowFirstRow + m_windowRows == m_rows && simTime > m_times[m_windowRows - 1])
     {
-      NS_LOG_ERROR (this << " calculated index exceeds trace file size!");
+      NS_LOG_ERROR (this << " requested time exceeds trace file duration!");
     }
 
-  float lowerKey = m_traceVector.at (lowerIndex).at (TIME_INDEX);
-  float upperKey = m_traceVector.at (lowerIndex + 1).at (TIME_INDEX);
+  float lowerKey = m_times[lowerIndex];
+  float upperKey = m_times[lowerIndex + 1];
 
   // Interpolation in linear domain
-  float lowerVal = SatUtils::DbToLinear (m_traceVector.at (lowerIndex).at (FADING_INDEX));
-  float upperVal = SatUtils::DbToLinear (m_traceVector.at (lowerIndex + 1).at (FADING_INDEX));
+  float lowerVal = SatUtils::DbToLinear (m_fading[lowerIndex]);
+  float upperVal = SatUtils::DbToLinear (m_fading[lowerIndex + 1]);
 
   // y = y0 + (y1 - y0) * (x - x0) / (x1 - x0)
   double fading = lowerVal + (upperVal - lowerVal)
     * (simTime - lowerKey) / (upperKey - lowerKey);
 
-  /*
-  std::cout << "Now: " << simTime <<
-      ", interpolated fading: " << fading_dB <<
-      ", interpolated fading: " << SatUtils::DbToLinear (fading_dB) <<
-      ", Lower time: " << lowerKey <<
-      ", Upper time: " << upperKey <<
-      ", Lower fading: " << lowerVal <<
-      ", Upper fading: " << upperVal << std::endl;
-  */
   return fading;
 }
 
@@ -161,31 +574,110 @@ bool
 SatFadingExternalInputTrace::TestFadingTrace () const
 {
   NS_LOG_FUNCTION (this);
-  NS_ASSERT (!m_traceVector.empty ());
+  NS_ASSERT (m_rows > 1);
 
-  std::vector<std::vector<float> >::const_iterator cit;
   float prevTime (-1.0);
   float currTime (-1.0);
 
-  for (cit = m_traceVector.begin (); cit != m_traceVector.end (); ++cit)
+  // Streamed traces are read chunk by chunk, other traces are fully in the window
+  uint32_t chunks = (m_chunkLength > 0) ? (m_rows - 2) / m_chunkLength + 1 : 1;
+  std::vector<float> samples;
+  std::ifstream ifs;
+  std::string error;
+
+  // The stream of the trace may be used by the prefetcher thread
+  if (m_chunkLength > 0)
+    {
+      ifs.open (m_filePathName.c_str (), std::ios::in | std::ios::binary);
+    }
+
+  for (uint32_t chunk = 0; chunk < chunks; chunk++)
     {
-      if (prevTime > 0)
+      const float *times = m_times;
+      uint32_t rows = m_windowRows;
+
+      if (m_chunkLength > 0)
         {
-          currTime = cit->at (TIME_INDEX);
-          double diff = std::abs ( std::abs (currTime - prevTime) - m_timeInterval);
+          rows = ReadChunk (chunk, ifs, samples, error);
 
-          // Test that the the time samples are from constant interval and
-          // the time samples are always increasing.
-          if ( diff > 0.0003 || currTime < prevTime)
+          if (rows == 0)
             {
+              NS_LOG_INFO (error);
               return false;
             }
+
+          times = &samples[0];
+        }
+
+      // The first sample of a chunk is the last one of the previous chunk
+      for (uint32_t i = (chunk > 0) ? 1 : 0; i < rows; i++)
+        {
+          if (prevTime > 0)
+            {
+              currTime = times[i];
+              double diff = std::abs ( std::abs (currTime - prevTime) - m_timeInterval);
+
+              // Test that the the time samples are from constant interval and
+              // the time samples are always increasing.
+              if ( diff > TIME_INTERVAL_TOLERANCE || currTime < prevTime)
+                {
+                  return false;
+                }
+            }
+          prevTime = times[i];
         }
-      prevTime = cit->at (TIME_INDEX);
     }
 
   // Succeeded
   return true;
 }
 
+void
+SatFadingExternalInputTrace::WriteFlatTrace (std::string filePathName) const
+{
+  NS_LOG_FUNCTION (this << filePathName);
+
+  if (m_chunkLength > 0)
+    {
+      NS_FATAL_ERROR ("Streamed traces cannot be written in the flat format.");
+    }
+
+  FlatTraceHeader_t header;
+  std::memset (&header, 0, sizeof (FlatTraceHeader_t));
+  std::copy (FLAT_TRACE_MAGIC, FLAT_TRACE_MAGIC + sizeof (FLAT_TRACE_MAGIC), header.m_magic);
+  header.m_version = FLAT_TRACE_VERSION;
+  header.m_columns = m_columns;
+  header.m_rows = m_rows;
+  header.m_startTime = m_startTime;
+  header.m_timeInterval = m_timeInterval;
+  header.m_uniform = m_uniformSampling ? 1 : 0;
+
+  std::ofstream ofs (filePathName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+
+  if (!ofs.is_open ())
+    {
+      NS_FATAL_ERROR ("The file " << filePathName << " cannot be created.");
+    }
+
+  // The columns are contiguous both in the owned samples and in the mapped file
+  ofs.write ((const char*)&header, sizeof (FlatTraceHeader_t));
+  ofs.write ((const char*)m_times, m_columns * m_rows * sizeof (float));
+
+  if (!ofs.good ())
+    {
+      NS_FATAL_ERROR ("The file " << filePathName << " cannot be written.");
+    }
+
+  ofs.close ();
+}
+
+void
+SatFadingExternalInputTrace::ConvertToFlatTrace (TraceFileType_e type, std::string inputFilePathName, std::string outputFilePathName)
+{
+  NS_LOG_FUNCTION (type << inputFilePathName << outputFilePathName);
+
+  Ptr<SatFadingExternalInputTrace> trace = Create<SatFadingExternalInputTrace> (type, inputFilePathName);
+  trace->WriteFlatTrace (outputFilePathName);
+}
+
 } // namespace ns3
@@ -22,7 +22,12 @@
 #define SATELLITE_FADING_EXTERNAL_INPUT_TRACE_H
 
 #include <vector>
+#include <string>
+#include <fstream>
+#include <stdint.h>
 #include "ns3/simple-ref-count.h"
+#include "ns3/ptr.h"
+#include "satellite-fading-trace-prefetcher.h"
 
 namespace ns3 {
 
@@ -31,8 +36,25 @@ namespace ns3 {
  * \brief The class for satellite fading external input trace. The class reads
  * fading trace input samples from a file and provides the current fading value
  * for this specific fading file.
+ *
+ * Two file formats are supported. The legacy format is a sequence of native
+ * floats with the columns of each sample interleaved. The flat format starts
+ * with a FlatTraceHeader_t and stores each column contiguously after it. Flat
+ * files are memory mapped read-only, so the pages are shared between all the
+ * simulation processes reading the same trace. Legacy files can be converted
+ * to the flat format with WriteFlatTrace. The format of a file is detected
+ * from its header.
+ *
+ * Legacy files may also be streamed: only a window of one chunk of samples
+ * is kept in memory, and the following chunk is loaded in advance by a
+ * SatFadingTracePrefetcher while the simulation time goes through the
+ * current one. Streamed traces must be sampled at constant interval, which
+ * is checked on each chunk as it is loaded. The file of a streamed trace is
+ * kept open, and errors met on the prefetcher thread are reported when the
+ * simulation thread moves to the chunk.
  */
-class SatFadingExternalInputTrace : public SimpleRefCount <SatFadingExternalInputTrace>
+class SatFadingExternalInputTrace : public SimpleRefCount <SatFadingExternalInputTrace>,
+                                    public SatFadingTracePrefetcher::Source
 {
 public:
   enum TraceFileType_e
@@ -53,6 +75,16 @@ public:
    */
   SatFadingExternalInputTrace (TraceFileType_e type, std::string filePathName);
 
+  /**
+   * Constructor of a streamed trace.
+   * \param type
+   * \param filePathName
+   * \param chunkLength Number of samples per chunk
+   * \param prefetcher Prefetcher loading the chunks in background
+   */
+  SatFadingExternalInputTrace (TraceFileType_e type, std::string filePathName,
+                               uint32_t chunkLength, Ptr<SatFadingTracePrefetcher> prefetcher);
+
   /**
    * Destructor for SatFadingExternalInputTrace
    */
@@ -62,7 +94,7 @@ public:
    * Get the current fading value for this specific fading file
    * \return fading value in linear format
    */
-  double GetFading () const;
+  double GetFading ();
 
   /**
    * A method to test that the fading trace is according to
@@ -71,13 +103,117 @@ public:
    */
   bool TestFadingTrace () const;
 
+  /**
+   * Write the fading trace to a file in the flat format
+   * \param filePathName Path and file name of the flat fading file
+   */
+  void WriteFlatTrace (std::string filePathName) const;
+
+  /**
+   * Convert a fading trace file to the flat format
+   * \param type Type of the fading file
+   * \param inputFilePathName Path and file name of the fading file to convert
+   * \param outputFilePathName Path and file name of the flat fading file
+   */
+  static void ConvertToFlatTrace (TraceFileType_e type, std::string inputFilePathName, std::string outputFilePathName);
+
+  /**
+   * Load the chunk requested from the prefetcher, called on its I/O thread
+   */
+  virtual void LoadPrefetchChunk ();
+
 private:
+  /**
+   * Header of the flat fading trace files. The header is followed by the
+   * columns of the trace, each one made of m_rows native floats. Byte order
+   * of the header and of the samples is the one of the writing host.
+   */
+  typedef struct
+  {
+    char m_magic[8];
+    uint32_t m_version;
+    uint32_t m_columns;
+    uint64_t m_rows;
+    float m_startTime;
+    float m_timeInterval;
+    uint32_t m_uniform;
+    uint32_t m_reserved;
+  } FlatTraceHeader_t;
+
+  /**
+   * Open the fading trace file, trying also the path used by test.py
+   * \param filePathName Path and file name of the fading file, updated to
+   * the path actually opened
+   * \param ifs Stream opened
+   */
+  static void OpenTrace (std::string& filePathName, std::ifstream& ifs);
+
   /**
    * Read the fading trace from a binary file
    * \param filePathName Path and file name of the fading file
    */
   void ReadTrace (std::string filePathName);
 
+  /**
+   * Read the fading trace from a legacy binary file into the owned samples
+   * \param ifs Stream of the fading file
+   */
+  void ReadLegacyTrace (std::ifstream& ifs);
+
+  /**
+   * Open the stream of a streamed legacy trace and read its first chunk
+   */
+  void StartStreaming ();
+
+  /**
+   * Read a chunk of a streamed legacy trace, including the first sample of
+   * the next chunk, and check that its time samples are at constant
+   * interval once the interval is known. Does not log nor abort, as it is
+   * called on the prefetcher thread.
+   * \param chunk Index of the chunk
+   * \param ifs Stream of the fading file
+   * \param samples Container for the time and fading columns of the chunk
+   * \param error Description of the error, if any
+   * \return number of samples read, zero on error
+   */
+  uint32_t ReadChunk (uint32_t chunk, std::ifstream& ifs, std::vector<float>& samples, std::string& error) const;
+
+  /**
+   * Check that the time samples of a chunk are increasing at constant interval
+   * \param samples Time and fading columns of the chunk
+   * \param rows Number of samples of the chunk
+   * \return true if the interval between the samples is m_timeInterval
+   */
+  bool IsUniformChunk (const std::vector<float>& samples, uint32_t rows) const;
+
+  /**
+   * Move the window of a streamed trace to the given chunk, and request the
+   * next chunk from the prefetcher
+   * \param chunk Index of the chunk
+   */
+  void MoveWindow (uint32_t chunk);
+
+  /**
+   * Memory map the fading trace from a flat binary file
+   * \param filePathName Path and file name of the fading file
+   * \param header Header read from the fading file
+   */
+  void MapFlatTrace (std::string filePathName, const FlatTraceHeader_t& header);
+
+  /**
+   * Check whether the time samples of a legacy trace have a constant
+   * interval, and set the start time and interval of the trace
+   */
+  void UpdateSampling ();
+
+  /**
+   * Find the index of the time sample just before the given time, moving
+   * the window of a streamed trace if needed
+   * \param time Time in seconds
+   * \return index of the lower sample in the window, smaller than m_windowRows - 1
+   */
+  uint32_t FindLowerIndex (float time);
+
   /**
    * There may be different fading file types.
    * - FT_TWO_COLUMN
@@ -97,19 +233,88 @@ private:
   static const uint32_t FADING_INDEX = 1;
   static const uint32_t SCINTILLATION_INDEX = 2;
 
+  /**
+   * Magic string and version identifying the flat fading trace files
+   */
+  static const char FLAT_TRACE_MAGIC[8];
+  static const uint32_t FLAT_TRACE_VERSION = 1;
+
+  /**
+   * Maximum deviation of the time sample interval for the trace to be
+   * considered uniformly sampled
+   */
+  static const float TIME_INTERVAL_TOLERANCE;
+
   /**
    * Fading start time and interval calculated from the actual trace file.
-   * Note, that the current implementation assumes that we have constant
-   * time interval between fading samples. This assumption has been made
-   * for speed-up issues.
+   * When the time samples are at constant interval, the sample index of a
+   * time is calculated directly from these. Otherwise the time column is
+   * searched.
    */
   float m_startTime;
   float m_timeInterval;
+  bool m_uniformSampling;
+
+  /**
+   * Number of columns and rows of the trace
+   */
+  uint32_t m_columns;
+  uint32_t m_rows;
+
+  /**
+   * Time and fading columns of the trace window, pointing either to the
+   * owned samples or to the memory mapped file
+   */
+  const float *m_times;
+  const float *m_fading;
+
+  /**
+   * Samples read from a legacy trace file, stored column by column
+   */
+  std::vector<float> m_samples;
+
+  /**
+   * Path and file name of the fading file
+   */
+  std::string m_filePathName;
+
+  /**
+   * Number of samples per chunk of a streamed trace, zero when the whole
+   * trace is loaded
+   */
+  uint32_t m_chunkLength;
+
+  /**
+   * Window of the trace available in m_times and m_fading
+   */
+  uint32_t m_windowChunk;
+  uint32_t m_windowFirstRow;
+  uint32_t m_windowRows;
+
+  /**
+   * Stream of the streamed trace file, kept open for all the chunks. Only
+   * used by one thread at a time, the simulation thread waits for the
+   * prefetcher before reading from it.
+   */
+  std::ifstream m_chunkStream;
+
+  /**
+   * Prefetcher of the streamed trace and chunk loaded by it. The prefetch
+   * samples and error are only accessed by the simulation thread after
+   * waiting for the prefetcher.
+   */
+  Ptr<SatFadingTracePrefetcher> m_prefetcher;
+  bool m_prefetchRequested;
+  uint32_t m_prefetchChunk;
+  uint32_t m_prefetchRows;
+  std::vector<float> m_prefetchSamples;
+  std::string m_prefetchError;
 
   /**
-   * Container for the fading trace.
+   * Memory mapped flat trace file
    */
-  std::vector<std::vector<float> > m_traceVector;
+  void *m_mappedFile;
+  size_t m_mappedSize;
 };
 
 } // namespace ns3
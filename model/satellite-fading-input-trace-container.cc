@@ -20,6 +20,7 @@
 #include "satellite-fading-input-trace-container.h"
 #include "ns3/satellite-env-variables.h"
 #include "ns3/singleton.h"
+#include "ns3/string.h"
 #include "satellite-id-mapper.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatFadingInputTraceContainer");
@@ -33,7 +34,14 @@ SatFadingInputTraceContainer::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatFadingInputTraceContainer")
     .SetParent<SatBaseTraceContainer> ()
-    .AddConstructor<SatFadingInputTraceContainer> ();
+    .AddConstructor<SatFadingInputTraceContainer> ()
+    .AddAttribute ("TraceBundle",
+                   "Name of a trace bundle of the fading input trace directory, created with "
+                   "SatInputTraceBundle::CreateBundle, read instead of the text traces. "
+                   "Empty to read the text traces.",
+                   StringValue (""),
+                   MakeStringAccessor (&SatFadingInputTraceContainer::m_traceBundle),
+                   MakeStringChecker ());
   return tid;
 }
 
@@ -46,8 +54,13 @@ SatFadingInputTraceContainer::GetInstanceTypeId (void) const
 }
 
 SatFadingInputTraceContainer::SatFadingInputTraceContainer ()
+  : m_container (),
+  m_traceBundle (""),
+  m_bundle ()
 {
   NS_LOG_FUNCTION (this);
+
+  ObjectBase::ConstructSelf (AttributeConstructionList ());
 }
 
 SatFadingInputTraceContainer::~SatFadingInputTraceContainer ()
@@ -76,6 +89,9 @@ SatFadingInputTraceContainer::Reset ()
     {
       m_container.clear ();
     }
+
+  // The containers of the bundle traces have been released first
+  m_bundle = NULL;
 }
 
 Ptr<SatInputFileStreamTimeDoubleContainer>
@@ -83,8 +99,7 @@ SatFadingInputTraceContainer::AddNode (key_t key)
 {
   NS_LOG_FUNCTION (this);
 
-  std::stringstream filename;
-  std::string dataPath = Singleton<SatEnvVariables>::Get ()->LocateDataDirectory ();
+  std::string dataPath = Singleton<SatEnvVariables>::Get ()->LocateDataDirectory () + "/fadingtraces/input/";
 
   int32_t gwId = Singleton<SatIdMapper>::Get ()->GetGwIdWithMac (key.first);
   int32_t utId = Singleton<SatIdMapper>::Get ()->GetUtIdWithMac (key.first);
@@ -94,46 +109,30 @@ SatFadingInputTraceContainer::AddNode (key_t key)
     {
       NS_FATAL_ERROR ("SatFadingInputTraceContainer::AddNode - No such MAC address in the trace ID mapper");
     }
-  else
-    {
-      if (utId >= 0 && gwId < 0)
-        {
-          filename << dataPath << "/fadingtraces/input/BEAM_" << beamId << "_UT_" << utId << "_channelType_" << SatEnums::GetChannelTypeName (key.second);
-        }
-
-      if (gwId >= 0 && utId < 0)
-        {
-          filename << dataPath << "/fadingtraces/input/BEAM_" << beamId << "_GW_" << gwId << "_channelType_" << SatEnums::GetChannelTypeName (key.second);
-        }
-      std::pair <container_t::iterator, bool> result = m_container.insert (std::make_pair (key, CreateObject<SatInputFileStreamTimeDoubleContainer> (filename.str ().c_str (), std::ios::in, SatBaseTraceContainer::FADING_TRACE_DEFAULT_NUMBER_OF_COLUMNS)));
 
-      if (result.second == false)
-        {
-          NS_FATAL_ERROR ("SatFadingInputTraceContainer::AddNode failed");
-        }
+  std::string traceName = SatInputTraceBundle::GetTraceName (beamId, utId, gwId, key.second);
 
-      NS_LOG_INFO ("Added node with MAC " << key.first << " channel type " << key.second);
+  NS_LOG_INFO ("Added node with MAC " << key.first << " channel type " << key.second);
 
-      return result.first->second;
+  if (m_traceBundle.empty ())
+    {
+      return CreateObject<SatInputFileStreamTimeDoubleContainer> (dataPath + traceName, std::ios::in, SatBaseTraceContainer::FADING_TRACE_DEFAULT_NUMBER_OF_COLUMNS);
     }
 
-  NS_FATAL_ERROR ("SatFadingInputTraceContainer::AddNode failed");
-  return NULL;
-}
-
-Ptr<SatInputFileStreamTimeDoubleContainer>
-SatFadingInputTraceContainer::FindNode (key_t key)
-{
-  NS_LOG_FUNCTION (this);
+  if (m_bundle == NULL)
+    {
+      m_bundle = Create<SatInputTraceBundle> (dataPath + m_traceBundle, SatBaseTraceContainer::FADING_TRACE_DEFAULT_NUMBER_OF_COLUMNS);
+    }
 
-  container_t::iterator iter = m_container.find (key);
+  const double* columns;
+  uint32_t numOfRows;
 
-  if (iter == m_container.end ())
+  if (!m_bundle->FindTrace (beamId, utId, gwId, key.second, columns, numOfRows))
     {
-      return AddNode (key);
+      NS_FATAL_ERROR ("SatFadingInputTraceContainer::AddNode - No trace " << traceName << " in the trace bundle " << m_traceBundle);
     }
 
-  return iter->second;
+  return CreateObject<SatInputFileStreamTimeDoubleContainer> (traceName, columns, numOfRows, SatBaseTraceContainer::FADING_TRACE_DEFAULT_NUMBER_OF_COLUMNS);
 }
 
 double
@@ -141,7 +140,9 @@ SatFadingInputTraceContainer::GetFadingValue (key_t key)
 {
   NS_LOG_FUNCTION (this);
 
-  return FindNode (key)->ProceedToNextClosestTimeSample ().at (SatBaseTraceContainer::FADING_TRACE_DEFAULT_FADING_VALUE_INDEX);
+  Ptr<SatInputFileStreamTimeDoubleContainer> trace = FindTrace (m_container, this, &SatFadingInputTraceContainer::AddNode, key);
+
+  return trace->ProceedToNextClosestTimeSample (SatBaseTraceContainer::FADING_TRACE_DEFAULT_FADING_VALUE_INDEX);
 }
 
 } // namespace ns3
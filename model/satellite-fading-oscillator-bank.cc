@@ -0,0 +1,401 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "ns3/log.h"
+#include "satellite-fading-oscillator-bank.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatFadingOscillatorBank");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatFadingOscillatorBank);
+
+/**
+ * \brief Calculate cosine and sine of a small angle with Taylor polynomials.
+ * Accurate to double precision for angles in range [-0.25, 0.25].
+ * \param angle angle in radians
+ * \param cosine cosine of the angle
+ * \param sine sine of the angle
+ */
+static inline void
+SmallAngleCosSin (double angle, double& cosine, double& sine)
+{
+  double angle2 = angle * angle;
+  cosine = 1.0 - angle2 / 2.0 * (1.0 - angle2 / 12.0 * (1.0 - angle2 / 30.0 * (1.0 - angle2 / 56.0 * (1.0 - angle2 / 90.0 * (1.0 - angle2 / 132.0)))));
+  sine = angle * (1.0 - angle2 / 6.0 * (1.0 - angle2 / 20.0 * (1.0 - angle2 / 42.0 * (1.0 - angle2 / 72.0 * (1.0 - angle2 / 110.0)))));
+}
+
+/**
+ * \brief Calculate cosine and sine of an angle in range [-1, 1] without
+ * transcendental function calls, using two angle doublings.
+ * \param angle angle in radians
+ * \param cosine cosine of the angle
+ * \param sine sine of the angle
+ */
+static inline void
+BoundedAngleCosSin (double angle, double& cosine, double& sine)
+{
+  double c, s;
+  SmallAngleCosSin (angle * 0.25, c, s);
+
+  double c2 = c * c - s * s;
+  double s2 = 2.0 * s * c;
+
+  cosine = c2 * c2 - s2 * s2;
+  sine = 2.0 * s2 * c2;
+}
+
+/**
+ * \brief Calculate exponential of a value in range [-1, 1] without
+ * transcendental function calls, using a Taylor polynomial and three squarings.
+ * \param value value
+ * \return exponential of the value
+ */
+static inline double
+BoundedExp (double value)
+{
+  double x = value * 0.125;
+  double e = 1.0 + x * (1.0 + x / 2.0 * (1.0 + x / 3.0 * (1.0 + x / 4.0 * (1.0 + x / 5.0 * (1.0 + x / 6.0 * (1.0 + x / 7.0 * (1.0 + x / 8.0 * (1.0 + x / 9.0 * (1.0 + x / 10.0)))))))));
+
+  e *= e;
+  e *= e;
+  e *= e;
+
+  return e;
+}
+
+TypeId
+SatFadingOscillatorBank::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatFadingOscillatorBank")
+    .SetParent<Object> ()
+    .AddConstructor<SatFadingOscillatorBank> ();
+  return tid;
+}
+
+SatFadingOscillatorBank::SatFadingOscillatorBank ()
+  : m_maxOmega (0.0),
+  m_phaseTime (0.0),
+  m_stepTime (0.0),
+  m_phaseValid (false),
+  m_rotationsSinceAnchor (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatFadingOscillatorBank::~SatFadingOscillatorBank ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SatFadingOscillatorBank::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Clear ();
+  Object::DoDispose ();
+}
+
+void
+SatFadingOscillatorBank::AddOscillator (std::complex<double> amplitude, double initialPhase, double omega)
+{
+  NS_LOG_FUNCTION (this << amplitude << " " << initialPhase << " " << omega);
+
+  m_complexAmplitudeReal.push_back (amplitude.real ());
+  m_complexAmplitudeImag.push_back (amplitude.imag ());
+  m_amplitude.push_back (0.0);
+  m_phase.push_back (initialPhase);
+  m_omega.push_back (omega);
+  m_phaseCos.push_back (0.0);
+  m_phaseSin.push_back (0.0);
+  m_stepCos.push_back (0.0);
+  m_stepSin.push_back (0.0);
+
+  m_maxOmega = std::max (m_maxOmega, std::fabs (omega));
+  m_phaseValid = false;
+  m_stepTime = 0.0;
+}
+
+void
+SatFadingOscillatorBank::AddOscillator (double amplitude, double initialPhase, double omega)
+{
+  NS_LOG_FUNCTION (this << amplitude << " " << initialPhase << " " << omega);
+
+  m_complexAmplitudeReal.push_back (0.0);
+  m_complexAmplitudeImag.push_back (0.0);
+  m_amplitude.push_back (amplitude);
+  m_phase.push_back (initialPhase);
+  m_omega.push_back (omega);
+  m_phaseCos.push_back (0.0);
+  m_phaseSin.push_back (0.0);
+  m_stepCos.push_back (0.0);
+  m_stepSin.push_back (0.0);
+
+  m_maxOmega = std::max (m_maxOmega, std::fabs (omega));
+  m_phaseValid = false;
+  m_stepTime = 0.0;
+}
+
+void
+SatFadingOscillatorBank::Clear ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_complexAmplitudeReal.clear ();
+  m_complexAmplitudeImag.clear ();
+  m_amplitude.clear ();
+  m_phase.clear ();
+  m_omega.clear ();
+  m_phaseCos.clear ();
+  m_phaseSin.clear ();
+  m_stepCos.clear ();
+  m_stepSin.clear ();
+
+  m_maxOmega = 0.0;
+  m_phaseValid = false;
+  m_stepTime = 0.0;
+}
+
+uint32_t
+SatFadingOscillatorBank::GetNOscillators () const
+{
+  return m_omega.size ();
+}
+
+std::complex<double>
+SatFadingOscillatorBank::GetComplexSumAt (double timeInSeconds)
+{
+  NS_LOG_FUNCTION (this << timeInSeconds);
+
+  AdvanceTo (timeInSeconds);
+
+  return SumComplexValues ();
+}
+
+std::complex<double>
+SatFadingOscillatorBank::GetCosineWaveSumAt (double timeInSeconds)
+{
+  NS_LOG_FUNCTION (this << timeInSeconds);
+
+  AdvanceTo (timeInSeconds);
+
+  return SumCosineWaveValues ();
+}
+
+void
+SatFadingOscillatorBank::GetComplexSumsAt (double startTime, double timeStep, std::vector<std::complex<double> >& sums)
+{
+  NS_LOG_FUNCTION (this << startTime << timeStep << sums.size ());
+
+  AdvanceTo (startTime);
+
+  for (uint32_t k = 0; k < sums.size (); k++)
+    {
+      if (k > 0)
+        {
+          StepTo (startTime + k * timeStep, timeStep);
+        }
+
+      sums[k] = SumComplexValues ();
+    }
+}
+
+void
+SatFadingOscillatorBank::GetCosineWaveSumsAt (double startTime, double timeStep, std::vector<std::complex<double> >& sums)
+{
+  NS_LOG_FUNCTION (this << startTime << timeStep << sums.size ());
+
+  AdvanceTo (startTime);
+
+  for (uint32_t k = 0; k < sums.size (); k++)
+    {
+      if (k > 0)
+        {
+          StepTo (startTime + k * timeStep, timeStep);
+        }
+
+      sums[k] = SumCosineWaveValues ();
+    }
+}
+
+std::complex<double>
+SatFadingOscillatorBank::SumComplexValues () const
+{
+  const uint32_t count = m_omega.size ();
+  const double* amplitudeReal = m_complexAmplitudeReal.data ();
+  const double* amplitudeImag = m_complexAmplitudeImag.data ();
+  const double* phaseCos = m_phaseCos.data ();
+
+  double sumReal = 0.0;
+  double sumImag = 0.0;
+
+  for (uint32_t i = 0; i < count; i++)
+    {
+      sumReal += amplitudeReal[i] * phaseCos[i];
+      sumImag += amplitudeImag[i] * phaseCos[i];
+    }
+
+  return std::complex<double> (sumReal, sumImag);
+}
+
+std::complex<double>
+SatFadingOscillatorBank::SumCosineWaveValues () const
+{
+  const uint32_t count = m_omega.size ();
+  const double* amplitude = m_amplitude.data ();
+  const double* phaseCos = m_phaseCos.data ();
+  const double* phaseSin = m_phaseSin.data ();
+
+  double sumReal = 0.0;
+  double sumImag = 0.0;
+
+  // amplitude * exp (cos (phase) + i sin (phase)), where both the real and
+  // imaginary part of the exponent are bounded to [-1, 1]
+  for (uint32_t i = 0; i < count; i++)
+    {
+      double magnitude = amplitude[i] * BoundedExp (phaseCos[i]);
+      double c, s;
+      BoundedAngleCosSin (phaseSin[i], c, s);
+      sumReal += magnitude * c;
+      sumImag += magnitude * s;
+    }
+
+  return std::complex<double> (sumReal, sumImag);
+}
+
+void
+SatFadingOscillatorBank::AdvanceTo (double timeInSeconds)
+{
+  NS_LOG_FUNCTION (this << timeInSeconds);
+
+  if (!m_phaseValid || timeInSeconds < m_phaseTime)
+    {
+      Anchor (timeInSeconds);
+      return;
+    }
+
+  double timeStep = timeInSeconds - m_phaseTime;
+
+  if (timeStep > 0.0)
+    {
+      StepTo (timeInSeconds, timeStep);
+    }
+}
+
+void
+SatFadingOscillatorBank::StepTo (double timeInSeconds, double timeStep)
+{
+  if (m_rotationsSinceAnchor >= MAX_ROTATIONS_BETWEEN_ANCHORS
+      || m_maxOmega * timeStep > 0.25 * (1 << MAX_ANGLE_HALVINGS))
+    {
+      Anchor (timeInSeconds);
+      return;
+    }
+
+  if (timeStep != m_stepTime)
+    {
+      UpdateRotationStep (timeStep);
+    }
+
+  Rotate ();
+  m_phaseTime = timeInSeconds;
+}
+
+void
+SatFadingOscillatorBank::Rotate ()
+{
+  const uint32_t count = m_omega.size ();
+  double* phaseCos = m_phaseCos.data ();
+  double* phaseSin = m_phaseSin.data ();
+  const double* stepCos = m_stepCos.data ();
+  const double* stepSin = m_stepSin.data ();
+
+  for (uint32_t i = 0; i < count; i++)
+    {
+      double c = phaseCos[i] * stepCos[i] - phaseSin[i] * stepSin[i];
+      double s = phaseSin[i] * stepCos[i] + phaseCos[i] * stepSin[i];
+      phaseCos[i] = c;
+      phaseSin[i] = s;
+    }
+
+  m_rotationsSinceAnchor++;
+}
+
+void
+SatFadingOscillatorBank::Anchor (double timeInSeconds)
+{
+  NS_LOG_FUNCTION (this << timeInSeconds);
+
+  for (uint32_t i = 0; i < m_omega.size (); i++)
+    {
+      double phase = timeInSeconds * m_omega[i] + m_phase[i];
+      m_phaseCos[i] = std::cos (phase);
+      m_phaseSin[i] = std::sin (phase);
+    }
+
+  m_phaseTime = timeInSeconds;
+  m_phaseValid = true;
+  m_rotationsSinceAnchor = 0;
+}
+
+void
+SatFadingOscillatorBank::UpdateRotationStep (double timeStep)
+{
+  NS_LOG_FUNCTION (this << timeStep);
+
+  // halve the largest rotation angle until it is small enough for the polynomials
+  uint32_t halvings = 0;
+  double scale = 1.0;
+
+  while (m_maxOmega * timeStep * scale > 0.25 && halvings < MAX_ANGLE_HALVINGS)
+    {
+      scale *= 0.5;
+      halvings++;
+    }
+
+  const uint32_t count = m_omega.size ();
+  const double* omega = m_omega.data ();
+  double* stepCos = m_stepCos.data ();
+  double* stepSin = m_stepSin.data ();
+
+  for (uint32_t i = 0; i < count; i++)
+    {
+      SmallAngleCosSin (omega[i] * timeStep * scale, stepCos[i], stepSin[i]);
+    }
+
+  // double the angles back to the full time step
+  for (uint32_t h = 0; h < halvings; h++)
+    {
+      for (uint32_t i = 0; i < count; i++)
+        {
+          double c = stepCos[i] * stepCos[i] - stepSin[i] * stepSin[i];
+          double s = 2.0 * stepSin[i] * stepCos[i];
+          stepCos[i] = c;
+          stepSin[i] = s;
+        }
+    }
+
+  m_stepTime = timeStep;
+}
+
+} // namespace ns3
@@ -0,0 +1,259 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SATELLITE_FADING_OSCILLATOR_BANK_H
+#define SATELLITE_FADING_OSCILLATOR_BANK_H
+
+#include <vector>
+#include <complex>
+#include "ns3/object.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * \brief Bank of fading oscillators evaluated together. The bank gives
+ * the same values as summing a set of SatFadingOscillator objects, but
+ * stores the oscillator parameters and the current phasors of the
+ * oscillators as contiguous arrays.
+ *
+ * Instead of evaluating cosine and sine of the absolute phase of each
+ * oscillator on every call, the phasors are rotated from the previous
+ * evaluation time with a phase rotation recurrence. The rotation steps
+ * are computed with polynomials, so the loops over the oscillators do not
+ * contain transcendental function calls and can be vectorized by the
+ * compiler. The phasors are re-anchored to the exact phase periodically,
+ * when the time goes backwards and when the rotation since the previous
+ * evaluation is too large, to keep the accumulated error negligible.
+ */
+class SatFadingOscillatorBank : public Object
+{
+public:
+  /**
+   * \brief NS-3 function for type id
+   * \return type id
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Constructor
+   */
+  SatFadingOscillatorBank ();
+
+  /**
+   * \brief Destructor
+   */
+  ~SatFadingOscillatorBank ();
+
+  /**
+   * \brief Add an oscillator with complex amplitude to the bank
+   * \param amplitude amplitude
+   * \param initialPhase initial phase
+   * \param omega rotation speed
+   */
+  void AddOscillator (std::complex<double> amplitude, double initialPhase, double omega);
+
+  /**
+   * \brief Add an oscillator with real amplitude to the bank
+   * \param amplitude amplitude
+   * \param initialPhase initial phase
+   * \param omega rotation speed
+   */
+  void AddOscillator (double amplitude, double initialPhase, double omega);
+
+  /**
+   * \brief Remove all the oscillators from the bank
+   */
+  void Clear ();
+
+  /**
+   * \brief Get the number of oscillators in the bank
+   * \return number of oscillators
+   */
+  uint32_t GetNOscillators () const;
+
+  /**
+   * \brief Returns the sum of the complex values of the oscillators at time t,
+   * see SatFadingOscillator::GetComplexValueAt
+   * \param timeInSeconds current time in seconds
+   * \return complex sum
+   */
+  std::complex<double> GetComplexSumAt (double timeInSeconds);
+
+  /**
+   * \brief Returns the sum of the cosine wave complex values of the oscillators
+   * at time t, see SatFadingOscillator::GetCosineWaveValueAt
+   * \param timeInSeconds current time in seconds
+   * \return complex sum
+   */
+  std::complex<double> GetCosineWaveSumAt (double timeInSeconds);
+
+  /**
+   * \brief Calculates the sums of the complex values of the oscillators at
+   * fixed time steps, see GetComplexSumAt
+   * \param startTime time of the first sum in seconds
+   * \param timeStep time step between the sums in seconds
+   * \param sums vector filled with the complex sums, its size defines the number of sums
+   */
+  void GetComplexSumsAt (double startTime, double timeStep, std::vector<std::complex<double> >& sums);
+
+  /**
+   * \brief Calculates the sums of the cosine wave complex values of the
+   * oscillators at fixed time steps, see GetCosineWaveSumAt
+   * \param startTime time of the first sum in seconds
+   * \param timeStep time step between the sums in seconds
+   * \param sums vector filled with the complex sums, its size defines the number of sums
+   */
+  void GetCosineWaveSumsAt (double startTime, double timeStep, std::vector<std::complex<double> >& sums);
+
+  /**
+   * \brief Do needed dispose actions
+   */
+  void DoDispose ();
+
+private:
+  /**
+   * \brief Rotate the phasors of the oscillators to the given time
+   * \param timeInSeconds time in seconds
+   */
+  void AdvanceTo (double timeInSeconds);
+
+  /**
+   * \brief Set the phasors of the oscillators to the exact phase at the given time
+   * \param timeInSeconds time in seconds
+   */
+  void Anchor (double timeInSeconds);
+
+  /**
+   * \brief Calculate the phasor rotation of the oscillators for the given time step
+   * \param timeStep time step in seconds
+   */
+  void UpdateRotationStep (double timeStep);
+
+  /**
+   * \brief Rotate the phasors of the oscillators by the given time step, or
+   * anchor them if the rotation cannot be done accurately
+   * \param timeInSeconds time in seconds after the step
+   * \param timeStep time step in seconds
+   */
+  void StepTo (double timeInSeconds, double timeStep);
+
+  /**
+   * \brief Rotate the phasors of the oscillators by one rotation time step
+   */
+  void Rotate ();
+
+  /**
+   * \brief Sum of the complex values of the oscillators at the current phases
+   * \return complex sum
+   */
+  std::complex<double> SumComplexValues () const;
+
+  /**
+   * \brief Sum of the cosine wave complex values of the oscillators at the current phases
+   * \return complex sum
+   */
+  std::complex<double> SumCosineWaveValues () const;
+
+  /**
+   * \brief Maximum number of rotations before the phasors are re-anchored
+   */
+  static const uint32_t MAX_ROTATIONS_BETWEEN_ANCHORS = 1024;
+
+  /**
+   * \brief Maximum number of angle halvings used when calculating the rotation step
+   */
+  static const uint32_t MAX_ANGLE_HALVINGS = 8;
+
+  /**
+   * \brief Real parts of the complex amplitudes
+   */
+  std::vector<double> m_complexAmplitudeReal;
+
+  /**
+   * \brief Imaginary parts of the complex amplitudes
+   */
+  std::vector<double> m_complexAmplitudeImag;
+
+  /**
+   * \brief Real amplitudes
+   */
+  std::vector<double> m_amplitude;
+
+  /**
+   * \brief Initial phases
+   */
+  std::vector<double> m_phase;
+
+  /**
+   * \brief Rotation speeds
+   */
+  std::vector<double> m_omega;
+
+  /**
+   * \brief Cosines of the current phases
+   */
+  std::vector<double> m_phaseCos;
+
+  /**
+   * \brief Sines of the current phases
+   */
+  std::vector<double> m_phaseSin;
+
+  /**
+   * \brief Cosines of the phase rotations over the rotation time step
+   */
+  std::vector<double> m_stepCos;
+
+  /**
+   * \brief Sines of the phase rotations over the rotation time step
+   */
+  std::vector<double> m_stepSin;
+
+  /**
+   * \brief Largest absolute rotation speed of the oscillators
+   */
+  double m_maxOmega;
+
+  /**
+   * \brief Time of the current phases in seconds
+   */
+  double m_phaseTime;
+
+  /**
+   * \brief Time step of the calculated phase rotations in seconds
+   */
+  double m_stepTime;
+
+  /**
+   * \brief Flag telling whether the current phases are valid
+   */
+  bool m_phaseValid;
+
+  /**
+   * \brief Number of rotations since the phases were anchored
+   */
+  uint32_t m_rotationsSinceAnchor;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_FADING_OSCILLATOR_BANK_H */
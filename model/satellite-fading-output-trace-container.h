@@ -46,6 +46,11 @@ public:
    */
   typedef std::map <key_t, Ptr<SatOutputFileStreamDoubleContainer> > container_t;
 
+  /**
+   * \brief typedef for map of bounded recorders
+   */
+  typedef std::map <key_t, Ptr<SatOutputTraceRecorder> > recorderContainer_t;
+
   /**
    * \brief Constructor
    */
@@ -109,6 +114,21 @@ private:
    */
   Ptr<SatOutputFileStreamDoubleContainer> FindNode (key_t key);
 
+  /**
+   * \brief Function for finding the bounded recorder matching the key,
+   * creating it if needed
+   * \param key key
+   * \return matching recorder, NULL if the key has no output file
+   */
+  Ptr<SatOutputTraceRecorder> FindRecorder (key_t key);
+
+  /**
+   * \brief Function for getting the output file name matching the key
+   * \param key key
+   * \return file name, empty if the key does not match a UT or a GW
+   */
+  std::string GetFileName (key_t key) const;
+
   /**
    * \brief Write the contents of a container matching to the key into a file
    */
@@ -119,6 +139,11 @@ private:
    */
   container_t m_container;
 
+  /**
+   * \brief Map for bounded recorders
+   */
+  recorderContainer_t m_recorders;
+
   /**
    * \brief Switch for figure output
    */
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include "ns3/log.h"
+#include "satellite-fading-trace-prefetcher.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatFadingTracePrefetcher");
+
+namespace ns3 {
+
+SatFadingTracePrefetcher::Source::~Source ()
+{
+}
+
+void
+SatFadingTracePrefetcher::Source::Process ()
+{
+  LoadPrefetchChunk ();
+}
+
+SatFadingTracePrefetcher::SatFadingTracePrefetcher ()
+  : m_worker (Create<SatBackgroundWorker> ())
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatFadingTracePrefetcher::~SatFadingTracePrefetcher ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_worker = NULL;
+}
+
+void
+SatFadingTracePrefetcher::Prefetch (Source *source)
+{
+  NS_LOG_FUNCTION (this << source);
+
+  m_worker->Queue (source);
+}
+
+void
+SatFadingTracePrefetcher::WaitFor (Source *source)
+{
+  NS_LOG_FUNCTION (this << source);
+
+  m_worker->WaitFor (source);
+}
+
+void
+SatFadingTracePrefetcher::Cancel (Source *source)
+{
+  NS_LOG_FUNCTION (this << source);
+
+  m_worker->Cancel (source);
+}
+
+} // namespace ns3
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SATELLITE_FADING_TRACE_PREFETCHER_H
+#define SATELLITE_FADING_TRACE_PREFETCHER_H
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/satellite-background-worker.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief Background loader of fading trace chunks. The prefetcher owns a
+ * single I/O thread shared by all the streamed fading traces. A trace
+ * requests the chunk following its current window with Prefetch, and
+ * synchronizes with WaitFor before using the loaded samples, so that the
+ * file reads do not happen on the simulation thread as long as the I/O
+ * thread keeps up with the simulation time.
+ */
+class SatFadingTracePrefetcher : public SimpleRefCount<SatFadingTracePrefetcher>
+{
+public:
+  /**
+   * \brief Interface of the objects loading their chunks through the prefetcher
+   */
+  class Source : public SatBackgroundWorker::Job
+  {
+  public:
+    /**
+     * \brief Destructor
+     */
+    virtual ~Source ();
+
+    /**
+     * \brief Load the requested chunk, called on the I/O thread
+     */
+    virtual void LoadPrefetchChunk () = 0;
+
+  private:
+    /**
+     * \brief Process the prefetch request by loading the chunk
+     */
+    virtual void Process ();
+  };
+
+  /**
+   * \brief Constructor, starts the I/O thread
+   */
+  SatFadingTracePrefetcher ();
+
+  /**
+   * \brief Destructor, stops the I/O thread
+   */
+  ~SatFadingTracePrefetcher ();
+
+  /**
+   * \brief Request the source to load its chunk on the I/O thread
+   * \param source source to load, only one request per source may be pending
+   */
+  void Prefetch (Source *source);
+
+  /**
+   * \brief Block until the pending request of the source, if any, is done
+   * \param source source to wait for
+   */
+  void WaitFor (Source *source);
+
+  /**
+   * \brief Drop the pending request of the source, waiting for it if it is
+   * being processed
+   * \param source source whose request is dropped
+   */
+  void Cancel (Source *source);
+
+private:
+  /**
+   * \brief I/O thread
+   */
+  Ptr<SatBackgroundWorker> m_worker;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_FADING_TRACE_PREFETCHER_H */
@@ -71,5 +71,23 @@ SatFreeSpaceLoss::GetFsl (Ptr<MobilityModel> a, Ptr<MobilityModel> b, double fre
   return fsl;
 }
 
+void
+SatFreeSpaceLoss::GetFslBatch (Ptr<MobilityModel> a, Ptr<MobilityModel> b, const std::vector<double>& frequenciesHz, std::vector<double>& fsl) const
+{
+  NS_LOG_FUNCTION (this << frequenciesHz.size ());
+
+  double distance = a->GetDistanceFrom (b);
+
+  // (4 * pi * d * f / c)^2 = k * f^2, with k depending only on the distance
+  double coefficient = std::pow ( ( (4.0 * M_PI * distance) / SatConstVariables::SPEED_OF_LIGHT ), 2.0 );
+
+  fsl.resize (frequenciesHz.size ());
+
+  for (uint32_t i = 0; i < frequenciesHz.size (); i++)
+    {
+      fsl[i] = coefficient * frequenciesHz[i] * frequenciesHz[i];
+    }
+}
+
 
 } // namespace ns3
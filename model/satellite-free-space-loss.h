@@ -20,6 +20,7 @@
 #ifndef SATELLITE_FREE_SPACE_LOSS_H
 #define SATELLITE_FREE_SPACE_LOSS_H
 
+#include <vector>
 #include "ns3/object.h"
 #include "ns3/mobility-model.h"
 
@@ -50,6 +51,10 @@ public:
 
   /**
    * \brief Calculate the free-space loss in linear format
+   *
+   * Subclasses overriding this method must also override GetFslBatch, which
+   * does not call it.
+   *
    * \param a Mobility model of node a
    * \param b Mobility model of node b
    * \param frequencyHz Frequency in Hertz
@@ -65,6 +70,21 @@ public:
    * \return the free space loss as dBs.
    */
   virtual double GetFsldB (Ptr<MobilityModel> a, Ptr<MobilityModel> b, double frequencyHz) const;
+
+  /**
+   * \brief Calculate the free-space loss in linear format for a set of
+   * frequencies, evaluating the distance between the nodes only once
+   *
+   * The loss is computed with the same formula as GetFsl, but without calling
+   * it, so this method has to be overridden together with GetFsl to keep the
+   * channel consistent with a modified loss model.
+   *
+   * \param a Mobility model of node a
+   * \param b Mobility model of node b
+   * \param frequenciesHz Frequencies in Hertz
+   * \param fsl Container filled with the free space loss of each frequency as ratio
+   */
+  virtual void GetFslBatch (Ptr<MobilityModel> a, Ptr<MobilityModel> b, const std::vector<double>& frequenciesHz, std::vector<double>& fsl) const;
 };
 
 
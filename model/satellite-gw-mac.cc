@@ -286,7 +286,7 @@ SatGwMac::ReceiveSignalingPacket (Ptr<Packet> packet)
                 m_crReceiveCallback (m_beamId, macTag.GetSourceAddress (), crMsg);
               }
           }
-        else
+        else if (Singleton<SatLog>::Get ()->IsEnabled (SatLog::LOG_WARNING))
           {
             /**
              * Control message NOT found in container anymore! This means, that the
@@ -313,7 +313,7 @@ SatGwMac::ReceiveSignalingPacket (Ptr<Packet> packet)
           {
             m_fwdScheduler->CnoInfoUpdated (macTag.GetSourceAddress (), cnoReport->GetCnoEstimate ());
           }
-        else
+        else if (Singleton<SatLog>::Get ()->IsEnabled (SatLog::LOG_WARNING))
           {
             /**
              * Control message NOT found in container anymore! This means, that the
@@ -347,7 +347,7 @@ SatGwMac::ReceiveSignalingPacket (Ptr<Packet> packet)
             uint32_t beamId = handoverRecommendation->GetRecommendedBeamId ();
             m_handoverCallback (macTag.GetSourceAddress (), m_beamId, beamId);
           }
-        else
+        else if (Singleton<SatLog>::Get ()->IsEnabled (SatLog::LOG_WARNING))
           {
             /**
              * Control message NOT found in container anymore! This means, that the
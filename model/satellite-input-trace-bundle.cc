@@ -0,0 +1,344 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/satellite-input-fstream-time-double-container.h"
+#include "satellite-input-trace-bundle.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatInputTraceBundle");
+
+namespace ns3 {
+
+const char SatInputTraceBundle::MAGIC[8] = { 'S', 'A', 'T', 'B', 'N', 'D', 'L', '\0' };
+
+SatInputTraceBundle::SatInputTraceBundle (std::string fileName, uint32_t valuesInRow)
+  : m_fileName (fileName),
+  m_mappedFile (NULL),
+  m_mappedSize (0),
+  m_header (NULL),
+  m_entries (NULL)
+{
+  NS_LOG_FUNCTION (this << fileName << valuesInRow);
+
+  int fd = open (fileName.c_str (), O_RDONLY);
+
+  if (fd < 0)
+    {
+      NS_FATAL_ERROR ("The trace bundle " << fileName << " cannot be opened.");
+    }
+
+  struct stat fileStat;
+
+  if (fstat (fd, &fileStat) < 0)
+    {
+      close (fd);
+      NS_FATAL_ERROR ("The trace bundle " << fileName << " cannot be accessed.");
+    }
+
+  m_mappedSize = fileStat.st_size;
+
+  if (m_mappedSize < sizeof (Header_t))
+    {
+      close (fd);
+      NS_FATAL_ERROR ("The trace bundle " << fileName << " is truncated.");
+    }
+
+  m_mappedFile = mmap (NULL, m_mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+
+  if (m_mappedFile == MAP_FAILED)
+    {
+      m_mappedFile = NULL;
+      NS_FATAL_ERROR ("The trace bundle " << fileName << " cannot be memory mapped.");
+    }
+
+  m_header = (const Header_t*)m_mappedFile;
+  m_entries = (const Entry_t*)((const char*)m_mappedFile + sizeof (Header_t));
+
+  if (!std::equal (MAGIC, MAGIC + sizeof (MAGIC), m_header->m_magic))
+    {
+      NS_FATAL_ERROR ("The file " << fileName << " is not a trace bundle.");
+    }
+
+  if (m_header->m_version != VERSION)
+    {
+      NS_FATAL_ERROR ("The trace bundle " << fileName << " has unsupported version " << m_header->m_version);
+    }
+
+  if (m_header->m_columns < valuesInRow)
+    {
+      NS_FATAL_ERROR ("The trace bundle " << fileName << " has " << m_header->m_columns << " columns, " << valuesInRow << " expected.");
+    }
+
+  if (m_mappedSize < sizeof (Header_t) + (uint64_t)m_header->m_numOfTraces * sizeof (Entry_t))
+    {
+      NS_FATAL_ERROR ("The trace bundle " << fileName << " is truncated.");
+    }
+
+  // Only the index is checked, the time samples have been checked when the bundle was created
+  for (uint32_t i = 0; i < m_header->m_numOfTraces; i++)
+    {
+      const Entry_t& entry = m_entries[i];
+
+      if (entry.m_rows < 1 || entry.m_rows > std::numeric_limits<uint32_t>::max ()
+          || entry.m_offset % sizeof (double) != 0
+          || entry.m_offset + m_header->m_columns * entry.m_rows * sizeof (double) > m_mappedSize)
+        {
+          NS_FATAL_ERROR ("The trace bundle " << fileName << " has an invalid entry for " << GetTraceName (entry.m_beamId, entry.m_utId, entry.m_gwId, (SatEnums::ChannelType_t)entry.m_channelType));
+        }
+
+      if (i > 0 && !IsBefore (m_entries[i - 1], entry))
+        {
+          NS_FATAL_ERROR ("The trace bundle " << fileName << " index is not sorted.");
+        }
+    }
+
+  NS_LOG_INFO ("Mapped " << m_header->m_numOfTraces << " traces of " << fileName);
+}
+
+SatInputTraceBundle::~SatInputTraceBundle ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_mappedFile != NULL)
+    {
+      munmap (m_mappedFile, m_mappedSize);
+      m_mappedFile = NULL;
+    }
+}
+
+uint32_t
+SatInputTraceBundle::GetNumOfTraces () const
+{
+  return m_header->m_numOfTraces;
+}
+
+bool
+SatInputTraceBundle::FindTrace (int32_t beamId, int32_t utId, int32_t gwId, SatEnums::ChannelType_t channelType,
+                                const double*& columns, uint32_t& numOfRows) const
+{
+  NS_LOG_FUNCTION (this << beamId << utId << gwId << channelType);
+
+  Entry_t key;
+  std::memset (&key, 0, sizeof (Entry_t));
+  key.m_beamId = beamId;
+  key.m_utId = (utId < 0) ? -1 : utId;
+  key.m_gwId = (gwId < 0) ? -1 : gwId;
+  key.m_channelType = channelType;
+
+  const Entry_t *last = m_entries + m_header->m_numOfTraces;
+  const Entry_t *entry = std::lower_bound (m_entries, last, key, &SatInputTraceBundle::IsBefore);
+
+  if (entry == last || IsBefore (key, *entry))
+    {
+      return false;
+    }
+
+  columns = (const double*)((const char*)m_mappedFile + entry->m_offset);
+  numOfRows = entry->m_rows;
+  return true;
+}
+
+std::string
+SatInputTraceBundle::GetTraceName (int32_t beamId, int32_t utId, int32_t gwId, SatEnums::ChannelType_t channelType)
+{
+  std::stringstream name;
+
+  if (utId >= 0)
+    {
+      name << "BEAM_" << beamId << "_UT_" << utId << "_channelType_" << SatEnums::GetChannelTypeName (channelType);
+    }
+  else
+    {
+      name << "BEAM_" << beamId << "_GW_" << gwId << "_channelType_" << SatEnums::GetChannelTypeName (channelType);
+    }
+
+  return name.str ();
+}
+
+bool
+SatInputTraceBundle::IsBefore (const Entry_t& a, const Entry_t& b)
+{
+  if (a.m_beamId != b.m_beamId)
+    {
+      return a.m_beamId < b.m_beamId;
+    }
+  if (a.m_utId != b.m_utId)
+    {
+      return a.m_utId < b.m_utId;
+    }
+  if (a.m_gwId != b.m_gwId)
+    {
+      return a.m_gwId < b.m_gwId;
+    }
+  return a.m_channelType < b.m_channelType;
+}
+
+bool
+SatInputTraceBundle::ParseTraceName (std::string name, Entry_t& entry)
+{
+  int beamId, nodeId;
+  char nodeType[3];
+  char channelTypeName[32];
+  int length = 0;
+
+  if (std::sscanf (name.c_str (), "BEAM_%d_%2[A-Z]_%d_channelType_%31[A-Z_]%n",
+                   &beamId, nodeType, &nodeId, channelTypeName, &length) != 4
+      || length != (int)name.size ())
+    {
+      return false;
+    }
+
+  std::memset (&entry, 0, sizeof (Entry_t));
+  entry.m_beamId = beamId;
+
+  if (std::strcmp (nodeType, "UT") == 0)
+    {
+      entry.m_utId = nodeId;
+      entry.m_gwId = -1;
+    }
+  else if (std::strcmp (nodeType, "GW") == 0)
+    {
+      entry.m_utId = -1;
+      entry.m_gwId = nodeId;
+    }
+  else
+    {
+      return false;
+    }
+
+  for (uint32_t channelType = SatEnums::FORWARD_FEEDER_CH; channelType <= SatEnums::RETURN_FEEDER_CH; channelType++)
+    {
+      if (SatEnums::GetChannelTypeName ((SatEnums::ChannelType_t)channelType) == channelTypeName)
+        {
+          entry.m_channelType = channelType;
+          return true;
+        }
+    }
+
+  return false;
+}
+
+uint32_t
+SatInputTraceBundle::CreateBundle (std::string inputDirectory, std::string fileName, uint32_t valuesInRow)
+{
+  NS_LOG_FUNCTION (inputDirectory << fileName << valuesInRow);
+
+  DIR *dir = opendir (inputDirectory.c_str ());
+
+  if (dir == NULL)
+    {
+      NS_FATAL_ERROR ("The directory " << inputDirectory << " cannot be opened.");
+    }
+
+  std::vector<std::string> names;
+  std::vector<Entry_t> entries;
+  Entry_t entry;
+
+  for (struct dirent *file = readdir (dir); file != NULL; file = readdir (dir))
+    {
+      if (ParseTraceName (file->d_name, entry))
+        {
+          names.push_back (file->d_name);
+          entries.push_back (entry);
+        }
+    }
+
+  closedir (dir);
+
+  std::ofstream ofs (fileName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+
+  if (!ofs.is_open ())
+    {
+      NS_FATAL_ERROR ("The trace bundle " << fileName << " cannot be created.");
+    }
+
+  // The traces are written after room left for the index, which is written
+  // once the sizes of the traces are known
+  uint64_t offset = sizeof (Header_t) + entries.size () * sizeof (Entry_t);
+  ofs.seekp (offset);
+
+  for (uint32_t i = 0; i < entries.size (); i++)
+    {
+      Ptr<SatInputFileStreamTimeDoubleContainer> trace =
+        CreateObject<SatInputFileStreamTimeDoubleContainer> (inputDirectory + "/" + names[i], std::ios::in, valuesInRow);
+
+      entries[i].m_rows = trace->GetNumOfRows ();
+      entries[i].m_offset = offset;
+
+      for (uint32_t column = 0; column < valuesInRow; column++)
+        {
+          ofs.write ((const char*)trace->GetColumn (column), entries[i].m_rows * sizeof (double));
+        }
+
+      offset += valuesInRow * entries[i].m_rows * sizeof (double);
+    }
+
+  std::sort (entries.begin (), entries.end (), &SatInputTraceBundle::IsBefore);
+
+  for (uint32_t i = 1; i < entries.size (); i++)
+    {
+      if (!IsBefore (entries[i - 1], entries[i]))
+        {
+          NS_FATAL_ERROR ("The directory " << inputDirectory << " has several traces for " << GetTraceName (entries[i].m_beamId, entries[i].m_utId, entries[i].m_gwId, (SatEnums::ChannelType_t)entries[i].m_channelType));
+        }
+    }
+
+  Header_t header;
+  std::memset (&header, 0, sizeof (Header_t));
+  std::copy (MAGIC, MAGIC + sizeof (MAGIC), header.m_magic);
+  header.m_version = VERSION;
+  header.m_columns = valuesInRow;
+  header.m_numOfTraces = entries.size ();
+
+  ofs.seekp (0);
+  ofs.write ((const char*)&header, sizeof (Header_t));
+
+  if (!entries.empty ())
+    {
+      ofs.write ((const char*)&entries[0], entries.size () * sizeof (Entry_t));
+    }
+
+  if (!ofs.good ())
+    {
+      NS_FATAL_ERROR ("The trace bundle " << fileName << " cannot be written.");
+    }
+
+  ofs.close ();
+
+  NS_LOG_INFO ("Bundled " << entries.size () << " traces of " << inputDirectory << " to " << fileName);
+
+  return entries.size ();
+}
+
+} // namespace ns3
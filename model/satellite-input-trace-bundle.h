@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SATELLITE_INPUT_TRACE_BUNDLE_H
+#define SATELLITE_INPUT_TRACE_BUNDLE_H
+
+#include "ns3/simple-ref-count.h"
+#include "satellite-enums.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * \brief Binary bundle of the time based input traces of a directory, i.e.,
+ * the interference, Rx power or fading input traces of every node and
+ * channel type. The bundle replaces the text files named
+ * BEAM_<beam>_UT_<ut>_channelType_<channel type> or
+ * BEAM_<beam>_GW_<gw>_channelType_<channel type>.
+ *
+ * The bundle starts with a Header_t, followed by the Entry_t of every
+ * trace sorted by node and channel type, and by the columns of the traces,
+ * each one made of native doubles. Byte order is the one of the writing
+ * host. The bundle is memory mapped read-only, so the traces are neither
+ * parsed nor copied when loaded, and the pages are shared between all the
+ * simulation processes reading the same bundle.
+ *
+ * Bundles are created from the text traces of a directory with
+ * CreateBundle.
+ */
+class SatInputTraceBundle : public SimpleRefCount<SatInputTraceBundle>
+{
+public:
+  /**
+   * \brief Constructor, memory mapping the bundle
+   * \param fileName path and file name of the bundle
+   * \param valuesInRow number of columns expected in the traces
+   */
+  SatInputTraceBundle (std::string fileName, uint32_t valuesInRow);
+
+  /**
+   * \brief Destructor
+   */
+  ~SatInputTraceBundle ();
+
+  /**
+   * \brief Function for getting the number of traces in the bundle
+   * \return number of traces
+   */
+  uint32_t GetNumOfTraces () const;
+
+  /**
+   * \brief Function for finding the trace of a node. The columns are valid
+   * as long as the bundle exists.
+   * \param beamId beam id of the node
+   * \param utId UT id of the node, negative for a GW
+   * \param gwId GW id of the node, negative for a UT
+   * \param channelType channel type
+   * \param columns pointer to the contiguous columns of the trace, the
+   * first one being the time column
+   * \param numOfRows number of rows of the trace
+   * \return true if the bundle contains the trace
+   */
+  bool FindTrace (int32_t beamId, int32_t utId, int32_t gwId, SatEnums::ChannelType_t channelType,
+                  const double*& columns, uint32_t& numOfRows) const;
+
+  /**
+   * \brief Function for getting the name of the text trace of a node
+   * \param beamId beam id of the node
+   * \param utId UT id of the node, negative for a GW
+   * \param gwId GW id of the node, negative for a UT
+   * \param channelType channel type
+   * \return name of the text trace
+   */
+  static std::string GetTraceName (int32_t beamId, int32_t utId, int32_t gwId, SatEnums::ChannelType_t channelType);
+
+  /**
+   * \brief Create a bundle of all the text traces of a directory
+   * \param inputDirectory directory of the text traces
+   * \param fileName path and file name of the bundle
+   * \param valuesInRow number of values in a row of the text traces
+   * \return number of traces in the bundle
+   */
+  static uint32_t CreateBundle (std::string inputDirectory, std::string fileName, uint32_t valuesInRow);
+
+private:
+  /**
+   * Header of the bundle files
+   */
+  typedef struct
+  {
+    char m_magic[8];
+    uint32_t m_version;
+    uint32_t m_columns;
+    uint32_t m_numOfTraces;
+    uint32_t m_reserved;
+  } Header_t;
+
+  /**
+   * Index entry of a trace. The key of the entries is the beam, UT, GW and
+   * channel type, -1 being used for the missing UT or GW id. The columns of
+   * the trace start at m_offset bytes from the beginning of the bundle.
+   */
+  typedef struct
+  {
+    int32_t m_beamId;
+    int32_t m_utId;
+    int32_t m_gwId;
+    uint32_t m_channelType;
+    uint64_t m_rows;
+    uint64_t m_offset;
+  } Entry_t;
+
+  /**
+   * \brief Order of the entries in the bundle
+   * \param a first entry
+   * \param b second entry
+   * \return true if the key of a is before the key of b
+   */
+  static bool IsBefore (const Entry_t& a, const Entry_t& b);
+
+  /**
+   * \brief Parse the name of a text trace
+   * \param name file name of the text trace
+   * \param entry entry updated with the key of the trace
+   * \return true if the name is the one of a text trace
+   */
+  static bool ParseTraceName (std::string name, Entry_t& entry);
+
+  /**
+   * Magic string and version identifying the bundle files
+   */
+  static const char MAGIC[8];
+  static const uint32_t VERSION = 1;
+
+  /**
+   * Bundle file name
+   */
+  std::string m_fileName;
+
+  /**
+   * Memory mapped bundle and its size
+   */
+  void *m_mappedFile;
+  uint64_t m_mappedSize;
+
+  /**
+   * Header and entries of the mapped bundle
+   */
+  const Header_t *m_header;
+  const Entry_t *m_entries;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_INPUT_TRACE_BUNDLE_H */
@@ -20,6 +20,7 @@
 #include "satellite-interference-input-trace-container.h"
 #include "ns3/satellite-env-variables.h"
 #include "ns3/singleton.h"
+#include "ns3/string.h"
 #include "satellite-id-mapper.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatInterferenceInputTraceContainer");
@@ -33,7 +34,14 @@ SatInterferenceInputTraceContainer::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatInterferenceInputTraceContainer")
     .SetParent<SatBaseTraceContainer> ()
-    .AddConstructor<SatInterferenceInputTraceContainer> ();
+    .AddConstructor<SatInterferenceInputTraceContainer> ()
+    .AddAttribute ("TraceBundle",
+                   "Name of a trace bundle of the interference input trace directory, created with "
+                   "SatInputTraceBundle::CreateBundle, read instead of the text traces. "
+                   "Empty to read the text traces.",
+                   StringValue (""),
+                   MakeStringAccessor (&SatInterferenceInputTraceContainer::m_traceBundle),
+                   MakeStringChecker ());
   return tid;
 }
 
@@ -46,8 +54,13 @@ SatInterferenceInputTraceContainer::GetInstanceTypeId (void) const
 }
 
 SatInterferenceInputTraceContainer::SatInterferenceInputTraceContainer ()
+  : m_container (),
+  m_traceBundle (""),
+  m_bundle ()
 {
   NS_LOG_FUNCTION (this);
+
+  ObjectBase::ConstructSelf (AttributeConstructionList ());
 }
 
 SatInterferenceInputTraceContainer::~SatInterferenceInputTraceContainer ()
@@ -76,6 +89,9 @@ SatInterferenceInputTraceContainer::Reset ()
     {
       m_container.clear ();
     }
+
+  // The containers of the bundle traces have been released first
+  m_bundle = NULL;
 }
 
 Ptr<SatInputFileStreamTimeDoubleContainer>
@@ -83,8 +99,7 @@ SatInterferenceInputTraceContainer::AddNode (key_t key)
 {
   NS_LOG_FUNCTION (this);
 
-  std::stringstream filename;
-  std::string dataPath = Singleton<SatEnvVariables>::Get ()->LocateDataDirectory ();
+  std::string dataPath = Singleton<SatEnvVariables>::Get ()->LocateDataDirectory () + "/interferencetraces/input/";
 
   int32_t gwId = Singleton<SatIdMapper>::Get ()->GetGwIdWithMac (key.first);
   int32_t utId = Singleton<SatIdMapper>::Get ()->GetUtIdWithMac (key.first);
@@ -94,47 +109,30 @@ SatInterferenceInputTraceContainer::AddNode (key_t key)
     {
       return NULL;
     }
-  else
-    {
-      if (utId >= 0 && gwId < 0)
-        {
-          filename << dataPath << "/interferencetraces/input/BEAM_" << beamId << "_UT_" << utId << "_channelType_" << SatEnums::GetChannelTypeName (key.second);
-        }
-
-      if (gwId >= 0 && utId < 0)
-        {
-          filename << dataPath << "/interferencetraces/input/BEAM_" << beamId << "_GW_" << gwId << "_channelType_" << SatEnums::GetChannelTypeName (key.second);
-        }
 
-      std::pair <container_t::iterator, bool> result = m_container.insert (std::make_pair (key, CreateObject<SatInputFileStreamTimeDoubleContainer> (filename.str ().c_str (), std::ios::in, SatBaseTraceContainer::INTF_TRACE_DEFAULT_NUMBER_OF_COLUMNS)));
+  std::string traceName = SatInputTraceBundle::GetTraceName (beamId, utId, gwId, key.second);
 
-      if (result.second == false)
-        {
-          NS_FATAL_ERROR ("SatInterferenceInputTraceContainer::AddNode failed");
-        }
+  NS_LOG_INFO ("Added node with MAC " << key.first << " channel type " << key.second);
 
-      NS_LOG_INFO ("Added node with MAC " << key.first << " channel type " << key.second);
-
-      return result.first->second;
+  if (m_traceBundle.empty ())
+    {
+      return CreateObject<SatInputFileStreamTimeDoubleContainer> (dataPath + traceName, std::ios::in, SatBaseTraceContainer::INTF_TRACE_DEFAULT_NUMBER_OF_COLUMNS);
     }
 
-  NS_FATAL_ERROR ("SatInterferenceInputTraceContainer::AddNode failed");
-  return NULL;
-}
-
-Ptr<SatInputFileStreamTimeDoubleContainer>
-SatInterferenceInputTraceContainer::FindNode (key_t key)
-{
-  NS_LOG_FUNCTION (this);
+  if (m_bundle == NULL)
+    {
+      m_bundle = Create<SatInputTraceBundle> (dataPath + m_traceBundle, SatBaseTraceContainer::INTF_TRACE_DEFAULT_NUMBER_OF_COLUMNS);
+    }
 
-  container_t::iterator iter = m_container.find (key);
+  const double* columns;
+  uint32_t numOfRows;
 
-  if (iter == m_container.end ())
+  if (!m_bundle->FindTrace (beamId, utId, gwId, key.second, columns, numOfRows))
     {
-      return AddNode (key);
+      NS_FATAL_ERROR ("SatInterferenceInputTraceContainer::AddNode - No trace " << traceName << " in the trace bundle " << m_traceBundle);
     }
 
-  return iter->second;
+  return CreateObject<SatInputFileStreamTimeDoubleContainer> (traceName, columns, numOfRows, SatBaseTraceContainer::INTF_TRACE_DEFAULT_NUMBER_OF_COLUMNS);
 }
 
 double
@@ -142,7 +140,9 @@ SatInterferenceInputTraceContainer::GetInterferenceDensity (key_t key)
 {
   NS_LOG_FUNCTION (this);
 
-  return FindNode (key)->ProceedToNextClosestTimeSample ().at (SatBaseTraceContainer::INTF_TRACE_DEFAULT_INTF_DENSITY_INDEX);
+  Ptr<SatInputFileStreamTimeDoubleContainer> trace = FindTrace (m_container, this, &SatInterferenceInputTraceContainer::AddNode, key);
+
+  return trace->ProceedToNextClosestTimeSample (SatBaseTraceContainer::INTF_TRACE_DEFAULT_INTF_DENSITY_INDEX);
 }
 
 } // namespace ns3
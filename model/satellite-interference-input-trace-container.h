@@ -24,6 +24,8 @@
 #include "ns3/satellite-input-fstream-time-double-container.h"
 #include "satellite-enums.h"
 #include "ns3/mac48-address.h"
+#include "satellite-input-trace-bundle.h"
+#include <vector>
 
 namespace ns3 {
 
@@ -32,6 +34,11 @@ namespace ns3 {
  *
  * \brief Class for interference input trace container. The class contains
  * multiple interference input sample traces and provides an interface to them.
+ *
+ * The traces are read from the text files of the input trace directory, or
+ * from the trace bundle of this directory named by the `TraceBundle`
+ * attribute, see SatInputTraceBundle. The traces of the nodes are kept in a
+ * table indexed by the trace id of the node and the channel type.
  */
 class SatInterferenceInputTraceContainer : public SatBaseTraceContainer
 {
@@ -42,9 +49,9 @@ public:
   typedef std::pair<Address, SatEnums::ChannelType_t> key_t;
 
   /**
-   * \brief typedef for map of containers
+   * \brief typedef for table of containers, indexed by trace id and channel type
    */
-  typedef std::map <key_t, Ptr<SatInputFileStreamTimeDoubleContainer> > container_t;
+  typedef std::vector <Ptr<SatInputFileStreamTimeDoubleContainer> > container_t;
 
   /**
    * \brief Constructor
@@ -87,23 +94,26 @@ public:
 
 private:
   /**
-   * \brief Function for adding the node to the map
+   * \brief Function for loading the trace of a node
    * \param key key
-   * \return pointer to the added container
+   * \return pointer to the loaded container
    */
   Ptr<SatInputFileStreamTimeDoubleContainer> AddNode (std::pair<Address, SatEnums::ChannelType_t> key);
 
   /**
-   * \brief Function for finding the container matching the key
-   * \param key key
-   * \return matching container
+   * \brief Table for containers
    */
-  Ptr<SatInputFileStreamTimeDoubleContainer> FindNode (key_t key);
+  container_t m_container;
 
   /**
-   * \brief Map for containers
+   * \brief Name of the trace bundle, empty to read the text traces
    */
-  container_t m_container;
+  std::string m_traceBundle;
+
+  /**
+   * \brief Trace bundle, loaded with the first trace
+   */
+  Ptr<SatInputTraceBundle> m_bundle;
 };
 
 } // namespace ns3
@@ -51,6 +51,8 @@ SatInterferenceOutputTraceContainer::SatInterferenceOutputTraceContainer ()
   : m_enableFigureOutput (true)
 {
   NS_LOG_FUNCTION (this);
+
+  ObjectBase::ConstructSelf (AttributeConstructionList ());
 }
 
 SatInterferenceOutputTraceContainer::~SatInterferenceOutputTraceContainer ()
@@ -81,11 +83,18 @@ SatInterferenceOutputTraceContainer::Reset ()
 
       m_container.clear ();
     }
+
+  for (recorderContainer_t::iterator iter = m_recorders.begin (); iter != m_recorders.end (); iter++)
+    {
+      iter->second->Close ();
+    }
+  m_recorders.clear ();
+
   m_enableFigureOutput = true;
 }
 
-Ptr<SatOutputFileStreamDoubleContainer>
-SatInterferenceOutputTraceContainer::AddNode (key_t key)
+std::string
+SatInterferenceOutputTraceContainer::GetFileName (key_t key) const
 {
   NS_LOG_FUNCTION (this);
 
@@ -96,23 +105,33 @@ SatInterferenceOutputTraceContainer::AddNode (key_t key)
   int32_t utId = Singleton<SatIdMapper>::Get ()->GetUtIdWithMac (key.first);
   int32_t beamId = Singleton<SatIdMapper>::Get ()->GetBeamIdWithMac (key.first);
 
-  if (beamId < 0 || (utId < 0 && gwId < 0))
+  if (beamId >= 0 && utId >= 0 && gwId < 0)
     {
-      return NULL;
+      filename << dataPath << "/interference_output_trace_BEAM_" << beamId << "_UT_" << utId << "_channelType_" << SatEnums::GetChannelTypeName (key.second);
     }
-  else
+
+  if (beamId >= 0 && gwId >= 0 && utId < 0)
     {
-      if (utId >= 0 && gwId < 0)
-        {
-          filename << dataPath << "/interference_output_trace_BEAM_" << beamId << "_UT_" << utId << "_channelType_" << SatEnums::GetChannelTypeName (key.second);
-        }
+      filename << dataPath << "/interference_output_trace_BEAM_" << beamId << "_GW_" << gwId << "_channelType_" << SatEnums::GetChannelTypeName (key.second);
+    }
 
-      if (gwId >= 0 && utId < 0)
-        {
-          filename << dataPath << "/interference_output_trace_BEAM_" << beamId << "_GW_" << gwId << "_channelType_" << SatEnums::GetChannelTypeName (key.second);
-        }
+  return filename.str ();
+}
+
+Ptr<SatOutputFileStreamDoubleContainer>
+SatInterferenceOutputTraceContainer::AddNode (key_t key)
+{
+  NS_LOG_FUNCTION (this);
 
-      std::pair <container_t::iterator, bool> result = m_container.insert (std::make_pair (key, CreateObject<SatOutputFileStreamDoubleContainer> (filename.str ().c_str (), std::ios::out, SatBaseTraceContainer::INTF_TRACE_DEFAULT_NUMBER_OF_COLUMNS)));
+  std::string filename = GetFileName (key);
+
+  if (filename.empty ())
+    {
+      return NULL;
+    }
+  else
+    {
+      std::pair <container_t::iterator, bool> result = m_container.insert (std::make_pair (key, CreateObject<SatOutputFileStreamDoubleContainer> (filename.c_str (), std::ios::out, SatBaseTraceContainer::INTF_TRACE_DEFAULT_NUMBER_OF_COLUMNS)));
 
       if (result.second == false)
         {
@@ -140,6 +159,33 @@ SatInterferenceOutputTraceContainer::FindNode (key_t key)
   return iter->second;
 }
 
+Ptr<SatOutputTraceRecorder>
+SatInterferenceOutputTraceContainer::FindRecorder (key_t key)
+{
+  NS_LOG_FUNCTION (this);
+
+  recorderContainer_t::iterator iter = m_recorders.find (key);
+
+  if (iter != m_recorders.end ())
+    {
+      return iter->second;
+    }
+
+  std::string filename = GetFileName (key);
+
+  if (filename.empty ())
+    {
+      return NULL;
+    }
+
+  Ptr<SatOutputTraceRecorder> recorder = CreateRecorder (filename);
+  m_recorders.insert (std::make_pair (key, recorder));
+
+  NS_LOG_INFO ("Added recorder for MAC " << key.first << " channel type " << key.second);
+
+  return recorder;
+}
+
 void
 SatInterferenceOutputTraceContainer::WriteToFile ()
 {
@@ -172,6 +218,17 @@ SatInterferenceOutputTraceContainer::AddToContainer (key_t key, std::vector<doub
       NS_FATAL_ERROR ("SatInterferenceOutputTraceContainer::AddToContainer - Incorrect vector size");
     }
 
+  if (m_useBoundedRecorder)
+    {
+      Ptr<SatOutputTraceRecorder> recorder = FindRecorder (key);
+
+      if (recorder != NULL)
+        {
+          recorder->AddSample (newItem[0], newItem[SatBaseTraceContainer::INTF_TRACE_DEFAULT_INTF_DENSITY_INDEX]);
+        }
+      return;
+    }
+
   Ptr<SatOutputFileStreamDoubleContainer> node = FindNode (key);
 
   if (node != NULL)
@@ -21,6 +21,9 @@
 #include "ns3/satellite-env-variables.h"
 #include "ns3/singleton.h"
 #include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/enum.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatLog");
 
@@ -33,7 +36,34 @@ SatLog::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatLog")
     .SetParent<Object> ()
-    .AddConstructor<SatLog> ();
+    .AddConstructor<SatLog> ()
+    .AddAttribute ("MinSeverity",
+                   "Lowest type of the info, warning and error messages added to the logs.",
+                   EnumValue (SatLog::LOG_INFO),
+                   MakeEnumAccessor (&SatLog::m_minSeverity),
+                   MakeEnumChecker (SatLog::LOG_INFO, "Info",
+                                    SatLog::LOG_WARNING, "Warning",
+                                    SatLog::LOG_ERROR, "Error"))
+    .AddAttribute ("GenericLogEnabled",
+                   "Add the generic messages to the logs.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&SatLog::m_genericLogEnabled),
+                   MakeBooleanChecker ())
+    .AddAttribute ("CustomLogEnabled",
+                   "Add the custom messages to the logs.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&SatLog::m_customLogEnabled),
+                   MakeBooleanChecker ())
+    .AddAttribute ("MaxMessages",
+                   "Maximum number of messages kept in memory per log, the older ones being dropped. Zero keeps every message.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&SatLog::m_maxMessages),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("StreamingOutput",
+                   "Write the messages to the log files during the simulation instead of keeping them in memory.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatLog::m_streamingOutput),
+                   MakeBooleanChecker ());
   return tid;
 }
 
@@ -46,6 +76,12 @@ SatLog::GetInstanceTypeId (void) const
 }
 
 SatLog::SatLog ()
+  : m_container (),
+  m_minSeverity (LOG_INFO),
+  m_genericLogEnabled (true),
+  m_customLogEnabled (true),
+  m_maxMessages (0),
+  m_streamingOutput (false)
 {
   NS_LOG_FUNCTION (this);
 
@@ -80,7 +116,7 @@ SatLog::Reset ()
     }
 }
 
-Ptr<SatOutputFileStreamStringContainer>
+SatLog::log_t&
 SatLog::CreateLog (LogType_t logType, std::string fileTag)
 {
   NS_LOG_FUNCTION (this);
@@ -92,7 +128,17 @@ SatLog::CreateLog (LogType_t logType, std::string fileTag)
 
   key_t key = std::make_pair (logType, fileTag);
 
-  std::pair <container_t::iterator, bool> result = m_container.insert (std::make_pair (key, CreateObject<SatOutputFileStreamStringContainer> (filename.str ().c_str (), std::ios::out)));
+  log_t log;
+  log.container = CreateObject<SatOutputFileStreamStringContainer> (filename.str ().c_str (), std::ios::out);
+  log.nextMessage = 0;
+  log.numOfDroppedMessages = 0;
+
+  if (m_streamingOutput)
+    {
+      log.container->SetAttribute ("StreamingOutput", BooleanValue (true));
+    }
+
+  std::pair <container_t::iterator, bool> result = m_container.insert (std::make_pair (key, log));
 
   if (result.second == false)
     {
@@ -104,7 +150,7 @@ SatLog::CreateLog (LogType_t logType, std::string fileTag)
   return result.first->second;
 }
 
-Ptr<SatOutputFileStreamStringContainer>
+SatLog::log_t&
 SatLog::FindLog (LogType_t logType, std::string fileTag)
 {
   NS_LOG_FUNCTION (this);
@@ -130,7 +176,23 @@ SatLog::WriteToFile ()
 
   for (iter = m_container.begin (); iter != m_container.end (); iter++)
     {
-      iter->second->WriteContainerToFile ();
+      log_t &log = iter->second;
+
+      if (log.numOfDroppedMessages > 0)
+        {
+          std::stringstream note;
+          note << "SatLog: " << log.numOfDroppedMessages << " earlier messages dropped, "
+               << "the last " << log.messages.size () << " messages follow";
+          log.container->AddToContainer (note.str ());
+        }
+
+      // Oldest message first, the ring buffer starting at the next message to overwrite
+      for (uint32_t i = 0; i < log.messages.size (); i++)
+        {
+          log.container->AddToContainer (log.messages[(log.nextMessage + i) % log.messages.size ()]);
+        }
+
+      log.container->WriteContainerToFile ();
     }
 }
 
@@ -139,23 +201,58 @@ SatLog::AddToLog (LogType_t logType, std::string fileTag, std::string message)
 {
   NS_LOG_FUNCTION (this);
 
+  if (!IsEnabled (logType))
+    {
+      return;
+    }
+
   if (logType != LOG_CUSTOM)
     {
       fileTag = GetFileTag (logType);
     }
 
-  Ptr<SatOutputFileStreamStringContainer> log = FindLog (logType, fileTag);
+  log_t &log = FindLog (logType, fileTag);
 
   NS_LOG_INFO ("Type: " << logType << ", file tag: " << fileTag << ", message: " << message);
 
-  if (log != NULL)
+  if (m_streamingOutput || m_maxMessages == 0)
+    {
+      log.container->AddToContainer (message);
+    }
+  else if (log.messages.size () < m_maxMessages)
+    {
+      log.messages.push_back (message);
+    }
+  else
+    {
+      log.messages[log.nextMessage].swap (message);
+      log.nextMessage = (log.nextMessage + 1) % log.messages.size ();
+      log.numOfDroppedMessages++;
+    }
+}
+
+uint64_t
+SatLog::GetNumOfDroppedMessages (LogType_t logType, std::string fileTag) const
+{
+  NS_LOG_FUNCTION (this);
+
+  if (logType != LOG_CUSTOM)
     {
-      log->AddToContainer (message);
+      fileTag = GetFileTag (logType);
     }
+
+  container_t::const_iterator iter = m_container.find (std::make_pair (logType, fileTag));
+
+  if (iter == m_container.end ())
+    {
+      return 0;
+    }
+
+  return iter->second.numOfDroppedMessages;
 }
 
 std::string
-SatLog::GetFileTag (LogType_t logType)
+SatLog::GetFileTag (LogType_t logType) const
 {
   std::string fileTag = "";
 
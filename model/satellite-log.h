@@ -22,6 +22,7 @@
 
 #include "ns3/satellite-output-fstream-string-container.h"
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -48,6 +49,17 @@ namespace ns3 {
  * With (LOG_CUSTOM, "_exampleTag", "Example message for custom log") and simulation tag
  * "_ut30_beam1" the file log_exampleTag_ut30_beam1 would contain the message
  * "Example message for custom log".
+ *
+ * The messages are filtered by type with the `MinSeverity`,
+ * `GenericLogEnabled` and `CustomLogEnabled` attributes. Callers building
+ * costly messages should check IsEnabled() before formatting them.
+ *
+ * By default, the messages of every log are kept in memory until the logs
+ * are written at dispose time. The `MaxMessages` attribute bounds every log
+ * to a ring buffer of its last messages; the older ones are dropped and
+ * counted, and the count is written before the kept messages. With the
+ * `StreamingOutput` attribute, the messages are instead written to the file
+ * during the simulation, and no message is dropped.
  */
 class SatLog : public Object
 {
@@ -70,9 +82,20 @@ public:
   typedef std::pair <LogType_t, std::string> key_t;
 
   /**
-   * \brief typedef for map of containers
+   * \brief Messages of a log
+   */
+  typedef struct
+  {
+    Ptr<SatOutputFileStreamStringContainer> container;  //!< Output of the log
+    std::vector<std::string> messages;                   //!< Kept messages, used as a ring buffer if bounded
+    uint32_t nextMessage;                                //!< Index of the oldest kept message once the ring buffer is full
+    uint64_t numOfDroppedMessages;                       //!< Number of messages dropped from the ring buffer
+  } log_t;
+
+  /**
+   * \brief typedef for map of logs
    */
-  typedef std::map <key_t, Ptr<SatOutputFileStreamStringContainer> > container_t;
+  typedef std::map <key_t, log_t> container_t;
 
   /**
    * \brief Constructor
@@ -109,6 +132,33 @@ public:
    */
   void AddToLog (LogType_t logType, std::string fileTag, std::string message);
 
+  /**
+   * \brief Check whether the messages of a log type are kept, before
+   * formatting them
+   * \param logType log type
+   * \return true if the messages of this type are added to the logs
+   */
+  inline bool IsEnabled (LogType_t logType) const
+  {
+    switch (logType)
+      {
+      case LOG_GENERIC:
+        return m_genericLogEnabled;
+      case LOG_CUSTOM:
+        return m_customLogEnabled;
+      default:
+        return logType >= m_minSeverity;
+      }
+  }
+
+  /**
+   * \brief Function for getting the number of messages dropped from a log
+   * \param logType log type
+   * \param fileTag file tag for the filename, used only with LOG_CUSTOM
+   * \return number of messages dropped because of the `MaxMessages` attribute
+   */
+  uint64_t GetNumOfDroppedMessages (LogType_t logType, std::string fileTag) const;
+
   /**
    * \brief Function for resetting the variables
    */
@@ -120,7 +170,7 @@ private:
    * \param logType log type
    * \return file tag
    */
-  std::string GetFileTag (LogType_t logType);
+  std::string GetFileTag (LogType_t logType) const;
 
   /**
    * \brief Function for creating a log
@@ -128,7 +178,7 @@ private:
    * \param fileTag file tag for the filename
    * \return the created log
    */
-  Ptr<SatOutputFileStreamStringContainer> CreateLog (LogType_t logType, std::string fileTag);
+  log_t& CreateLog (LogType_t logType, std::string fileTag);
 
   /**
    * \brief Function for finding a log based on the key
@@ -136,7 +186,7 @@ private:
    * \param fileTag file tag for the filename
    * \return the log
    */
-  Ptr<SatOutputFileStreamStringContainer> FindLog (LogType_t logType, std::string fileTag);
+  log_t& FindLog (LogType_t logType, std::string fileTag);
 
   /**
    * \brief Write the contents of a container matching to the key into a file
@@ -147,6 +197,31 @@ private:
    * \brief Map for containers
    */
   container_t m_container;
+
+  /**
+   * \brief Lowest type of LOG_INFO, LOG_WARNING and LOG_ERROR kept
+   */
+  LogType_t m_minSeverity;
+
+  /**
+   * \brief Whether the LOG_GENERIC messages are kept
+   */
+  bool m_genericLogEnabled;
+
+  /**
+   * \brief Whether the LOG_CUSTOM messages are kept
+   */
+  bool m_customLogEnabled;
+
+  /**
+   * \brief Maximum number of messages kept per log, zero for no limit
+   */
+  uint32_t m_maxMessages;
+
+  /**
+   * \brief Write the messages to the files during the simulation
+   */
+  bool m_streamingOutput;
 };
 
 } // namespace ns3
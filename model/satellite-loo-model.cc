@@ -41,7 +41,8 @@ SatLooModel::SatLooModel ()
   m_currentState (0),
   m_looConf (NULL),
   m_normalRandomVariable (NULL),
-  m_uniformVariable (NULL)
+  m_uniformVariable (NULL),
+  m_useOscillatorBank (false)
 {
   NS_LOG_FUNCTION (this);
 
@@ -54,7 +55,8 @@ SatLooModel::SatLooModel (Ptr<SatLooConf> looConf, uint32_t numOfStates, uint32_
   m_currentState (initialState),
   m_looConf (looConf),
   m_normalRandomVariable (NULL),
-  m_uniformVariable (NULL)
+  m_uniformVariable (NULL),
+  m_useOscillatorBank (looConf->GetUseOscillatorBank ())
 {
   NS_LOG_FUNCTION (this << numOfStates << " " << initialSet << " " << initialState);
 
@@ -117,6 +119,9 @@ SatLooModel::Reset ()
       m_multipathOscillators.clear ();
     }
 
+  m_directSignalOscillatorBanks.clear ();
+  m_multipathOscillatorBanks.clear ();
+
   m_looParameters.clear ();
   m_sigma.clear ();
 }
@@ -129,6 +134,12 @@ SatLooModel::ConstructDirectSignalOscillators ()
   for (uint32_t i = 0; i < m_numOfStates; i++)
     {
       std::vector< Ptr<SatFadingOscillator> > oscillators;
+      Ptr<SatFadingOscillatorBank> oscillatorBank;
+
+      if (m_useOscillatorBank)
+        {
+          oscillatorBank = CreateObject<SatFadingOscillatorBank> ();
+        }
 
       /// Initial phase is common for all oscillators:
       double phi = m_uniformVariable->GetValue ();
@@ -153,9 +164,17 @@ SatLooModel::ConstructDirectSignalOscillators ()
           amplitude = pow (10, amplitude / 10) / m_looParameters[i][3];
 
           /// 3. Construct oscillator:
-          oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+          if (m_useOscillatorBank)
+            {
+              oscillatorBank->AddOscillator (amplitude, phi, omega);
+            }
+          else
+            {
+              oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+            }
         }
       m_directSignalOscillators.push_back (oscillators);
+      m_directSignalOscillatorBanks.push_back (oscillatorBank);
     }
 }
 
@@ -167,6 +186,12 @@ SatLooModel::ConstructMultipathOscillators ()
   for (uint32_t i = 0; i < m_numOfStates; i++)
     {
       std::vector< Ptr<SatFadingOscillator> > oscillators;
+      Ptr<SatFadingOscillatorBank> oscillatorBank;
+
+      if (m_useOscillatorBank)
+        {
+          oscillatorBank = CreateObject<SatFadingOscillatorBank> ();
+        }
 
       /// Initial phase is common for all oscillators:
       double phi = m_uniformVariable->GetValue ();
@@ -184,9 +209,17 @@ SatLooModel::ConstructMultipathOscillators ()
           double psi = m_normalRandomVariable->GetValue ();
           std::complex<double> amplitude = std::complex<double> (std::cos (psi), std::sin (psi)) * 2.0 / std::sqrt (m_looParameters[i][4]);
           /// 3. Construct oscillator:
-          oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+          if (m_useOscillatorBank)
+            {
+              oscillatorBank->AddOscillator (amplitude, phi, omega);
+            }
+          else
+            {
+              oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+            }
         }
       m_multipathOscillators.push_back (oscillators);
+      m_multipathOscillatorBanks.push_back (oscillatorBank);
     }
 }
 
@@ -205,22 +238,78 @@ SatLooModel::GetChannelGain ()
 {
   NS_LOG_FUNCTION (this);
 
-  double timeInSeconds = Now ().GetSeconds ();
+  return CalculateChannelGain (m_currentState, Now ().GetSeconds ());
+}
 
-  /// Direct signal
-  std::complex<double> directComplexGain = GetOscillatorCosineWaveSum (m_directSignalOscillators[m_currentState], timeInSeconds);
+double
+SatLooModel::CalculateChannelGain (uint32_t state, double timeInSeconds)
+{
+  NS_LOG_FUNCTION (this << state << timeInSeconds);
+
+  std::complex<double> directComplexGain;
+  std::complex<double> multipathComplexGain;
+
+  if (m_useOscillatorBank)
+    {
+      /// Direct signal
+      directComplexGain = m_directSignalOscillatorBanks[state]->GetCosineWaveSumAt (timeInSeconds);
+
+      /// Multipath
+      multipathComplexGain = m_multipathOscillatorBanks[state]->GetComplexSumAt (timeInSeconds);
+    }
+  else
+    {
+      /// Direct signal
+      directComplexGain = GetOscillatorCosineWaveSum (m_directSignalOscillators[state], timeInSeconds);
 
-  /// Multipath
-  std::complex<double> multipathComplexGain = GetOscillatorComplexSum (m_multipathOscillators[m_currentState], timeInSeconds);
-  multipathComplexGain = multipathComplexGain * m_sigma[m_currentState];
+      /// Multipath
+      multipathComplexGain = GetOscillatorComplexSum (m_multipathOscillators[state], timeInSeconds);
+    }
+  multipathComplexGain = multipathComplexGain * m_sigma[state];
 
   /// Combining
   std::complex<double> fadingGain = directComplexGain + multipathComplexGain;
   return sqrt ((pow (fadingGain.real (), 2) + pow (fadingGain.imag (), 2)));
 }
 
+void
+SatLooModel::GetChannelGains (uint32_t state, double startTime, double timeStep, bool useDecibels, std::vector<double>& gains)
+{
+  NS_LOG_FUNCTION (this << state << startTime << timeStep << useDecibels << gains.size ());
+
+  if (m_useOscillatorBank)
+    {
+      std::vector<std::complex<double> > directComplexGains (gains.size ());
+      std::vector<std::complex<double> > multipathComplexGains (gains.size ());
+
+      m_directSignalOscillatorBanks[state]->GetCosineWaveSumsAt (startTime, timeStep, directComplexGains);
+      m_multipathOscillatorBanks[state]->GetComplexSumsAt (startTime, timeStep, multipathComplexGains);
+
+      for (uint32_t k = 0; k < gains.size (); k++)
+        {
+          std::complex<double> fadingGain = directComplexGains[k] + multipathComplexGains[k] * m_sigma[state];
+          gains[k] = std::abs (fadingGain);
+        }
+    }
+  else
+    {
+      for (uint32_t k = 0; k < gains.size (); k++)
+        {
+          gains[k] = CalculateChannelGain (state, startTime + k * timeStep);
+        }
+    }
+
+  if (useDecibels)
+    {
+      for (uint32_t k = 0; k < gains.size (); k++)
+        {
+          gains[k] = 10.0 * std::log10 (gains[k]);
+        }
+    }
+}
+
 std::complex<double>
-SatLooModel::GetOscillatorCosineWaveSum (std::vector< Ptr<SatFadingOscillator> > oscillator, double timeInSeconds)
+SatLooModel::GetOscillatorCosineWaveSum (const std::vector< Ptr<SatFadingOscillator> >& oscillator, double timeInSeconds)
 {
   NS_LOG_FUNCTION (this);
 
@@ -235,7 +324,7 @@ SatLooModel::GetOscillatorCosineWaveSum (std::vector< Ptr<SatFadingOscillator> >
 }
 
 std::complex<double>
-SatLooModel::GetOscillatorComplexSum (std::vector< Ptr<SatFadingOscillator> > oscillator, double timeInSeconds)
+SatLooModel::GetOscillatorComplexSum (const std::vector< Ptr<SatFadingOscillator> >& oscillator, double timeInSeconds)
 {
   NS_LOG_FUNCTION (this);
 
@@ -300,6 +389,9 @@ SatLooModel::ChangeSet (uint32_t newSet, uint32_t newState)
       m_multipathOscillators.clear ();
     }
 
+  m_directSignalOscillatorBanks.clear ();
+  m_multipathOscillatorBanks.clear ();
+
   m_sigma.clear ();
 
   ConstructDirectSignalOscillators ();
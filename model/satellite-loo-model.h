@@ -23,6 +23,7 @@
 #include "ns3/vector.h"
 #include "satellite-base-fader.h"
 #include "satellite-fading-oscillator.h"
+#include "satellite-fading-oscillator-bank.h"
 #include "satellite-loo-conf.h"
 #include "ns3/random-variable-stream.h"
 
@@ -87,6 +88,16 @@ public:
    */
   void UpdateParameters (uint32_t set, uint32_t state);
 
+  /**
+   * \brief Function for calculating the channel gains of a state at fixed time steps
+   * \param state state
+   * \param startTime time of the first channel gain in seconds
+   * \param timeStep time step between the channel gains in seconds
+   * \param useDecibels whether the channel gains are calculated in dB
+   * \param gains vector filled with the channel gains, its size defines the number of gains
+   */
+  void GetChannelGains (uint32_t state, double startTime, double timeStep, bool useDecibels, std::vector<double>& gains);
+
 private:
   /**
    * \brief Number of states
@@ -138,6 +149,23 @@ private:
    */
   std::vector< std::vector< Ptr<SatFadingOscillator> > > m_multipathOscillators;
 
+  /**
+   * \brief Evaluate the oscillators with oscillator banks
+   */
+  bool m_useOscillatorBank;
+
+  /**
+   * \brief Direct signal oscillator banks, used instead of direct signal
+   * oscillators when oscillator bank is enabled
+   */
+  std::vector< Ptr<SatFadingOscillatorBank> > m_directSignalOscillatorBanks;
+
+  /**
+   * \brief Multipath oscillator banks, used instead of multipath
+   * oscillators when oscillator bank is enabled
+   */
+  std::vector< Ptr<SatFadingOscillatorBank> > m_multipathOscillatorBanks;
+
   /**
    * \brief Function for constructing direct signal oscillators
    */
@@ -148,13 +176,21 @@ private:
    */
   void ConstructMultipathOscillators ();
 
+  /**
+   * \brief Function for calculating the channel gain of a state
+   * \param state state
+   * \param timeInSeconds time in seconds
+   * \return channel gain
+   */
+  double CalculateChannelGain (uint32_t state, double timeInSeconds);
+
   /**
    * \brief Function for calculating cosine wave oscillator complex sum
    * \param oscillator oscillator
    * \param timeInSeconds current time in seconds
    * \return sum
    */
-  std::complex<double> GetOscillatorCosineWaveSum (std::vector< Ptr<SatFadingOscillator> > oscillator, double timeInSeconds);
+  std::complex<double> GetOscillatorCosineWaveSum (const std::vector< Ptr<SatFadingOscillator> >& oscillator, double timeInSeconds);
 
   /**
    * \brief Function for calculating oscillator complex sum
@@ -162,7 +198,7 @@ private:
    * \param timeInSeconds current time in seconds
    * \return sum
    */
-  std::complex<double> GetOscillatorComplexSum (std::vector< Ptr<SatFadingOscillator> > oscillator, double timeInSeconds);
+  std::complex<double> GetOscillatorComplexSum (const std::vector< Ptr<SatFadingOscillator> >& oscillator, double timeInSeconds);
 
   /**
    * \brief Function for setting the state
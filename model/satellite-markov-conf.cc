@@ -20,6 +20,7 @@
 
 #include "satellite-markov-conf.h"
 #include <map>
+#include <limits>
 
 namespace ns3 {
 
@@ -79,7 +80,34 @@ SatMarkovConf::GetTypeId (void)
     .AddAttribute ( "UseDecibels", "Defines whether the fading value should be in decibels or not.",
                     BooleanValue (false),
                     MakeBooleanAccessor (&SatMarkovConf::m_useDecibels),
-                    MakeBooleanChecker ());
+                    MakeBooleanChecker ())
+    .AddAttribute ( "UseUplinkFader", "Defines whether the uplink fading is calculated by the uplink fader. "
+                    "By default, the fading of both links is calculated by the downlink fader.",
+                    BooleanValue (false),
+                    MakeBooleanAccessor (&SatMarkovConf::m_useUplinkFader),
+                    MakeBooleanChecker ())
+    .AddAttribute ( "UsePreTabulatedFading", "Defines whether the fading values are generated ahead of time into fixed step tables and interpolated on each request.",
+                    BooleanValue (false),
+                    MakeBooleanAccessor (&SatMarkovConf::m_usePreTabulatedFading),
+                    MakeBooleanChecker ())
+    .AddAttribute ( "PreTabulationStep", "Time step of the pre-tabulated fading values.",
+                    TimeValue (MilliSeconds (1)),
+                    MakeTimeAccessor (&SatMarkovConf::m_preTabulationStep),
+                    MakeTimeChecker (NanoSeconds (1)))
+    .AddAttribute ( "PreTabulationLength", "Number of pre-tabulated fading values per state, generated at once when the table is refilled.",
+                    UintegerValue (1024),
+                    MakeUintegerAccessor (&SatMarkovConf::m_preTabulationLength),
+                    MakeUintegerChecker<uint32_t> (2))
+    .AddAttribute ( "DecoupledSetUpdates", "Defines whether the elevation parameter set is updated on mobility changes and periodically, "
+                    "instead of being resolved from the current elevation on each state change evaluation.",
+                    BooleanValue (false),
+                    MakeBooleanAccessor (&SatMarkovConf::m_decoupledSetUpdates),
+                    MakeBooleanChecker ())
+    .AddAttribute ( "SetUpdateInterval", "Interval of the periodic elevation parameter set updates when they are decoupled "
+                    "from the state change evaluation, zero to update only on mobility changes.",
+                    TimeValue (Seconds (1)),
+                    MakeTimeAccessor (&SatMarkovConf::m_setUpdateInterval),
+                    MakeTimeChecker (Seconds (0)));
   return tid;
 }
 
@@ -89,6 +117,12 @@ SatMarkovConf::SatMarkovConf ()
   m_minimumPositionChangeInMeters (1000.0),
   m_cooldownPeriodLength (Seconds (0.00005)),
   m_useDecibels (false),
+  m_useUplinkFader (false),
+  m_usePreTabulatedFading (false),
+  m_preTabulationStep (MilliSeconds (1)),
+  m_preTabulationLength (1024),
+  m_decoupledSetUpdates (false),
+  m_setUpdateInterval (Seconds (1)),
   m_looConf (NULL),
   m_rayleighConf (NULL),
   m_faderType (SatMarkovConf::LOO_FADER)
@@ -110,6 +144,7 @@ SatMarkovConf::SatMarkovConf ()
           states.push_back (probabilities);
         }
       m_markovProbabilities.push_back (states);
+      m_transitionTables.push_back (Create<SatMarkovTransitionTable> (states));
     }
 
   for (uint32_t i = 0; i < m_stateCount; i++)
@@ -155,6 +190,7 @@ SatMarkovConf::Reset ()
   m_looConf = NULL;
   m_rayleighConf = NULL;
 
+  m_transitionTables.clear ();
   m_initialProbabilities.clear ();
   m_markovElevations.clear ();
 }
@@ -181,6 +217,57 @@ SatMarkovConf::GetElevationProbabilities (uint32_t set)
   return m_markovProbabilities[set];
 }
 
+Ptr<const SatMarkovTransitionTable>
+SatMarkovConf::GetTransitionTable (uint32_t set)
+{
+  NS_LOG_FUNCTION (this << set);
+
+  if (set >= m_transitionTables.size ())
+    {
+      NS_FATAL_ERROR ("SatMarkovConf::GetTransitionTable - Invalid set");
+    }
+
+  return m_transitionTables[set];
+}
+
+uint32_t
+SatMarkovConf::GetProbabilitySetID (double elevation, double& lowerElevation, double& upperElevation)
+{
+  NS_LOG_FUNCTION (this << elevation);
+
+  uint32_t set = GetProbabilitySetID (elevation);
+
+  /// the set stays the same until the elevation reaches the midpoint to a neighbouring set elevation
+  lowerElevation = -std::numeric_limits<double>::infinity ();
+  upperElevation = std::numeric_limits<double>::infinity ();
+
+  std::map<double, uint32_t>::iterator iter;
+  std::map<double, uint32_t>::iterator previous = m_markovElevations.end ();
+
+  for (iter = m_markovElevations.begin (); iter != m_markovElevations.end (); iter++)
+    {
+      if (iter->second == set)
+        {
+          if (previous != m_markovElevations.end ())
+            {
+              lowerElevation = (previous->first + iter->first) / 2;
+            }
+
+          std::map<double, uint32_t>::iterator next = iter;
+          next++;
+
+          if (next != m_markovElevations.end ())
+            {
+              upperElevation = (iter->first + next->first) / 2;
+            }
+          break;
+        }
+      previous = iter;
+    }
+
+  return set;
+}
+
 uint32_t
 SatMarkovConf::GetProbabilitySetID (double elevation)
 {
@@ -292,6 +379,54 @@ SatMarkovConf::GetRayleighConf ()
   return m_rayleighConf;
 }
 
+bool
+SatMarkovConf::IsUplinkFaderUsed ()
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_useUplinkFader;
+}
+
+bool
+SatMarkovConf::IsPreTabulatedFadingUsed ()
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_usePreTabulatedFading;
+}
+
+Time
+SatMarkovConf::GetPreTabulationStep ()
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_preTabulationStep;
+}
+
+uint32_t
+SatMarkovConf::GetPreTabulationLength ()
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_preTabulationLength;
+}
+
+bool
+SatMarkovConf::AreSetUpdatesDecoupled ()
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_decoupledSetUpdates;
+}
+
+Time
+SatMarkovConf::GetSetUpdateInterval ()
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_setUpdateInterval;
+}
+
 SatMarkovConf::MarkovFaderType_t
 SatMarkovConf::GetFaderType ()
 {
@@ -30,6 +30,7 @@
 #include "ns3/simulator.h"
 #include "satellite-loo-conf.h"
 #include "satellite-rayleigh-conf.h"
+#include "satellite-markov-model.h"
 
 namespace ns3 {
 
@@ -85,6 +86,16 @@ public:
    */
   uint32_t GetProbabilitySetID (double elevation);
 
+  /**
+   * \brief Function for returning the parameter set and the elevation range
+   * in which the same parameter set is selected
+   * \param elevation elevation
+   * \param lowerElevation lower bound (exclusive) of the elevation range
+   * \param upperElevation upper bound (exclusive) of the elevation range
+   * \return parameter set
+   */
+  uint32_t GetProbabilitySetID (double elevation, double& lowerElevation, double& upperElevation);
+
   /**
    * \brief Function for returning the probabilities
    * \param set parameter set
@@ -92,6 +103,13 @@ public:
    */
   std::vector<std::vector<double> > GetElevationProbabilities (uint32_t set);
 
+  /**
+   * \brief Function for returning the precomputed state change table
+   * \param set parameter set
+   * \return state change table
+   */
+  Ptr<const SatMarkovTransitionTable> GetTransitionTable (uint32_t set);
+
   /**
    * \brief Function for returning the number of states
    * \return number of states
@@ -146,6 +164,43 @@ public:
    */
   bool AreDecibelsUsed ();
 
+  /**
+   * \brief Function for getting whether the uplink fading is calculated by the uplink fader or not
+   * \return is the uplink fader used or not
+   */
+  bool IsUplinkFaderUsed ();
+
+  /**
+   * \brief Function for getting whether the fading values are pre-tabulated or not
+   * \return is pre-tabulated fading used or not
+   */
+  bool IsPreTabulatedFadingUsed ();
+
+  /**
+   * \brief Function for returning the time step of the pre-tabulated fading values
+   * \return time step
+   */
+  Time GetPreTabulationStep ();
+
+  /**
+   * \brief Function for returning the number of pre-tabulated fading values per state
+   * \return number of pre-tabulated fading values
+   */
+  uint32_t GetPreTabulationLength ();
+
+  /**
+   * \brief Function for getting whether the parameter set updates are decoupled
+   * from the state change evaluation
+   * \return are the parameter set updates decoupled or not
+   */
+  bool AreSetUpdatesDecoupled ();
+
+  /**
+   * \brief Function for returning the interval of the periodic parameter set updates
+   * \return update interval
+   */
+  Time GetSetUpdateInterval ();
+
   /**
    *  \brief Do needed dispose actions.
    */
@@ -167,6 +222,11 @@ private:
    */
   std::vector<std::vector<std::vector<double> > > m_markovProbabilities;
 
+  /**
+   * \brief Precomputed Markov state change tables, one per parameter set
+   */
+  std::vector<Ptr<const SatMarkovTransitionTable> > m_transitionTables;
+
   /**
    * \brief Initial Markov state probabilities
    */
@@ -192,6 +252,36 @@ private:
    */
   bool m_useDecibels;
 
+  /**
+   * \brief Defines whether the uplink fading is calculated by the uplink fader or by the downlink fader
+   */
+  bool m_useUplinkFader;
+
+  /**
+   * \brief Defines whether the fading values are pre-tabulated or calculated on each request
+   */
+  bool m_usePreTabulatedFading;
+
+  /**
+   * \brief Time step of the pre-tabulated fading values
+   */
+  Time m_preTabulationStep;
+
+  /**
+   * \brief Number of pre-tabulated fading values per state
+   */
+  uint32_t m_preTabulationLength;
+
+  /**
+   * \brief Defines whether the parameter set updates are decoupled from the state change evaluation
+   */
+  bool m_decoupledSetUpdates;
+
+  /**
+   * \brief Interval of the periodic parameter set updates
+   */
+  Time m_setUpdateInterval;
+
   /**
    * \brief Loo configuration
    */
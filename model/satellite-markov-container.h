@@ -20,25 +20,24 @@
 #ifndef SATELLITE_MARKOV_CONTAINER_H
 #define SATELLITE_MARKOV_CONTAINER_H
 
-#include "satellite-markov-model.h"
 #include "satellite-markov-conf.h"
-#include "geo-coordinate.h"
-#include "ns3/vector.h"
+#include "satellite-markov-fading-manager.h"
 #include "satellite-base-fading.h"
-#include "satellite-loo-model.h"
-#include "satellite-rayleigh-model.h"
 #include "ns3/traced-callback.h"
 
 namespace ns3 {
 
+class SatMobilityObserver;
+
 /**
  * \ingroup satellite
  *
- * \brief Container for Markov-model. This class contains the
- * Markov-model state machines and implements the fading interface.
- * The class implements, e.g., the state machine selection and
- * contains the logic for deciding when the new fading value will
- * be calculated and state change evaluation should happen.
+ * \brief Container for Markov-model. This class implements the fading
+ * interface for one terminal. The Markov-model state machines, the faders
+ * and the logic for deciding when the new fading value will be calculated
+ * and state change evaluation should happen are in SatMarkovFadingManager,
+ * which holds the state of all the terminals sharing the same
+ * configuration. This class is a handle to one terminal of the manager.
  */
 class SatMarkovContainer : public SatBaseFading
 {
@@ -62,6 +61,14 @@ public:
    */
   SatMarkovContainer (Ptr<SatMarkovConf> markovConf, SatBaseFading::ElevationCallback elevation, SatBaseFading::VelocityCallback velocity);
 
+  /**
+   * \brief Constructor of a terminal of a shared fading manager
+   * \param manager Markov fading manager.
+   * \param elevation Elevation angle callback.
+   * \param velocity Velocity callback.
+   */
+  SatMarkovContainer (Ptr<SatMarkovFadingManager> manager, SatBaseFading::ElevationCallback elevation, SatBaseFading::VelocityCallback velocity);
+
   /**
    * \brief Destructor
    */
@@ -85,6 +92,14 @@ public:
    */
   double DoGetFading (Address macAddress, SatEnums::ChannelType_t channeltype);
 
+  /**
+   * \brief Listener for the mobility changes of the terminal, updating the
+   * parameter set of the terminal from its new elevation when the parameter
+   * set updates are decoupled from the fading requests
+   * \param observer mobility observer of the terminal
+   */
+  void MobilityChanged (Ptr<const SatMobilityObserver> observer);
+
   /**
    * \brief Function for unlocking the parameter set and state
    */
@@ -126,104 +141,14 @@ public:
 
 private:
   /**
-   * \brief Markov model object
-   */
-  Ptr<SatMarkovModel> m_markovModel;
-
-  /**
-   * \brief Markoc model configuration
-   */
-  Ptr<SatMarkovConf> m_markovConf;
-
-  /**
-   * \brief Uplink fader
-   */
-  Ptr<SatBaseFader> m_fader_up;
-
-  /**
-   * \brief Downlink fader
-   */
-  Ptr<SatBaseFader> m_fader_down;
-
-  /**
-   * \brief Number of states available
-   */
-  uint32_t m_numOfStates;
-
-  /**
-   * \brief Number of parameter sets available
-   */
-  uint32_t m_numOfSets;
-
-  /**
-   * \brief Current parameter set
-   */
-  uint32_t m_currentSet;
-
-  /**
-   * \brief Current state
-   */
-  uint32_t m_currentState;
-
-  /**
-   * \brief Cooldown period length in time
+   * \brief Manager holding the fading state of the terminal
    */
-  Time m_cooldownPeriodLength;
+  Ptr<SatMarkovFadingManager> m_manager;
 
   /**
-   * \brief Minimum state change distance in meters
+   * \brief Id of the terminal in the manager
    */
-  double m_minimumPositionChangeInMeters;
-
-  /**
-   * \brief Latest calculated uplink fading value
-   */
-  double m_latestCalculatedFadingValue_up;
-
-  /**
-   * \brief Latest calculated downlink fading value
-   */
-  double m_latestCalculatedFadingValue_down;
-
-  /**
-   * \brief Latest calculation time for uplink fading value
-   */
-  Time m_latestCalculationTime_up;
-
-  /**
-   * \brief Latest calculation time for downlink fading value
-   */
-  Time m_latestCalculationTime_down;
-
-  /**
-   * \brief Variable for disabling the parameter set change
-   */
-  bool m_enableSetLock;
-
-  /**
-   * \brief Variable for disabling state changes
-   */
-  bool m_enableStateLock;
-
-  /**
-   * \brief Node movement velocity
-   */
-  VelocityCallback m_velocity;
-
-  /**
-   * \brief Latest calculation time for state change
-   */
-  Time m_latestStateChangeTime;
-
-  /**
-   * \brief Current elevation value
-   */
-  ElevationCallback m_currentElevation;
-
-  /**
-   * \brief Defines whether the calculations should return the fading value in decibels or not
-   */
-  bool m_useDecibels;
+  uint32_t m_terminal;
 
   /**
    * \brief Fading trace function
@@ -233,60 +158,6 @@ private:
                   double                      // fading value
                   >
   m_fadingTrace;
-
-  /**
-   * \brief Function for updating the state change probabilities
-   * \param set parameter set
-   */
-  void UpdateProbabilities (uint32_t set);
-
-  /**
-   * \brief Function for evaluating state change
-   */
-  void EvaluateStateChange (SatEnums::ChannelType_t channelType);
-
-  /**
-   * \brief Function for calculating the fading value
-   * \param channelType channel type
-   * \return fading value
-   */
-  double CalculateFading (SatEnums::ChannelType_t channelType);
-
-  /**
-   * \brief Function for calculating the elevation
-   * \return elevation value
-   */
-  double CalculateElevation ();
-
-  /**
-   * \brief Function for checking whether the cooldown period has passed
-   * \param channelType channel type
-   * \return has cooldown period passed
-   */
-  bool HasCooldownPeriodPassed (SatEnums::ChannelType_t channelType);
-
-  /**
-   * \brief Function for getting the cached fading values
-   * \param channelType channel type
-   * \return cached fading value
-   */
-  double GetCachedFadingValue (SatEnums::ChannelType_t channelType);
-
-  /**
-   * \brief Function for creating the Markov state faders
-   */
-  void CreateFaders (SatMarkovConf::MarkovFaderType_t faderType);
-
-  /**
-   * \brief Function for calculating the distance since latest state change position
-   * \return distance
-   */
-  double CalculateDistanceSinceLastStateChange ();
-
-  /**
-   * \brief Clear used variables
-   */
-  void Reset ();
 };
 
 } // namespace ns3
@@ -0,0 +1,979 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "satellite-markov-fading-manager.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatMarkovFadingManager);
+NS_LOG_COMPONENT_DEFINE ("SatMarkovFadingManager");
+
+TypeId
+SatMarkovFadingManager::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatMarkovFadingManager")
+    .SetParent<Object> ()
+    .AddConstructor<SatMarkovFadingManager> ();
+  return tid;
+}
+
+SatMarkovFadingManager::SatMarkovFadingManager ()
+  : m_markovConf (NULL),
+  m_faderType (SatMarkovConf::LOO_FADER),
+  m_numOfStates (0),
+  m_numOfSets (0),
+  m_numOfGroups (0),
+  m_initialState (0),
+  m_cooldownPeriodLength (),
+  m_minimumPositionChangeInMeters (0.0),
+  m_useDecibels (false),
+  m_useUplinkFader (false),
+  m_useOscillatorBank (false),
+  m_usePreTabulatedFading (false),
+  m_preTabulationStep (0.0),
+  m_preTabulationLength (0),
+  m_decoupledSetUpdates (false),
+  m_setUpdateInterval (),
+  m_directCapacityPerFader (0),
+  m_multipathCapacityPerFader (0)
+{
+  NS_LOG_FUNCTION (this);
+  NS_FATAL_ERROR ("SatMarkovFadingManager::SatMarkovFadingManager - Constructor not in use");
+}
+
+SatMarkovFadingManager::SatMarkovFadingManager (Ptr<SatMarkovConf> markovConf)
+  : m_markovConf (markovConf),
+  m_faderType (markovConf->GetFaderType ()),
+  m_numOfStates (markovConf->GetStateCount ()),
+  m_numOfSets (markovConf->GetNumOfSets ()),
+  m_numOfGroups (0),
+  m_initialState (markovConf->GetInitialState ()),
+  m_cooldownPeriodLength (markovConf->GetCooldownPeriod ()),
+  m_minimumPositionChangeInMeters (markovConf->GetMinimumPositionChange ()),
+  m_useDecibels (markovConf->AreDecibelsUsed ()),
+  m_useUplinkFader (markovConf->IsUplinkFaderUsed ()),
+  m_useOscillatorBank (false),
+  m_usePreTabulatedFading (markovConf->IsPreTabulatedFadingUsed ()),
+  m_preTabulationStep (markovConf->GetPreTabulationStep ().GetSeconds ()),
+  m_preTabulationLength (markovConf->GetPreTabulationLength ()),
+  m_decoupledSetUpdates (markovConf->AreSetUpdatesDecoupled ()),
+  m_setUpdateInterval (markovConf->GetSetUpdateInterval ()),
+  m_directCapacityPerFader (0),
+  m_multipathCapacityPerFader (0)
+{
+  NS_LOG_FUNCTION (this);
+
+  for (uint32_t set = 0; set < m_numOfSets; set++)
+    {
+      m_transitionTables.push_back (m_markovConf->GetTransitionTable (set));
+    }
+
+  switch (m_faderType)
+    {
+    case SatMarkovConf::LOO_FADER:
+      {
+        m_useOscillatorBank = m_markovConf->GetLooConf ()->GetUseOscillatorBank ();
+        m_numOfGroups = m_numOfStates;
+
+        for (uint32_t set = 0; set < m_numOfSets; set++)
+          {
+            m_faderParameters.push_back (m_markovConf->GetLooConf ()->GetParameters (set));
+          }
+        break;
+      }
+    case SatMarkovConf::RAYLEIGH_FADER:
+      {
+        m_useOscillatorBank = m_markovConf->GetRayleighConf ()->GetUseOscillatorBank ();
+        m_numOfGroups = 1;
+
+        for (uint32_t set = 0; set < m_numOfSets; set++)
+          {
+            m_faderParameters.push_back (m_markovConf->GetRayleighConf ()->GetParameters (set));
+          }
+        break;
+      }
+    default:
+      {
+        NS_FATAL_ERROR ("SatMarkovFadingManager::SatMarkovFadingManager - Invalid fader type");
+      }
+    }
+
+  CalculateCapacities ();
+
+  NS_LOG_INFO ("Creating SatMarkovFadingManager, States: " << m_numOfStates <<
+               " Sets: " << m_numOfSets <<
+               " Direct signal oscillators per fader: " << m_directCapacityPerFader <<
+               " Multipath oscillators per fader: " << m_multipathCapacityPerFader);
+}
+
+SatMarkovFadingManager::~SatMarkovFadingManager ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SatMarkovFadingManager::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_setUpdateEvent.Cancel ();
+
+  m_markovConf = NULL;
+  m_transitionTables.clear ();
+
+  m_elevation.clear ();
+  m_velocity.clear ();
+  m_normalRandomVariable.clear ();
+  m_uniformVariable.clear ();
+  m_directOscillatorBanks.clear ();
+  m_multipathOscillatorBanks.clear ();
+
+  Object::DoDispose ();
+}
+
+void
+SatMarkovFadingManager::CalculateCapacities ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_directCapacity.assign (m_numOfGroups, 0);
+  m_multipathCapacity.assign (m_numOfGroups, 0);
+
+  for (uint32_t set = 0; set < m_numOfSets; set++)
+    {
+      for (uint32_t group = 0; group < m_numOfGroups; group++)
+        {
+          const std::vector<double>& parameters = m_faderParameters[set][group];
+          double directCount = 0.0;
+          double multipathCount = 0.0;
+
+          if (m_faderType == SatMarkovConf::LOO_FADER)
+            {
+              directCount = parameters[3];
+              multipathCount = parameters[4];
+            }
+          else
+            {
+              multipathCount = parameters[1];
+            }
+
+          uint32_t direct = (uint32_t) std::ceil (std::max (directCount, 0.0));
+          uint32_t multipath = (uint32_t) std::ceil (std::max (multipathCount, 0.0));
+
+          m_directCapacity[group] = std::max (m_directCapacity[group], direct);
+          m_multipathCapacity[group] = std::max (m_multipathCapacity[group], multipath);
+        }
+    }
+
+  m_directOffset.resize (m_numOfGroups);
+  m_multipathOffset.resize (m_numOfGroups);
+  m_directCapacityPerFader = 0;
+  m_multipathCapacityPerFader = 0;
+
+  for (uint32_t group = 0; group < m_numOfGroups; group++)
+    {
+      m_directOffset[group] = m_directCapacityPerFader;
+      m_multipathOffset[group] = m_multipathCapacityPerFader;
+      m_directCapacityPerFader += m_directCapacity[group];
+      m_multipathCapacityPerFader += m_multipathCapacity[group];
+    }
+}
+
+uint32_t
+SatMarkovFadingManager::AddTerminal (SatBaseFading::ElevationCallback elevation, SatBaseFading::VelocityCallback velocity)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t terminal = m_elevation.size ();
+  uint32_t faders = 2 * (terminal + 1);
+  uint32_t groups = faders * m_numOfGroups;
+
+  m_elevation.push_back (elevation);
+  m_velocity.push_back (velocity);
+  m_currentState.push_back (m_initialState);
+  m_markovState.push_back (m_initialState);
+  m_currentSetLowerElevation.push_back (NAN);
+  m_currentSetUpperElevation.push_back (NAN);
+  m_latestStateChangeTime.push_back (Now ());
+  m_enableSetLock.push_back (false);
+  m_enableStateLock.push_back (false);
+
+  m_latestCalculatedFadingValue.resize (faders, 0.0);
+  m_latestCalculationTime.resize (faders, Now ());
+  m_faderSet.resize (faders, 0);
+  m_faderState.resize (faders, 0);
+  m_normalRandomVariable.resize (faders);
+  m_uniformVariable.resize (faders);
+
+  m_directCount.resize (groups, 0);
+  m_directPhase.resize (groups, 0.0);
+  m_multipathCount.resize (groups, 0);
+  m_multipathPhase.resize (groups, 0.0);
+  m_sigma.resize (groups, 0.0);
+
+  if (m_useOscillatorBank)
+    {
+      m_directOscillatorBanks.resize (groups);
+      m_multipathOscillatorBanks.resize (groups);
+    }
+  else
+    {
+      m_directAmplitude.resize (faders * m_directCapacityPerFader, 0.0);
+      m_directOmega.resize (faders * m_directCapacityPerFader, 0.0);
+      m_multipathAmplitude.resize (faders * m_multipathCapacityPerFader);
+      m_multipathOmega.resize (faders * m_multipathCapacityPerFader, 0.0);
+    }
+
+  if (m_usePreTabulatedFading)
+    {
+      m_tableValues.resize (faders * m_numOfStates);
+      m_tableStartTime.resize (faders * m_numOfStates, 0.0);
+      m_tableValid.resize (faders * m_numOfStates, false);
+    }
+
+  /// initialize Markov model
+  m_currentSet.push_back (0);
+  m_currentSet[terminal] = GetProbabilitySetID (terminal, elevation ());
+  m_activeSet.push_back (m_currentSet[terminal]);
+  DoTransition (terminal);
+
+  if (m_decoupledSetUpdates && !m_setUpdateInterval.IsZero () && !m_setUpdateEvent.IsRunning ())
+    {
+      m_setUpdateEvent = Simulator::Schedule (m_setUpdateInterval, &SatMarkovFadingManager::UpdateActiveSets, this);
+    }
+
+  /// create faders
+  CreateFader (2 * terminal + UP_FADER, m_currentSet[terminal], m_currentState[terminal]);
+  CreateFader (2 * terminal + DOWN_FADER, m_currentSet[terminal], m_currentState[terminal]);
+
+  /// initialize fading values
+  CalculateFading (terminal, SatEnums::RETURN_USER_CH);
+  CalculateFading (terminal, SatEnums::FORWARD_USER_CH);
+
+  NS_LOG_INFO ("Added terminal " << terminal <<
+               " Elevation: " << elevation () <<
+               " Current Set ID: " << m_currentSet[terminal] <<
+               " Cool down Period Length In Seconds: " << m_cooldownPeriodLength.GetSeconds () <<
+               " Minimum Position Change In Meters: " << m_minimumPositionChangeInMeters);
+
+  return terminal;
+}
+
+void
+SatMarkovFadingManager::ReleaseTerminal (uint32_t terminal)
+{
+  NS_LOG_FUNCTION (this << terminal);
+
+  if (terminal >= m_elevation.size ())
+    {
+      return;
+    }
+
+  m_elevation[terminal].Nullify ();
+  m_velocity[terminal].Nullify ();
+
+  for (uint32_t fader = 2 * terminal; fader < 2 * terminal + 2; fader++)
+    {
+      m_normalRandomVariable[fader] = NULL;
+      m_uniformVariable[fader] = NULL;
+
+      if (m_useOscillatorBank)
+        {
+          for (uint32_t group = fader * m_numOfGroups; group < (fader + 1) * m_numOfGroups; group++)
+            {
+              m_directOscillatorBanks[group] = NULL;
+              m_multipathOscillatorBanks[group] = NULL;
+            }
+        }
+
+      if (m_usePreTabulatedFading)
+        {
+          for (uint32_t row = fader * m_numOfStates; row < (fader + 1) * m_numOfStates; row++)
+            {
+              std::vector<double> ().swap (m_tableValues[row]);
+              m_tableValid[row] = false;
+            }
+        }
+    }
+}
+
+uint32_t
+SatMarkovFadingManager::GetNTerminals () const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_elevation.size ();
+}
+
+void
+SatMarkovFadingManager::UpdateActiveSet (uint32_t terminal)
+{
+  NS_LOG_FUNCTION (this << terminal);
+
+  if (!m_decoupledSetUpdates || m_elevation[terminal].IsNull ())
+    {
+      return;
+    }
+
+  double elevation = m_elevation[terminal] ();
+
+  /// the cached elevation range is the one of the active set
+  if ( !(m_currentSetLowerElevation[terminal] < elevation && elevation < m_currentSetUpperElevation[terminal]) )
+    {
+      m_activeSet[terminal] = m_markovConf->GetProbabilitySetID (elevation, m_currentSetLowerElevation[terminal], m_currentSetUpperElevation[terminal]);
+    }
+}
+
+void
+SatMarkovFadingManager::UpdateActiveSets ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (uint32_t terminal = 0; terminal < m_elevation.size (); terminal++)
+    {
+      UpdateActiveSet (terminal);
+    }
+
+  m_setUpdateEvent = Simulator::Schedule (m_setUpdateInterval, &SatMarkovFadingManager::UpdateActiveSets, this);
+}
+
+uint32_t
+SatMarkovFadingManager::GetFader (uint32_t terminal, SatEnums::ChannelType_t channelType) const
+{
+  switch (channelType)
+    {
+    case SatEnums::RETURN_USER_CH:
+    case SatEnums::FORWARD_FEEDER_CH:
+      {
+        return 2 * terminal + UP_FADER;
+      }
+    case SatEnums::FORWARD_USER_CH:
+    case SatEnums::RETURN_FEEDER_CH:
+      {
+        return 2 * terminal + DOWN_FADER;
+      }
+    default:
+      {
+        NS_FATAL_ERROR ("SatMarkovFadingManager::GetFader - Invalid channel type");
+      }
+    }
+  return 0;
+}
+
+uint32_t
+SatMarkovFadingManager::GetGroup (uint32_t fader, uint32_t state) const
+{
+  if (m_faderType == SatMarkovConf::LOO_FADER)
+    {
+      return fader * m_numOfGroups + state;
+    }
+  return fader;
+}
+
+void
+SatMarkovFadingManager::CreateFader (uint32_t fader, uint32_t set, uint32_t state)
+{
+  NS_LOG_FUNCTION (this << fader << set << state);
+
+  m_faderSet[fader] = set;
+  m_faderState[fader] = state;
+
+  if (m_faderType == SatMarkovConf::LOO_FADER)
+    {
+      m_normalRandomVariable[fader] = CreateObject<NormalRandomVariable> ();
+    }
+  m_uniformVariable[fader] = CreateObject<UniformRandomVariable> ();
+  m_uniformVariable[fader]->SetAttribute ("Min", DoubleValue (-1.0 * M_PI));
+  m_uniformVariable[fader]->SetAttribute ("Max", DoubleValue (M_PI));
+
+  if (m_faderType == SatMarkovConf::LOO_FADER)
+    {
+      ConstructLooOscillators (fader, set);
+    }
+  else
+    {
+      ConstructRayleighOscillators (fader, set);
+    }
+}
+
+void
+SatMarkovFadingManager::UpdateFaderParameters (uint32_t fader, uint32_t set, uint32_t state)
+{
+  NS_LOG_FUNCTION (this << fader << set << state);
+
+  /// Loo faders reconstruct their oscillators on set change, Rayleigh faders
+  /// keep the oscillators of their initial set
+  if (m_faderType == SatMarkovConf::LOO_FADER && m_faderSet[fader] != set)
+    {
+      ConstructLooOscillators (fader, set);
+      InvalidateFadingTables (fader);
+    }
+
+  m_faderSet[fader] = set;
+  m_faderState[fader] = state;
+}
+
+void
+SatMarkovFadingManager::ConstructLooOscillators (uint32_t fader, uint32_t set)
+{
+  NS_LOG_FUNCTION (this << fader << set);
+
+  const std::vector<std::vector<double> >& parameters = m_faderParameters[set];
+  Ptr<NormalRandomVariable> normal = m_normalRandomVariable[fader];
+  Ptr<UniformRandomVariable> uniform = m_uniformVariable[fader];
+
+  /// direct signal oscillators of all the states
+  for (uint32_t i = 0; i < m_numOfStates; i++)
+    {
+      uint32_t group = GetGroup (fader, i);
+      uint32_t offset = fader * m_directCapacityPerFader + m_directOffset[i];
+
+      if (m_useOscillatorBank)
+        {
+          m_directOscillatorBanks[group] = CreateObject<SatFadingOscillatorBank> ();
+        }
+
+      /// Initial phase is common for all oscillators:
+      double phi = uniform->GetValue ();
+      /// Theta is common for all oscillators:
+      double theta = uniform->GetValue ();
+      uint32_t j = 0;
+      for (; j < parameters[i][3]; j++)
+        {
+          uint32_t n = j + 1;
+          double alpha = (2.0 * M_PI * n - M_PI + theta) / (4.0 * parameters[i][3]);
+          double omega = 2.0 * M_PI * parameters[i][5] * std::cos (alpha);
+          double amplitude = normal->GetValue (parameters[i][0], parameters[i][1]);
+          amplitude = pow (10, amplitude / 10) / parameters[i][3];
+
+          if (m_useOscillatorBank)
+            {
+              m_directOscillatorBanks[group]->AddOscillator (amplitude, phi, omega);
+            }
+          else
+            {
+              m_directAmplitude[offset + j] = amplitude;
+              m_directOmega[offset + j] = omega;
+            }
+        }
+      m_directCount[group] = j;
+      m_directPhase[group] = phi;
+    }
+
+  /// multipath oscillators of all the states
+  for (uint32_t i = 0; i < m_numOfStates; i++)
+    {
+      uint32_t group = GetGroup (fader, i);
+      uint32_t offset = fader * m_multipathCapacityPerFader + m_multipathOffset[i];
+
+      if (m_useOscillatorBank)
+        {
+          m_multipathOscillatorBanks[group] = CreateObject<SatFadingOscillatorBank> ();
+        }
+
+      /// Initial phase is common for all oscillators:
+      double phi = uniform->GetValue ();
+      /// Theta is common for all oscillators:
+      double theta = uniform->GetValue ();
+      uint32_t j = 0;
+      for (; j < parameters[i][4]; j++)
+        {
+          uint32_t n = j + 1;
+          double alpha = (2.0 * M_PI * n - M_PI + theta) / (4.0 * parameters[i][4]);
+          double omega = 2.0 * M_PI * parameters[i][6] * std::cos (alpha);
+          double psi = normal->GetValue ();
+          std::complex<double> amplitude = std::complex<double> (std::cos (psi), std::sin (psi)) * 2.0 / std::sqrt (parameters[i][4]);
+
+          if (m_useOscillatorBank)
+            {
+              m_multipathOscillatorBanks[group]->AddOscillator (amplitude, phi, omega);
+            }
+          else
+            {
+              m_multipathAmplitude[offset + j] = amplitude;
+              m_multipathOmega[offset + j] = omega;
+            }
+        }
+      m_multipathCount[group] = j;
+      m_multipathPhase[group] = phi;
+    }
+
+  for (uint32_t i = 0; i < m_numOfStates; i++)
+    {
+      m_sigma[GetGroup (fader, i)] = sqrt (0.5 * pow (10, (parameters[i][2] / 10)));
+    }
+}
+
+void
+SatMarkovFadingManager::ConstructRayleighOscillators (uint32_t fader, uint32_t set)
+{
+  NS_LOG_FUNCTION (this << fader << set);
+
+  const std::vector<std::vector<double> >& parameters = m_faderParameters[set];
+  Ptr<UniformRandomVariable> uniform = m_uniformVariable[fader];
+  uint32_t group = GetGroup (fader, 0);
+  uint32_t offset = fader * m_multipathCapacityPerFader;
+
+  if (m_useOscillatorBank)
+    {
+      m_multipathOscillatorBanks[group] = CreateObject<SatFadingOscillatorBank> ();
+    }
+
+  ///Initial phase is common for all oscillators:
+  double phi = uniform->GetValue ();
+  /// Theta is common for all oscillators:
+  double theta = uniform->GetValue ();
+  uint32_t i = 0;
+  for (; i < parameters[0][1]; i++)
+    {
+      uint32_t n = i + 1;
+      double alpha = (2.0 * M_PI * n - M_PI + theta) / (4.0 * parameters[0][1]);
+      double omega = 2.0 * parameters[0][0] * M_PI * std::cos (alpha);
+      double psi = uniform->GetValue ();
+      std::complex<double> amplitude = std::complex<double> (std::cos (psi), std::sin (psi)) * 2.0 / std::sqrt (parameters[0][1]);
+
+      if (m_useOscillatorBank)
+        {
+          m_multipathOscillatorBanks[group]->AddOscillator (amplitude, phi, omega);
+        }
+      else
+        {
+          m_multipathAmplitude[offset + i] = amplitude;
+          m_multipathOmega[offset + i] = omega;
+        }
+    }
+  m_multipathCount[group] = i;
+  m_multipathPhase[group] = phi;
+}
+
+double
+SatMarkovFadingManager::CalculateLooChannelGain (uint32_t group, double timeInSeconds)
+{
+  NS_LOG_FUNCTION (this << group << timeInSeconds);
+
+  std::complex<double> directComplexGain (0, 0);
+  std::complex<double> multipathComplexGain (0, 0);
+
+  if (m_useOscillatorBank)
+    {
+      directComplexGain = m_directOscillatorBanks[group]->GetCosineWaveSumAt (timeInSeconds);
+      multipathComplexGain = m_multipathOscillatorBanks[group]->GetComplexSumAt (timeInSeconds);
+    }
+  else
+    {
+      uint32_t state = group % m_numOfGroups;
+      uint32_t fader = group / m_numOfGroups;
+
+      const double* directAmplitude = &m_directAmplitude[fader * m_directCapacityPerFader + m_directOffset[state]];
+      const double* directOmega = &m_directOmega[fader * m_directCapacityPerFader + m_directOffset[state]];
+      double directPhase = m_directPhase[group];
+
+      for (uint32_t i = 0; i < m_directCount[group]; i++)
+        {
+          double phase = timeInSeconds * directOmega[i] + directPhase;
+          std::complex<double> complexPhase (std::cos (phase), std::sin (phase));
+          directComplexGain += directAmplitude[i] * std::exp (complexPhase);
+        }
+
+      const std::complex<double>* multipathAmplitude = &m_multipathAmplitude[fader * m_multipathCapacityPerFader + m_multipathOffset[state]];
+      const double* multipathOmega = &m_multipathOmega[fader * m_multipathCapacityPerFader + m_multipathOffset[state]];
+      double multipathPhase = m_multipathPhase[group];
+
+      for (uint32_t i = 0; i < m_multipathCount[group]; i++)
+        {
+          multipathComplexGain += multipathAmplitude[i] * std::cos (timeInSeconds * multipathOmega[i] + multipathPhase);
+        }
+    }
+  multipathComplexGain = multipathComplexGain * m_sigma[group];
+
+  /// Combining
+  std::complex<double> fadingGain = directComplexGain + multipathComplexGain;
+  return sqrt ((pow (fadingGain.real (), 2) + pow (fadingGain.imag (), 2)));
+}
+
+std::complex<double>
+SatMarkovFadingManager::CalculateRayleighComplexGain (uint32_t group, double timeInSeconds)
+{
+  NS_LOG_FUNCTION (this << group << timeInSeconds);
+
+  if (m_useOscillatorBank)
+    {
+      return m_multipathOscillatorBanks[group]->GetComplexSumAt (timeInSeconds);
+    }
+
+  const std::complex<double>* amplitude = &m_multipathAmplitude[group * m_multipathCapacityPerFader];
+  const double* omega = &m_multipathOmega[group * m_multipathCapacityPerFader];
+  double phase = m_multipathPhase[group];
+
+  std::complex<double> sumAmplitude = std::complex<double> (0, 0);
+  for (uint32_t i = 0; i < m_multipathCount[group]; i++)
+    {
+      sumAmplitude += amplitude[i] * std::cos (timeInSeconds * omega[i] + phase);
+    }
+  return sumAmplitude;
+}
+
+double
+SatMarkovFadingManager::GetChannelGain (uint32_t fader)
+{
+  NS_LOG_FUNCTION (this << fader);
+
+  uint32_t group = GetGroup (fader, m_faderState[fader]);
+  double timeInSeconds = Now ().GetSeconds ();
+
+  if (m_faderType == SatMarkovConf::LOO_FADER)
+    {
+      double channelGain = CalculateLooChannelGain (group, timeInSeconds);
+      return m_useDecibels ? 10.0 * std::log10 (channelGain) : channelGain;
+    }
+
+  std::complex<double> complexGain = CalculateRayleighComplexGain (group, timeInSeconds);
+  double channelGain = (std::pow (complexGain.real (), 2) + std::pow (complexGain.imag (), 2)) / 2;
+  return m_useDecibels ? 10 * std::log10 (channelGain) : channelGain;
+}
+
+void
+SatMarkovFadingManager::GetChannelGains (uint32_t fader, uint32_t state, double startTime, double timeStep, double* gains)
+{
+  NS_LOG_FUNCTION (this << fader << state << startTime << timeStep);
+
+  uint32_t group = GetGroup (fader, state);
+
+  if (m_faderType == SatMarkovConf::LOO_FADER)
+    {
+      if (m_useOscillatorBank)
+        {
+          std::vector<std::complex<double> > directComplexGains (m_preTabulationLength);
+          std::vector<std::complex<double> > multipathComplexGains (m_preTabulationLength);
+
+          m_directOscillatorBanks[group]->GetCosineWaveSumsAt (startTime, timeStep, directComplexGains);
+          m_multipathOscillatorBanks[group]->GetComplexSumsAt (startTime, timeStep, multipathComplexGains);
+
+          for (uint32_t k = 0; k < m_preTabulationLength; k++)
+            {
+              std::complex<double> fadingGain = directComplexGains[k] + multipathComplexGains[k] * m_sigma[group];
+              gains[k] = std::abs (fadingGain);
+            }
+        }
+      else
+        {
+          for (uint32_t k = 0; k < m_preTabulationLength; k++)
+            {
+              gains[k] = CalculateLooChannelGain (group, startTime + k * timeStep);
+            }
+        }
+    }
+  else
+    {
+      std::vector<std::complex<double> > complexGains (m_preTabulationLength);
+
+      if (m_useOscillatorBank)
+        {
+          m_multipathOscillatorBanks[group]->GetComplexSumsAt (startTime, timeStep, complexGains);
+        }
+      else
+        {
+          for (uint32_t k = 0; k < m_preTabulationLength; k++)
+            {
+              complexGains[k] = CalculateRayleighComplexGain (group, startTime + k * timeStep);
+            }
+        }
+
+      for (uint32_t k = 0; k < m_preTabulationLength; k++)
+        {
+          gains[k] = std::norm (complexGains[k]) / 2;
+        }
+    }
+}
+
+double
+SatMarkovFadingManager::GetFading (uint32_t terminal, SatEnums::ChannelType_t channelType)
+{
+  NS_LOG_FUNCTION (this << terminal << channelType);
+
+  NS_ASSERT (terminal < m_elevation.size ());
+
+  uint32_t fader = GetFader (terminal, channelType);
+
+  if (HasCooldownPeriodPassed (fader))
+    {
+      NS_LOG_INFO ("Cool down period has passed, calculating new fading value");
+
+      if (m_velocity[terminal] () > 0)
+        {
+          EvaluateStateChange (terminal);
+        }
+      return CalculateFading (terminal, channelType);
+    }
+
+  NS_LOG_INFO ("Cool down period in effect, using old fading value");
+  return m_latestCalculatedFadingValue[fader];
+}
+
+bool
+SatMarkovFadingManager::HasCooldownPeriodPassed (uint32_t fader) const
+{
+  return (Now ().GetSeconds () - m_latestCalculationTime[fader].GetSeconds ()) > m_cooldownPeriodLength.GetSeconds ();
+}
+
+void
+SatMarkovFadingManager::EvaluateStateChange (uint32_t terminal)
+{
+  NS_LOG_FUNCTION (this << terminal);
+
+  double distance = (Now ().GetSeconds () - m_latestStateChangeTime[terminal].GetSeconds ()) * m_velocity[terminal] ();
+
+  if (distance > m_minimumPositionChangeInMeters)
+    {
+      if (!m_enableSetLock[terminal])
+        {
+          uint32_t newSetId;
+
+          if (m_decoupledSetUpdates)
+            {
+              newSetId = m_activeSet[terminal];
+            }
+          else
+            {
+              newSetId = GetProbabilitySetID (terminal, m_elevation[terminal] ());
+            }
+
+          if (m_currentSet[terminal] != newSetId)
+            {
+              NS_LOG_INFO ("Terminal " << terminal << " set ID [old, new]: [" << m_currentSet[terminal] << "," << newSetId << "]");
+
+              m_currentSet[terminal] = newSetId;
+            }
+        }
+
+      if (!m_enableStateLock[terminal])
+        {
+          m_latestStateChangeTime[terminal] = Now ();
+          DoTransition (terminal);
+        }
+    }
+}
+
+void
+SatMarkovFadingManager::DoTransition (uint32_t terminal)
+{
+  NS_LOG_FUNCTION (this << terminal);
+
+  double random = std::rand () / double (RAND_MAX);
+
+  m_markovState[terminal] = m_transitionTables[m_currentSet[terminal]]->GetNextState (m_markovState[terminal], random);
+
+  NS_LOG_INFO ("Transition done, new state: " << m_markovState[terminal]);
+}
+
+uint32_t
+SatMarkovFadingManager::GetProbabilitySetID (uint32_t terminal, double elevation)
+{
+  NS_LOG_FUNCTION (this << terminal << elevation);
+
+  if ( !(m_currentSetLowerElevation[terminal] < elevation && elevation < m_currentSetUpperElevation[terminal]) )
+    {
+      return m_markovConf->GetProbabilitySetID (elevation, m_currentSetLowerElevation[terminal], m_currentSetUpperElevation[terminal]);
+    }
+
+  return m_currentSet[terminal];
+}
+
+double
+SatMarkovFadingManager::CalculateFading (uint32_t terminal, SatEnums::ChannelType_t channelType)
+{
+  NS_LOG_FUNCTION (this << terminal << channelType);
+
+  if (!m_enableStateLock[terminal])
+    {
+      m_currentState[terminal] = m_markovState[terminal];
+    }
+
+  NS_ASSERT (m_currentState[terminal] < m_numOfStates);
+
+  uint32_t fader = GetFader (terminal, channelType);
+  UpdateFaderParameters (fader, m_currentSet[terminal], m_currentState[terminal]);
+
+  /// by default, the fading value of both links is calculated by the downlink fader
+  uint32_t gainFader = m_useUplinkFader ? fader : 2 * terminal + DOWN_FADER;
+
+  if (m_usePreTabulatedFading)
+    {
+      m_latestCalculatedFadingValue[fader] = GetTabulatedFading (gainFader);
+    }
+  else
+    {
+      m_latestCalculatedFadingValue[fader] = GetChannelGain (gainFader);
+    }
+
+  NS_LOG_INFO ("Calculated fading value " << m_latestCalculatedFadingValue[fader] << " of fader " << fader);
+
+  m_latestCalculationTime[fader] = Now ();
+
+  return m_latestCalculatedFadingValue[fader];
+}
+
+double
+SatMarkovFadingManager::GetTabulatedFading (uint32_t fader)
+{
+  NS_LOG_FUNCTION (this << fader);
+
+  uint32_t state = m_faderState[fader];
+  uint32_t row = fader * m_numOfStates + state;
+  std::vector<double>& values = m_tableValues[row];
+
+  /// the table of a state is allocated the first time the state is visited
+  if (values.empty ())
+    {
+      values.resize (m_preTabulationLength, 0.0);
+    }
+
+  double timeInSeconds = Now ().GetSeconds ();
+  double position = (timeInSeconds - m_tableStartTime[row]) / m_preTabulationStep;
+
+  if (!m_tableValid[row] || position < 0.0 || position >= m_preTabulationLength - 1)
+    {
+      double startTime = std::floor (timeInSeconds / m_preTabulationStep) * m_preTabulationStep;
+
+      NS_LOG_INFO ("Filling " << m_preTabulationLength << " fading values of state " << state << " from " << startTime << " s");
+
+      GetChannelGains (fader, state, startTime, m_preTabulationStep, &values[0]);
+      m_tableStartTime[row] = startTime;
+      m_tableValid[row] = true;
+      position = (timeInSeconds - startTime) / m_preTabulationStep;
+    }
+
+  uint32_t index = std::min ((uint32_t) position, m_preTabulationLength - 2);
+  double fraction = position - index;
+
+  /// values are tabulated and interpolated in linear units
+  double channelGain = values[index] + fraction * (values[index + 1] - values[index]);
+  return m_useDecibels ? 10.0 * std::log10 (channelGain) : channelGain;
+}
+
+void
+SatMarkovFadingManager::InvalidateFadingTables (uint32_t fader)
+{
+  NS_LOG_FUNCTION (this << fader);
+
+  if (m_usePreTabulatedFading)
+    {
+      uint32_t first = fader * m_numOfStates;
+      std::fill (m_tableValid.begin () + first, m_tableValid.begin () + first + m_numOfStates, false);
+    }
+}
+
+void
+SatMarkovFadingManager::LockToSetAndState (uint32_t terminal, uint32_t newSet, uint32_t newState)
+{
+  NS_LOG_FUNCTION (this << terminal << newSet << newState);
+
+  if (newState >= m_numOfStates)
+    {
+      NS_FATAL_ERROR ("SatMarkovFadingManager::LockToSetAndState - Invalid state");
+    }
+  if (newSet >= m_numOfSets)
+    {
+      NS_FATAL_ERROR ("SatMarkovFadingManager::LockToSetAndState - Invalid set");
+    }
+
+  m_currentSet[terminal] = newSet;
+  m_currentState[terminal] = newState;
+  m_currentSetLowerElevation[terminal] = NAN;
+  m_currentSetUpperElevation[terminal] = NAN;
+
+  m_enableSetLock[terminal] = true;
+  m_enableStateLock[terminal] = true;
+}
+
+void
+SatMarkovFadingManager::LockToSet (uint32_t terminal, uint32_t newSet)
+{
+  NS_LOG_FUNCTION (this << terminal << newSet);
+
+  if (newSet >= m_numOfSets)
+    {
+      NS_FATAL_ERROR ("SatMarkovFadingManager::LockToSet - Invalid set");
+    }
+
+  m_currentSet[terminal] = newSet;
+  m_currentSetLowerElevation[terminal] = NAN;
+  m_currentSetUpperElevation[terminal] = NAN;
+
+  m_enableSetLock[terminal] = true;
+  m_enableStateLock[terminal] = false;
+}
+
+void
+SatMarkovFadingManager::RandomizeLockedSetAndState (uint32_t terminal)
+{
+  NS_LOG_FUNCTION (this << terminal);
+
+  uint32_t newSet = 0;
+  uint32_t newState = 0;
+
+  if (m_numOfSets > 1)
+    {
+      newSet = (rand () % (m_numOfSets - 1));
+    }
+
+  if (m_numOfStates > 1)
+    {
+      newState = (rand () % (m_numOfStates - 1));
+    }
+
+  LockToSetAndState (terminal, newSet, newState);
+}
+
+void
+SatMarkovFadingManager::RandomizeLockedState (uint32_t terminal, uint32_t set)
+{
+  NS_LOG_FUNCTION (this << terminal << set);
+
+  LockToSet (terminal, set);
+
+  uint32_t newState = 0;
+
+  if (m_numOfStates > 1)
+    {
+      newState = (rand () % (m_numOfStates - 1));
+    }
+
+  m_currentState[terminal] = newState;
+
+  m_enableStateLock[terminal] = true;
+}
+
+void
+SatMarkovFadingManager::UnlockSetAndState (uint32_t terminal)
+{
+  NS_LOG_FUNCTION (this << terminal);
+
+  m_enableSetLock[terminal] = false;
+  m_enableStateLock[terminal] = false;
+}
+
+} // namespace ns3
@@ -0,0 +1,530 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SATELLITE_MARKOV_FADING_MANAGER_H
+#define SATELLITE_MARKOV_FADING_MANAGER_H
+
+#include <vector>
+#include <complex>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/random-variable-stream.h"
+#include "satellite-base-fading.h"
+#include "satellite-markov-conf.h"
+#include "satellite-fading-oscillator-bank.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * \brief Manager of the Markov-fading state of a set of terminals sharing
+ * the same Markov configuration. The state of all the terminals is stored
+ * in contiguous arrays indexed by terminal id: the Markov chain state, the
+ * cached fading values, the oscillators of the Loo or Rayleigh faders and
+ * the pre-tabulated fading values. SatMarkovContainer is a thin handle to
+ * one terminal of the manager.
+ *
+ * Each terminal has an uplink and a downlink fader, stored at fader index
+ * 2 * terminal and 2 * terminal + 1. The oscillators of a fader are grouped
+ * by state for Loo faders, and in one group for Rayleigh faders. Each group
+ * has a fixed capacity covering all the parameter sets, so that the arrays
+ * are not reallocated on parameter set changes.
+ *
+ * The parameter set of a terminal is resolved from its elevation either on
+ * each state change evaluation, or, when SatMarkovConf::DecoupledSetUpdates
+ * is enabled, on mobility changes (UpdateActiveSet) and periodically. In the
+ * latter case the state change evaluation only reads the active set.
+ *
+ * The random variables and the calls to the random number generator are
+ * the same, and done in the same order, as with one Markov model and two
+ * fader objects per terminal, so the fading values are identical for a
+ * fixed seed. As with these fader objects, the fading of both links is
+ * calculated by the downlink fader, the uplink requests only updating the
+ * parameter set and state of the uplink fader, unless
+ * SatMarkovConf::UseUplinkFader is enabled.
+ */
+class SatMarkovFadingManager : public Object
+{
+public:
+  /**
+   * \brief NS-3 function for type id
+   * \return type id
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Constructor
+   */
+  SatMarkovFadingManager ();
+
+  /**
+   * \brief Constructor
+   * \param markovConf Markov configuration object.
+   */
+  SatMarkovFadingManager (Ptr<SatMarkovConf> markovConf);
+
+  /**
+   * \brief Destructor
+   */
+  ~SatMarkovFadingManager ();
+
+  /**
+   *  \brief Do needed dispose actions.
+   */
+  void DoDispose ();
+
+  /**
+   * \brief Function for adding a terminal, initializing its Markov model
+   * and faders
+   * \param elevation Elevation angle callback.
+   * \param velocity Velocity callback.
+   * \return terminal id
+   */
+  uint32_t AddTerminal (SatBaseFading::ElevationCallback elevation, SatBaseFading::VelocityCallback velocity);
+
+  /**
+   * \brief Function for releasing the callbacks and random variables of a
+   * terminal which is not used anymore
+   * \param terminal terminal id
+   */
+  void ReleaseTerminal (uint32_t terminal);
+
+  /**
+   * \brief Function for getting the number of terminals
+   * \return number of terminals
+   */
+  uint32_t GetNTerminals () const;
+
+  /**
+   * \brief Function for updating the active parameter set of a terminal from
+   * its current elevation, when the parameter set updates are decoupled from
+   * the state change evaluation. Called on mobility changes.
+   * \param terminal terminal id
+   */
+  void UpdateActiveSet (uint32_t terminal);
+
+  /**
+   * \brief Function for getting the fading of a terminal, see
+   * SatMarkovContainer::DoGetFading
+   * \param terminal terminal id
+   * \param channelType channel type
+   * \return fading value
+   */
+  double GetFading (uint32_t terminal, SatEnums::ChannelType_t channelType);
+
+  /**
+   * \brief Function for unlocking the parameter set and state of a terminal
+   * \param terminal terminal id
+   */
+  void UnlockSetAndState (uint32_t terminal);
+
+  /**
+   * \brief Function for locking the parameter set and state of a terminal
+   * \param terminal terminal id
+   * \param newSet new set
+   * \param newState new state
+   */
+  void LockToSetAndState (uint32_t terminal, uint32_t newSet, uint32_t newState);
+
+  /**
+   * \brief Function for locking the parameter set of a terminal
+   * \param terminal terminal id
+   * \param newSet new set
+   */
+  void LockToSet (uint32_t terminal, uint32_t newSet);
+
+  /**
+   * \brief Function for locking the parameter set and state of a terminal to random values
+   * \param terminal terminal id
+   */
+  void RandomizeLockedSetAndState (uint32_t terminal);
+
+  /**
+   * \brief Function for locking the state of a terminal to random value. The
+   * set will be locked to the value provided by the parameter
+   * \param terminal terminal id
+   * \param set The value for set
+   */
+  void RandomizeLockedState (uint32_t terminal, uint32_t set);
+
+private:
+  /**
+   * \brief Index of the uplink fader of a terminal
+   */
+  static const uint32_t UP_FADER = 0;
+
+  /**
+   * \brief Index of the downlink fader of a terminal
+   */
+  static const uint32_t DOWN_FADER = 1;
+
+  /**
+   * \brief Function for getting the fader of a terminal matching the channel type
+   * \param terminal terminal id
+   * \param channelType channel type
+   * \return fader index
+   */
+  uint32_t GetFader (uint32_t terminal, SatEnums::ChannelType_t channelType) const;
+
+  /**
+   * \brief Function for getting the oscillator group of a fader for a state
+   * \param fader fader index
+   * \param state state
+   * \return oscillator group index
+   */
+  uint32_t GetGroup (uint32_t fader, uint32_t state) const;
+
+  /**
+   * \brief Function for computing the oscillator capacities of the groups
+   */
+  void CalculateCapacities ();
+
+  /**
+   * \brief Function for creating the random variables and oscillators of a fader
+   * \param fader fader index
+   * \param set initial parameter set
+   * \param state initial state
+   */
+  void CreateFader (uint32_t fader, uint32_t set, uint32_t state);
+
+  /**
+   * \brief Function for updating the parameter set and state of a fader,
+   * reconstructing the Loo oscillators on parameter set change
+   * \param fader fader index
+   * \param set parameter set
+   * \param state state
+   */
+  void UpdateFaderParameters (uint32_t fader, uint32_t set, uint32_t state);
+
+  /**
+   * \brief Function for constructing the Loo oscillators of a fader for a parameter set
+   * \param fader fader index
+   * \param set parameter set
+   */
+  void ConstructLooOscillators (uint32_t fader, uint32_t set);
+
+  /**
+   * \brief Function for constructing the Rayleigh oscillators of a fader for a parameter set
+   * \param fader fader index
+   * \param set parameter set
+   */
+  void ConstructRayleighOscillators (uint32_t fader, uint32_t set);
+
+  /**
+   * \brief Function for calculating the channel gain of a fader in its current state
+   * \param fader fader index
+   * \return channel gain, in dB if decibels are used
+   */
+  double GetChannelGain (uint32_t fader);
+
+  /**
+   * \brief Function for calculating the linear channel gain of a Loo fader
+   * \param group oscillator group
+   * \param timeInSeconds time in seconds
+   * \return channel gain
+   */
+  double CalculateLooChannelGain (uint32_t group, double timeInSeconds);
+
+  /**
+   * \brief Function for calculating the complex gain of a Rayleigh fader
+   * \param group oscillator group
+   * \param timeInSeconds time in seconds
+   * \return complex gain
+   */
+  std::complex<double> CalculateRayleighComplexGain (uint32_t group, double timeInSeconds);
+
+  /**
+   * \brief Function for calculating the channel gains of a fader state at fixed time
+   * steps, in linear units whatever m_useDecibels
+   * \param fader fader index
+   * \param state state
+   * \param startTime time of the first channel gain in seconds
+   * \param timeStep time step between the channel gains in seconds
+   * \param gains first of the channel gains to fill
+   */
+  void GetChannelGains (uint32_t fader, uint32_t state, double startTime, double timeStep, double* gains);
+
+  /**
+   * \brief Function for evaluating state change of a terminal
+   * \param terminal terminal id
+   */
+  void EvaluateStateChange (uint32_t terminal);
+
+  /**
+   * \brief Function for calculating the fading value of a terminal
+   * \param terminal terminal id
+   * \param channelType channel type
+   * \return fading value
+   */
+  double CalculateFading (uint32_t terminal, SatEnums::ChannelType_t channelType);
+
+  /**
+   * \brief Function for getting the fading value of the current state of a
+   * fader from the pre-tabulated fading values, refilling them if needed
+   * \param fader fader index
+   * \return fading value
+   */
+  double GetTabulatedFading (uint32_t fader);
+
+  /**
+   * \brief Function for invalidating the pre-tabulated fading values of a
+   * fader, when its oscillators are reconstructed
+   * \param fader fader index
+   */
+  void InvalidateFadingTables (uint32_t fader);
+
+  /**
+   * \brief Function for selecting the parameter set of a terminal based on the
+   * elevation, see SatMarkovConf::GetProbabilitySetID
+   * \param terminal terminal id
+   * \param elevation elevation
+   * \return parameter set
+   */
+  uint32_t GetProbabilitySetID (uint32_t terminal, double elevation);
+
+  /**
+   * \brief Function for updating the active parameter sets of all the
+   * terminals, scheduled periodically
+   */
+  void UpdateActiveSets ();
+
+  /**
+   * \brief Function for selecting the next Markov state of a terminal
+   * \param terminal terminal id
+   */
+  void DoTransition (uint32_t terminal);
+
+  /**
+   * \brief Function for checking whether the cooldown period of a fader has passed
+   * \param fader fader index
+   * \return has cooldown period passed
+   */
+  bool HasCooldownPeriodPassed (uint32_t fader) const;
+
+  /**
+   * \brief Markov model configuration
+   */
+  Ptr<SatMarkovConf> m_markovConf;
+
+  /**
+   * \brief Fader type
+   */
+  SatMarkovConf::MarkovFaderType_t m_faderType;
+
+  /**
+   * \brief Number of states
+   */
+  uint32_t m_numOfStates;
+
+  /**
+   * \brief Number of parameter sets
+   */
+  uint32_t m_numOfSets;
+
+  /**
+   * \brief Number of oscillator groups per fader
+   */
+  uint32_t m_numOfGroups;
+
+  /**
+   * \brief Initial state of the Markov models
+   */
+  uint32_t m_initialState;
+
+  /**
+   * \brief Cooldown period length in time
+   */
+  Time m_cooldownPeriodLength;
+
+  /**
+   * \brief Minimum state change distance in meters
+   */
+  double m_minimumPositionChangeInMeters;
+
+  /**
+   * \brief Defines whether the calculations should return the fading value in decibels or not
+   */
+  bool m_useDecibels;
+
+  /**
+   * \brief Defines whether the uplink fading is calculated by the uplink fader
+   */
+  bool m_useUplinkFader;
+
+  /**
+   * \brief Defines whether the oscillators are evaluated with oscillator banks
+   */
+  bool m_useOscillatorBank;
+
+  /**
+   * \brief Defines whether the fading values are pre-tabulated or calculated on each request
+   */
+  bool m_usePreTabulatedFading;
+
+  /**
+   * \brief Time step of the pre-tabulated fading values in seconds
+   */
+  double m_preTabulationStep;
+
+  /**
+   * \brief Number of pre-tabulated fading values per state
+   */
+  uint32_t m_preTabulationLength;
+
+  /**
+   * \brief Defines whether the parameter set updates are decoupled from the state change evaluation
+   */
+  bool m_decoupledSetUpdates;
+
+  /**
+   * \brief Interval of the periodic parameter set updates
+   */
+  Time m_setUpdateInterval;
+
+  /**
+   * \brief Event of the next periodic parameter set update
+   */
+  EventId m_setUpdateEvent;
+
+  /**
+   * \brief State change tables, one per parameter set
+   */
+  std::vector<Ptr<const SatMarkovTransitionTable> > m_transitionTables;
+
+  /**
+   * \brief Fader parameters, one per parameter set
+   */
+  std::vector<std::vector<std::vector<double> > > m_faderParameters;
+
+  /**
+   * \brief Direct signal oscillator capacity and offset of each group
+   */
+  std::vector<uint32_t> m_directCapacity;
+  std::vector<uint32_t> m_directOffset;
+  uint32_t m_directCapacityPerFader;
+
+  /**
+   * \brief Multipath oscillator capacity and offset of each group
+   */
+  std::vector<uint32_t> m_multipathCapacity;
+  std::vector<uint32_t> m_multipathOffset;
+  uint32_t m_multipathCapacityPerFader;
+
+  /**
+   * \brief Per terminal elevation and velocity callbacks
+   */
+  std::vector<SatBaseFading::ElevationCallback> m_elevation;
+  std::vector<SatBaseFading::VelocityCallback> m_velocity;
+
+  /**
+   * \brief Per terminal parameter set, state, and state of the Markov model
+   */
+  std::vector<uint32_t> m_currentSet;
+  std::vector<uint32_t> m_currentState;
+  std::vector<uint32_t> m_markovState;
+
+  /**
+   * \brief Per terminal elevation range of the current parameter set
+   */
+  std::vector<double> m_currentSetLowerElevation;
+  std::vector<double> m_currentSetUpperElevation;
+
+  /**
+   * \brief Per terminal parameter set matching the latest elevation, used
+   * when the parameter set updates are decoupled
+   */
+  std::vector<uint32_t> m_activeSet;
+
+  /**
+   * \brief Per terminal latest state change time
+   */
+  std::vector<Time> m_latestStateChangeTime;
+
+  /**
+   * \brief Per terminal set and state locks
+   */
+  std::vector<bool> m_enableSetLock;
+  std::vector<bool> m_enableStateLock;
+
+  /**
+   * \brief Per fader latest calculated fading value and calculation time
+   */
+  std::vector<double> m_latestCalculatedFadingValue;
+  std::vector<Time> m_latestCalculationTime;
+
+  /**
+   * \brief Per fader parameter set and state
+   */
+  std::vector<uint32_t> m_faderSet;
+  std::vector<uint32_t> m_faderState;
+
+  /**
+   * \brief Per fader random variables
+   */
+  std::vector<Ptr<NormalRandomVariable> > m_normalRandomVariable;
+  std::vector<Ptr<UniformRandomVariable> > m_uniformVariable;
+
+  /**
+   * \brief Per group number of oscillators and common initial phases
+   */
+  std::vector<uint32_t> m_directCount;
+  std::vector<double> m_directPhase;
+  std::vector<uint32_t> m_multipathCount;
+  std::vector<double> m_multipathPhase;
+
+  /**
+   * \brief Per group multipath power converted to linear units (Loo)
+   */
+  std::vector<double> m_sigma;
+
+  /**
+   * \brief Direct signal oscillator amplitudes and rotation speeds
+   */
+  std::vector<double> m_directAmplitude;
+  std::vector<double> m_directOmega;
+
+  /**
+   * \brief Multipath oscillator amplitudes and rotation speeds
+   */
+  std::vector<std::complex<double> > m_multipathAmplitude;
+  std::vector<double> m_multipathOmega;
+
+  /**
+   * \brief Per group oscillator banks, used instead of the oscillator
+   * arrays when oscillator bank is enabled
+   */
+  std::vector<Ptr<SatFadingOscillatorBank> > m_directOscillatorBanks;
+  std::vector<Ptr<SatFadingOscillatorBank> > m_multipathOscillatorBanks;
+
+  /**
+   * \brief Pre-tabulated fading values in linear units, per fader and state.
+   * The table of a state is allocated when the state is first visited and
+   * freed when the terminal is released.
+   */
+  std::vector<std::vector<double> > m_tableValues;
+  std::vector<double> m_tableStartTime;
+  std::vector<bool> m_tableValid;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_MARKOV_FADING_MANAGER_H */
@@ -20,6 +20,9 @@
 
 #include "satellite-markov-model.h"
 #include <cstdlib>
+#include <cmath>
+#include <limits>
+#include <algorithm>
 #include "ns3/simulator.h"
 
 namespace ns3 {
@@ -27,6 +30,150 @@ namespace ns3 {
 NS_OBJECT_ENSURE_REGISTERED (SatMarkovModel);
 NS_LOG_COMPONENT_DEFINE ("SatMarkovModel");
 
+SatMarkovTransitionTable::SatMarkovTransitionTable (const std::vector<std::vector<double> >& probabilities)
+  : m_numOfStates (probabilities.size ()),
+  m_useAliasMethod (probabilities.size () >= ALIAS_METHOD_MIN_STATES)
+{
+  NS_LOG_FUNCTION (this << m_numOfStates);
+
+  m_cumulativeProbabilities.resize (m_numOfStates * m_numOfStates);
+  m_validRows.resize (m_numOfStates, false);
+
+  for (uint32_t i = 0; i < m_numOfStates; ++i)
+    {
+      if (probabilities[i].size () != m_numOfStates)
+        {
+          NS_FATAL_ERROR ("SatMarkovTransitionTable::SatMarkovTransitionTable - Invalid number of probabilities");
+        }
+
+      double acc = 0.0;
+      for (uint32_t j = 0; j < m_numOfStates; ++j)
+        {
+          acc += probabilities[i][j];
+          m_cumulativeProbabilities[i * m_numOfStates + j] = acc;
+        }
+
+      // rows of unreachable states may not sum to one, so they are only
+      // rejected if a transition is done from them
+      m_validRows[i] = ( fabs (acc - 1.0) <= std::numeric_limits<double>::epsilon ());
+
+      if (!m_validRows[i])
+        {
+          NS_LOG_INFO ("Probability sum of state " << i << " does not match: " << acc);
+        }
+    }
+
+  if (m_useAliasMethod)
+    {
+      /// Vose's alias method, built separately for each row
+      m_aliasProbabilities.resize (m_numOfStates * m_numOfStates, 1.0);
+      m_aliases.resize (m_numOfStates * m_numOfStates, 0);
+
+      for (uint32_t i = 0; i < m_numOfStates; ++i)
+        {
+          if (!m_validRows[i])
+            {
+              continue;
+            }
+
+          double total = m_cumulativeProbabilities[i * m_numOfStates + m_numOfStates - 1];
+          std::vector<double> scaled (m_numOfStates);
+          std::vector<uint32_t> small;
+          std::vector<uint32_t> large;
+
+          for (uint32_t j = 0; j < m_numOfStates; ++j)
+            {
+              scaled[j] = probabilities[i][j] * m_numOfStates / total;
+              if (scaled[j] < 1.0)
+                {
+                  small.push_back (j);
+                }
+              else
+                {
+                  large.push_back (j);
+                }
+            }
+
+          while (!small.empty () && !large.empty ())
+            {
+              uint32_t less = small.back ();
+              uint32_t more = large.back ();
+              small.pop_back ();
+              large.pop_back ();
+
+              m_aliasProbabilities[i * m_numOfStates + less] = scaled[less];
+              m_aliases[i * m_numOfStates + less] = more;
+
+              scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+              if (scaled[more] < 1.0)
+                {
+                  small.push_back (more);
+                }
+              else
+                {
+                  large.push_back (more);
+                }
+            }
+
+          /// remaining columns are full, also those left in small due to rounding
+          while (!large.empty ())
+            {
+              m_aliasProbabilities[i * m_numOfStates + large.back ()] = 1.0;
+              large.pop_back ();
+            }
+          while (!small.empty ())
+            {
+              m_aliasProbabilities[i * m_numOfStates + small.back ()] = 1.0;
+              small.pop_back ();
+            }
+        }
+    }
+}
+
+uint32_t
+SatMarkovTransitionTable::GetNumOfStates () const
+{
+  return m_numOfStates;
+}
+
+uint32_t
+SatMarkovTransitionTable::GetNextState (uint32_t currentState, double random) const
+{
+  NS_LOG_FUNCTION (this << currentState << random);
+
+  NS_ASSERT (currentState < m_numOfStates);
+
+  if (!m_validRows[currentState])
+    {
+      NS_FATAL_ERROR ("SatMarkovTransitionTable::GetNextState - Probability sum does not match");
+    }
+
+  if (m_useAliasMethod)
+    {
+      double position = random * m_numOfStates;
+      uint32_t column = std::min ((uint32_t) position, m_numOfStates - 1);
+      uint32_t index = currentState * m_numOfStates + column;
+
+      if (position - column < m_aliasProbabilities[index])
+        {
+          return column;
+        }
+      return m_aliases[index];
+    }
+
+  const double* row = &m_cumulativeProbabilities[currentState * m_numOfStates];
+  double r = row[m_numOfStates - 1] * random;
+
+  for (uint32_t i = 0; i < m_numOfStates; ++i)
+    {
+      if (r <= row[i])
+        {
+          return i;
+        }
+    }
+  return m_numOfStates - 1;
+}
+
 TypeId SatMarkovModel::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatMarkovModel")
@@ -89,6 +236,8 @@ SatMarkovModel::Reset ()
       delete[] m_probabilities;
       m_probabilities = NULL;
     }
+
+  m_transitionTable = NULL;
 }
 
 uint32_t
@@ -119,6 +268,18 @@ SatMarkovModel::DoTransition ()
 
   NS_LOG_INFO ("Doing transition, current state: " << m_currentState);
 
+  if (m_transitionTable != NULL)
+    {
+      double random = std::rand () / double (RAND_MAX);
+
+      NS_LOG_INFO ("Random value: " << random);
+
+      m_currentState = m_transitionTable->GetNextState (m_currentState, random);
+
+      NS_LOG_INFO ("Transition done, new state: " << m_currentState);
+      return m_currentState;
+    }
+
   double total = 0;
   for (uint32_t i = 0; i < m_numOfStates; ++i)
     {
@@ -162,6 +323,20 @@ SatMarkovModel::SetProbability (uint32_t from,
 
   NS_LOG_INFO ("Setting probability, from: " << from << " to: " << to << " probability: " << probability);
   m_probabilities[from * m_numOfStates + to] = probability;
+  m_transitionTable = NULL;
+}
+
+void
+SatMarkovModel::SetTransitionTable (Ptr<const SatMarkovTransitionTable> table)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (table->GetNumOfStates () != m_numOfStates)
+    {
+      NS_FATAL_ERROR ("SatMarkovModel::SetTransitionTable - Invalid number of states");
+    }
+
+  m_transitionTable = table;
 }
 
 } // namespace ns3
@@ -20,11 +20,85 @@
 #ifndef SATELLITE_MARKOV_MODEL_H
 #define SATELLITE_MARKOV_MODEL_H
 
+#include <vector>
 #include "ns3/object.h"
 #include "ns3/log.h"
+#include "ns3/simple-ref-count.h"
 
 namespace ns3 {
 
+/**
+ * \ingroup satellite
+ *
+ * \brief Precomputed state change table of a Markov model. The table holds
+ * the cumulative distribution of each row of the state change probabilities,
+ * so that the next state is found with a single uniform random value. For
+ * large state counts the rows are sampled with the alias method instead.
+ */
+class SatMarkovTransitionTable : public SimpleRefCount<SatMarkovTransitionTable>
+{
+public:
+  /**
+   * \brief Minimum number of states for which the alias method is used
+   */
+  static const uint32_t ALIAS_METHOD_MIN_STATES = 16;
+
+  /**
+   * \brief Constructor
+   *
+   * Rows which do not sum to one, such as the rows of unreachable states,
+   * are accepted, but no transition can be done from them.
+   *
+   * \param probabilities state change probabilities, one row per start state
+   */
+  SatMarkovTransitionTable (const std::vector<std::vector<double> >& probabilities);
+
+  /**
+   * \brief Function for returning the number of states
+   * \return number of states
+   */
+  uint32_t GetNumOfStates () const;
+
+  /**
+   * \brief Function for selecting the next state
+   * \param currentState current state
+   * \param random uniform random value in range [0, 1]
+   * \return next state
+   */
+  uint32_t GetNextState (uint32_t currentState, double random) const;
+
+private:
+  /**
+   * \brief Number of states
+   */
+  uint32_t m_numOfStates;
+
+  /**
+   * \brief Whether the rows are sampled with the alias method
+   */
+  bool m_useAliasMethod;
+
+  /**
+   * \brief Cumulative state change probabilities, row by row
+   */
+  std::vector<double> m_cumulativeProbabilities;
+
+  /**
+   * \brief Alias method acceptance probabilities, row by row
+   */
+  std::vector<double> m_aliasProbabilities;
+
+  /**
+   * \brief Alias method alias states, row by row
+   */
+  std::vector<uint32_t> m_aliases;
+
+  /**
+   * \brief Whether the probabilities of each row sum to one
+   */
+  std::vector<bool> m_validRows;
+};
+
 /**
  * \ingroup satellite
  *
@@ -68,6 +142,13 @@ public:
                        uint32_t to,
                        double probability);
 
+  /**
+   * \brief Function for setting precomputed state change table, used
+   * instead of the probability values set with SetProbability
+   * \param table state change table
+   */
+  void SetTransitionTable (Ptr<const SatMarkovTransitionTable> table);
+
   /**
    * \brief Function for evaluating the state change
    * \return new state
@@ -97,6 +178,11 @@ private:
    */
   double* m_probabilities;
 
+  /**
+   * \brief Precomputed state change table, if set
+   */
+  Ptr<const SatMarkovTransitionTable> m_transitionTable;
+
   /**
    * \brief Number of states
    */
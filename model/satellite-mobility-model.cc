@@ -60,6 +60,7 @@ SatMobilityModel::GetInstanceTypeId (void) const
 
 SatMobilityModel::SatMobilityModel ()
   : m_cartesianPositionOutdated (false),
+  m_courseVersion (0),
   m_GetAsGeoCoordinates (true)
 {
 
@@ -85,10 +86,17 @@ SatMobilityModel::SetGeoPosition (const GeoCoordinate &position)
 void
 SatMobilityModel::NotifyGeoCourseChange (void) const
 {
+  m_courseVersion++;
   m_satCourseChangeTrace (this);
   NotifyCourseChange ();
 }
 
+uint64_t
+SatMobilityModel::GetCourseVersion (void) const
+{
+  return m_courseVersion;
+}
+
 Vector
 SatMobilityModel::DoGetPosition (void) const
 {
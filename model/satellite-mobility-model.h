@@ -67,6 +67,17 @@ public:
 
   void NotifyGeoCourseChange (void) const;
 
+  /**
+   * \brief Get the version number of the current course.
+   *
+   * Version is incremented every time course change is notified, so observers
+   * can compare stored version to the current one in order to detect
+   * whether values derived from the position are still valid.
+   *
+   * \return the current course version
+   */
+  uint64_t GetCourseVersion (void) const;
+
   /**
    * Callback signature for `SatCourseChange` trace source.
    *
@@ -128,6 +139,9 @@ private:
   // flag to indicated if position in Cartesian format is out of date.
   mutable bool m_cartesianPositionOutdated;
 
+  // version of the course, incremented on every course change notification
+  mutable uint64_t m_courseVersion;
+
   // this is the flag for indicating that when calling method DoSetPosition (defined by class Mobility Model)
   // is taking Vector filled by longitude (in x), latitude (in y) and altitude (in z)
   // this enables using ns-3 mobility helper without to convert geo coordinates first to Cartesian
@@ -69,6 +69,10 @@ SatMobilityObserver::GetTypeId (void)
                      "The value of the some property has changed",
                      MakeTraceSourceAccessor (&SatMobilityObserver::m_propertyChangeTrace),
                      "ns3::SatMobilityObserver::PropertyChangedCallback")
+    .AddTraceSource ("AvoidedRecalculations",
+                     "The number of elevation angle and timing advance recalculations avoided by caching",
+                     MakeTraceSourceAccessor (&SatMobilityObserver::m_avoidedRecalculations),
+                     "ns3::TracedValueCallback::Uint32")
   ;
   return tid;
 }
@@ -95,7 +99,15 @@ SatMobilityObserver::SatMobilityObserver (Ptr<SatMobilityModel> ownMobility, Ptr
   m_geoSatMobility (geoSatMobility),
   m_ownProgDelayModel (NULL),
   m_anotherProgDelayModel (NULL),
-  m_initialized (false)
+  m_avoidedRecalculations (0),
+  m_initialized (false),
+  m_elevationAngleValid (false),
+  m_timingAdvanceValid (false),
+  m_elevationOwnVersion (0),
+  m_elevationSatVersion (0),
+  m_timingOwnVersion (0),
+  m_timingSatVersion (0),
+  m_timingAnotherVersion (0)
 {
   NS_LOG_FUNCTION (this << ownMobility << geoSatMobility);
 
@@ -114,8 +126,6 @@ SatMobilityObserver::SatMobilityObserver (Ptr<SatMobilityModel> ownMobility, Ptr
   m_earthRadius = CalculateDistance (satellitePosition.ToVector (), Vector (0, 0, 0)) - satelliteAltitude;
 
   SatelliteStatusChanged ();
-  m_updateElevationAngle = true;
-  m_updateTimingAdvance = true;
   m_timingAdvance_s = Seconds (0);
 
   m_geoSatMobility->TraceConnect ("SatCourseChange", "Satellite", MakeCallback ( &SatMobilityObserver::PositionChanged, this));
@@ -162,6 +172,7 @@ SatMobilityObserver::ObserveTimingAdvance (Ptr<PropagationDelayModel> ownDelayMo
   m_ownProgDelayModel = ownDelayModel;
   m_anotherProgDelayModel = anotherDelayModel;
   m_anotherMobility = anotherMobility;
+  m_timingAdvanceValid = false;
 
   // same reference ellipsoide must be used by mobilities
   NS_ASSERT (m_anotherMobility->GetGeoPosition ().GetRefEllipsoid () == m_ownMobility->GetGeoPosition ().GetRefEllipsoid () );
@@ -174,13 +185,24 @@ SatMobilityObserver::GetElevationAngle (void)
 {
   NS_LOG_FUNCTION (this);
 
-  if ( m_updateElevationAngle == true )
+  uint64_t ownVersion = m_ownMobility->GetCourseVersion ();
+  uint64_t satVersion = m_geoSatMobility->GetCourseVersion ();
+
+  if ( m_elevationAngleValid
+       && ( ownVersion == m_elevationOwnVersion )
+       && ( satVersion == m_elevationSatVersion ) )
+    {
+      m_avoidedRecalculations++;
+    }
+  else
     {
       // same reference ellipsoide must be used by mobilities
       NS_ASSERT (m_geoSatMobility->GetGeoPosition ().GetRefEllipsoid () == m_ownMobility->GetGeoPosition ().GetRefEllipsoid () );
 
       UpdateElevationAngle ();
-      m_updateElevationAngle = false;
+      m_elevationOwnVersion = ownVersion;
+      m_elevationSatVersion = satVersion;
+      m_elevationAngleValid = true;
     }
 
   return m_elevationAngle;
@@ -203,7 +225,23 @@ SatMobilityObserver::GetTimingAdvance (void)
   NS_LOG_FUNCTION (this);
 
   // update timing advance, if another end is given and update needed
-  if ( (m_anotherMobility != NULL) &&  ( m_updateTimingAdvance == true ) )
+  if ( m_anotherMobility == NULL )
+    {
+      return m_timingAdvance_s;
+    }
+
+  uint64_t ownVersion = m_ownMobility->GetCourseVersion ();
+  uint64_t satVersion = m_geoSatMobility->GetCourseVersion ();
+  uint64_t anotherVersion = m_anotherMobility->GetCourseVersion ();
+
+  if ( m_timingAdvanceValid
+       && ( ownVersion == m_timingOwnVersion )
+       && ( satVersion == m_timingSatVersion )
+       && ( anotherVersion == m_timingAnotherVersion ) )
+    {
+      m_avoidedRecalculations++;
+    }
+  else
     {
       // another propagation delay is expected to be given
       NS_ASSERT ( m_anotherProgDelayModel != NULL );
@@ -215,7 +253,10 @@ SatMobilityObserver::GetTimingAdvance (void)
       NS_ASSERT (m_anotherMobility->GetGeoPosition ().GetRefEllipsoid () == m_ownMobility->GetGeoPosition ().GetRefEllipsoid () );
 
       UpdateTimingAdvance ();
-      m_updateTimingAdvance = false;
+      m_timingOwnVersion = ownVersion;
+      m_timingSatVersion = satVersion;
+      m_timingAnotherVersion = anotherVersion;
+      m_timingAdvanceValid = true;
     }
 
   return m_timingAdvance_s;
@@ -237,13 +278,8 @@ SatMobilityObserver::PositionChanged (std::string context, Ptr<const SatMobility
 {
   NS_LOG_FUNCTION (this << context << position);
 
-  // set flag on to idicate that elevation angle is needed to update,
-  // when its status is requested with method GetElevationAngle
-  m_updateElevationAngle = true;
-
-  // set flag on to idicate that timing advance is needed to update,
-  // when its status is requested with method GetTimingAdvance
-  m_updateTimingAdvance = true;
+  // cached elevation angle and timing advance are invalidated by course versions
+  // of the mobilities, so they are recalculated only when requested next time
 
   // call satellite statis updated routine to update needed variables
   if ( context == "Satellite" )
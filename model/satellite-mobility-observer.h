@@ -22,6 +22,7 @@
 #define SATELLITE_MOBILITY_OBSERVER_H
 
 #include "ns3/object.h"
+#include "ns3/traced-value.h"
 #include "satellite-mobility-model.h"
 #include "satellite-propagation-delay-model.h"
 #include "geo-coordinate.h"
@@ -35,6 +36,12 @@ namespace ns3 {
  *
  * Observing of timing advance is set by method ObserveTimingAdvance
  *
+ * Observed properties are cached together with the course versions of the
+ * mobilities they were calculated from. A property is recalculated only when
+ * one of the related mobilities has reported a course change since the
+ * previous calculation. Number of avoided recalculations can be followed
+ * through trace source `AvoidedRecalculations`.
+ *
  */
 class SatMobilityObserver : public Object
 {
@@ -83,6 +90,9 @@ public:
   /**
    * \brief Get elevation angle.
    *
+   * Elevation angle is recalculated only if own or satellite mobility
+   * has changed its course since the previous calculation.
+   *
    * \return the current elevation angle as degrees.
    */
   double GetElevationAngle (void);
@@ -97,6 +107,9 @@ public:
   /**
    * \brief Get timing advance.
    *
+   * Timing advance is recalculated only if own, satellite or another end
+   * mobility has changed its course since the previous calculation.
+   *
    * \return the current timing advance.
    */
   Time GetTimingAdvance (void);
@@ -149,9 +162,19 @@ private:
   Ptr<PropagationDelayModel> m_ownProgDelayModel;
   Ptr<PropagationDelayModel> m_anotherProgDelayModel;
 
+  /**
+   * Used to follow the number of property recalculations avoided by caching.
+   */
+  TracedValue<uint32_t> m_avoidedRecalculations;
+
   bool m_initialized;  // flag for GetElevationAngle
-  bool m_updateElevationAngle;  // flag for GetElevationAngle
-  bool m_updateTimingAdvance;   // flag for GetTimingAdvance
+  bool m_elevationAngleValid;  // flag telling if cached elevation angle is calculated
+  bool m_timingAdvanceValid;   // flag telling if cached timing advance is calculated
+  uint64_t m_elevationOwnVersion;  // own course version used for cached elevation angle
+  uint64_t m_elevationSatVersion;  // satellite course version used for cached elevation angle
+  uint64_t m_timingOwnVersion;     // own course version used for cached timing advance
+  uint64_t m_timingSatVersion;     // satellite course version used for cached timing advance
+  uint64_t m_timingAnotherVersion; // another end course version used for cached timing advance
   double m_minAltitude;
   double m_maxAltitude;
   double m_elevationAngle;
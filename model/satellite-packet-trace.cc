@@ -18,11 +18,17 @@
  * Author: Jani Puttonen <jani.puttonen@magister.fi>
  */
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
 #include "ns3/object.h"
 #include "ns3/log.h"
-#include "ns3/output-stream-wrapper.h"
-#include "ns3/trace-helper.h"
 #include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
 #include "ns3/mac48-address.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
@@ -34,23 +40,90 @@ namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (SatPacketTrace);
 
+const char SatPacketTrace::BINARY_TRACE_MAGIC[8] = { 'S', 'A', 'T', 'P', 'K', 'T', 'T', 'R' };
+
 SatPacketTrace::SatPacketTrace ()
+  : m_binaryOutput (false),
+  m_blockSize (65536),
+  m_packetEventMask (0),
+  m_nodeTypeMask (0),
+  m_logLevelMask (0),
+  m_linkDirMask (0)
 {
   ObjectBase::ConstructSelf (AttributeConstructionList ());
 
-  AsciiTraceHelper asciiTraceHelper;
+  std::vector<std::string> names;
+
+  for (uint32_t i = SatEnums::PACKET_SENT; i <= SatEnums::PACKET_DROP; i++)
+    {
+      names.push_back (SatEnums::GetPacketEventName (static_cast<SatEnums::SatPacketEvent_t> (i)));
+    }
+  m_packetEventMask = ParseFilter ("TracedPacketEvents", m_tracedPacketEvents, names);
+
+  names.clear ();
+  for (uint32_t i = SatEnums::NT_UT; i <= SatEnums::NT_UNDEFINED; i++)
+    {
+      names.push_back (SatEnums::GetNodeTypeName (static_cast<SatEnums::SatNodeType_t> (i)));
+    }
+  m_nodeTypeMask = ParseFilter ("TracedNodeTypes", m_tracedNodeTypes, names);
+
+  names.clear ();
+  for (uint32_t i = SatEnums::LL_ND; i <= SatEnums::LL_CH; i++)
+    {
+      names.push_back (SatEnums::GetLogLevelName (static_cast<SatEnums::SatLogLevel_t> (i)));
+    }
+  m_logLevelMask = ParseFilter ("TracedLogLevels", m_tracedLogLevels, names);
+
+  names.clear ();
+  for (uint32_t i = SatEnums::LD_FORWARD; i <= SatEnums::LD_UNDEFINED; i++)
+    {
+      names.push_back (SatEnums::GetLinkDirName (static_cast<SatEnums::SatLinkDir_t> (i)));
+    }
+  m_linkDirMask = ParseFilter ("TracedLinkDirections", m_tracedLinkDirs, names);
+
+  std::istringstream nodeIds (m_tracedNodeIds);
+  std::string nodeId;
+
+  while (std::getline (nodeIds, nodeId, ','))
+    {
+      std::istringstream ids (nodeId);
+      uint32_t id;
+
+      while (ids >> id)
+        {
+          m_nodeIds.insert (id);
+        }
+
+      if (!ids.eof ())
+        {
+          NS_FATAL_ERROR ("SatPacketTrace::SatPacketTrace - Invalid node id in TracedNodeIds: " << m_tracedNodeIds);
+        }
+    }
 
   std::stringstream outputPath;
-  outputPath << Singleton<SatEnvVariables>::Get ()->GetOutputPath () << "/" << m_fileName << ".log";
+  outputPath << Singleton<SatEnvVariables>::Get ()->GetOutputPath () << "/" << m_fileName << (m_binaryOutput ? ".bin" : ".log");
 
-  m_packetTraceStream = asciiTraceHelper.CreateFileStream (outputPath.str ());
+  std::ios::openmode mode = m_binaryOutput ? (std::ios::out | std::ios::binary) : std::ios::out;
+  m_writer = Create<SatOutputFileStreamWriter> (outputPath.str (), mode, false);
+  m_block.reserve (m_blockSize + 1024);
 
-  PrintHeader ();
+  if (m_binaryOutput)
+    {
+      uint32_t version = BINARY_TRACE_VERSION;
+      m_block.append (BINARY_TRACE_MAGIC, sizeof (BINARY_TRACE_MAGIC));
+      m_block.append (reinterpret_cast<const char*> (&version), sizeof (version));
+    }
+  else
+    {
+      PrintHeader (m_block);
+    }
 }
 
 SatPacketTrace::~SatPacketTrace ()
 {
   NS_LOG_FUNCTION (this);
+
+  CloseWriter ();
 }
 
 TypeId
@@ -70,6 +143,51 @@ SatPacketTrace::GetTypeId ()
                    StringValue ("PacketTrace"),
                    MakeStringAccessor (&SatPacketTrace::m_fileName),
                    MakeStringChecker ())
+    .AddAttribute ("BinaryOutput",
+                   "Write binary records instead of text, to be converted with SatPacketTrace::ConvertToText",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatPacketTrace::m_binaryOutput),
+                   MakeBooleanChecker ())
+    .AddAttribute ("BlockSize",
+                   "Size of the blocks handed to the background writer [bytes]",
+                   UintegerValue (65536),
+                   MakeUintegerAccessor (&SatPacketTrace::m_blockSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("TracedPacketEvents",
+                   "Packet events to trace (SND, RCV, ENQ, DRP), separated by spaces or commas. Empty for all.",
+                   StringValue (""),
+                   MakeStringAccessor (&SatPacketTrace::m_tracedPacketEvents),
+                   MakeStringChecker ())
+    .AddAttribute ("TracedNodeTypes",
+                   "Node types to trace (UT, SAT, GW, NCC, TER, UNDEF), separated by spaces or commas. Empty for all.",
+                   StringValue (""),
+                   MakeStringAccessor (&SatPacketTrace::m_tracedNodeTypes),
+                   MakeStringChecker ())
+    .AddAttribute ("TracedLogLevels",
+                   "Log levels to trace (ND, LLC, MAC, PHY, CH), separated by spaces or commas. Empty for all.",
+                   StringValue (""),
+                   MakeStringAccessor (&SatPacketTrace::m_tracedLogLevels),
+                   MakeStringChecker ())
+    .AddAttribute ("TracedLinkDirections",
+                   "Link directions to trace (FWD, RTN, UNDEF), separated by spaces or commas. Empty for all.",
+                   StringValue (""),
+                   MakeStringAccessor (&SatPacketTrace::m_tracedLinkDirs),
+                   MakeStringChecker ())
+    .AddAttribute ("TracedNodeIds",
+                   "Ids of the nodes to trace, separated by spaces or commas. Empty for all.",
+                   StringValue (""),
+                   MakeStringAccessor (&SatPacketTrace::m_tracedNodeIds),
+                   MakeStringChecker ())
+    .AddAttribute ("StartTime",
+                   "Time of the first traced entries",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&SatPacketTrace::m_startTime),
+                   MakeTimeChecker ())
+    .AddAttribute ("StopTime",
+                   "Time after which the entries are not traced, zero for no stop time",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&SatPacketTrace::m_stopTime),
+                   MakeTimeChecker ())
   ;
   return tid;
 }
@@ -78,25 +196,109 @@ void
 SatPacketTrace::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+
+  CloseWriter ();
   Object::DoDispose ();
 }
 
 void
-SatPacketTrace::PrintHeader ()
+SatPacketTrace::CloseWriter ()
 {
   NS_LOG_FUNCTION (this);
 
-  *m_packetTraceStream->GetStream () << "COLUMN DESCRIPTIONS" << std::endl;
-  *m_packetTraceStream->GetStream () << "-------------------" << std::endl;
-  *m_packetTraceStream->GetStream () << "Time" << std::endl;
-  *m_packetTraceStream->GetStream () << "Packet event (SND, RCV, DRP, ENQ)" << std::endl;
-  *m_packetTraceStream->GetStream () << "Node type (UT, SAT, GW, NCC, TER)" << std::endl;
-  *m_packetTraceStream->GetStream () << "Node id" << std::endl;
-  *m_packetTraceStream->GetStream () << "MAC address" << std::endl;
-  *m_packetTraceStream->GetStream () << "Log level (ND, LLC, MAC, PHY, CH)" << std::endl;
-  *m_packetTraceStream->GetStream () << "Link direction (FWD, RTN)" << std::endl;
-  *m_packetTraceStream->GetStream () << "Packet info (List of: Packet id, source MAC address, destination MAC address)" << std::endl;
-  *m_packetTraceStream->GetStream () << "-------------------" << std::endl << std::endl;
+  if (m_writer != NULL)
+    {
+      m_writer->Write (m_block);
+      m_writer->Close ();
+      m_writer = 0;
+    }
+}
+
+uint32_t
+SatPacketTrace::ParseFilter (std::string attribute, std::string value, const std::vector<std::string>& names)
+{
+  NS_LOG_FUNCTION (attribute << value);
+
+  std::replace (value.begin (), value.end (), ',', ' ');
+  std::istringstream tokens (value);
+  std::string token;
+  uint32_t mask = 0;
+  bool empty = true;
+
+  while (tokens >> token)
+    {
+      empty = false;
+      uint32_t i = 0;
+
+      while (i < names.size () && names[i] != token)
+        {
+          i++;
+        }
+
+      if (i == names.size ())
+        {
+          NS_FATAL_ERROR ("SatPacketTrace::ParseFilter - Invalid value " << token << " in " << attribute);
+        }
+      mask |= (1 << i);
+    }
+
+  return empty ? ~0u : mask;
+}
+
+bool
+SatPacketTrace::IsLogLevelTraced (SatEnums::SatLogLevel_t logLevel) const
+{
+  return (m_logLevelMask & (1 << logLevel)) != 0;
+}
+
+void
+SatPacketTrace::PrintHeader (std::string& output)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  output.append ("COLUMN DESCRIPTIONS\n");
+  output.append ("-------------------\n");
+  output.append ("Time\n");
+  output.append ("Packet event (SND, RCV, DRP, ENQ)\n");
+  output.append ("Node type (UT, SAT, GW, NCC, TER)\n");
+  output.append ("Node id\n");
+  output.append ("MAC address\n");
+  output.append ("Log level (ND, LLC, MAC, PHY, CH)\n");
+  output.append ("Link direction (FWD, RTN)\n");
+  output.append ("Packet info (List of: Packet id, source MAC address, destination MAC address)\n");
+  output.append ("-------------------\n\n");
+}
+
+void
+SatPacketTrace::FormatEntry (const PacketTraceRecord_t& record, const std::string& packetInfo, std::string& output)
+{
+  char buffer[64];
+
+  // Same format as the default format of the output streams
+  snprintf (buffer, sizeof (buffer), "%g ", record.m_time);
+  output.append (buffer);
+  output.append (SatEnums::GetPacketEventName (static_cast<SatEnums::SatPacketEvent_t> (record.m_packetEvent)));
+  output.push_back (' ');
+  output.append (SatEnums::GetNodeTypeName (static_cast<SatEnums::SatNodeType_t> (record.m_nodeType)));
+  snprintf (buffer, sizeof (buffer), " %u %02x:%02x:%02x:%02x:%02x:%02x ", record.m_nodeId,
+            record.m_macAddress[0], record.m_macAddress[1], record.m_macAddress[2],
+            record.m_macAddress[3], record.m_macAddress[4], record.m_macAddress[5]);
+  output.append (buffer);
+  output.append (SatEnums::GetLogLevelName (static_cast<SatEnums::SatLogLevel_t> (record.m_logLevel)));
+  output.push_back (' ');
+  output.append (SatEnums::GetLinkDirName (static_cast<SatEnums::SatLinkDir_t> (record.m_linkDir)));
+  output.push_back (' ');
+  output.append (packetInfo);
+  output.push_back ('\n');
+}
+
+void
+SatPacketTrace::WriteBlockIfFull ()
+{
+  if (m_block.size () >= m_blockSize)
+    {
+      m_writer->Write (m_block);
+    }
 }
 
 void
@@ -111,28 +313,96 @@ SatPacketTrace::AddTraceEntry (Time now,
 {
   NS_LOG_FUNCTION (this << now.GetSeconds ());
 
-  /**
-   * TODO: Currently the packet trace logs all entries updated by the protocol layers.
-   * A filtering functionality may be implemented later, to restrict the amount of output
-   * data. The user may configure the filtering rules by attributes, e.g.
-   * - Entries from only certain type packet events
-   * - Entries from only certain node types
-   * - Entries from only certain node ids
-   * - Entries with certain log level (i.e. protocol layer)
-   * - Entries from one simulation direction
-   */
-
-  std::ostringstream oss;
-  oss << now.GetSeconds () << " "
-      << SatEnums::GetPacketEventName (packetEvent) << " "
-      << SatEnums::GetNodeTypeName (nodeType) << " "
-      << nodeId << " "
-      << macAddress << " "
-      << SatEnums::GetLogLevelName (logLevel) << " "
-      << SatEnums::GetLinkDirName (linkDir) << " "
-      << packetInfo;
-
-  *m_packetTraceStream->GetStream () << oss.str () << std::endl;
+  if ((m_packetEventMask & (1 << packetEvent)) == 0
+      || (m_nodeTypeMask & (1 << nodeType)) == 0
+      || (m_logLevelMask & (1 << logLevel)) == 0
+      || (m_linkDirMask & (1 << linkDir)) == 0
+      || now < m_startTime
+      || (!m_stopTime.IsZero () && now > m_stopTime)
+      || (!m_nodeIds.empty () && m_nodeIds.find (nodeId) == m_nodeIds.end ())
+      || m_writer == NULL)
+    {
+      return;
+    }
+
+  PacketTraceRecord_t record;
+  record.m_time = now.GetSeconds ();
+  record.m_nodeId = nodeId;
+  record.m_packetEvent = packetEvent;
+  record.m_nodeType = nodeType;
+  record.m_logLevel = logLevel;
+  record.m_linkDir = linkDir;
+  macAddress.CopyTo (record.m_macAddress);
+  record.m_packetInfoLength = std::min<size_t> (packetInfo.size (), std::numeric_limits<uint16_t>::max ());
+
+  if (m_binaryOutput)
+    {
+      m_block.append (reinterpret_cast<const char*> (&record), sizeof (record));
+      m_block.append (packetInfo, 0, record.m_packetInfoLength);
+    }
+  else
+    {
+      FormatEntry (record, packetInfo, m_block);
+    }
+
+  WriteBlockIfFull ();
+}
+
+void
+SatPacketTrace::ConvertToText (std::string binaryFileName, std::string textFileName)
+{
+  NS_LOG_FUNCTION (binaryFileName << textFileName);
+
+  std::ifstream input (binaryFileName.c_str (), std::ios::in | std::ios::binary);
+
+  if (!input.is_open ())
+    {
+      NS_FATAL_ERROR ("SatPacketTrace::ConvertToText - Unable to open " << binaryFileName);
+    }
+
+  char magic[sizeof (BINARY_TRACE_MAGIC)];
+  uint32_t version = 0;
+  input.read (magic, sizeof (magic));
+  input.read (reinterpret_cast<char*> (&version), sizeof (version));
+
+  if (!input || std::memcmp (magic, BINARY_TRACE_MAGIC, sizeof (magic)) != 0 || version != BINARY_TRACE_VERSION)
+    {
+      NS_FATAL_ERROR ("SatPacketTrace::ConvertToText - " << binaryFileName << " is not a binary packet trace");
+    }
+
+  std::ofstream output (textFileName.c_str (), std::ios::out);
+
+  if (!output.is_open ())
+    {
+      NS_FATAL_ERROR ("SatPacketTrace::ConvertToText - Unable to open " << textFileName);
+    }
+
+  std::string text;
+  std::string packetInfo;
+  PacketTraceRecord_t record;
+
+  PrintHeader (text);
+
+  while (input.read (reinterpret_cast<char*> (&record), sizeof (record)))
+    {
+      packetInfo.resize (record.m_packetInfoLength);
+
+      if (record.m_packetInfoLength > 0 && !input.read (&packetInfo[0], record.m_packetInfoLength))
+        {
+          NS_FATAL_ERROR ("SatPacketTrace::ConvertToText - Truncated record in " << binaryFileName);
+        }
+
+      FormatEntry (record, packetInfo, text);
+
+      if (text.size () >= 65536)
+        {
+          output.write (text.data (), text.size ());
+          text.clear ();
+        }
+    }
+
+  output.write (text.data (), text.size ());
+  output.close ();
 }
 
 }
@@ -21,9 +21,14 @@
 #ifndef SATELLITE_PACKET_TRACE_H_
 #define SATELLITE_PACKET_TRACE_H_
 
+#include <set>
+#include <string>
+#include <vector>
 #include "ns3/object.h"
-#include "ns3/output-stream-wrapper.h"
+#include "ns3/nstime.h"
+#include "ns3/mac48-address.h"
 #include "satellite-enums.h"
+#include "ns3/satellite-output-fstream-writer.h"
 
 
 namespace ns3 {
@@ -33,11 +38,37 @@ namespace ns3 {
  * \brief The SatPacketTrace implements a packet trace functionality.
  * The movement of packet through the satellite stack can be traced
  * in different protocol layers and direction.
+ *
+ * The entries may be filtered by packet event, node type, node id, log level,
+ * link direction and time window. The filters are applied before the entry
+ * is formatted. The accepted entries are collected into fixed-size blocks
+ * which are written by a background SatOutputFileStreamWriter, so memory
+ * is bounded and the file is not flushed for each entry.
+ *
+ * The entries are written either as text, or as binary records which are
+ * converted to the same text with ConvertToText.
  */
 
 class SatPacketTrace : public Object
 {
 public:
+  /**
+   * \brief Binary record of a packet trace entry. The record is followed
+   * by m_packetInfoLength characters of packet info. Byte order is the one
+   * of the writing host.
+   */
+  typedef struct
+  {
+    double m_time;
+    uint32_t m_nodeId;
+    uint8_t m_packetEvent;
+    uint8_t m_nodeType;
+    uint8_t m_logLevel;
+    uint8_t m_linkDir;
+    uint8_t m_macAddress[6];
+    uint16_t m_packetInfoLength;
+  } PacketTraceRecord_t;
+
   /**
    * \brief Constructor
    */
@@ -82,11 +113,59 @@ public:
                       SatEnums::SatLinkDir_t linkDir,
                       std::string packetInfo);
 
+  /**
+   * \brief Check whether the entries of a log level pass the filters
+   * \param logLevel Log level
+   * \return true if the entries of the log level may be traced
+   */
+  bool IsLogLevelTraced (SatEnums::SatLogLevel_t logLevel) const;
+
+  /**
+   * \brief Convert a binary packet trace to the text format
+   * \param binaryFileName Binary packet trace file
+   * \param textFileName Text packet trace file
+   */
+  static void ConvertToText (std::string binaryFileName, std::string textFileName);
+
 private:
   /**
    * \brief Print header to the packet trace log
+   * \param output Text to append the header to
+   */
+  static void PrintHeader (std::string& output);
+
+  /**
+   * \brief Format a packet trace entry as text
+   * \param record Record of the entry
+   * \param packetInfo Packet info of the entry
+   * \param output Text to append the entry to
+   */
+  static void FormatEntry (const PacketTraceRecord_t& record, const std::string& packetInfo, std::string& output);
+
+  /**
+   * \brief Parse a filter attribute
+   * \param attribute Name of the attribute
+   * \param value List of names separated by spaces or commas, empty for all
+   * \param names Names of the enumeration values, indexed by value
+   * \return Mask of the accepted values
+   */
+  static uint32_t ParseFilter (std::string attribute, std::string value, const std::vector<std::string>& names);
+
+  /**
+   * \brief Hand the current block to the writer if it is full
+   */
+  void WriteBlockIfFull ();
+
+  /**
+   * \brief Write the last block and close the writer
    */
-  void PrintHeader ();
+  void CloseWriter ();
+
+  /**
+   * Magic string and version identifying the binary packet trace files
+   */
+  static const char BINARY_TRACE_MAGIC[8];
+  static const uint32_t BINARY_TRACE_VERSION = 1;
 
   /**
    * File name of the packet trace log
@@ -94,9 +173,52 @@ private:
   std::string m_fileName;
 
   /**
-   * Stream wrapper used for packet traces
+   * Write binary records instead of text
+   */
+  bool m_binaryOutput;
+
+  /**
+   * Size of the blocks handed to the writer
+   */
+  uint32_t m_blockSize;
+
+  /**
+   * Filter attributes, lists of names
+   */
+  std::string m_tracedPacketEvents;
+  std::string m_tracedNodeTypes;
+  std::string m_tracedLogLevels;
+  std::string m_tracedLinkDirs;
+  std::string m_tracedNodeIds;
+
+  /**
+   * Time window of the traced entries, zero stop time for no end
+   */
+  Time m_startTime;
+  Time m_stopTime;
+
+  /**
+   * Masks of the traced enumeration values, parsed from the filter attributes
+   */
+  uint32_t m_packetEventMask;
+  uint32_t m_nodeTypeMask;
+  uint32_t m_logLevelMask;
+  uint32_t m_linkDirMask;
+
+  /**
+   * Traced node ids, empty for all
+   */
+  std::set<uint32_t> m_nodeIds;
+
+  /**
+   * Writer of the packet trace file
+   */
+  Ptr<SatOutputFileStreamWriter> m_writer;
+
+  /**
+   * Block being filled with entries
    */
-  Ptr<OutputStreamWrapper> m_packetTraceStream;
+  std::string m_block;
 
 };
 
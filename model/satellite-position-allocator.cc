@@ -219,7 +219,8 @@ SatSpotBeamPositionAllocator::GetTypeId (void)
     .AddAttribute ("MinElevationAngleInDegForUT",
                    "Minimum accepted elevation angle in degrees for UTs",
                    DoubleValue (5.00),
-                   MakeDoubleAccessor (&SatSpotBeamPositionAllocator::m_minElevationAngleInDeg),
+                   MakeDoubleAccessor (&SatSpotBeamPositionAllocator::SetMinElevationAngle,
+                                       &SatSpotBeamPositionAllocator::GetMinElevationAngle),
                    MakeDoubleChecker<double> ())
   ;
   return tid;
@@ -227,7 +228,9 @@ SatSpotBeamPositionAllocator::GetTypeId (void)
 
 SatSpotBeamPositionAllocator::SatSpotBeamPositionAllocator ()
   : m_targetBeamId (0),
-  m_minElevationAngleInDeg (1)
+  m_minElevationAngleInDeg (1),
+  m_tableBeamId (0),
+  m_tableMinElevationAngleInDeg (0)
 {
 
 }
@@ -236,7 +239,9 @@ SatSpotBeamPositionAllocator::SatSpotBeamPositionAllocator (uint32_t beamId, Ptr
   : m_targetBeamId (beamId),
   m_minElevationAngleInDeg (1),
   m_antennaGainPatterns (patterns),
-  m_geoPos (geoPos)
+  m_geoPos (geoPos),
+  m_tableBeamId (0),
+  m_tableMinElevationAngleInDeg (0)
 {
 }
 
@@ -253,45 +258,143 @@ SatSpotBeamPositionAllocator::SetAltitude (Ptr<RandomVariableStream> altitude)
   m_altitude = altitude;
 }
 
+void
+SatSpotBeamPositionAllocator::SetMinElevationAngle (double minElevationAngleInDeg)
+{
+  NS_LOG_FUNCTION (this << minElevationAngleInDeg);
+
+  m_minElevationAngleInDeg = minElevationAngleInDeg;
+}
+
+double
+SatSpotBeamPositionAllocator::GetMinElevationAngle () const
+{
+  return m_minElevationAngleInDeg;
+}
+
+void
+SatSpotBeamPositionAllocator::UpdateSamplingTable () const
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_cells.empty ()
+      || m_tableBeamId != m_targetBeamId
+      || m_tableMinElevationAngleInDeg != m_minElevationAngleInDeg
+      || m_tableAntennaGainPatterns != m_antennaGainPatterns)
+    {
+      CreateSamplingTable ();
+    }
+}
+
+void
+SatSpotBeamPositionAllocator::CreateSamplingTable () const
+{
+  NS_LOG_FUNCTION (this);
+
+  m_utMobility = CreateObject<SatConstantPositionMobilityModel> ();
+  m_geoMobility = CreateObject<SatConstantPositionMobilityModel> ();
+  m_utMobility->SetGeoPosition (GeoCoordinate (0.00, 0.00, 0.00));
+  m_geoMobility->SetGeoPosition (m_geoPos);
+  m_utObserver = CreateObject<SatMobilityObserver> (m_utMobility, m_geoMobility);
+
+  Ptr<SatAntennaGainPattern> agp = m_antennaGainPatterns->GetAntennaGainPattern (m_targetBeamId);
+  std::vector< std::pair<double, double> > validCells = agp->GetValidCells ();
+  std::pair<double, double> cellSize = agp->GetCellSize ();
+
+  // Corners are checked slightly inside the cell, at the limits of the positions drawn from the cell
+  double latExtent = cellSize.first - 0.001;
+  double lonExtent = cellSize.second - 0.001;
+
+  m_cells.clear ();
+  m_cellFullyValid.clear ();
+
+  for (std::vector< std::pair<double, double> >::const_iterator it = validCells.begin (); it != validCells.end (); ++it)
+    {
+      GeoCoordinate corners[4] = { GeoCoordinate (it->first, it->second, 0.0),
+                                   GeoCoordinate (it->first + latExtent, it->second, 0.0),
+                                   GeoCoordinate (it->first, it->second + lonExtent, 0.0),
+                                   GeoCoordinate (it->first + latExtent, it->second + lonExtent, 0.0)};
+      uint32_t validCorners (0);
+
+      for (uint32_t i = 0; i < 4; ++i)
+        {
+          if (!std::isnan (GetValidElevation (corners[i], true)))
+            {
+              ++validCorners;
+            }
+        }
+
+      if (validCorners > 0)
+        {
+          m_cells.push_back (*it);
+          m_cellFullyValid.push_back (validCorners == 4);
+        }
+    }
+
+  m_tableBeamId = m_targetBeamId;
+  m_tableMinElevationAngleInDeg = m_minElevationAngleInDeg;
+  m_tableAntennaGainPatterns = m_antennaGainPatterns;
+
+  NS_LOG_INFO ("Sampling table for beam " << m_targetBeamId << " created with " << m_cells.size () << " cells out of " << validCells.size ());
+
+  if (m_cells.empty ())
+    {
+      NS_FATAL_ERROR (this << " no valid cells for spot-beam allocation of beam " << m_targetBeamId);
+    }
+}
+
+double
+SatSpotBeamPositionAllocator::GetValidElevation (GeoCoordinate pos, bool checkBestBeam) const
+{
+  NS_LOG_FUNCTION (this << checkBestBeam);
+
+  if (checkBestBeam && m_antennaGainPatterns->GetBestBeamId (pos) != m_targetBeamId)
+    {
+      return NAN;
+    }
+
+  // Set the position to the UT mobility and calculate the elevation angle
+  m_utMobility->SetGeoPosition (pos);
+  double elevation = m_utObserver->GetElevationAngle ();
+
+  if (std::isnan (elevation) || elevation < m_minElevationAngleInDeg)
+    {
+      return NAN;
+    }
+
+  return elevation;
+}
+
 GeoCoordinate
 SatSpotBeamPositionAllocator::GetNextGeoPosition () const
 {
   NS_LOG_FUNCTION (this);
 
-  uint32_t bestBeamId (std::numeric_limits<uint32_t>::max ());
+  UpdateSamplingTable ();
+
   Ptr<SatAntennaGainPattern> agp = m_antennaGainPatterns->GetAntennaGainPattern (m_targetBeamId);
   uint32_t tries (0);
+  uint32_t cellIndex (0);
   GeoCoordinate pos;
+  double elevation (NAN);
 
-  Ptr<SatConstantPositionMobilityModel> utMob = CreateObject<SatConstantPositionMobilityModel> ();
-  Ptr<SatConstantPositionMobilityModel> geoMob = CreateObject<SatConstantPositionMobilityModel> ();
-  utMob->SetGeoPosition (GeoCoordinate (0.00, 0.00, 0.00));
-  geoMob->SetGeoPosition (m_geoPos);
-  Ptr<SatMobilityObserver> utObserver = CreateObject<SatMobilityObserver> (utMob, geoMob);
-
-  double elevation (std::numeric_limits<double>::max ());
-
-  // Try until
+  // Draw from the sampling table until
   // - we have a valid position
   // - the MAX_TRIES have been exceeded
-  // - elevation is NOT NaN
-  // - elevation is not higher than threshold
-  while ( ( bestBeamId != m_targetBeamId || std::isnan (elevation) || elevation < m_minElevationAngleInDeg ) && tries < MAX_TRIES)
+  // Best beam is known for positions drawn from fully valid cells, so only
+  // the elevation angle is checked for them. Draws are rejected only at the
+  // edges of the coverage: in cells valid at some corners only, or where the
+  // elevation angle crosses the threshold inside a cell.
+  while ( std::isnan (elevation) && tries < MAX_TRIES)
     {
-      pos = agp->GetValidRandomPosition ();
-      bestBeamId = m_antennaGainPatterns->GetBestBeamId (pos);
-
-      // Set the new position to the UT mobility
-      utMob->SetGeoPosition (pos);
-
-      // Calculate the elevation angle
-      elevation = utObserver->GetElevationAngle ();
+      pos = agp->GetRandomPositionInCells (m_cells, cellIndex);
+      elevation = GetValidElevation (pos, !m_cellFullyValid[cellIndex]);
 
       ++tries;
     }
 
   // If the positioning fails
-  if (tries >= MAX_TRIES)
+  if (std::isnan (elevation))
     {
       NS_FATAL_ERROR (this << " max number of tries for spot-beam allocation exceeded!");
     }
@@ -26,6 +26,8 @@
 #include "ns3/position-allocator.h"
 #include "geo-coordinate.h"
 #include "satellite-antenna-gain-pattern-container.h"
+#include "satellite-constant-position-mobility-model.h"
+#include "satellite-mobility-observer.h"
 
 namespace ns3 {
 
@@ -195,6 +197,22 @@ public:
 
   void SetAltitude (Ptr<RandomVariableStream> altitude);
 
+  /**
+   * \brief Set the minimum accepted elevation angle of the UTs.
+   *
+   * The sampling table depends on the elevation angle, so it is
+   * rebuilt at the next position request.
+   *
+   * \param minElevationAngleInDeg minimum elevation angle in degrees
+   */
+  void SetMinElevationAngle (double minElevationAngleInDeg);
+
+  /**
+   * \brief Get the minimum accepted elevation angle of the UTs.
+   * \return minimum elevation angle in degrees
+   */
+  double GetMinElevationAngle (void) const;
+
   /**
    * \brief Get next position
    * \return The next chosen position.
@@ -202,6 +220,31 @@ public:
   virtual GeoCoordinate GetNextGeoPosition (void) const;
   virtual int64_t AssignStreams (int64_t stream);
 private:
+  /**
+   * \brief Check that the sampling table matches the current configuration,
+   * and create it again if not.
+   */
+  void UpdateSamplingTable (void) const;
+
+  /**
+   * \brief Create the sampling table of the target beam.
+   *
+   * The table holds the cells of the target beam antenna pattern, where
+   * the target beam is the best beam and the elevation angle is above
+   * m_minElevationAngleInDeg at least at one corner. Cells where the
+   * conditions hold at all corners are marked as fully valid, so the
+   * best beam of the positions drawn from them does not need to be checked.
+   */
+  void CreateSamplingTable (void) const;
+
+  /**
+   * \brief Check if the given position fulfills the beam and elevation angle conditions.
+   * \param pos position to check
+   * \param checkBestBeam whether the best beam needs to be checked
+   * \return elevation angle at the position, NAN if the position is not valid
+   */
+  double GetValidElevation (GeoCoordinate pos, bool checkBestBeam) const;
+
   /**
    * Max number of tries to pick a random position for a UT.
    */
@@ -241,6 +284,30 @@ private:
    * A random variable stream for altitude.
    */
   Ptr<RandomVariableStream> m_altitude;
+
+  /**
+   * Lower left corners {latitude, longitude} of the cells in the sampling table.
+   */
+  mutable std::vector< std::pair<double, double> > m_cells;
+
+  /**
+   * Flags telling whether all positions of the corresponding cell in m_cells are valid.
+   */
+  mutable std::vector<bool> m_cellFullyValid;
+
+  /**
+   * Configuration the sampling table was created for.
+   */
+  mutable uint32_t m_tableBeamId;
+  mutable double m_tableMinElevationAngleInDeg;
+  mutable Ptr<SatAntennaGainPatternContainer> m_tableAntennaGainPatterns;
+
+  /**
+   * Mobilities and observer reused for the elevation angle calculations.
+   */
+  mutable Ptr<SatConstantPositionMobilityModel> m_utMobility;
+  mutable Ptr<SatConstantPositionMobilityModel> m_geoMobility;
+  mutable Ptr<SatMobilityObserver> m_utObserver;
 };
 
 
@@ -19,6 +19,7 @@
  */
 
 #include <ns3/satellite-env-variables.h>
+#include <ns3/satellite-input-fstream-wrapper.h>
 #include "satellite-position-input-trace-container.h"
 
 
@@ -72,35 +73,79 @@ SatPositionInputTraceContainer::Reset ()
 {
   NS_LOG_FUNCTION (this);
 
-  if (!m_container.empty ())
-    {
-      m_container.clear ();
-    }
+  m_container.clear ();
+  m_handles.clear ();
 }
 
-Ptr<SatInputFileStreamTimeDoubleContainer>
+uint32_t
 SatPositionInputTraceContainer::AddNode (const std::string& filename)
 {
   NS_LOG_FUNCTION (this << filename);
 
-  std::pair <container_t::iterator, bool> result = m_container.insert (std::make_pair (filename, CreateObject<SatInputFileStreamTimeDoubleContainer> (filename.c_str (), std::ios::in, SatBaseTraceContainer::POSITION_TRACE_DEFAULT_NUMBER_OF_COLUMNS)));
+  SatInputFileStreamWrapper inputFileStreamWrapper (filename, std::ios::in);
+  std::ifstream* inputFileStream = inputFileStreamWrapper.GetStream ();
+
+  if (!inputFileStream->is_open ())
+    {
+      NS_FATAL_ERROR ("SatPositionInputTraceContainer::AddNode - Input stream is not valid for reading: " << filename);
+    }
+
+  positionTrace_t trace;
+  trace.m_cursor = 0;
+
+  double values[SatBaseTraceContainer::POSITION_TRACE_DEFAULT_NUMBER_OF_COLUMNS];
+
+  while (true)
+    {
+      for (uint32_t i = 0; i < SatBaseTraceContainer::POSITION_TRACE_DEFAULT_NUMBER_OF_COLUMNS; i++)
+        {
+          *inputFileStream >> values[i];
+        }
+
+      if (inputFileStream->eof ())
+        {
+          break;
+        }
+
+      if (!trace.m_times.empty () && trace.m_times.back () > values[0])
+        {
+          NS_FATAL_ERROR ("SatPositionInputTraceContainer::AddNode - Invalid input file format (time sample error)");
+        }
+
+      trace.m_times.push_back (values[0]);
+      trace.m_latitudes.push_back (values[SatBaseTraceContainer::POSITION_TRACE_DEFAULT_LATITUDE_INDEX]);
+      trace.m_longitudes.push_back (values[SatBaseTraceContainer::POSITION_TRACE_DEFAULT_LONGITUDE_INDEX]);
+      trace.m_altitudes.push_back (values[SatBaseTraceContainer::POSITION_TRACE_DEFAULT_ALTITUDE_INDEX]);
+    }
+
+  inputFileStream->close ();
+
+  if (trace.m_times.empty ())
+    {
+      NS_FATAL_ERROR ("SatPositionInputTraceContainer::AddNode - Empty file");
+    }
+
+  uint32_t handle = m_container.size ();
+  m_container.push_back (trace);
+
+  std::pair <handleMap_t::iterator, bool> result = m_handles.insert (std::make_pair (filename, handle));
 
   if (result.second == false)
     {
       NS_FATAL_ERROR ("SatPositionInputTraceContainer::AddNode failed");
     }
 
-  return result.first->second;
+  return handle;
 }
 
-Ptr<SatInputFileStreamTimeDoubleContainer>
-SatPositionInputTraceContainer::FindNode (const std::string& key)
+uint32_t
+SatPositionInputTraceContainer::GetTraceHandle (const std::string& key)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << key);
 
-  container_t::iterator iter = m_container.find (key);
+  handleMap_t::iterator iter = m_handles.find (key);
 
-  if (iter == m_container.end ())
+  if (iter == m_handles.end ())
     {
       return AddNode (key);
     }
@@ -111,13 +156,48 @@ SatPositionInputTraceContainer::FindNode (const std::string& key)
 GeoCoordinate
 SatPositionInputTraceContainer::GetPosition (const std::string& key, GeoCoordinate::ReferenceEllipsoid_t refEllipsoid)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << key);
+
+  return GetPosition (GetTraceHandle (key), refEllipsoid);
+}
+
+GeoCoordinate
+SatPositionInputTraceContainer::GetPosition (uint32_t handle, GeoCoordinate::ReferenceEllipsoid_t refEllipsoid)
+{
+  NS_LOG_FUNCTION (this << handle);
+
+  NS_ASSERT (handle < m_container.size ());
+
+  positionTrace_t& trace = m_container[handle];
+  double currentTime = Now ().GetSeconds ();
+  uint32_t lastIndex = trace.m_times.size () - 1;
+
+  // time is expected to move forward, so seek only backwards if needed
+  while (trace.m_cursor > 0 && trace.m_times[trace.m_cursor] > currentTime)
+    {
+      trace.m_cursor--;
+    }
+
+  while (trace.m_cursor < lastIndex && trace.m_times[trace.m_cursor + 1] <= currentTime)
+    {
+      trace.m_cursor++;
+    }
+
+  uint32_t i = trace.m_cursor;
+
+  // No enclosing samples available before the first or after the last sample
+  if (trace.m_times[i] >= currentTime || i == lastIndex)
+    {
+      return GeoCoordinate (trace.m_latitudes[i], trace.m_longitudes[i], trace.m_altitudes[i], refEllipsoid);
+    }
+
+  // linear interpolation between the samples enclosing the current time
+  double linearCoefficient = (currentTime - trace.m_times[i]) / (trace.m_times[i + 1] - trace.m_times[i]);
 
-  std::vector<double> row = FindNode (key)->InterpolateBetweenClosestTimeSamples ();
   return GeoCoordinate (
-    row.at (SatBaseTraceContainer::POSITION_TRACE_DEFAULT_LATITUDE_INDEX),
-    row.at (SatBaseTraceContainer::POSITION_TRACE_DEFAULT_LONGITUDE_INDEX),
-    row.at (SatBaseTraceContainer::POSITION_TRACE_DEFAULT_ALTITUDE_INDEX),
+    trace.m_latitudes[i] + linearCoefficient * (trace.m_latitudes[i + 1] - trace.m_latitudes[i]),
+    trace.m_longitudes[i] + linearCoefficient * (trace.m_longitudes[i + 1] - trace.m_longitudes[i]),
+    trace.m_altitudes[i] + linearCoefficient * (trace.m_altitudes[i + 1] - trace.m_altitudes[i]),
     refEllipsoid);
 }
 
@@ -21,7 +21,8 @@
 #ifndef SATELLITE_POSITION_INPUT_TRACE_CONTAINER_H
 #define SATELLITE_POSITION_INPUT_TRACE_CONTAINER_H
 
-#include <ns3/satellite-input-fstream-time-double-container.h>
+#include <map>
+#include <vector>
 #include "satellite-antenna-gain-pattern-container.h"
 #include "satellite-base-trace-container.h"
 #include "geo-coordinate.h"
@@ -30,17 +31,38 @@ namespace ns3 {
 
 /**
  * \ingroup satellite
+ * \brief Class for position input trace container. The class contains
+ * multiple position input sample traces and provides an interface to them.
  *
- * \brief Class for Rx power input trace container. The class contains
- * multiple Rx power input sample traces and provides an interface to them.
+ * Each trace is stored as contiguous per-column arrays and identified by
+ * a handle, which can be resolved once with GetTraceHandle and then used
+ * for allocation free position lookups. Lookups are expected to move forward
+ * in time, so the closest samples are located with a cursor kept per trace.
  */
 class SatPositionInputTraceContainer : public SatBaseTraceContainer
 {
 public:
   /**
-   * \brief typedef for map of containers
+   * \brief Struct for one position trace stored in columns
    */
-  typedef std::map <std::string, Ptr<SatInputFileStreamTimeDoubleContainer> > container_t;
+  typedef struct
+  {
+    std::vector<double> m_times;
+    std::vector<double> m_latitudes;
+    std::vector<double> m_longitudes;
+    std::vector<double> m_altitudes;
+    uint32_t m_cursor;
+  } positionTrace_t;
+
+  /**
+   * \brief typedef for container of traces
+   */
+  typedef std::vector<positionTrace_t> container_t;
+
+  /**
+   * \brief typedef for map of trace handles by file name
+   */
+  typedef std::map <std::string, uint32_t> handleMap_t;
 
   /**
    * \brief Constructor
@@ -70,12 +92,30 @@ public:
   void DoDispose ();
 
   /**
-   * \brief Function for getting the Rx power density
-   * \param key key
-   * \return Rx power density
+   * \brief Function for getting the handle of a trace. Trace is read from
+   * the file when its handle is requested first time.
+   * \param key filename to read positions from
+   * \return handle of the trace
+   */
+  uint32_t GetTraceHandle (const std::string& key);
+
+  /**
+   * \brief Function for getting the position at current simulation time
+   * \param key filename to read positions from
+   * \param refEllipsoid reference ellipsoid of the returned position
+   * \return position
    */
   GeoCoordinate GetPosition (const std::string& key, GeoCoordinate::ReferenceEllipsoid_t refEllipsoid);
 
+  /**
+   * \brief Function for getting the position at current simulation time
+   * with a pre-resolved trace handle
+   * \param handle handle of the trace got from GetTraceHandle
+   * \param refEllipsoid reference ellipsoid of the returned position
+   * \return position
+   */
+  GeoCoordinate GetPosition (uint32_t handle, GeoCoordinate::ReferenceEllipsoid_t refEllipsoid);
+
   /**
    * \brief Function for resetting the variables
    */
@@ -83,23 +123,21 @@ public:
 
 private:
   /**
-   * \brief Function for adding the node to the map
+   * \brief Function for reading a trace from file and adding it to the container
    * \param key filename to read positions from
-   * \return pointer to the added container
+   * \return handle of the added trace
    */
-  Ptr<SatInputFileStreamTimeDoubleContainer> AddNode (const std::string& key);
+  uint32_t AddNode (const std::string& key);
 
   /**
-   * \brief Function for finding the container matching the key
-   * \param key key
-   * \return matching container
+   * \brief Container for traces
    */
-  Ptr<SatInputFileStreamTimeDoubleContainer> FindNode (const std::string& key);
+  container_t m_container;
 
   /**
-   * \brief Map for containers
+   * \brief Map for trace handles
    */
-  container_t m_container;
+  handleMap_t m_handles;
 };
 
 } // namespace ns3
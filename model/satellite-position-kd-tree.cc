@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "ns3/log.h"
+#include "satellite-position-kd-tree.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatPositionKdTree");
+
+namespace ns3 {
+
+const uint32_t SatPositionKdTree::NO_NODE;
+
+SatPositionKdTree::SatPositionKdTree ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SatPositionKdTree::Build (const std::vector<Vector>& positions)
+{
+  NS_LOG_FUNCTION (this << positions.size ());
+
+  std::vector<Node_t> nodes;
+  nodes.reserve (positions.size ());
+
+  for (uint32_t i = 0; i < positions.size (); i++)
+    {
+      Node_t node;
+      node.m_position = positions[i];
+      node.m_item = i;
+      node.m_axis = 0;
+      node.m_left = NO_NODE;
+      node.m_right = NO_NODE;
+      nodes.push_back (node);
+    }
+
+  m_nodes.clear ();
+  m_nodes.reserve (nodes.size ());
+
+  BuildNode (nodes, 0, nodes.size (), 0);
+}
+
+bool
+SatPositionKdTree::FindNearest (const Vector& position, uint32_t& item, double& distance) const
+{
+  NS_LOG_FUNCTION (this << position);
+
+  if (m_nodes.empty ())
+    {
+      return false;
+    }
+
+  uint32_t bestItem = NO_NODE;
+  double bestDistanceSquared = std::numeric_limits<double>::max ();
+
+  FindNearestNode (0, position, bestItem, bestDistanceSquared);
+
+  item = bestItem;
+  distance = std::sqrt (bestDistanceSquared);
+  return true;
+}
+
+uint32_t
+SatPositionKdTree::GetSize () const
+{
+  return m_nodes.size ();
+}
+
+uint32_t
+SatPositionKdTree::BuildNode (std::vector<Node_t>& nodes, uint32_t first, uint32_t last, uint32_t depth)
+{
+  if (first >= last)
+    {
+      return NO_NODE;
+    }
+
+  uint32_t axis = depth % 3;
+  uint32_t median = first + (last - first) / 2;
+
+  std::nth_element (nodes.begin () + first, nodes.begin () + median, nodes.begin () + last,
+                    [axis] (const Node_t& a, const Node_t& b)
+                    {
+                      return ( axis == 0 ? a.m_position.x < b.m_position.x :
+                               ( axis == 1 ? a.m_position.y < b.m_position.y : a.m_position.z < b.m_position.z ) );
+                    });
+
+  uint32_t index = m_nodes.size ();
+  m_nodes.push_back (nodes[median]);
+  m_nodes[index].m_axis = axis;
+
+  uint32_t left = BuildNode (nodes, first, median, depth + 1);
+  uint32_t right = BuildNode (nodes, median + 1, last, depth + 1);
+
+  m_nodes[index].m_left = left;
+  m_nodes[index].m_right = right;
+
+  return index;
+}
+
+void
+SatPositionKdTree::FindNearestNode (uint32_t node, const Vector& position, uint32_t& bestItem, double& bestDistanceSquared) const
+{
+  if (node == NO_NODE)
+    {
+      return;
+    }
+
+  const Node_t& current = m_nodes[node];
+
+  double dx = position.x - current.m_position.x;
+  double dy = position.y - current.m_position.y;
+  double dz = position.z - current.m_position.z;
+  double distanceSquared = dx * dx + dy * dy + dz * dz;
+
+  if ( distanceSquared < bestDistanceSquared
+       || ( distanceSquared == bestDistanceSquared && current.m_item < bestItem ) )
+    {
+      bestDistanceSquared = distanceSquared;
+      bestItem = current.m_item;
+    }
+
+  double axisDelta = ( current.m_axis == 0 ? dx : ( current.m_axis == 1 ? dy : dz ) );
+  uint32_t nearChild = ( axisDelta < 0 ? current.m_left : current.m_right );
+  uint32_t farChild = ( axisDelta < 0 ? current.m_right : current.m_left );
+
+  FindNearestNode (nearChild, position, bestItem, bestDistanceSquared);
+
+  // the other side of the splitting plane may contain a closer (or equally close) position
+  if ( axisDelta * axisDelta <= bestDistanceSquared )
+    {
+      FindNearestNode (farChild, position, bestItem, bestDistanceSquared);
+    }
+}
+
+} // namespace ns3
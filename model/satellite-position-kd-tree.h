@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SATELLITE_POSITION_KD_TREE_H
+#define SATELLITE_POSITION_KD_TREE_H
+
+#include <vector>
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * \brief k-d tree of Cartesian positions, used to find the position nearest
+ * to a given one without scanning all of them.
+ *
+ * Positions are identified by their index in the vector given to Build.
+ * From equally distant positions the one with the lowest index is found,
+ * so the result is the same as the one of a linear scan keeping the first
+ * nearest position.
+ */
+class SatPositionKdTree
+{
+public:
+  /**
+   * \brief Default constructor, creates an empty tree.
+   */
+  SatPositionKdTree ();
+
+  /**
+   * \brief Build the tree from the given positions, replacing the previous ones.
+   * \param positions Positions to index
+   */
+  void Build (const std::vector<Vector>& positions);
+
+  /**
+   * \brief Find the position nearest to the given one.
+   * \param position Position to find the nearest indexed position for
+   * \param item Index of the nearest position is stored here
+   * \param distance Distance to the nearest position is stored here
+   * \return false if the tree is empty, true otherwise
+   */
+  bool FindNearest (const Vector& position, uint32_t& item, double& distance) const;
+
+  /**
+   * \brief Get the number of indexed positions.
+   * \return the number of positions
+   */
+  uint32_t GetSize () const;
+
+private:
+  /**
+   * Node of the tree.
+   */
+  typedef struct
+  {
+    Vector m_position;  // indexed position
+    uint32_t m_item;    // index of the position in the vector given to Build
+    uint32_t m_axis;    // splitting axis of the node (0 = x, 1 = y, 2 = z)
+    uint32_t m_left;    // index of the left child node, NO_NODE if none
+    uint32_t m_right;   // index of the right child node, NO_NODE if none
+  } Node_t;
+
+  /// Value used for the missing child node of a node
+  static const uint32_t NO_NODE = 0xFFFFFFFF;
+
+  /**
+   * Recursively build a subtree from the given nodes.
+   *
+   * \param nodes Nodes of the subtree, reordered while building
+   * \param first Index of the first node of the subtree in nodes
+   * \param last Index past the last node of the subtree in nodes
+   * \param depth Depth of the subtree root in the tree
+   * \return Index of the subtree root in m_nodes
+   */
+  uint32_t BuildNode (std::vector<Node_t>& nodes, uint32_t first, uint32_t last, uint32_t depth);
+
+  /**
+   * Recursively search a subtree for the nearest position.
+   *
+   * \param node Index of the subtree root to search
+   * \param position Position to find the nearest indexed position for
+   * \param bestItem Index of the nearest position found so far
+   * \param bestDistanceSquared Squared distance to the nearest position found so far
+   */
+  void FindNearestNode (uint32_t node, const Vector& position, uint32_t& bestItem, double& bestDistanceSquared) const;
+
+  /**
+   * Nodes of the tree, root node is the first node.
+   */
+  std::vector<Node_t> m_nodes;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_POSITION_KD_TREE_H */
@@ -144,11 +144,14 @@ SatQueue::Enqueue (Ptr<Packet> p)
     {
       NS_LOG_INFO ("Queue full (at max packets) -- dropping pkt");
 
-      std::stringstream msg;
-      msg << "SatQueue is full: packet dropped!";
-      msg << " at: " << Now ().GetSeconds () << "s";
-      msg << " MaxPackets: " << m_maxPackets;
-      Singleton<SatLog>::Get ()->AddToLog (SatLog::LOG_WARNING, "", msg.str ());
+      if (Singleton<SatLog>::Get ()->IsEnabled (SatLog::LOG_WARNING))
+        {
+          std::stringstream msg;
+          msg << "SatQueue is full: packet dropped!";
+          msg << " at: " << Now ().GetSeconds () << "s";
+          msg << " MaxPackets: " << m_maxPackets;
+          Singleton<SatLog>::Get ()->AddToLog (SatLog::LOG_WARNING, "", msg.str ());
+        }
 
       Drop (p);
       return false;
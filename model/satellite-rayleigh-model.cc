@@ -36,7 +36,8 @@ TypeId SatRayleighModel::GetTypeId (void)
 SatRayleighModel::SatRayleighModel ()
   : m_currentSet (),
   m_currentState (),
-  m_rayleighConf ()
+  m_rayleighConf (),
+  m_useOscillatorBank (false)
 {
   NS_LOG_FUNCTION (this);
 
@@ -46,7 +47,8 @@ SatRayleighModel::SatRayleighModel ()
 SatRayleighModel::SatRayleighModel (Ptr<SatRayleighConf> rayleighConf, uint32_t initialSet, uint32_t initialState)
   : m_currentSet (initialSet),
   m_currentState (initialState),
-  m_rayleighConf (rayleighConf)
+  m_rayleighConf (rayleighConf),
+  m_useOscillatorBank (rayleighConf->GetUseOscillatorBank ())
 {
   NS_LOG_FUNCTION (this);
 
@@ -82,6 +84,7 @@ SatRayleighModel::Reset ()
 
   m_rayleighConf = NULL;
   m_oscillators.clear ();
+  m_oscillatorBank = NULL;
   m_uniformVariable = NULL;
 }
 
@@ -90,6 +93,11 @@ SatRayleighModel::ConstructOscillators ()
 {
   NS_LOG_FUNCTION (this);
 
+  if (m_useOscillatorBank)
+    {
+      m_oscillatorBank = CreateObject<SatFadingOscillatorBank> ();
+    }
+
   ///Initial phase is common for all oscillators:
   double phi = m_uniformVariable->GetValue ();
   /// Theta is common for all oscillators:
@@ -106,7 +114,14 @@ SatRayleighModel::ConstructOscillators ()
       double psi = m_uniformVariable->GetValue ();
       std::complex<double> amplitude = std::complex<double> (std::cos (psi), std::sin (psi)) * 2.0 / std::sqrt (m_rayleighParameters[0][1]);
       /// 3. Construct oscillator:
-      m_oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+      if (m_useOscillatorBank)
+        {
+          m_oscillatorBank->AddOscillator (amplitude, phi, omega);
+        }
+      else
+        {
+          m_oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+        }
     }
 }
 
@@ -115,7 +130,18 @@ SatRayleighModel::GetComplexGain ()
 {
   NS_LOG_FUNCTION (this);
 
-  double timeInSeconds = Now ().GetSeconds ();
+  return CalculateComplexGain (Now ().GetSeconds ());
+}
+
+std::complex<double>
+SatRayleighModel::CalculateComplexGain (double timeInSeconds)
+{
+  NS_LOG_FUNCTION (this << timeInSeconds);
+
+  if (m_useOscillatorBank)
+    {
+      return m_oscillatorBank->GetComplexSumAt (timeInSeconds);
+    }
 
   std::complex<double> sumAmplitude = std::complex<double> (0, 0);
   for (uint32_t i = 0; i < m_oscillators.size (); i++)
@@ -156,4 +182,37 @@ SatRayleighModel::UpdateParameters (uint32_t newSet, uint32_t newState)
   m_currentState = newState;
 }
 
+void
+SatRayleighModel::GetChannelGains (uint32_t state, double startTime, double timeStep, bool useDecibels, std::vector<double>& gains)
+{
+  NS_LOG_FUNCTION (this << state << startTime << timeStep << useDecibels << gains.size ());
+
+  std::vector<std::complex<double> > complexGains (gains.size ());
+
+  if (m_useOscillatorBank)
+    {
+      m_oscillatorBank->GetComplexSumsAt (startTime, timeStep, complexGains);
+    }
+  else
+    {
+      for (uint32_t k = 0; k < complexGains.size (); k++)
+        {
+          complexGains[k] = CalculateComplexGain (startTime + k * timeStep);
+        }
+    }
+
+  for (uint32_t k = 0; k < gains.size (); k++)
+    {
+      gains[k] = std::norm (complexGains[k]) / 2;
+    }
+
+  if (useDecibels)
+    {
+      for (uint32_t k = 0; k < gains.size (); k++)
+        {
+          gains[k] = 10 * std::log10 (gains[k]);
+        }
+    }
+}
+
 } // namespace ns3
@@ -22,6 +22,7 @@
 
 #include "ns3/vector.h"
 #include "satellite-fading-oscillator.h"
+#include "satellite-fading-oscillator-bank.h"
 #include "satellite-base-fader.h"
 #include "ns3/random-variable-stream.h"
 #include "satellite-rayleigh-conf.h"
@@ -92,12 +93,29 @@ public:
    */
   void UpdateParameters (uint32_t set, uint32_t state);
 
+  /**
+   * \brief Function for calculating the channel gains at fixed time steps
+   * \param state state, not used by Rayleigh model
+   * \param startTime time of the first channel gain in seconds
+   * \param timeStep time step between the channel gains in seconds
+   * \param useDecibels whether the channel gains are calculated in dB
+   * \param gains vector filled with the channel gains, its size defines the number of gains
+   */
+  void GetChannelGains (uint32_t state, double startTime, double timeStep, bool useDecibels, std::vector<double>& gains);
+
 private:
   /**
    * \brief Function for constructing the oscillators
    */
   void ConstructOscillators ();
 
+  /**
+   * \brief Function for calculating the complex gain at the given time
+   * \param timeInSeconds time in seconds
+   * \return complex gain
+   */
+  std::complex<double> CalculateComplexGain (double timeInSeconds);
+
   /**
    * \brief Clear used variables
    */
@@ -132,6 +150,17 @@ private:
    * \brief Rayleigh model parameters
    */
   std::vector<std::vector<double> > m_rayleighParameters;
+
+  /**
+   * \brief Evaluate the oscillators with an oscillator bank
+   */
+  bool m_useOscillatorBank;
+
+  /**
+   * \brief Oscillator bank, used instead of the vector of oscillators
+   * when oscillator bank is enabled
+   */
+  Ptr<SatFadingOscillatorBank> m_oscillatorBank;
 };
 
 } // namespace ns3
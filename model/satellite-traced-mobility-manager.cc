@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <algorithm>
+#include <ns3/simulator.h>
+#include <ns3/log.h>
+#include "satellite-traced-mobility-model.h"
+#include "satellite-traced-mobility-manager.h"
+
+
+NS_LOG_COMPONENT_DEFINE ("SatTracedMobilityManager");
+
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatTracedMobilityManager);
+
+TypeId
+SatTracedMobilityManager::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatTracedMobilityManager")
+    .SetParent<Object> ()
+    .AddConstructor<SatTracedMobilityManager> ()
+  ;
+
+  return tid;
+}
+
+TypeId
+SatTracedMobilityManager::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+SatTracedMobilityManager::SatTracedMobilityManager ()
+  : m_isResetScheduled (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatTracedMobilityManager::~SatTracedMobilityManager ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_updateGroups.clear ();
+}
+
+void
+SatTracedMobilityManager::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Reset ();
+
+  Object::DoDispose ();
+}
+
+void
+SatTracedMobilityManager::Reset ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (updateGroupMap_t::iterator it = m_updateGroups.begin (); it != m_updateGroups.end (); ++it)
+    {
+      it->second.m_updateEvent.Cancel ();
+    }
+
+  m_updateGroups.clear ();
+  m_isResetScheduled = false;
+}
+
+void
+SatTracedMobilityManager::AddMobility (Ptr<SatTracedMobilityModel> mobility, Time updateInterval)
+{
+  NS_LOG_FUNCTION (this << mobility << updateInterval);
+
+  if (!m_isResetScheduled)
+    {
+      // The singleton outlives the simulator, do not keep its events
+      Simulator::ScheduleDestroy (&SatTracedMobilityManager::Reset, this);
+      m_isResetScheduled = true;
+    }
+
+  updateGroup_t& group = m_updateGroups[updateInterval];
+
+  if (!group.m_updateEvent.IsRunning ())
+    {
+      NS_LOG_INFO ("Scheduling update of the group for interval " << updateInterval);
+      group.m_updateEvent = Simulator::Schedule (updateInterval, &SatTracedMobilityManager::UpdatePositions, this, updateInterval);
+    }
+
+  group.m_mobilities.push_back (mobility);
+}
+
+void
+SatTracedMobilityManager::RemoveMobility (Ptr<SatTracedMobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+
+  for (updateGroupMap_t::iterator it = m_updateGroups.begin (); it != m_updateGroups.end (); ++it)
+    {
+      std::vector<Ptr<SatTracedMobilityModel> >& mobilities = it->second.m_mobilities;
+      std::vector<Ptr<SatTracedMobilityModel> >::iterator found = std::find (mobilities.begin (), mobilities.end (), mobility);
+
+      if (found != mobilities.end ())
+        {
+          mobilities.erase (found);
+
+          if (mobilities.empty ())
+            {
+              it->second.m_updateEvent.Cancel ();
+              m_updateGroups.erase (it);
+            }
+          return;
+        }
+    }
+}
+
+uint32_t
+SatTracedMobilityManager::GetNumOfMobilities (Time updateInterval) const
+{
+  NS_LOG_FUNCTION (this << updateInterval);
+
+  updateGroupMap_t::const_iterator it = m_updateGroups.find (updateInterval);
+
+  if (it == m_updateGroups.end ())
+    {
+      return 0;
+    }
+
+  return it->second.m_mobilities.size ();
+}
+
+void
+SatTracedMobilityManager::UpdatePositions (Time updateInterval)
+{
+  NS_LOG_FUNCTION (this << updateInterval);
+
+  updateGroupMap_t::iterator it = m_updateGroups.find (updateInterval);
+
+  if (it == m_updateGroups.end ())
+    {
+      return;
+    }
+
+  it->second.m_updateEvent = Simulator::Schedule (updateInterval, &SatTracedMobilityManager::UpdatePositions, this, updateInterval);
+
+  // Course change callbacks may remove mobilities, and even the group
+  const std::vector<Ptr<SatTracedMobilityModel> > mobilities = it->second.m_mobilities;
+
+  for (std::vector<Ptr<SatTracedMobilityModel> >::const_iterator mobility = mobilities.begin (); mobility != mobilities.end (); ++mobility)
+    {
+      (*mobility)->UpdateGeoPositionFromFile ();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SATELLITE_TRACED_MOBILITY_MANAGER_H
+#define SATELLITE_TRACED_MOBILITY_MANAGER_H
+
+#include <map>
+#include <vector>
+#include <ns3/object.h>
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+
+namespace ns3 {
+
+class SatTracedMobilityModel;
+
+/**
+ * \ingroup satellite
+ * \brief Manager for updating the positions of traced mobility models.
+ *
+ * Instead of each SatTracedMobilityModel scheduling its own periodic update
+ * event, mobilities sharing the same update interval are grouped together
+ * and updated in a single event. Course change is still notified separately
+ * by each updated mobility. The manager is used as a singleton, which is
+ * reset when the simulator is destroyed.
+ */
+class SatTracedMobilityManager : public Object
+{
+public:
+  /**
+   * \brief Get the type ID
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  TypeId GetInstanceTypeId (void) const;
+
+  /**
+   * \brief Constructor
+   */
+  SatTracedMobilityManager ();
+
+  /**
+   * \brief Destructor
+   */
+  virtual ~SatTracedMobilityManager ();
+
+  /**
+   * \brief Dispose of this class instance
+   */
+  virtual void DoDispose ();
+
+  /**
+   * \brief Add mobility to be updated periodically.
+   *
+   * First update of the mobility is done at the next update event of
+   * the group using the same update interval. If there is no such group
+   * yet, or if its update event is no longer scheduled, the next update
+   * event of the group is scheduled after the update interval from now.
+   *
+   * \param mobility mobility to update
+   * \param updateInterval interval at which the position should update
+   */
+  void AddMobility (Ptr<SatTracedMobilityModel> mobility, Time updateInterval);
+
+  /**
+   * \brief Remove mobility from the periodic updates.
+   * \param mobility mobility to remove
+   */
+  void RemoveMobility (Ptr<SatTracedMobilityModel> mobility);
+
+  /**
+   * \brief Get the number of mobilities updated at the given interval.
+   * \param updateInterval update interval of the group
+   * \return the number of mobilities in the group
+   */
+  uint32_t GetNumOfMobilities (Time updateInterval) const;
+
+  /**
+   * \brief Function for resetting the variables, called when the simulator
+   *        is destroyed
+   */
+  void Reset ();
+
+private:
+  /**
+   * \brief Struct for mobilities sharing the same update interval
+   */
+  typedef struct
+  {
+    EventId m_updateEvent;
+    std::vector<Ptr<SatTracedMobilityModel> > m_mobilities;
+  } updateGroup_t;
+
+  /**
+   * \brief typedef for map of update groups by update interval
+   */
+  typedef std::map<Time, updateGroup_t> updateGroupMap_t;
+
+  /**
+   * \brief Update positions of all mobilities in a group and schedule the next update
+   * \param updateInterval update interval of the group
+   */
+  void UpdatePositions (Time updateInterval);
+
+  /**
+   * \brief Map for update groups
+   */
+  updateGroupMap_t m_updateGroups;
+
+  /**
+   * \brief Flag telling whether Reset is scheduled at the simulator destruction
+   */
+  bool m_isResetScheduled;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_TRACED_MOBILITY_MANAGER_H */
@@ -24,6 +24,7 @@
 #include <ns3/singleton.h>
 #include "satellite-traced-mobility-model.h"
 #include "satellite-position-input-trace-container.h"
+#include "satellite-traced-mobility-manager.h"
 
 
 NS_LOG_COMPONENT_DEFINE ("SatTracedMobilityModel");
@@ -47,9 +48,10 @@ SatTracedMobilityModel::GetTypeId (void)
                                     GeoCoordinate::WGS84, "WGS84",
                                     GeoCoordinate::GRS80, "GRS80"))
     .AddAttribute ("UpdateInterval",
-                   "Interval at which the position should update",
+                   "Interval at which the position should update. Mobilities sharing the same interval are updated in a single event.",
                    TimeValue (MilliSeconds (1)),
-                   MakeTimeAccessor (&SatTracedMobilityModel::m_updateInterval),
+                   MakeTimeAccessor (&SatTracedMobilityModel::SetUpdateInterval,
+                                     &SatTracedMobilityModel::GetUpdateInterval),
                    MakeTimeChecker (FemtoSeconds (1)))
   ;
 
@@ -65,6 +67,8 @@ SatTracedMobilityModel::GetInstanceTypeId (void) const
 void
 SatTracedMobilityModel::DoDispose ()
 {
+  Singleton<SatTracedMobilityManager>::Get ()->RemoveMobility (this);
+  m_registered = false;
   m_antennaGainPatterns = NULL;
 
   Object::DoDispose ();
@@ -77,7 +81,9 @@ SatTracedMobilityModel::SatTracedMobilityModel ()
 
 SatTracedMobilityModel::SatTracedMobilityModel (const std::string& filename, Ptr<SatAntennaGainPatternContainer> agp)
   : m_traceFilename (filename),
+  m_traceHandle (0),
   m_updateInterval (MilliSeconds (1)),
+  m_registered (false),
   m_refEllipsoid (GeoCoordinate::SPHERE),
   m_geoPosition (0.0, 0.0, 0.0),
   m_velocity (0.0, 0.0, 0.0),
@@ -85,9 +91,41 @@ SatTracedMobilityModel::SatTracedMobilityModel (const std::string& filename, Ptr
 {
   NS_LOG_FUNCTION (this);
 
+  m_traceHandle = Singleton<SatPositionInputTraceContainer>::Get ()->GetTraceHandle (m_traceFilename);
   UpdateGeoPositionFromFile ();
 }
 
+void
+SatTracedMobilityModel::NotifyConstructionCompleted (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  SatMobilityModel::NotifyConstructionCompleted ();
+  Singleton<SatTracedMobilityManager>::Get ()->AddMobility (this, m_updateInterval);
+  m_registered = true;
+}
+
+void
+SatTracedMobilityModel::SetUpdateInterval (Time updateInterval)
+{
+  NS_LOG_FUNCTION (this << updateInterval);
+
+  if (m_registered && updateInterval != m_updateInterval)
+    {
+      SatTracedMobilityManager *manager = Singleton<SatTracedMobilityManager>::Get ();
+      manager->RemoveMobility (this);
+      manager->AddMobility (this, updateInterval);
+    }
+
+  m_updateInterval = updateInterval;
+}
+
+Time
+SatTracedMobilityModel::GetUpdateInterval (void) const
+{
+  return m_updateInterval;
+}
+
 SatTracedMobilityModel::~SatTracedMobilityModel ()
 {
   NS_LOG_FUNCTION (this);
@@ -129,10 +167,8 @@ SatTracedMobilityModel::UpdateGeoPositionFromFile (void)
 {
   NS_LOG_FUNCTION (this);
 
-  GeoCoordinate newPosition = Singleton<SatPositionInputTraceContainer>::Get ()->GetPosition (m_traceFilename, m_refEllipsoid);
+  GeoCoordinate newPosition = Singleton<SatPositionInputTraceContainer>::Get ()->GetPosition (m_traceHandle, m_refEllipsoid);
   DoSetGeoPosition (newPosition);
-
-  Simulator::Schedule (m_updateInterval, &SatTracedMobilityModel::UpdateGeoPositionFromFile, this);
 }
 
 uint32_t
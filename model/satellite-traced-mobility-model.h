@@ -68,6 +68,36 @@ public:
    */
   uint32_t GetBestBeamId (void) const;
 
+  /**
+   * \brief Update the position from the trace at the current time.
+   *
+   * Called periodically by SatTracedMobilityManager for all traced
+   * mobilities sharing the same update interval.
+   */
+  void UpdateGeoPositionFromFile (void);
+
+  /**
+   * \brief Set the interval at which the position is updated.
+   *
+   * Once the mobility is registered to SatTracedMobilityManager, it is
+   * moved to the update group of the new interval.
+   *
+   * \param updateInterval interval at which the position should update
+   */
+  void SetUpdateInterval (Time updateInterval);
+
+  /**
+   * \brief Get the interval at which the position is updated.
+   * \return the update interval
+   */
+  Time GetUpdateInterval (void) const;
+
+protected:
+  /**
+   * \brief Register to SatTracedMobilityManager once attributes are set.
+   */
+  virtual void NotifyConstructionCompleted (void);
+
 private:
   /**
    * \return the current velocity.
@@ -84,10 +114,10 @@ private:
    */
   virtual void DoSetGeoPosition (const GeoCoordinate &position);
 
-  void UpdateGeoPositionFromFile (void);
-
   std::string m_traceFilename;
+  uint32_t m_traceHandle;
   Time m_updateInterval;
+  bool m_registered;
   GeoCoordinate::ReferenceEllipsoid_t m_refEllipsoid;
   GeoCoordinate m_geoPosition;
   Vector m_velocity;
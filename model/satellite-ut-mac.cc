@@ -724,7 +724,7 @@ SatUtMac::ReceiveSignalingPacket (Ptr<Packet> packet)
             packet->RemovePacketTag (macTag);
             packet->RemovePacketTag (ctrlTag);
           }
-        else
+        else if (Singleton<SatLog>::Get ()->IsEnabled (SatLog::LOG_WARNING))
           {
             /**
              * Control message NOT found in container anymore! This means, that the
@@ -755,7 +755,7 @@ SatUtMac::ReceiveSignalingPacket (Ptr<Packet> packet)
                 m_timuInfo = Create<SatTimuInfo> (beamId, timuMsg->GetGwAddress ());
               }
           }
-        else
+        else if (Singleton<SatLog>::Get ()->IsEnabled (SatLog::LOG_WARNING))
           {
             /**
              * Control message NOT found in container anymore! This means, that the
@@ -0,0 +1,249 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <ns3/log.h>
+#include <ns3/string.h>
+#include <ns3/uinteger.h>
+#include <ns3/satellite-output-fstream-writer.h>
+
+#include "satellite-columnar-file-aggregator.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatColumnarFileAggregator");
+
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatColumnarFileAggregator);
+
+const char SatColumnarFileAggregator::FILE_MAGIC[8] = { 'S', 'A', 'T', 'C', 'O', 'L', 'S', 'T' };
+
+
+SatColumnarFileAggregator::SatColumnarFileAggregator ()
+  : m_outputFileName ("untitled"),
+  m_generalHeading (""),
+  m_blockSize (4096)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+
+SatColumnarFileAggregator::~SatColumnarFileAggregator ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+
+TypeId // static
+SatColumnarFileAggregator::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::SatColumnarFileAggregator")
+    .SetParent<DataCollectionObject> ()
+    .AddConstructor<SatColumnarFileAggregator> ()
+    .AddAttribute ("OutputFileName",
+                   "The path and name of the output file, to which the "
+                   "`.bin` suffix is appended.",
+                   StringValue ("untitled"),
+                   MakeStringAccessor (&SatColumnarFileAggregator::SetOutputFileName,
+                                       &SatColumnarFileAggregator::GetOutputFileName),
+                   MakeStringChecker ())
+    .AddAttribute ("GeneralHeading",
+                   "Heading of all the contexts, written once in the file.",
+                   StringValue (""),
+                   MakeStringAccessor (&SatColumnarFileAggregator::SetGeneralHeading,
+                                       &SatColumnarFileAggregator::GetGeneralHeading),
+                   MakeStringChecker ())
+    .AddAttribute ("BlockSize",
+                   "Number of samples collected before they are written as "
+                   "a block of columns.",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&SatColumnarFileAggregator::m_blockSize),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+
+void
+SatColumnarFileAggregator::SetOutputFileName (std::string outputFileName)
+{
+  NS_LOG_FUNCTION (this << outputFileName);
+  m_outputFileName = outputFileName;
+}
+
+
+std::string
+SatColumnarFileAggregator::GetOutputFileName () const
+{
+  return m_outputFileName;
+}
+
+
+void
+SatColumnarFileAggregator::SetGeneralHeading (std::string generalHeading)
+{
+  NS_LOG_FUNCTION (this << generalHeading);
+  m_generalHeading = generalHeading;
+}
+
+
+std::string
+SatColumnarFileAggregator::GetGeneralHeading () const
+{
+  return m_generalHeading;
+}
+
+
+void
+SatColumnarFileAggregator::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_writer != 0)
+    {
+      FlushSamples ();
+      m_writer->Close ();
+      m_writer = 0;
+    }
+
+  m_contextIndices.clear ();
+  DataCollectionObject::DoDispose ();
+}
+
+
+void
+SatColumnarFileAggregator::Write2d (std::string context, double x, double y)
+{
+  //NS_LOG_FUNCTION (this << context << x << y);
+
+  if (IsEnabled ())
+    {
+      OpenFile ();
+      m_times.push_back (x);
+      m_contextColumn.push_back (GetContextIndex (context));
+      m_values.push_back (y);
+
+      if (m_times.size () >= m_blockSize)
+        {
+          FlushSamples ();
+        }
+    }
+}
+
+
+void
+SatColumnarFileAggregator::AddContextHeading (std::string context,
+                                              std::string heading)
+{
+  NS_LOG_FUNCTION (this << context << heading);
+
+  OpenFile ();
+  const uint32_t contextIndex = GetContextIndex (context);
+  AppendStringRecord (RECORD_CONTEXT_HEADING, contextIndex, heading);
+}
+
+
+void
+SatColumnarFileAggregator::OpenFile ()
+{
+  if (m_writer != 0)
+    {
+      return;
+    }
+
+  NS_LOG_FUNCTION (this);
+
+  m_writer = Create<SatOutputFileStreamWriter> (m_outputFileName + ".bin",
+                                                std::ios::out | std::ios::binary,
+                                                false);
+
+  const uint32_t version = FILE_VERSION;
+  m_block.append (FILE_MAGIC, sizeof (FILE_MAGIC));
+  m_block.append (reinterpret_cast<const char*> (&version), sizeof (version));
+  AppendStringRecord (RECORD_GENERAL_HEADING, 0, m_generalHeading);
+
+  m_times.reserve (m_blockSize);
+  m_contextColumn.reserve (m_blockSize);
+  m_values.reserve (m_blockSize);
+}
+
+
+uint32_t
+SatColumnarFileAggregator::GetContextIndex (const std::string &context)
+{
+  std::map<std::string, uint32_t>::const_iterator it = m_contextIndices.find (context);
+  if (it != m_contextIndices.end ())
+    {
+      return it->second;
+    }
+
+  const uint32_t contextIndex = m_contextIndices.size ();
+  m_contextIndices[context] = contextIndex;
+  AppendStringRecord (RECORD_CONTEXT, contextIndex, context);
+  return contextIndex;
+}
+
+
+void
+SatColumnarFileAggregator::AppendStringRecord (RecordType_t recordType,
+                                               uint32_t contextIndex,
+                                               const std::string &text)
+{
+  const uint8_t type = recordType;
+  const uint32_t length = text.size ();
+
+  m_block.append (reinterpret_cast<const char*> (&type), sizeof (type));
+  if (recordType != RECORD_GENERAL_HEADING)
+    {
+      m_block.append (reinterpret_cast<const char*> (&contextIndex), sizeof (contextIndex));
+    }
+  m_block.append (reinterpret_cast<const char*> (&length), sizeof (length));
+  m_block.append (text);
+}
+
+
+void
+SatColumnarFileAggregator::FlushSamples ()
+{
+  NS_LOG_FUNCTION (this << m_times.size ());
+
+  if (!m_times.empty ())
+    {
+      const uint8_t type = RECORD_BLOCK;
+      const uint32_t numOfSamples = m_times.size ();
+
+      m_block.append (reinterpret_cast<const char*> (&type), sizeof (type));
+      m_block.append (reinterpret_cast<const char*> (&numOfSamples), sizeof (numOfSamples));
+      m_block.append (reinterpret_cast<const char*> (&m_times[0]),
+                      numOfSamples * sizeof (double));
+      m_block.append (reinterpret_cast<const char*> (&m_contextColumn[0]),
+                      numOfSamples * sizeof (uint32_t));
+      m_block.append (reinterpret_cast<const char*> (&m_values[0]),
+                      numOfSamples * sizeof (double));
+
+      m_times.clear ();
+      m_contextColumn.clear ();
+      m_values.clear ();
+    }
+
+  m_writer->Write (m_block);
+}
+
+
+} // end of namespace ns3
@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SATELLITE_COLUMNAR_FILE_AGGREGATOR_H
+#define SATELLITE_COLUMNAR_FILE_AGGREGATOR_H
+
+#include <ns3/data-collection-object.h>
+#include <ns3/ptr.h>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace ns3 {
+
+class SatOutputFileStreamWriter;
+
+/**
+ * \ingroup satstats
+ * \brief Aggregator which writes the samples of all the contexts into a
+ *        single binary file, column by column.
+ *
+ * ### Input ###
+ * This class provides the same input methods as MultiFileAggregator for
+ * scatter statistics:
+ * - Write2d(), for a time and a value of a context;
+ * - AddContextHeading(), for the heading of a context.
+ *
+ * ### Output ###
+ * The file `OutputFileName` + `.bin` starts with the magic string `SATCOLST`
+ * and a 32-bit version, followed by records made of a 8-bit record type and
+ * its content:
+ * - RECORD_GENERAL_HEADING: the length and the characters of the heading;
+ * - RECORD_CONTEXT: the index, the length and the characters of a context,
+ *   written the first time the context is seen;
+ * - RECORD_CONTEXT_HEADING: the context index, the length and the
+ *   characters of a heading of the context;
+ * - RECORD_BLOCK: a number of samples, followed by the columns of their
+ *   times (`double`), context indices (`uint32_t`) and values (`double`).
+ *
+ * Lengths and numbers are 32-bit, and the byte order is the one of the
+ * writing host. Contexts are thus written once in the file, whatever the
+ * number of samples. The records are collected into blocks of `BlockSize`
+ * samples, which are written by a background SatOutputFileStreamWriter, so
+ * that a single file is open whatever the number of contexts.
+ *
+ * The file is read back by SatColumnarFileReader, which also converts it
+ * into the text files of MultiFileAggregator.
+ */
+class SatColumnarFileAggregator : public DataCollectionObject
+{
+public:
+  /**
+   * \enum RecordType_t
+   * \brief Types of the records of a columnar file.
+   */
+  typedef enum
+  {
+    RECORD_GENERAL_HEADING = 1,
+    RECORD_CONTEXT,
+    RECORD_CONTEXT_HEADING,
+    RECORD_BLOCK
+  } RecordType_t;
+
+  /// Magic string at the beginning of a columnar file.
+  static const char FILE_MAGIC[8];
+
+  /// Version of the columnar file format.
+  static const uint32_t FILE_VERSION = 1;
+
+  /// Creates a new aggregator instance.
+  SatColumnarFileAggregator ();
+
+  /// Destructor.
+  virtual ~SatColumnarFileAggregator ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \param outputFileName name of the output file, without the `.bin` suffix.
+   */
+  void SetOutputFileName (std::string outputFileName);
+
+  /**
+   * \return name of the output file, without the `.bin` suffix.
+   */
+  std::string GetOutputFileName () const;
+
+  /**
+   * \param generalHeading heading of all the contexts.
+   */
+  void SetGeneralHeading (std::string generalHeading);
+
+  /**
+   * \return heading of all the contexts.
+   */
+  std::string GetGeneralHeading () const;
+
+  /**
+   * \brief Write a sample of a context.
+   * \param context the context, e.g., the identifier of the statistics.
+   * \param x the time of the sample.
+   * \param y the value of the sample.
+   */
+  void Write2d (std::string context, double x, double y);
+
+  /**
+   * \brief Add a heading to a context.
+   * \param context the context, e.g., the identifier of the statistics.
+   * \param heading the heading.
+   */
+  void AddContextHeading (std::string context, std::string heading);
+
+protected:
+  // Inherited from Object base class
+  virtual void DoDispose ();
+
+private:
+  /**
+   * \brief Open the output file and write the file header, if not done yet.
+   */
+  void OpenFile ();
+
+  /**
+   * \brief Get the index of a context, writing the context record on first
+   *        use.
+   * \param context the context.
+   * \return the index of the context.
+   */
+  uint32_t GetContextIndex (const std::string &context);
+
+  /**
+   * \brief Append a string record to the current block.
+   * \param recordType type of the record.
+   * \param contextIndex context index, only written for context records.
+   * \param text characters of the record.
+   */
+  void AppendStringRecord (RecordType_t recordType,
+                           uint32_t contextIndex,
+                           const std::string &text);
+
+  /**
+   * \brief Append the pending samples as a block record, and hand the
+   *        current block over to the writer.
+   */
+  void FlushSamples ();
+
+  std::string m_outputFileName;  ///< `OutputFileName` attribute.
+  std::string m_generalHeading;  ///< `GeneralHeading` attribute.
+  uint32_t m_blockSize;          ///< `BlockSize` attribute.
+
+  /// Writer of the output file, created on the first record.
+  Ptr<SatOutputFileStreamWriter> m_writer;
+
+  /// Records not yet handed over to the writer.
+  std::string m_block;
+
+  /// Map of the contexts and their indices.
+  std::map<std::string, uint32_t> m_contextIndices;
+
+  std::vector<double> m_times;            ///< Times of the pending samples.
+  std::vector<uint32_t> m_contextColumn;  ///< Context indices of the pending samples.
+  std::vector<double> m_values;           ///< Values of the pending samples.
+
+}; // end of class SatColumnarFileAggregator
+
+
+} // end of namespace ns3
+
+
+#endif /* SATELLITE_COLUMNAR_FILE_AGGREGATOR_H */
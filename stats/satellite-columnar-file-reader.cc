@@ -0,0 +1,323 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <cstring>
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/satellite-columnar-file-aggregator.h>
+
+#include "satellite-columnar-file-reader.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatColumnarFileReader");
+
+
+namespace ns3 {
+
+
+SatColumnarFileReader::SatColumnarFileReader (std::string fileName)
+  : m_fileName (fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+
+  m_input.open (fileName.c_str (), std::ios::in | std::ios::binary);
+
+  if (!m_input.is_open ())
+    {
+      NS_FATAL_ERROR ("SatColumnarFileReader - Unable to open " << fileName);
+    }
+
+  char magic[sizeof (SatColumnarFileAggregator::FILE_MAGIC)];
+  uint32_t version = 0;
+  m_input.read (magic, sizeof (magic));
+  m_input.read (reinterpret_cast<char*> (&version), sizeof (version));
+
+  if (!m_input
+      || std::memcmp (magic, SatColumnarFileAggregator::FILE_MAGIC, sizeof (magic)) != 0
+      || version != SatColumnarFileAggregator::FILE_VERSION)
+    {
+      NS_FATAL_ERROR ("SatColumnarFileReader - " << fileName << " is not a columnar statistics file");
+    }
+}
+
+
+bool
+SatColumnarFileReader::ReadBlock (std::vector<double> &times,
+                                  std::vector<uint32_t> &contextIndices,
+                                  std::vector<double> &values)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint8_t type;
+
+  while (m_input.read (reinterpret_cast<char*> (&type), sizeof (type)))
+    {
+      switch (type)
+        {
+        case SatColumnarFileAggregator::RECORD_GENERAL_HEADING:
+          m_generalHeading = ReadString ();
+          break;
+
+        case SatColumnarFileAggregator::RECORD_CONTEXT:
+          {
+            uint32_t contextIndex;
+            Read (&contextIndex, sizeof (contextIndex));
+            NS_ABORT_MSG_IF (contextIndex != m_contexts.size (),
+                             "SatColumnarFileReader - Unexpected context index " << contextIndex << " in " << m_fileName);
+            m_contexts.push_back (ReadString ());
+            m_contextHeadings.push_back (std::vector<std::string> ());
+            break;
+          }
+
+        case SatColumnarFileAggregator::RECORD_CONTEXT_HEADING:
+          {
+            uint32_t contextIndex;
+            Read (&contextIndex, sizeof (contextIndex));
+            NS_ABORT_MSG_IF (contextIndex >= m_contexts.size (),
+                             "SatColumnarFileReader - Unknown context index " << contextIndex << " in " << m_fileName);
+            m_contextHeadings[contextIndex].push_back (ReadString ());
+            break;
+          }
+
+        case SatColumnarFileAggregator::RECORD_BLOCK:
+          {
+            uint32_t numOfSamples;
+            Read (&numOfSamples, sizeof (numOfSamples));
+            times.resize (numOfSamples);
+            contextIndices.resize (numOfSamples);
+            values.resize (numOfSamples);
+
+            if (numOfSamples > 0)
+              {
+                Read (&times[0], numOfSamples * sizeof (double));
+                Read (&contextIndices[0], numOfSamples * sizeof (uint32_t));
+                Read (&values[0], numOfSamples * sizeof (double));
+              }
+
+            for (uint32_t i = 0; i < numOfSamples; i++)
+              {
+                NS_ABORT_MSG_IF (contextIndices[i] >= m_contexts.size (),
+                                 "SatColumnarFileReader - Unknown context index " << contextIndices[i] << " in " << m_fileName);
+              }
+            return true;
+          }
+
+        default:
+          NS_FATAL_ERROR ("SatColumnarFileReader - Invalid record type " << (uint32_t) type << " in " << m_fileName);
+          break;
+        }
+    }
+
+  return false;
+}
+
+
+std::string
+SatColumnarFileReader::GetGeneralHeading () const
+{
+  return m_generalHeading;
+}
+
+
+uint32_t
+SatColumnarFileReader::GetNumOfContexts () const
+{
+  return m_contexts.size ();
+}
+
+
+std::string
+SatColumnarFileReader::GetContext (uint32_t contextIndex) const
+{
+  NS_ASSERT (contextIndex < m_contexts.size ());
+  return m_contexts[contextIndex];
+}
+
+
+const std::vector<std::string> &
+SatColumnarFileReader::GetContextHeadings (uint32_t contextIndex) const
+{
+  NS_ASSERT (contextIndex < m_contextHeadings.size ());
+  return m_contextHeadings[contextIndex];
+}
+
+
+std::string
+SatColumnarFileReader::ReadString ()
+{
+  uint32_t length;
+  Read (&length, sizeof (length));
+
+  std::string text (length, '\0');
+  if (length > 0)
+    {
+      Read (&text[0], length);
+    }
+  return text;
+}
+
+
+void
+SatColumnarFileReader::Read (void *buffer, std::size_t size)
+{
+  if (!m_input.read (reinterpret_cast<char*> (buffer), size))
+    {
+      NS_FATAL_ERROR ("SatColumnarFileReader - Truncated record in " << m_fileName);
+    }
+}
+
+
+void // static
+SatColumnarFileReader::ConvertToText (std::string binaryFileName,
+                                      std::string outputFileName,
+                                      bool multiFileMode)
+{
+  NS_LOG_FUNCTION (binaryFileName << outputFileName << multiFileMode);
+
+  SatColumnarFileReader reader (binaryFileName);
+  std::vector<double> times;
+  std::vector<uint32_t> contextIndices;
+  std::vector<double> values;
+
+  if (!multiFileMode)
+    {
+      const std::string fileName = outputFileName + ".txt";
+      std::ofstream output (fileName.c_str (), std::ios::out);
+      if (!output.is_open ())
+        {
+          NS_FATAL_ERROR ("SatColumnarFileReader - Unable to open " << fileName);
+        }
+
+      bool isHeadingWritten = false;
+      while (reader.ReadBlock (times, contextIndices, values))
+        {
+          if (!isHeadingWritten && !reader.GetGeneralHeading ().empty ())
+            {
+              output << reader.GetGeneralHeading () << "\n";
+            }
+          isHeadingWritten = true;
+
+          for (uint32_t i = 0; i < times.size (); i++)
+            {
+              output << reader.GetContext (contextIndices[i]) << " "
+                     << times[i] << " " << values[i] << "\n";
+            }
+        }
+
+      if (!isHeadingWritten && !reader.GetGeneralHeading ().empty ())
+        {
+          output << reader.GetGeneralHeading () << "\n";
+        }
+
+      for (uint32_t c = 0; c < reader.GetNumOfContexts (); c++)
+        {
+          const std::vector<std::string> &headings = reader.GetContextHeadings (c);
+          for (uint32_t h = 0; h < headings.size (); h++)
+            {
+              output << headings[h] << "\n";
+            }
+        }
+
+      output.close ();
+      return;
+    }
+
+  // Files of the contexts. At most MAX_OPEN_FILES are open at once, the
+  // others are reopened in append mode when needed.
+  std::vector<std::ofstream*> outputs;
+  std::vector<bool> isCreated;
+  uint32_t numOfOpenFiles = 0;
+
+  while (reader.ReadBlock (times, contextIndices, values))
+    {
+      outputs.resize (reader.GetNumOfContexts (), 0);
+      isCreated.resize (reader.GetNumOfContexts (), false);
+
+      for (uint32_t i = 0; i < times.size (); i++)
+        {
+          const uint32_t c = contextIndices[i];
+
+          if (outputs[c] == 0)
+            {
+              if (numOfOpenFiles >= MAX_OPEN_FILES)
+                {
+                  for (uint32_t j = 0; j < outputs.size (); j++)
+                    {
+                      delete outputs[j];
+                      outputs[j] = 0;
+                    }
+                  numOfOpenFiles = 0;
+                }
+
+              const std::string fileName = outputFileName + "-" + reader.GetContext (c) + ".txt";
+              outputs[c] = new std::ofstream (fileName.c_str (),
+                                              isCreated[c] ? std::ios::app : std::ios::out);
+              if (!outputs[c]->is_open ())
+                {
+                  NS_FATAL_ERROR ("SatColumnarFileReader - Unable to open " << fileName);
+                }
+              numOfOpenFiles++;
+
+              if (!isCreated[c] && !reader.GetGeneralHeading ().empty ())
+                {
+                  *outputs[c] << reader.GetGeneralHeading () << "\n";
+                }
+              isCreated[c] = true;
+            }
+
+          *outputs[c] << times[i] << " " << values[i] << "\n";
+        }
+    }
+
+  for (uint32_t j = 0; j < outputs.size (); j++)
+    {
+      delete outputs[j];
+    }
+
+  // Append the headings, reported at the end of the simulation.
+  for (uint32_t c = 0; c < reader.GetNumOfContexts (); c++)
+    {
+      const std::vector<std::string> &headings = reader.GetContextHeadings (c);
+      if (headings.empty ())
+        {
+          continue;
+        }
+
+      const std::string fileName = outputFileName + "-" + reader.GetContext (c) + ".txt";
+      const bool created = c < isCreated.size () && isCreated[c];
+      std::ofstream output (fileName.c_str (), created ? std::ios::app : std::ios::out);
+      if (!output.is_open ())
+        {
+          NS_FATAL_ERROR ("SatColumnarFileReader - Unable to open " << fileName);
+        }
+
+      if (!created && !reader.GetGeneralHeading ().empty ())
+        {
+          output << reader.GetGeneralHeading () << "\n";
+        }
+      for (uint32_t h = 0; h < headings.size (); h++)
+        {
+          output << headings[h] << "\n";
+        }
+    }
+
+} // end of `void ConvertToText (std::string, std::string, bool)`
+
+
+} // end of namespace ns3
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SATELLITE_COLUMNAR_FILE_READER_H
+#define SATELLITE_COLUMNAR_FILE_READER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+
+namespace ns3 {
+
+/**
+ * \ingroup satstats
+ * \brief Reader of the binary files written by SatColumnarFileAggregator.
+ *
+ * The samples are read block by block with ReadBlock(), while the contexts
+ * and their headings are collected as their records are met. For example:
+ * \code
+ *     SatColumnarFileReader reader ("stat-per-ut-fwd-app-delay-scatter.bin");
+ *     std::vector<double> times;
+ *     std::vector<uint32_t> contexts;
+ *     std::vector<double> values;
+ *     while (reader.ReadBlock (times, contexts, values))
+ *       {
+ *         // reader.GetContext (contexts[i]) is the context of sample i
+ *       }
+ * \endcode
+ *
+ * ConvertToText() converts a whole file into the text files which
+ * MultiFileAggregator would have written.
+ */
+class SatColumnarFileReader
+{
+public:
+  /**
+   * \brief Constructor, opens the file and reads its header.
+   * \param fileName name of the binary file, including the `.bin` suffix.
+   */
+  SatColumnarFileReader (std::string fileName);
+
+  /**
+   * \brief Read the next block of samples.
+   * \param times the times of the samples.
+   * \param contextIndices the context indices of the samples.
+   * \param values the values of the samples.
+   * \return false if the end of the file is reached.
+   */
+  bool ReadBlock (std::vector<double> &times,
+                  std::vector<uint32_t> &contextIndices,
+                  std::vector<double> &values);
+
+  /**
+   * \return the heading of all the contexts.
+   */
+  std::string GetGeneralHeading () const;
+
+  /**
+   * \return the number of contexts read so far.
+   */
+  uint32_t GetNumOfContexts () const;
+
+  /**
+   * \param contextIndex index of a context.
+   * \return the context.
+   */
+  std::string GetContext (uint32_t contextIndex) const;
+
+  /**
+   * \param contextIndex index of a context.
+   * \return the headings of the context read so far.
+   */
+  const std::vector<std::string> & GetContextHeadings (uint32_t contextIndex) const;
+
+  /**
+   * \brief Convert a binary file into text files.
+   * \param binaryFileName name of the binary file.
+   * \param outputFileName name of the text files, without the `.txt` suffix.
+   * \param multiFileMode write a `-<context>.txt` file for each context,
+   *                      like MultiFileAggregator does by default, instead of
+   *                      a single file where the context starts each line.
+   *
+   * The headings of a context are written at the end of its samples, since
+   * the collectors report them when they are destroyed. At most
+   * MAX_OPEN_FILES files are kept open at once.
+   */
+  static void ConvertToText (std::string binaryFileName,
+                             std::string outputFileName,
+                             bool multiFileMode);
+
+  /// Maximum number of text files kept open by ConvertToText().
+  static const uint32_t MAX_OPEN_FILES = 64;
+
+private:
+  /**
+   * \brief Read a 32-bit length followed by its characters.
+   * \return the characters read.
+   */
+  std::string ReadString ();
+
+  /**
+   * \brief Read raw data, aborting the simulation if the file is truncated.
+   * \param buffer destination of the data.
+   * \param size number of bytes to read.
+   */
+  void Read (void *buffer, std::size_t size);
+
+  /// Name of the binary file.
+  std::string m_fileName;
+
+  /// The binary file.
+  std::ifstream m_input;
+
+  /// Heading of all the contexts.
+  std::string m_generalHeading;
+
+  /// Contexts, by context index.
+  std::vector<std::string> m_contexts;
+
+  /// Headings of the contexts, by context index.
+  std::vector<std::vector<std::string> > m_contextHeadings;
+
+}; // end of class SatColumnarFileReader
+
+
+} // end of namespace ns3
+
+
+#endif /* SATELLITE_COLUMNAR_FILE_READER_H */
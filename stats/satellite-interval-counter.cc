@@ -0,0 +1,260 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/simulator.h>
+
+#include "satellite-interval-counter.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatIntervalCounter");
+
+
+namespace ns3 {
+
+
+SatIntervalCounter::Counter::Counter ()
+  : isUsed (false),
+  context (""),
+  intervalSum (0.0),
+  intervalSamples (0),
+  totalSum (0.0),
+  totalSamples (0)
+{
+}
+
+
+SatIntervalCounter::SatIntervalCounter (OutputType_t outputType, double conversionFactor)
+  : m_outputType (outputType),
+  m_conversionFactor (conversionFactor),
+  m_interval (Seconds (0)),
+  m_startTime (Seconds (0)),
+  m_lastSnapshotTime (Seconds (0)),
+  m_isFlushed (false)
+{
+  NS_LOG_FUNCTION (this << outputType << conversionFactor);
+}
+
+
+void
+SatIntervalCounter::AddIdentifier (uint32_t identifier, std::string context)
+{
+  NS_LOG_FUNCTION (this << identifier << context);
+
+  if (identifier >= m_counters.size ())
+    {
+      m_counters.resize (identifier + 1);
+    }
+
+  if (!m_counters[identifier].isUsed)
+    {
+      m_counters[identifier].isUsed = true;
+      m_identifiers.push_back (identifier);
+    }
+  m_counters[identifier].context = context;
+}
+
+
+void
+SatIntervalCounter::SetScalarSink (Callback<void, std::string, double> sink)
+{
+  NS_LOG_FUNCTION (this);
+  m_scalarSink = sink;
+}
+
+
+void
+SatIntervalCounter::SetScatterSink (Callback<void, std::string, double, double> sink,
+                                    Time interval)
+{
+  NS_LOG_FUNCTION (this << interval.GetSeconds ());
+  NS_ABORT_MSG_IF (!interval.IsStrictlyPositive (),
+                   "SatIntervalCounter - Invalid interval " << interval.GetSeconds ());
+  m_scatterSink = sink;
+  m_interval = interval;
+}
+
+
+void
+SatIntervalCounter::Start ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_startTime = Simulator::Now ();
+  m_lastSnapshotTime = m_startTime;
+
+  if (!m_scatterSink.IsNull ())
+    {
+      m_snapshotEvent = Simulator::Schedule (m_interval,
+                                             &SatIntervalCounter::Snapshot,
+                                             Ptr<SatIntervalCounter> (this));
+    }
+
+  Simulator::ScheduleDestroy (&SatIntervalCounter::Flush,
+                              Ptr<SatIntervalCounter> (this));
+}
+
+
+void
+SatIntervalCounter::Flush ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_isFlushed)
+    {
+      return;
+    }
+
+  m_isFlushed = true;
+  m_snapshotEvent.Cancel ();
+
+  if (!m_scatterSink.IsNull () && Simulator::Now () > m_lastSnapshotTime)
+    {
+      WriteInterval ();
+    }
+
+  if (!m_scalarSink.IsNull ())
+    {
+      const double duration = (Simulator::Now () - m_startTime).GetSeconds ();
+
+      for (std::vector<uint32_t>::const_iterator it = m_identifiers.begin ();
+           it != m_identifiers.end (); ++it)
+        {
+          Counter &counter = m_counters[*it];
+          counter.totalSum += counter.intervalSum;
+          counter.totalSamples += counter.intervalSamples;
+          counter.intervalSum = 0.0;
+          counter.intervalSamples = 0;
+          m_scalarSink (counter.context,
+                        GetValue (counter.totalSum, counter.totalSamples, duration));
+        }
+    }
+
+  // Release the aggregators behind the sinks.
+  m_scalarSink = MakeNullCallback<void, std::string, double> ();
+  m_scatterSink = MakeNullCallback<void, std::string, double, double> ();
+}
+
+
+void
+SatIntervalCounter::AddToAll (double value)
+{
+  for (std::vector<uint32_t>::const_iterator it = m_identifiers.begin ();
+       it != m_identifiers.end (); ++it)
+    {
+      Add (*it, value);
+    }
+}
+
+
+Callback<void, uint32_t, uint32_t>
+SatIntervalCounter::GetUinteger32Sink (uint32_t identifier)
+{
+  NS_LOG_FUNCTION (this << identifier);
+  NS_ASSERT (identifier < m_counters.size () && m_counters[identifier].isUsed);
+  return MakeBoundCallback (&SatIntervalCounter::TraceSinkUinteger32,
+                            Ptr<SatIntervalCounter> (this), identifier);
+}
+
+
+Callback<void, bool, bool>
+SatIntervalCounter::GetBooleanSink (uint32_t identifier)
+{
+  NS_LOG_FUNCTION (this << identifier);
+  NS_ASSERT (identifier < m_counters.size () && m_counters[identifier].isUsed);
+  return MakeBoundCallback (&SatIntervalCounter::TraceSinkBoolean,
+                            Ptr<SatIntervalCounter> (this), identifier);
+}
+
+
+void
+SatIntervalCounter::Snapshot ()
+{
+  NS_LOG_FUNCTION (this);
+
+  WriteInterval ();
+  m_snapshotEvent = Simulator::Schedule (m_interval,
+                                         &SatIntervalCounter::Snapshot,
+                                         Ptr<SatIntervalCounter> (this));
+}
+
+
+void
+SatIntervalCounter::WriteInterval ()
+{
+  const Time now = Simulator::Now ();
+  const double duration = (now - m_lastSnapshotTime).GetSeconds ();
+  m_lastSnapshotTime = now;
+
+  for (std::vector<uint32_t>::const_iterator it = m_identifiers.begin ();
+       it != m_identifiers.end (); ++it)
+    {
+      Counter &counter = m_counters[*it];
+      m_scatterSink (counter.context, now.GetSeconds (),
+                     GetValue (counter.intervalSum, counter.intervalSamples, duration));
+      counter.totalSum += counter.intervalSum;
+      counter.totalSamples += counter.intervalSamples;
+      counter.intervalSum = 0.0;
+      counter.intervalSamples = 0;
+    }
+}
+
+
+double
+SatIntervalCounter::GetValue (double sum, uint64_t samples, double duration) const
+{
+  switch (m_outputType)
+    {
+    case SatIntervalCounter::OUTPUT_TYPE_AVERAGE_PER_SECOND:
+      return duration > 0.0 ? sum * m_conversionFactor / duration : 0.0;
+
+    case SatIntervalCounter::OUTPUT_TYPE_AVERAGE_PER_SAMPLE:
+      return samples > 0 ? sum / samples : 0.0;
+
+    default:
+      NS_FATAL_ERROR ("SatIntervalCounter - Invalid output type");
+      break;
+    }
+
+  return 0.0;
+}
+
+
+void // static
+SatIntervalCounter::TraceSinkUinteger32 (Ptr<SatIntervalCounter> counter,
+                                         uint32_t identifier,
+                                         uint32_t oldValue,
+                                         uint32_t newValue)
+{
+  counter->Add (identifier, newValue);
+}
+
+
+void // static
+SatIntervalCounter::TraceSinkBoolean (Ptr<SatIntervalCounter> counter,
+                                      uint32_t identifier,
+                                      bool oldValue,
+                                      bool newValue)
+{
+  counter->AddBoolean (identifier, newValue);
+}
+
+
+} // end of namespace ns3
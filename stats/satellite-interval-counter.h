@@ -0,0 +1,245 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SATELLITE_INTERVAL_COUNTER_H
+#define SATELLITE_INTERVAL_COUNTER_H
+
+#include <ns3/simple-ref-count.h>
+#include <ns3/ptr.h>
+#include <ns3/callback.h>
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
+#include <ns3/assert.h>
+#include <string>
+#include <vector>
+
+
+namespace ns3 {
+
+/**
+ * \ingroup satstats
+ * \brief Plain counters of all the identifiers of a statistics, written to
+ *        the output by a single periodic event.
+ *
+ * This is a lightweight replacement of a chain of collectors per identifier
+ * for the statistics which only report sums or ratios. Samples are added
+ * to the counter of their identifier, which is a direct index in a vector:
+ * - Add(), or the sink returned by GetUinteger32Sink(), sums a value;
+ * - AddBoolean(), or the sink returned by GetBooleanSink(), counts a sample
+ *   which is true or false.
+ *
+ * ### Output ###
+ * With a scatter sink, the counters of every identifier are written every
+ * interval, with the end time of the interval, and then reset. With a
+ * scalar sink, the totals of every identifier are written once. Depending
+ * on the output type, a written value is either:
+ * - OUTPUT_TYPE_AVERAGE_PER_SECOND: the sum of the values, multiplied by
+ *   the conversion factor, divided by the duration in seconds;
+ * - OUTPUT_TYPE_AVERAGE_PER_SAMPLE: the sum of the values divided by the
+ *   number of samples, e.g., the ratio of true samples; 0 without samples.
+ *
+ * Start() schedules the periodic event, if any, and the last snapshot at
+ * Simulator::Destroy(), where a partial interval and the scalar totals are
+ * written. Flush() writes the last snapshot earlier. The sinks are released
+ * after the last snapshot, so that the aggregator behind them can write
+ * its file.
+ */
+class SatIntervalCounter : public SimpleRefCount<SatIntervalCounter>
+{
+public:
+  /**
+   * \enum OutputType_t
+   * \brief Types of the written values.
+   */
+  typedef enum
+  {
+    OUTPUT_TYPE_AVERAGE_PER_SECOND = 0,
+    OUTPUT_TYPE_AVERAGE_PER_SAMPLE
+  } OutputType_t;
+
+  /**
+   * \brief Constructor.
+   * \param outputType type of the written values.
+   * \param conversionFactor factor applied to the sums written as
+   *                         OUTPUT_TYPE_AVERAGE_PER_SECOND, e.g., 0.008 to
+   *                         convert bytes into kilobits.
+   */
+  SatIntervalCounter (OutputType_t outputType, double conversionFactor);
+
+  /**
+   * \brief Add the counter of an identifier.
+   * \param identifier the identifier, used as an index of the counters.
+   * \param context the context written with the values of the identifier.
+   */
+  void AddIdentifier (uint32_t identifier, std::string context);
+
+  /**
+   * \brief Write the totals of every identifier once, as the last snapshot.
+   * \param sink the sink receiving the context and the value.
+   */
+  void SetScalarSink (Callback<void, std::string, double> sink);
+
+  /**
+   * \brief Write the counters of every identifier every interval.
+   * \param sink the sink receiving the context, the time in seconds and the
+   *             value.
+   * \param interval the interval between two snapshots.
+   */
+  void SetScatterSink (Callback<void, std::string, double, double> sink,
+                       Time interval);
+
+  /**
+   * \brief Schedule the periodic snapshots and the last one.
+   */
+  void Start ();
+
+  /**
+   * \brief Write the last snapshot, if not done yet, and release the sinks.
+   */
+  void Flush ();
+
+  /**
+   * \brief Add a value to the counter of an identifier.
+   * \param identifier the identifier.
+   * \param value the value, e.g., the size of a packet in bytes.
+   */
+  inline void Add (uint32_t identifier, double value)
+  {
+    NS_ASSERT (identifier < m_counters.size () && m_counters[identifier].isUsed);
+    Counter &counter = m_counters[identifier];
+    counter.intervalSum += value;
+    counter.intervalSamples++;
+  }
+
+  /**
+   * \brief Add a value to the counters of every identifier.
+   * \param value the value, e.g., the size of a broadcast packet in bytes.
+   */
+  void AddToAll (double value);
+
+  /**
+   * \brief Count a sample of an identifier.
+   * \param identifier the identifier.
+   * \param value the sample, e.g., whether a packet is in error.
+   */
+  inline void AddBoolean (uint32_t identifier, bool value)
+  {
+    Add (identifier, value ? 1.0 : 0.0);
+  }
+
+  /**
+   * \param identifier the identifier.
+   * \return a trace sink of `uint32_t` values, e.g., for the `OutputBytes`
+   *         trace source of ApplicationPacketProbe, adding the new values
+   *         to the counter of the identifier.
+   */
+  Callback<void, uint32_t, uint32_t> GetUinteger32Sink (uint32_t identifier);
+
+  /**
+   * \param identifier the identifier.
+   * \return a trace sink of `bool` values, e.g., for the `OutputBool`
+   *         trace source of SatPhyRxCarrierPacketProbe, counting the new
+   *         values in the counter of the identifier.
+   */
+  Callback<void, bool, bool> GetBooleanSink (uint32_t identifier);
+
+private:
+  /// Counter of an identifier.
+  struct Counter
+  {
+    Counter ();
+    bool isUsed;              ///< Whether the identifier has been added.
+    std::string context;      ///< Context written with the values.
+    double intervalSum;       ///< Sum of the values of the current interval.
+    uint64_t intervalSamples; ///< Number of samples of the current interval.
+    double totalSum;          ///< Sum of the values of the past intervals.
+    uint64_t totalSamples;    ///< Number of samples of the past intervals.
+  };
+
+  /**
+   * \brief Write the counters of the elapsed interval and start a new one.
+   */
+  void Snapshot ();
+
+  /**
+   * \brief Write the scatter values of the elapsed interval and move the
+   *        interval counters into the totals.
+   */
+  void WriteInterval ();
+
+  /**
+   * \param sum sum of the values.
+   * \param samples number of samples.
+   * \param duration duration in seconds.
+   * \return the value to write, according to the output type.
+   */
+  double GetValue (double sum, uint64_t samples, double duration) const;
+
+  /**
+   * \brief Trace sink of `uint32_t` values bound to an identifier.
+   * \param counter the counter.
+   * \param identifier the identifier.
+   * \param oldValue the previous value, ignored.
+   * \param newValue the value to add.
+   */
+  static void TraceSinkUinteger32 (Ptr<SatIntervalCounter> counter,
+                                   uint32_t identifier,
+                                   uint32_t oldValue,
+                                   uint32_t newValue);
+
+  /**
+   * \brief Trace sink of `bool` values bound to an identifier.
+   * \param counter the counter.
+   * \param identifier the identifier.
+   * \param oldValue the previous value, ignored.
+   * \param newValue the sample to count.
+   */
+  static void TraceSinkBoolean (Ptr<SatIntervalCounter> counter,
+                                uint32_t identifier,
+                                bool oldValue,
+                                bool newValue);
+
+  OutputType_t m_outputType;  ///< Type of the written values.
+  double m_conversionFactor;  ///< Factor of the sums per second.
+  Time m_interval;            ///< Interval between two scatter snapshots.
+  Time m_startTime;           ///< Time of the first interval.
+  Time m_lastSnapshotTime;    ///< Time of the last snapshot.
+  EventId m_snapshotEvent;    ///< Next periodic snapshot.
+  bool m_isFlushed;           ///< Whether the last snapshot has been written.
+
+  /// Counters, indexed by identifier.
+  std::vector<Counter> m_counters;
+
+  /// Identifiers which have been added, in order of addition.
+  std::vector<uint32_t> m_identifiers;
+
+  /// Sink of the totals.
+  Callback<void, std::string, double> m_scalarSink;
+
+  /// Sink of the interval values.
+  Callback<void, std::string, double, double> m_scatterSink;
+
+}; // end of class SatIntervalCounter
+
+
+} // end of namespace ns3
+
+
+#endif /* SATELLITE_INTERVAL_COUNTER_H */
@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <ns3/log.h>
+#include <ns3/double.h>
+#include <ns3/uinteger.h>
+#include <ns3/trace-source-accessor.h>
+
+#include "satellite-quantile-collector.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatQuantileCollector");
+
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatQuantileCollector);
+
+/// Quantiles reported by the collectors.
+static const double g_reportedQuantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+
+
+SatQuantileCollector::SatQuantileCollector ()
+  : m_sketch (0.01, 2048),
+  m_relativeAccuracy (0.01),
+  m_maxNumOfBuckets (2048)
+{
+  NS_LOG_FUNCTION (this << GetName ());
+}
+
+
+TypeId // static
+SatQuantileCollector::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::SatQuantileCollector")
+    .SetParent<DataCollectionObject> ()
+    .AddConstructor<SatQuantileCollector> ()
+    .AddAttribute ("RelativeAccuracy",
+                   "Relative accuracy of the estimated quantiles. Only the "
+                   "sketches of the same accuracy can be merged.",
+                   DoubleValue (0.01),
+                   MakeDoubleAccessor (&SatQuantileCollector::SetRelativeAccuracy,
+                                       &SatQuantileCollector::GetRelativeAccuracy),
+                   MakeDoubleChecker<double> (1e-6, 0.5))
+    .AddAttribute ("MaxNumOfBuckets",
+                   "Maximum number of buckets of the sketch, for the positive "
+                   "and the negative samples each. When more buckets are "
+                   "needed, the buckets of the smallest values are collapsed.",
+                   UintegerValue (2048),
+                   MakeUintegerAccessor (&SatQuantileCollector::SetMaxNumOfBuckets,
+                                         &SatQuantileCollector::GetMaxNumOfBuckets),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddTraceSource ("Output",
+                     "Fired once per reported quantile when the collector is "
+                     "destroyed, with the quantile and its estimated value.",
+                     MakeTraceSourceAccessor (&SatQuantileCollector::m_output),
+                     "ns3::SatQuantileCollector::QuantileCallback")
+  ;
+  return tid;
+}
+
+
+void
+SatQuantileCollector::SetRelativeAccuracy (double relativeAccuracy)
+{
+  NS_LOG_FUNCTION (this << GetName () << relativeAccuracy);
+  m_relativeAccuracy = relativeAccuracy;
+  m_sketch = SatQuantileSketch (m_relativeAccuracy, m_maxNumOfBuckets);
+}
+
+
+double
+SatQuantileCollector::GetRelativeAccuracy () const
+{
+  return m_relativeAccuracy;
+}
+
+
+void
+SatQuantileCollector::SetMaxNumOfBuckets (uint32_t maxNumOfBuckets)
+{
+  NS_LOG_FUNCTION (this << GetName () << maxNumOfBuckets);
+  m_maxNumOfBuckets = maxNumOfBuckets;
+  m_sketch = SatQuantileSketch (m_relativeAccuracy, m_maxNumOfBuckets);
+}
+
+
+uint32_t
+SatQuantileCollector::GetMaxNumOfBuckets () const
+{
+  return m_maxNumOfBuckets;
+}
+
+
+void
+SatQuantileCollector::DoDispose ()
+{
+  NS_LOG_FUNCTION (this << GetName ());
+
+  if (m_sketch.GetCount () > 0)
+    {
+      for (uint32_t i = 0; i < GetNumOfReportedQuantiles (); i++)
+        {
+          const double quantile = GetReportedQuantile (i);
+          m_output (quantile, m_sketch.GetQuantile (quantile));
+        }
+    }
+
+  DataCollectionObject::DoDispose ();
+}
+
+
+void
+SatQuantileCollector::TraceSinkDouble (double oldData, double newData)
+{
+  NS_LOG_FUNCTION (this << GetName () << newData);
+
+  if (IsEnabled ())
+    {
+      m_sketch.Add (newData);
+    }
+}
+
+
+const SatQuantileSketch &
+SatQuantileCollector::GetSketch () const
+{
+  return m_sketch;
+}
+
+
+uint32_t // static
+SatQuantileCollector::GetNumOfReportedQuantiles ()
+{
+  return sizeof (g_reportedQuantiles) / sizeof (g_reportedQuantiles[0]);
+}
+
+
+double // static
+SatQuantileCollector::GetReportedQuantile (uint32_t i)
+{
+  NS_ASSERT (i < GetNumOfReportedQuantiles ());
+  return g_reportedQuantiles[i];
+}
+
+
+} // end of namespace ns3
@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SATELLITE_QUANTILE_COLLECTOR_H
+#define SATELLITE_QUANTILE_COLLECTOR_H
+
+#include <ns3/data-collection-object.h>
+#include <ns3/traced-callback.h>
+#include <ns3/satellite-quantile-sketch.h>
+
+
+namespace ns3 {
+
+/**
+ * \ingroup satstats
+ * \brief Collector which estimates quantiles of the received samples in a
+ *        quantile sketch of bounded memory.
+ *
+ * ### Input ###
+ * This class provides 1 method for receiving input samples:
+ * - TraceSinkDouble()
+ *
+ * The samples are not stored: each one is counted in a SatQuantileSketch,
+ * whose memory is bounded by the `MaxNumOfBuckets` attribute whatever the
+ * number and range of the samples.
+ *
+ * ### Output ###
+ * At the end of the instance's life (e.g., when the simulation ends), the
+ * `Output` trace source is fired once for each of the reported quantiles,
+ * i.e., 0.5, 0.9, 0.99 and 0.999, with the quantile and its estimated value
+ * as arguments. Nothing is fired if no sample has been received.
+ *
+ * The sketch is also available through GetSketch(), e.g., to merge the
+ * sketches of several collectors into a global one.
+ */
+class SatQuantileCollector : public DataCollectionObject
+{
+public:
+  /// Creates a new collector instance.
+  SatQuantileCollector ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Trace sink for receiving data from `double` valued trace sources.
+   * \param oldData the original value.
+   * \param newData the new value.
+   */
+  void TraceSinkDouble (double oldData, double newData);
+
+  /**
+   * \param relativeAccuracy relative accuracy of the sketch. Discards the
+   *                         samples received so far.
+   */
+  void SetRelativeAccuracy (double relativeAccuracy);
+
+  /**
+   * \return the relative accuracy of the sketch.
+   */
+  double GetRelativeAccuracy () const;
+
+  /**
+   * \param maxNumOfBuckets maximum number of buckets of the sketch. Discards
+   *                        the samples received so far.
+   */
+  void SetMaxNumOfBuckets (uint32_t maxNumOfBuckets);
+
+  /**
+   * \return the maximum number of buckets of the sketch.
+   */
+  uint32_t GetMaxNumOfBuckets () const;
+
+  /**
+   * \return the sketch of the samples received so far.
+   */
+  const SatQuantileSketch & GetSketch () const;
+
+  /**
+   * \return the number of quantiles reported by the collectors.
+   */
+  static uint32_t GetNumOfReportedQuantiles ();
+
+  /**
+   * \param i index of a reported quantile.
+   * \return the reported quantile.
+   */
+  static double GetReportedQuantile (uint32_t i);
+
+  /**
+   * \brief Common callback signature for trace sources related to quantiles.
+   * \param quantile the quantile, between 0 and 1.
+   * \param value the estimated value of the quantile.
+   */
+  typedef void (*QuantileCallback)(double quantile, double value);
+
+protected:
+  // Inherited from Object base class
+  virtual void DoDispose ();
+
+private:
+  /// The sketch of the received samples.
+  SatQuantileSketch m_sketch;
+
+  double m_relativeAccuracy;  ///< `RelativeAccuracy` attribute.
+  uint32_t m_maxNumOfBuckets; ///< `MaxNumOfBuckets` attribute.
+
+  /// `Output` trace source.
+  TracedCallback<double, double> m_output;
+
+}; // end of class SatQuantileCollector
+
+
+} // end of namespace ns3
+
+
+#endif /* SATELLITE_QUANTILE_COLLECTOR_H */
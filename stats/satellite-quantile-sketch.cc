@@ -0,0 +1,377 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <ns3/log.h>
+#include <ns3/abort.h>
+
+#include "satellite-quantile-sketch.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatQuantileSketch");
+
+
+namespace ns3 {
+
+
+SatQuantileSketch::Store::Store ()
+  : m_offset (0)
+{
+}
+
+
+void
+SatQuantileSketch::Store::Add (int32_t index, uint64_t count, uint32_t maxNumOfBuckets)
+{
+  int64_t low = index;
+  int64_t high = index;
+
+  if (!m_counts.empty ())
+    {
+      low = std::min<int64_t> (index, m_offset);
+      high = std::max<int64_t> (index, m_offset + static_cast<int64_t> (m_counts.size ()) - 1);
+    }
+
+  if (high - low + 1 > maxNumOfBuckets)
+    {
+      low = high - maxNumOfBuckets + 1;
+    }
+
+  if (m_counts.empty ()
+      || low != m_offset
+      || high != m_offset + static_cast<int64_t> (m_counts.size ()) - 1)
+    {
+      Extend (low, high);
+    }
+
+  m_counts[std::max<int64_t> (index, low) - m_offset] += count;
+}
+
+
+void
+SatQuantileSketch::Store::Merge (const Store &other, uint32_t maxNumOfBuckets)
+{
+  if (other.m_counts.empty ())
+    {
+      return;
+    }
+
+  int64_t low = other.m_offset;
+  int64_t high = other.m_offset + static_cast<int64_t> (other.m_counts.size ()) - 1;
+
+  if (!m_counts.empty ())
+    {
+      low = std::min<int64_t> (low, m_offset);
+      high = std::max<int64_t> (high, m_offset + static_cast<int64_t> (m_counts.size ()) - 1);
+    }
+
+  if (high - low + 1 > maxNumOfBuckets)
+    {
+      low = high - maxNumOfBuckets + 1;
+    }
+
+  Extend (low, high);
+
+  for (uint32_t i = 0; i < other.m_counts.size (); i++)
+    {
+      int64_t index = std::max<int64_t> (other.m_offset + static_cast<int64_t> (i), low);
+      m_counts[index - m_offset] += other.m_counts[i];
+    }
+}
+
+
+void
+SatQuantileSketch::Store::Extend (int32_t low, int32_t high)
+{
+  if (m_counts.empty ())
+    {
+      m_offset = low;
+      m_counts.assign (high - low + 1, 0);
+      return;
+    }
+
+  if (low > m_offset)
+    {
+      // collapse the buckets below the new range into its lowest bucket
+      int64_t collapsed = std::min<int64_t> (low - m_offset, m_counts.size ());
+      uint64_t count = 0;
+      for (int64_t i = 0; i < collapsed; i++)
+        {
+          count += m_counts[i];
+        }
+      m_counts.erase (m_counts.begin (), m_counts.begin () + collapsed);
+      m_offset = low;
+      if (m_counts.empty ())
+        {
+          m_counts.push_back (0);
+        }
+      m_counts[0] += count;
+    }
+  else if (low < m_offset)
+    {
+      m_counts.insert (m_counts.begin (), m_offset - low, 0);
+      m_offset = low;
+    }
+
+  m_counts.resize (high - m_offset + 1, 0);
+}
+
+
+SatQuantileSketch::SatQuantileSketch (double relativeAccuracy, uint32_t maxNumOfBuckets)
+  : m_relativeAccuracy (relativeAccuracy),
+  m_maxNumOfBuckets (maxNumOfBuckets),
+  m_zeroCount (0),
+  m_count (0),
+  m_sum (0.0),
+  m_min (std::numeric_limits<double>::max ()),
+  m_max (-std::numeric_limits<double>::max ())
+{
+  NS_ABORT_MSG_IF (relativeAccuracy <= 0.0 || relativeAccuracy >= 1.0,
+                   "Invalid relative accuracy " << relativeAccuracy);
+  NS_ABORT_MSG_IF (maxNumOfBuckets == 0, "Quantile sketch needs at least one bucket");
+
+  m_gamma = (1.0 + relativeAccuracy) / (1.0 - relativeAccuracy);
+  m_logGamma = std::log (m_gamma);
+  m_minIndexableValue = std::numeric_limits<double>::min () * m_gamma;
+}
+
+
+int32_t
+SatQuantileSketch::GetIndex (double value) const
+{
+  return static_cast<int32_t> (std::ceil (std::log (value) / m_logGamma));
+}
+
+
+double
+SatQuantileSketch::GetValue (int32_t index) const
+{
+  return 2.0 * std::exp (index * m_logGamma) / (1.0 + m_gamma);
+}
+
+
+void
+SatQuantileSketch::Add (double value)
+{
+  if (value > m_minIndexableValue)
+    {
+      m_positive.Add (GetIndex (value), 1, m_maxNumOfBuckets);
+    }
+  else if (value < -m_minIndexableValue)
+    {
+      m_negative.Add (GetIndex (-value), 1, m_maxNumOfBuckets);
+    }
+  else
+    {
+      m_zeroCount++;
+    }
+
+  m_count++;
+  m_sum += value;
+  m_min = std::min (m_min, value);
+  m_max = std::max (m_max, value);
+}
+
+
+void
+SatQuantileSketch::Merge (const SatQuantileSketch &other)
+{
+  NS_ABORT_MSG_IF (std::fabs (other.m_relativeAccuracy - m_relativeAccuracy) > 1e-12,
+                   "Cannot merge quantile sketches of relative accuracy "
+                   << m_relativeAccuracy << " and " << other.m_relativeAccuracy);
+
+  m_positive.Merge (other.m_positive, m_maxNumOfBuckets);
+  m_negative.Merge (other.m_negative, m_maxNumOfBuckets);
+  m_zeroCount += other.m_zeroCount;
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+  m_min = std::min (m_min, other.m_min);
+  m_max = std::max (m_max, other.m_max);
+}
+
+
+double
+SatQuantileSketch::GetQuantile (double quantile) const
+{
+  NS_ABORT_MSG_IF (quantile < 0.0 || quantile > 1.0, "Invalid quantile " << quantile);
+
+  if (m_count == 0)
+    {
+      return 0.0;
+    }
+
+  const double rank = quantile * (m_count - 1);
+  double value = 0.0;
+  uint64_t cumulated = 0;
+  bool found = false;
+
+  // negative samples, from the largest magnitude to the smallest one
+  for (uint32_t i = m_negative.m_counts.size (); i > 0 && !found; i--)
+    {
+      cumulated += m_negative.m_counts[i - 1];
+      if (cumulated > rank)
+        {
+          value = -GetValue (m_negative.m_offset + static_cast<int32_t> (i) - 1);
+          found = true;
+        }
+    }
+
+  if (!found)
+    {
+      cumulated += m_zeroCount;
+      found = cumulated > rank;
+    }
+
+  for (uint32_t i = 0; i < m_positive.m_counts.size () && !found; i++)
+    {
+      cumulated += m_positive.m_counts[i];
+      if (cumulated > rank)
+        {
+          value = GetValue (m_positive.m_offset + static_cast<int32_t> (i));
+          found = true;
+        }
+    }
+
+  return std::max (m_min, std::min (m_max, value));
+}
+
+
+uint64_t
+SatQuantileSketch::GetCount () const
+{
+  return m_count;
+}
+
+
+double
+SatQuantileSketch::GetMin () const
+{
+  return m_min;
+}
+
+
+double
+SatQuantileSketch::GetMax () const
+{
+  return m_max;
+}
+
+
+double
+SatQuantileSketch::GetMean () const
+{
+  return m_count > 0 ? m_sum / m_count : 0.0;
+}
+
+
+double
+SatQuantileSketch::GetRelativeAccuracy () const
+{
+  return m_relativeAccuracy;
+}
+
+
+uint32_t
+SatQuantileSketch::GetNumOfBuckets () const
+{
+  return m_positive.m_counts.size () + m_negative.m_counts.size ();
+}
+
+
+void
+SatQuantileSketch::Print (std::ostream &os) const
+{
+  std::streamsize precision = os.precision (17);
+
+  os << m_relativeAccuracy << " " << m_maxNumOfBuckets
+     << " " << m_count << " " << m_sum
+     << " " << m_min << " " << m_max
+     << " " << m_zeroCount;
+
+  const Store *stores[] = { &m_positive, &m_negative };
+
+  for (uint32_t s = 0; s < 2; s++)
+    {
+      const std::vector<uint64_t> &counts = stores[s]->m_counts;
+      uint32_t nonEmpty = counts.size () - std::count (counts.begin (), counts.end (), 0);
+      os << " " << nonEmpty;
+
+      for (uint32_t i = 0; i < counts.size (); i++)
+        {
+          if (counts[i] > 0)
+            {
+              os << " " << stores[s]->m_offset + static_cast<int32_t> (i) << " " << counts[i];
+            }
+        }
+    }
+
+  os.precision (precision);
+}
+
+
+bool
+SatQuantileSketch::Read (std::istream &is)
+{
+  double relativeAccuracy;
+  uint32_t maxNumOfBuckets;
+
+  if (!(is >> relativeAccuracy >> maxNumOfBuckets))
+    {
+      return false;
+    }
+
+  *this = SatQuantileSketch (relativeAccuracy, maxNumOfBuckets);
+
+  if (!(is >> m_count >> m_sum >> m_min >> m_max >> m_zeroCount))
+    {
+      return false;
+    }
+
+  Store *stores[] = { &m_positive, &m_negative };
+
+  for (uint32_t s = 0; s < 2; s++)
+    {
+      uint32_t nonEmpty;
+      if (!(is >> nonEmpty))
+        {
+          return false;
+        }
+
+      // buckets are printed in increasing order of index
+      Store store;
+      for (uint32_t i = 0; i < nonEmpty; i++)
+        {
+          int32_t index;
+          uint64_t count;
+          if (!(is >> index >> count))
+            {
+              return false;
+            }
+          store.Add (index, count, maxNumOfBuckets);
+        }
+      *stores[s] = store;
+    }
+
+  return true;
+}
+
+
+} // end of namespace ns3
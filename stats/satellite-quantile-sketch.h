@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SATELLITE_QUANTILE_SKETCH_H
+#define SATELLITE_QUANTILE_SKETCH_H
+
+#include <stdint.h>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+
+namespace ns3 {
+
+/**
+ * \ingroup satstats
+ * \brief Streaming quantile sketch with bounded memory and relative accuracy
+ * guarantee, following the DDSketch approach.
+ *
+ * Samples are counted in buckets whose boundaries grow geometrically, so that
+ * any quantile is estimated within the configured relative accuracy. The
+ * number of buckets is bounded: when the range of the samples requires more
+ * buckets, the buckets of the smallest magnitudes are collapsed together,
+ * which keeps the accuracy of the upper quantiles. Positive and negative
+ * samples are counted in separate bucket stores, and samples close to zero
+ * in a dedicated counter.
+ *
+ * Two sketches with the same relative accuracy can be merged, the result
+ * being the sketch that would have been obtained by adding the samples of
+ * both. The state of a sketch can be printed to a stream and read back, so
+ * that sketches of independent simulation runs can be merged afterwards.
+ */
+class SatQuantileSketch
+{
+public:
+  /**
+   * \brief Constructor.
+   * \param relativeAccuracy relative accuracy of the quantile estimations,
+   *                         strictly between 0 and 1
+   * \param maxNumOfBuckets maximum number of buckets per bucket store
+   */
+  SatQuantileSketch (double relativeAccuracy = 0.01, uint32_t maxNumOfBuckets = 2048);
+
+  /**
+   * \brief Add a sample to the sketch.
+   * \param value the sample
+   */
+  void Add (double value);
+
+  /**
+   * \brief Add the samples of another sketch to this one.
+   * \param other sketch with the same relative accuracy
+   */
+  void Merge (const SatQuantileSketch &other);
+
+  /**
+   * \brief Estimate a quantile of the samples.
+   * \param quantile quantile between 0 and 1
+   * \return the estimated value, or zero if the sketch is empty
+   */
+  double GetQuantile (double quantile) const;
+
+  /**
+   * \return the number of samples added to the sketch.
+   */
+  uint64_t GetCount () const;
+
+  /**
+   * \return the smallest sample added to the sketch.
+   */
+  double GetMin () const;
+
+  /**
+   * \return the largest sample added to the sketch.
+   */
+  double GetMax () const;
+
+  /**
+   * \return the mean of the samples added to the sketch.
+   */
+  double GetMean () const;
+
+  /**
+   * \return the relative accuracy of the sketch.
+   */
+  double GetRelativeAccuracy () const;
+
+  /**
+   * \return the number of buckets currently allocated by the sketch.
+   */
+  uint32_t GetNumOfBuckets () const;
+
+  /**
+   * \brief Print the state of the sketch on a single line, without end of line.
+   * \param os output stream
+   */
+  void Print (std::ostream &os) const;
+
+  /**
+   * \brief Read the state of a sketch printed by Print ().
+   * \param is input stream
+   * \return true if a complete sketch has been read
+   */
+  bool Read (std::istream &is);
+
+private:
+  /**
+   * \brief Contiguous bucket counters, the first one having index #m_offset.
+   */
+  class Store
+  {
+  public:
+    Store ();
+
+    /**
+     * \brief Add samples in a bucket, collapsing the lowest buckets if needed.
+     * \param index bucket index
+     * \param count number of samples
+     * \param maxNumOfBuckets maximum number of buckets of the store
+     */
+    void Add (int32_t index, uint64_t count, uint32_t maxNumOfBuckets);
+
+    /**
+     * \brief Add the buckets of another store.
+     * \param other the other store
+     * \param maxNumOfBuckets maximum number of buckets of the store
+     */
+    void Merge (const Store &other, uint32_t maxNumOfBuckets);
+
+    /**
+     * \brief Change the range of bucket indices. Buckets below the new range
+     * are collapsed into the lowest bucket of the range.
+     * \param low lowest bucket index
+     * \param high highest bucket index
+     */
+    void Extend (int32_t low, int32_t high);
+
+    std::vector<uint64_t> m_counts;
+    int32_t m_offset;
+  };
+
+  /**
+   * \param value absolute value of a sample, larger than #m_minIndexableValue
+   * \return the index of the bucket of the value
+   */
+  int32_t GetIndex (double value) const;
+
+  /**
+   * \param index bucket index
+   * \return the representative value of the bucket
+   */
+  double GetValue (int32_t index) const;
+
+  double m_relativeAccuracy;
+  uint32_t m_maxNumOfBuckets;
+  double m_gamma;
+  double m_logGamma;
+  double m_minIndexableValue;
+
+  Store m_positive;
+  Store m_negative;
+  uint64_t m_zeroCount;
+  uint64_t m_count;
+  double m_sum;
+  double m_min;
+  double m_max;
+
+}; // end of class SatQuantileSketch
+
+
+} // end of namespace ns3
+
+
+#endif /* SATELLITE_QUANTILE_SKETCH_H */
@@ -99,6 +99,8 @@ SatStatsAntennaGainHelper::GetAveragingMode () const
 void
 SatStatsAntennaGainHelper::AntennaGainCallback (std::string identifier, double gain)
 {
+  CallbackProfiler profiler (this);
+
   std::stringstream ss (identifier);
   uint32_t identifierNum;
   if (!(ss >> identifierNum))
@@ -121,6 +123,7 @@ SatStatsAntennaGainHelper::AntennaGainCallback (std::string identifier, double g
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
     case SatStatsHelper::OUTPUT_SCATTER_PLOT:
       {
         Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
@@ -190,20 +193,19 @@ SatStatsAntennaGainHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading ("gain_db")));
+        m_aggregator = CreateScatterAggregator ("gain_db");
 
         // Setup collectors.
         m_terminalCollectors.SetType ("ns3::UnitConversionCollector");
         m_terminalCollectors.SetAttribute ("ConversionType",
                                            EnumValue (UnitConversionCollector::TRANSPARENT));
         CreateCollectorPerIdentifier (m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator ("OutputTimeValue",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::Write2d);
+        ConnectToScatterAggregator (m_terminalCollectors,
+                                    "OutputTimeValue",
+                                    m_aggregator);
         break;
       }
 
@@ -441,6 +443,21 @@ SatStatsAntennaGainHelper::DoInstall ()
 }
 
 
+void
+SatStatsAntennaGainHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  DisposeCollectors (m_terminalCollectors);
+
+  // The averaging collector receives the outputs of the terminal collectors
+  if (m_averagingCollector != 0)
+    {
+      m_averagingCollector->Dispose ();
+    }
+}
+
+
 void
 SatStatsAntennaGainHelper::InstallProbes ()
 {
@@ -462,7 +479,7 @@ SatStatsAntennaGainHelper::InstallProbes ()
           std::ostringstream oss;
           oss << GetIdentifierForUt (*it);
 
-          if (hoModule->TraceConnect ("AntennaGainTrace", oss.str (), callback))
+          if (ConnectTraceSource (hoModule, "AntennaGainTrace", oss.str (), callback))
             {
               NS_LOG_INFO (this << " successfully connected with UT " << *it);
             }
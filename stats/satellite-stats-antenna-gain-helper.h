@@ -84,6 +84,7 @@ public:
 protected:
   // inherited from SatStatsHelper base class
   void DoInstall ();
+  void DoUninstall ();
 
   /// Maintains a list of collectors created by this helper.
   CollectorMap m_terminalCollectors;
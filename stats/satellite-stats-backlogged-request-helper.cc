@@ -121,8 +121,8 @@ SatStatsBackloggedRequestHelper::DoInstall ()
 
       Ptr<SatBeamScheduler> s = ncc->GetBeamScheduler (*it);
       NS_ASSERT_MSG (s != 0, "Error finding beam " << *it);
-      const bool ret = s->TraceConnect ("BacklogRequestsTrace",
-                                        context.str (), aggregatorSink);
+      const bool ret = ConnectTraceSource (s, "BacklogRequestsTrace",
+                                           context.str (), aggregatorSink);
       NS_ASSERT_MSG (ret,
                      "Error connecting to BacklogRequestsTrace of beam " << *it);
       NS_UNUSED (ret);
@@ -128,8 +128,8 @@ SatStatsBeamServiceTimeHelper::DoInstall ()
 				uint32_t beamId = mac->GetBeamId ();
 				std::ostringstream context;
 				context << beamId;
-	      const bool ret = mac->TraceConnect ("BeamServiceTime",
-	                                        context.str (), beamServiceCallback);
+	      const bool ret = ConnectTraceSource (mac, "BeamServiceTime",
+	                                           context.str (), beamServiceCallback);
 	      NS_ASSERT_MSG (ret,
 	                     "Error connecting to BeamServiceTime of beam " << beamId);
 	      NS_UNUSED (ret);
@@ -141,11 +141,21 @@ SatStatsBeamServiceTimeHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsBeamServiceTimeHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  DisposeCollectors (m_collectorMap);
+}
+
+
 void
 SatStatsBeamServiceTimeHelper::BeamServiceCallback (std::string context,
                                                       Time time)
 {
   NS_LOG_FUNCTION (this << context << time.GetSeconds ());
+  CallbackProfiler profiler (this);
 
   // convert context to number
   std::stringstream ss (context);
@@ -62,6 +62,7 @@ public:
 protected:
   // inherited from SatStatsHelper base class
   void DoInstall ();
+  void DoUninstall ();
 
 private:
   /**
@@ -124,9 +124,9 @@ SatStatsCapacityRequestHelper::DoInstall ()
       NS_ASSERT (utLlc != 0);
       Ptr<SatRequestManager> requestManager = utLlc->GetRequestManager ();
 
-      const bool ret = requestManager->TraceConnect ("CrTraceLog",
-                                                     context.str (),
-                                                     aggregatorSink);
+      const bool ret = ConnectTraceSource (requestManager, "CrTraceLog",
+                                           context.str (),
+                                           aggregatorSink);
       NS_ASSERT_MSG (ret,
                      "Error connecting to CrTraceLog of node " << (*it)->GetId ());
       NS_UNUSED (ret);
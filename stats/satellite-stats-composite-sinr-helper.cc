@@ -114,20 +114,19 @@ SatStatsCompositeSinrHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading ("sinr_db")));
+        m_aggregator = CreateScatterAggregator ("sinr_db");
 
         // Setup collectors.
         m_terminalCollectors.SetType ("ns3::UnitConversionCollector");
         m_terminalCollectors.SetAttribute ("ConversionType",
                                            EnumValue (UnitConversionCollector::TRANSPARENT));
         CreateCollectorPerIdentifier (m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator ("OutputTimeValue",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::Write2d);
+        ConnectToScatterAggregator (m_terminalCollectors,
+                                    "OutputTimeValue",
+                                    m_aggregator);
         break;
       }
 
@@ -255,6 +254,15 @@ SatStatsCompositeSinrHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsCompositeSinrHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  DisposeCollectors (m_terminalCollectors);
+}
+
+
 void
 SatStatsCompositeSinrHelper::InstallProbes ()
 {
@@ -326,7 +334,7 @@ SatStatsFwdCompositeSinrHelper::DoInstallProbes ()
            itCarrier != carriers.End (); ++itCarrier)
         {
           // Connect the object to the probe.
-          if (probe->ConnectByObject ("Sinr", itCarrier->second))
+          if (ConnectProbe (probe, "Sinr", itCarrier->second))
             {
               // Connect the probe to the right collector.
               bool ret = false;
@@ -341,6 +349,7 @@ SatStatsFwdCompositeSinrHelper::DoInstallProbes ()
                   break;
 
                 case SatStatsHelper::OUTPUT_SCATTER_FILE:
+                case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
                 case SatStatsHelper::OUTPUT_SCATTER_PLOT:
                   ret = m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
                                                                "OutputSinr",
@@ -378,7 +387,7 @@ SatStatsFwdCompositeSinrHelper::DoInstallProbes ()
                                     << " to collector " << identifier);
                 }
 
-            } // end of `if (probe->ConnectByObject ("Sinr", itCarrier->second))`
+            } // end of `if (ConnectProbe (probe, "Sinr", itCarrier->second))`
           else
             {
               NS_FATAL_ERROR ("Error connecting to Sinr trace source"
@@ -462,8 +471,7 @@ SatStatsRtnCompositeSinrHelper::DoInstallProbes ()
           for (ObjectVectorValue::Iterator itCarrier = carriers.Begin ();
                itCarrier != carriers.End (); ++itCarrier)
             {
-              if (itCarrier->second->TraceConnectWithoutContext ("Sinr",
-                                                                 callback))
+              if (ConnectTraceSource (itCarrier->second, "Sinr", callback))
                 {
                   NS_LOG_INFO (this << " successfully connected with node ID "
                                     << (*it)->GetId ()
@@ -492,6 +500,7 @@ void
 SatStatsRtnCompositeSinrHelper::SinrCallback (double sinrDb, const Address &from)
 {
   //NS_LOG_FUNCTION (this << sinrDb << from);
+  CallbackProfiler profiler (this);
 
   if (from.IsInvalid ())
     {
@@ -529,6 +538,7 @@ SatStatsRtnCompositeSinrHelper::SinrCallback (double sinrDb, const Address &from
               }
 
             case SatStatsHelper::OUTPUT_SCATTER_FILE:
+            case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
             case SatStatsHelper::OUTPUT_SCATTER_PLOT:
               {
                 Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
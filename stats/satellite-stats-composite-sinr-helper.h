@@ -70,6 +70,7 @@ public:
 protected:
   // inherited from SatStatsHelper base class
   void DoInstall ();
+  void DoUninstall ();
 
   /**
    * \brief
@@ -50,6 +50,8 @@
 #include <ns3/multi-file-aggregator.h>
 #include <ns3/magister-gnuplot-aggregator.h>
 #include <ns3/traffic-time-tag.h>
+#include <ns3/satellite-quantile-collector.h>
+#include <ns3/satellite-output-fstream-wrapper.h>
 
 #include <sstream>
 #include "satellite-stats-delay-helper.h"
@@ -75,6 +77,21 @@ SatStatsDelayHelper::~SatStatsDelayHelper ()
 }
 
 
+void
+SatStatsDelayHelper::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  // The collectors are still alive, they write their own quantiles when destroyed.
+  if (GetOutputType () == SatStatsHelper::OUTPUT_QUANTILE_FILE && m_aggregator != 0)
+    {
+      WriteQuantileSketches ();
+    }
+
+  SatStatsHelper::DoDispose ();
+}
+
+
 TypeId // static
 SatStatsDelayHelper::GetTypeId ()
 {
@@ -141,20 +158,19 @@ SatStatsDelayHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading ("delay_sec")));
+        m_aggregator = CreateScatterAggregator ("delay_sec");
 
         // Setup collectors.
         m_terminalCollectors.SetType ("ns3::UnitConversionCollector");
         m_terminalCollectors.SetAttribute ("ConversionType",
                                            EnumValue (UnitConversionCollector::TRANSPARENT));
         CreateCollectorPerIdentifier (m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator ("OutputTimeValue",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::Write2d);
+        ConnectToScatterAggregator (m_terminalCollectors,
+                                    "OutputTimeValue",
+                                    m_aggregator);
         break;
       }
 
@@ -382,6 +398,29 @@ SatStatsDelayHelper::DoInstall ()
         break;
       }
 
+    case SatStatsHelper::OUTPUT_QUANTILE_FILE:
+      {
+        if (m_averagingMode)
+          {
+            NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for averaged statistics.");
+          }
+
+        // Setup aggregator.
+        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
+                                         "OutputFileName", StringValue (GetOutputFileName ()),
+                                         "MultiFileMode", BooleanValue (false),
+                                         "EnableContextPrinting", BooleanValue (true),
+                                         "GeneralHeading", StringValue (GetIdentifierHeading ("quantile delay_sec")));
+
+        // Setup collectors.
+        m_terminalCollectors.SetType ("ns3::SatQuantileCollector");
+        CreateCollectorPerIdentifier (m_terminalCollectors);
+        m_terminalCollectors.ConnectToAggregator ("Output",
+                                                  m_aggregator,
+                                                  &MultiFileAggregator::Write2d);
+        break;
+      }
+
     default:
       NS_FATAL_ERROR ("SatStatsDelayHelper - Invalid output type");
       break;
@@ -393,6 +432,21 @@ SatStatsDelayHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsDelayHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  DisposeCollectors (m_terminalCollectors);
+
+  // The averaging collector receives the outputs of the terminal collectors
+  if (m_averagingCollector != 0)
+    {
+      m_averagingCollector->Dispose ();
+    }
+}
+
+
 void
 SatStatsDelayHelper::InstallProbes ()
 {
@@ -405,6 +459,7 @@ void
 SatStatsDelayHelper::RxDelayCallback (const Time &delay, const Address &from)
 {
   //NS_LOG_FUNCTION (this << delay.GetSeconds () << from);
+  CallbackProfiler profiler (this);
 
   if (from.IsInvalid ())
     {
@@ -414,12 +469,12 @@ SatStatsDelayHelper::RxDelayCallback (const Time &delay, const Address &from)
     }
   else
     {
-      // Determine the identifier associated with the sender address.
-      std::map<const Address, uint32_t>::const_iterator it = m_identifierMap.find (from);
+      // Determine the terminal index associated with the sender address.
+      uint32_t terminalIndex;
 
-      if (it != m_identifierMap.end ())
+      if (GetAddressTerminalIndex (from, terminalIndex))
         {
-          PassSampleToCollector (delay, it->second);
+          PassSampleToTerminal (delay, terminalIndex);
         }
       else
         {
@@ -447,7 +502,7 @@ SatStatsDelayHelper::SaveAddressAndIdentifier (Ptr<Node> utNode)
   else
     {
       const uint32_t identifier = GetIdentifierForUt (utNode);
-      m_identifierMap[addr] = identifier;
+      SetAddressTerminalIndex (addr, GetTerminalIndex (identifier));
       NS_LOG_INFO (this << " associated address " << addr
                         << " with identifier " << identifier);
 
@@ -455,6 +510,87 @@ SatStatsDelayHelper::SaveAddressAndIdentifier (Ptr<Node> utNode)
 }
 
 
+uint32_t
+SatStatsDelayHelper::GetTerminalIndex (uint32_t identifier)
+{
+  NS_LOG_FUNCTION (this << identifier);
+
+  std::map<uint32_t, uint32_t>::const_iterator it = m_terminalIndices.find (identifier);
+  if (it != m_terminalIndices.end ())
+    {
+      return it->second;
+    }
+
+  Ptr<DataCollectionObject> collector = m_terminalCollectors.Get (identifier);
+  NS_ASSERT_MSG (collector != 0,
+                 "Unable to find collector with identifier " << identifier);
+
+  // Bind the sample sink of the collector, according to its type.
+  Callback<void, double, double> sink;
+
+  switch (GetOutputType ())
+    {
+    case SatStatsHelper::OUTPUT_SCALAR_FILE:
+    case SatStatsHelper::OUTPUT_SCALAR_PLOT:
+      {
+        Ptr<ScalarCollector> c = collector->GetObject<ScalarCollector> ();
+        NS_ASSERT (c != 0);
+        sink = MakeCallback (&ScalarCollector::TraceSinkDouble, c);
+        break;
+      }
+
+    case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
+    case SatStatsHelper::OUTPUT_SCATTER_PLOT:
+      {
+        Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
+        NS_ASSERT (c != 0);
+        sink = MakeCallback (&UnitConversionCollector::TraceSinkDouble, c);
+        break;
+      }
+
+    case SatStatsHelper::OUTPUT_HISTOGRAM_FILE:
+    case SatStatsHelper::OUTPUT_HISTOGRAM_PLOT:
+    case SatStatsHelper::OUTPUT_PDF_FILE:
+    case SatStatsHelper::OUTPUT_PDF_PLOT:
+    case SatStatsHelper::OUTPUT_CDF_FILE:
+    case SatStatsHelper::OUTPUT_CDF_PLOT:
+      if (m_averagingMode)
+        {
+          Ptr<ScalarCollector> c = collector->GetObject<ScalarCollector> ();
+          NS_ASSERT (c != 0);
+          sink = MakeCallback (&ScalarCollector::TraceSinkDouble, c);
+        }
+      else
+        {
+          Ptr<DistributionCollector> c = collector->GetObject<DistributionCollector> ();
+          NS_ASSERT (c != 0);
+          sink = MakeCallback (&DistributionCollector::TraceSinkDouble, c);
+        }
+      break;
+
+    case SatStatsHelper::OUTPUT_QUANTILE_FILE:
+      {
+        Ptr<SatQuantileCollector> c = collector->GetObject<SatQuantileCollector> ();
+        NS_ASSERT (c != 0);
+        sink = MakeCallback (&SatQuantileCollector::TraceSinkDouble, c);
+        break;
+      }
+
+    default:
+      NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for this statistics.");
+      break;
+
+    } // end of `switch (GetOutputType ())`
+
+  const uint32_t terminalIndex = m_terminalSinks.size ();
+  m_terminalSinks.push_back (sink);
+  m_terminalIndices[identifier] = terminalIndex;
+  return terminalIndex;
+
+} // end of `uint32_t GetTerminalIndex (uint32_t)`
+
+
 bool
 SatStatsDelayHelper::ConnectProbeToCollector (Ptr<Probe> probe,
                                               uint32_t identifier)
@@ -473,6 +609,7 @@ SatStatsDelayHelper::ConnectProbeToCollector (Ptr<Probe> probe,
       break;
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
     case SatStatsHelper::OUTPUT_SCATTER_PLOT:
       ret = m_terminalCollectors.ConnectWithProbe (probe,
                                                    "OutputSeconds",
@@ -502,6 +639,13 @@ SatStatsDelayHelper::ConnectProbeToCollector (Ptr<Probe> probe,
         }
       break;
 
+    case SatStatsHelper::OUTPUT_QUANTILE_FILE:
+      ret = m_terminalCollectors.ConnectWithProbe (probe,
+                                                   "OutputSeconds",
+                                                   identifier,
+                                                   &SatQuantileCollector::TraceSinkDouble);
+      break;
+
     default:
       NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for this statistics.");
       break;
@@ -523,61 +667,70 @@ SatStatsDelayHelper::ConnectProbeToCollector (Ptr<Probe> probe,
 
 
 void
-SatStatsDelayHelper::PassSampleToCollector (const Time &delay, uint32_t identifier)
+SatStatsDelayHelper::PassSampleToTerminal (const Time &delay, uint32_t terminalIndex)
 {
-  //NS_LOG_FUNCTION (this << delay.GetSeconds () << identifier);
+  //NS_LOG_FUNCTION (this << delay.GetSeconds () << terminalIndex);
 
-  Ptr<DataCollectionObject> collector = m_terminalCollectors.Get (identifier);
-  NS_ASSERT_MSG (collector != 0,
-                 "Unable to find collector with identifier " << identifier);
+  NS_ASSERT_MSG (terminalIndex < m_terminalSinks.size (),
+                 "Unable to find collector with terminal index " << terminalIndex);
+  m_terminalSinks[terminalIndex] (0.0, delay.GetSeconds ());
+}
 
-  switch (GetOutputType ())
-    {
-    case SatStatsHelper::OUTPUT_SCALAR_FILE:
-    case SatStatsHelper::OUTPUT_SCALAR_PLOT:
-      {
-        Ptr<ScalarCollector> c = collector->GetObject<ScalarCollector> ();
-        NS_ASSERT (c != 0);
-        c->TraceSinkDouble (0.0, delay.GetSeconds ());
-        break;
-      }
 
-    case SatStatsHelper::OUTPUT_SCATTER_FILE:
-    case SatStatsHelper::OUTPUT_SCATTER_PLOT:
-      {
-        Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
-        NS_ASSERT (c != 0);
-        c->TraceSinkDouble (0.0, delay.GetSeconds ());
-        break;
-      }
+void
+SatStatsDelayHelper::WriteQuantileSketches ()
+{
+  NS_LOG_FUNCTION (this);
 
-    case SatStatsHelper::OUTPUT_HISTOGRAM_FILE:
-    case SatStatsHelper::OUTPUT_HISTOGRAM_PLOT:
-    case SatStatsHelper::OUTPUT_PDF_FILE:
-    case SatStatsHelper::OUTPUT_PDF_PLOT:
-    case SatStatsHelper::OUTPUT_CDF_FILE:
-    case SatStatsHelper::OUTPUT_CDF_PLOT:
-      if (m_averagingMode)
+  Ptr<MultiFileAggregator> fileAggregator = m_aggregator->GetObject<MultiFileAggregator> ();
+  NS_ASSERT (fileAggregator != 0);
+
+  // The sketches are saved so that the quantiles of independent runs can be merged.
+  const std::string fileName = GetOutputFileName () + "-sketch.txt";
+  Ptr<SatOutputFileStreamWrapper> sketchFile = Create<SatOutputFileStreamWrapper> (fileName, std::ios::out);
+  std::ostream *os = sketchFile->GetStream ();
+  *os << GetIdentifierHeading ("sketch") << std::endl;
+
+  SatQuantileSketch globalSketch;
+  bool first = true;
+
+  for (CollectorMap::Iterator it = m_terminalCollectors.Begin ();
+       it != m_terminalCollectors.End (); ++it)
+    {
+      Ptr<SatQuantileCollector> c = it->second->GetObject<SatQuantileCollector> ();
+      NS_ASSERT (c != 0);
+      const SatQuantileSketch &sketch = c->GetSketch ();
+
+      if (first)
         {
-          Ptr<ScalarCollector> c = collector->GetObject<ScalarCollector> ();
-          NS_ASSERT (c != 0);
-          c->TraceSinkDouble (0.0, delay.GetSeconds ());
+          globalSketch = sketch;
+          first = false;
         }
       else
         {
-          Ptr<DistributionCollector> c = collector->GetObject<DistributionCollector> ();
-          NS_ASSERT (c != 0);
-          c->TraceSinkDouble (0.0, delay.GetSeconds ());
+          globalSketch.Merge (sketch);
         }
-      break;
 
-    default:
-      NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for this statistics.");
-      break;
+      *os << c->GetName () << " ";
+      sketch.Print (*os);
+      *os << std::endl;
+    }
 
-    } // end of `switch (GetOutputType ())`
+  // A global identifier already covers all the samples.
+  if (GetIdentifierType () != SatStatsHelper::IDENTIFIER_GLOBAL && globalSketch.GetCount () > 0)
+    {
+      for (uint32_t i = 0; i < SatQuantileCollector::GetNumOfReportedQuantiles (); i++)
+        {
+          const double quantile = SatQuantileCollector::GetReportedQuantile (i);
+          fileAggregator->Write2d ("all", quantile, globalSketch.GetQuantile (quantile));
+        }
+
+      *os << "all ";
+      globalSketch.Print (*os);
+      *os << std::endl;
+    }
 
-} // end of `void PassSampleToCollector (Time, uint32_t)`
+} // end of `void WriteQuantileSketches ()`
 
 
 // FORWARD LINK APPLICATION-LEVEL /////////////////////////////////////////////
@@ -640,7 +793,7 @@ SatStatsFwdAppDelayHelper::DoInstallProbes ()
               probe->SetName (probeName.str ());
 
               // Connect the object to the probe.
-              if (probe->ConnectByObject ("RxDelay", app))
+              if (ConnectProbe (probe, "RxDelay", app))
                 {
                   isConnected = ConnectProbeToCollector (probe, identifier);
                   m_probes.push_back (probe->GetObject<Probe> ());
@@ -652,9 +805,8 @@ SatStatsFwdAppDelayHelper::DoInstallProbes ()
               Callback<void, Ptr<const Packet>, const Address &> rxCallback
                 = MakeBoundCallback (&SatStatsFwdAppDelayHelper::RxCallback,
                                      this,
-                                     identifier);
-              isConnected = app->TraceConnectWithoutContext ("Rx",
-                                                             rxCallback);
+                                     GetTerminalIndex (identifier));
+              isConnected = ConnectTraceSource (app, "Rx", rxCallback);
             }
 
           if (isConnected)
@@ -710,11 +862,12 @@ SatStatsFwdAppDelayHelper::DoInstallProbes ()
 
 void // static
 SatStatsFwdAppDelayHelper::RxCallback (Ptr<SatStatsFwdAppDelayHelper> helper,
-                                       uint32_t identifier,
+                                       uint32_t terminalIndex,
                                        Ptr<const Packet> packet,
                                        const Address &from)
 {
-  NS_LOG_FUNCTION (helper << identifier << packet << packet->GetSize () << from);
+  NS_LOG_FUNCTION (helper << terminalIndex << packet << packet->GetSize () << from);
+  CallbackProfiler profiler (PeekPointer (helper));
 
   //  bool isTagged = false;
   //  ByteTagIterator it = packet->GetByteTagIterator ();
@@ -731,7 +884,7 @@ SatStatsFwdAppDelayHelper::RxCallback (Ptr<SatStatsFwdAppDelayHelper> helper,
   //          TrafficTimeTag timeTag;
   //          item.GetTag (timeTag);
   //          const Time delay = Simulator::Now () - timeTag.GetSenderTimestamp ();
-  //          helper->PassSampleToCollector (delay, identifier);
+  //          helper->PassSampleToTerminal (delay, terminalIndex);
   //          isTagged = true; // this will exit the while loop.
   //        }
   //    }
@@ -748,7 +901,7 @@ SatStatsFwdAppDelayHelper::RxCallback (Ptr<SatStatsFwdAppDelayHelper> helper,
     {
       NS_LOG_DEBUG ("Contains a TrafficTimeTag tag");
       const Time delay = Simulator::Now () - timeTag.GetSenderTimestamp ();
-      helper->PassSampleToCollector (delay, identifier);
+      helper->PassSampleToTerminal (delay, terminalIndex);
     }
   else
     {
@@ -808,7 +961,7 @@ SatStatsFwdDevDelayHelper::DoInstallProbes ()
       Ptr<NetDevice> dev = GetUtSatNetDevice (*it);
 
       // Connect the object to the probe.
-      if (probe->ConnectByObject ("RxDelay", dev)
+      if (ConnectProbe (probe, "RxDelay", dev)
           && ConnectProbeToCollector (probe, identifier))
         {
           m_probes.push_back (probe->GetObject<Probe> ());
@@ -894,7 +1047,7 @@ SatStatsFwdMacDelayHelper::DoInstallProbes ()
       NS_ASSERT (satMac != 0);
 
       // Connect the object to the probe.
-      if (probe->ConnectByObject ("RxDelay", satMac)
+      if (ConnectProbe (probe, "RxDelay", satMac)
           && ConnectProbeToCollector (probe, identifier))
         {
           m_probes.push_back (probe->GetObject<Probe> ());
@@ -986,7 +1139,7 @@ SatStatsFwdPhyDelayHelper::DoInstallProbes ()
       NS_ASSERT (satPhy != 0);
 
       // Connect the object to the probe.
-      if (probe->ConnectByObject ("RxDelay", satPhy)
+      if (ConnectProbe (probe, "RxDelay", satPhy)
           && ConnectProbeToCollector (probe, identifier))
         {
           m_probes.push_back (probe->GetObject<Probe> ());
@@ -1109,13 +1262,11 @@ SatStatsRtnAppDelayHelper::DoInstallProbes ()
            */
           if (app->GetInstanceTypeId ().LookupTraceSourceByName ("RxDelay") != 0)
             {
-              isConnected = app->TraceConnectWithoutContext ("RxDelay",
-                                                             rxDelayCallback);
+              isConnected = ConnectTraceSource (app, "RxDelay", rxDelayCallback);
             }
           else if (app->GetInstanceTypeId ().LookupTraceSourceByName ("Rx") != 0)
             {
-              isConnected = app->TraceConnectWithoutContext ("Rx",
-                                                             rxCallback);
+              isConnected = ConnectTraceSource (app, "Rx", rxCallback);
             }
 
           if (isConnected)
@@ -1164,7 +1315,7 @@ SatStatsRtnAppDelayHelper::RxCallback (Ptr<const Packet> packet,
   //          TrafficTimeTag timeTag;
   //          item.GetTag (timeTag);
   //          const Time delay = Simulator::Now () - timeTag.GetSenderTimestamp ();
-  //          helper->PassSampleToCollector (delay, identifier);
+  //          helper->PassSampleToTerminal (delay, terminalIndex);
   //          isTagged = true; // this will exit the while loop.
   //        }
   //    }
@@ -1197,14 +1348,15 @@ void
 SatStatsRtnAppDelayHelper::Ipv4Callback (const Time &delay, const Address &from)
 {
   //NS_LOG_FUNCTION (this << Time.GetSeconds () << from);
+  CallbackProfiler profiler (this);
 
   if (InetSocketAddress::IsMatchingType (from))
     {
-      // Determine the identifier associated with the sender address.
+      // Determine the terminal index associated with the sender address.
       const Address ipv4Addr = InetSocketAddress::ConvertFrom (from).GetIpv4 ();
-      std::map<const Address, uint32_t>::const_iterator it1 = m_identifierMap.find (ipv4Addr);
+      uint32_t terminalIndex;
 
-      if (it1 == m_identifierMap.end ())
+      if (!GetAddressTerminalIndex (ipv4Addr, terminalIndex))
         {
           NS_LOG_WARN (this << " discarding a packet delay of " << delay.GetSeconds ()
                             << " from statistics collection because of"
@@ -1212,7 +1364,7 @@ SatStatsRtnAppDelayHelper::Ipv4Callback (const Time &delay, const Address &from)
         }
       else
         {
-          PassSampleToCollector (delay, it1->second);
+          PassSampleToTerminal (delay, terminalIndex);
         }
     }
   else
@@ -1240,6 +1392,7 @@ SatStatsRtnAppDelayHelper::SaveIpv4AddressAndIdentifier (Ptr<Node> utUserNode)
   else if (ipv4->GetNInterfaces () >= 2)
     {
       const uint32_t identifier = GetIdentifierForUtUser (utUserNode);
+      const uint32_t terminalIndex = GetTerminalIndex (identifier);
 
       /*
        * Assuming that #0 is for loopback interface and #1 is for subscriber
@@ -1248,7 +1401,7 @@ SatStatsRtnAppDelayHelper::SaveIpv4AddressAndIdentifier (Ptr<Node> utUserNode)
       for (uint32_t i = 0; i < ipv4->GetNAddresses (1); i++)
         {
           const Address addr = ipv4->GetAddress (1, i).GetLocal ();
-          m_identifierMap[addr] = identifier;
+          SetAddressTerminalIndex (addr, terminalIndex);
           NS_LOG_INFO (this << " associated address " << addr
                             << " with identifier " << identifier);
         }
@@ -1319,7 +1472,7 @@ SatStatsRtnDevDelayHelper::DoInstallProbes ()
         {
           NS_ASSERT ((*itDev)->GetObject<SatNetDevice> () != 0);
 
-          if ((*itDev)->TraceConnectWithoutContext ("RxDelay", callback))
+          if (ConnectTraceSource (*itDev, "RxDelay", callback))
             {
               NS_LOG_INFO (this << " successfully connected with node ID "
                                 << (*it)->GetId ()
@@ -1410,7 +1563,7 @@ SatStatsRtnMacDelayHelper::DoInstallProbes ()
           NS_ASSERT (satMac != 0);
 
           // Connect the object to the probe.
-          if (satMac->TraceConnectWithoutContext ("RxDelay", callback))
+          if (ConnectTraceSource (satMac, "RxDelay", callback))
             {
               NS_LOG_INFO (this << " successfully connected with node ID "
                                 << (*it)->GetId ()
@@ -1501,7 +1654,7 @@ SatStatsRtnPhyDelayHelper::DoInstallProbes ()
           NS_ASSERT (satPhy != 0);
 
           // Connect the object to the probe.
-          if (satPhy->TraceConnectWithoutContext ("RxDelay", callback))
+          if (ConnectTraceSource (satPhy, "RxDelay", callback))
             {
               NS_LOG_INFO (this << " successfully connected with node ID "
                                 << (*it)->GetId ()
@@ -26,8 +26,10 @@
 #include <ns3/ptr.h>
 #include <ns3/address.h>
 #include <ns3/collector-map.h>
+#include <ns3/callback.h>
 #include <list>
 #include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -93,6 +95,10 @@ public:
 protected:
   // inherited from SatStatsHelper base class
   void DoInstall ();
+  void DoUninstall ();
+
+  // inherited from Object base class
+  virtual void DoDispose ();
 
   /**
    * \brief
@@ -103,14 +109,25 @@ protected:
    * \brief Save the address and the proper identifier from the given UT node.
    * \param utNode a UT node.
    *
-   * The address of the given node will be saved in the #m_identifierMap
-   * member variable.
+   * The address of the given node will be associated with the terminal index
+   * of the identifier by SetAddressTerminalIndex().
    *
    * Used in return link statistics. DoInstallProbes() is expected to pass the
    * the UT node of interest into this method.
    */
   void SaveAddressAndIdentifier (Ptr<Node> utNode);
 
+  /**
+   * \brief Get the terminal index of an identifier, binding the sample sink
+   *        of its collector on first use.
+   * \param identifier
+   * \return the index of the sample sink in #m_terminalSinks.
+   *
+   * Terminal indices are dense, and assigned when installing the probes, so
+   * that passing a sample does not look up the collector.
+   */
+  uint32_t GetTerminalIndex (uint32_t identifier);
+
   /**
    * \brief Connect the probe to the right collector.
    * \param probe
@@ -119,12 +136,19 @@ protected:
   bool ConnectProbeToCollector (Ptr<Probe> probe, uint32_t identifier);
 
   /**
-   * \brief Find a collector with the right identifier and pass a sample data
-   *        to it.
+   * \brief Pass a sample data to the collector of a terminal.
    * \param delay
-   * \param identifier
+   * \param terminalIndex index returned by GetTerminalIndex().
+   */
+  void PassSampleToTerminal (const Time &delay, uint32_t terminalIndex);
+
+  /**
+   * \brief Write the quantiles of all the samples, merged from the sketches
+   *        of the collectors, and save the sketches in a separate file.
+   *
+   * Used in OUTPUT_QUANTILE_FILE output type.
    */
-  void PassSampleToCollector (const Time &delay, uint32_t identifier);
+  void WriteQuantileSketches ();
 
   /// Maintains a list of collectors created by this helper.
   CollectorMap m_terminalCollectors;
@@ -135,8 +159,11 @@ protected:
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
-  /// Map of address and the identifier associated with it (for return link).
-  std::map<const Address, uint32_t> m_identifierMap;
+  /// Sample sinks of the collectors, indexed by terminal index.
+  std::vector<Callback<void, double, double> > m_terminalSinks;
+
+  /// Map of identifier and the terminal index associated with it.
+  std::map<uint32_t, uint32_t> m_terminalIndices;
 
 private:
   bool m_averagingMode;  ///< `AveragingMode` attribute.
@@ -187,13 +214,14 @@ public:
    * \brief Receive inputs from trace sources and determine the right collector
    *        to forward the inputs to.
    * \param helper Pointer to the delay statistics collector helper
-   * \param identifier Identifier used to group statistics.
+   * \param terminalIndex Terminal index of the identifier used to group
+   *                      statistics.
    * \param packet the received packet, expected to have been tagged with
    *               TrafficTimeTag.
    * \param from the InetSocketAddress of the sender of the packet.
    */
   static void RxCallback (Ptr<SatStatsFwdAppDelayHelper> helper,
-                          uint32_t identifier,
+                          uint32_t terminalIndex,
                           Ptr<const Packet> packet,
                           const Address &from);
 
@@ -416,8 +444,8 @@ private:
    *        UT user node.
    * \param utUserNode a UT user node.
    *
-   * Any addresses found in the given node will be saved in the
-   * #m_identifierMap member variable.
+   * Any addresses found in the given node will be associated with the
+   * terminal index of the identifier by SetAddressTerminalIndex().
    */
   void SaveIpv4AddressAndIdentifier (Ptr<Node> utUserNode);
 
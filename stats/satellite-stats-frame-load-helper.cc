@@ -197,6 +197,19 @@ SatStatsFrameLoadHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsFrameLoadHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (std::map<uint32_t, CollectorMap>::iterator it = m_collectors.begin ();
+       it != m_collectors.end (); ++it)
+    {
+      DisposeCollectors (it->second);
+    }
+}
+
+
 std::string
 SatStatsFrameLoadHelper::GetIdentifierHeading (std::string dataLabel) const
 {
@@ -225,6 +238,7 @@ SatStatsFrameLoadHelper::FrameSymbolLoadCallback (std::string context,
                                                   double loadRatio)
 {
   //NS_LOG_FUNCTION (this << context << frameId << loadRatio);
+  CallbackProfiler profiler (this);
 
   // Get the right collector for this frame ID and identifier.
   Ptr<ScalarCollector> collector = GetCollector (frameId, context);
@@ -244,6 +258,7 @@ SatStatsFrameLoadHelper::FrameUserLoadCallback (std::string context,
                                                 uint32_t utCount)
 {
   //NS_LOG_FUNCTION (this << context << frameId << utCount);
+  CallbackProfiler profiler (this);
 
   // Get the right collector for this frame ID and identifier.
   Ptr<ScalarCollector> collector = GetCollector (frameId, context);
@@ -92,6 +92,7 @@ public:
 protected:
   // inherited from SatStatsHelper base class
   void DoInstall ();
+  void DoUninstall ();
   std::string GetIdentifierHeading (std::string dataLabel) const;
 
 private:
@@ -164,7 +165,7 @@ SatStatsFrameLoadHelper::SetupProbe (Ptr<Object> object,
     }
 
   // Connect the object to the probe and then to the callback.
-  if (probe->ConnectByObject (m_objectTraceSourceName, object)
+  if (ConnectProbe (probe->template GetObject<Probe> (), m_objectTraceSourceName, object)
       && probe->TraceConnect (m_probeTraceSourceName,
                               oss.str (),
                               MakeCallback (traceSink, this)))
@@ -217,8 +217,8 @@ SatStatsFrameTypeUsageHelper::DoInstall ()
 				uint32_t beamId = mac->GetBeamId ();
 				std::ostringstream context;
 				context << GetIdentifierForBeam (beamId);
-	      const bool ret = mac->TraceConnect ("BBFrameTxTrace",
-	                                        context.str (), frameTypeUsageCallback);
+	      const bool ret = ConnectTraceSource (mac, "BBFrameTxTrace",
+	                                           context.str (), frameTypeUsageCallback);
 	      NS_ASSERT_MSG (ret,
 	                     "Error connecting to BBFrameTxTrace of beam " << beamId);
 	      NS_UNUSED (ret);
@@ -230,6 +230,19 @@ SatStatsFrameTypeUsageHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsFrameTypeUsageHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (std::map<uint32_t, CollectorMap>::iterator it = m_collectors.begin ();
+       it != m_collectors.end (); ++it)
+    {
+      DisposeCollectors (it->second);
+    }
+}
+
+
 std::string
 SatStatsFrameTypeUsageHelper::GetIdentifierHeading (std::string dataLabel) const
 {
@@ -266,6 +279,7 @@ SatStatsFrameTypeUsageHelper::FrameTypeUsageCallback (std::string context,
                                                       SatEnums::SatBbFrameType_t frameType)
 {
   NS_LOG_FUNCTION (this << context << SatEnums::GetFrameTypeName (frameType));
+  CallbackProfiler profiler (this);
 
   // convert context to number
   std::stringstream ss (context);
@@ -68,6 +68,7 @@ public:
 protected:
   // inherited from SatStatsHelper base class
   void DoInstall ();
+  void DoUninstall ();
 
   /**
    * Get identifier header for file.
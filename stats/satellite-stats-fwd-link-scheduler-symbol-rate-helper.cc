@@ -81,6 +81,7 @@ void
 SatStatsFwdLinkSchedulerSymbolRateHelper::SymbolRateCallback (uint8_t sliceId, double symbolRate)
 {
   NS_LOG_FUNCTION (this << sliceId << " " << symbolRate);
+  CallbackProfiler profiler (this);
 
   Ptr<DataCollectionObject> collector = NULL;
 
@@ -117,6 +118,7 @@ SatStatsFwdLinkSchedulerSymbolRateHelper::SymbolRateCallback (uint8_t sliceId, d
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
     case SatStatsHelper::OUTPUT_SCATTER_PLOT:
       {
         Ptr<IntervalRateCollector> c = collector->GetObject<IntervalRateCollector> ();
@@ -190,24 +192,20 @@ SatStatsFwdLinkSchedulerSymbolRateHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading ("symbol_rate_baud")));
-        Ptr<MultiFileAggregator> aggregator = m_aggregator->GetObject<MultiFileAggregator> ();
+        m_aggregator = CreateScatterAggregator ("symbol_rate_baud");
 
         // Setup collectors
         m_collectors.SetType ("ns3::IntervalRateCollector");
         m_collectors.SetAttribute ("InputDataType",
                                    EnumValue (IntervalRateCollector::INPUT_DATA_TYPE_DOUBLE));
         CreateCollectorPerIdentifier (m_collectors);
-        m_collectors.ConnectToAggregator ("OutputWithTime",
-                                          m_aggregator,
-                                          &MultiFileAggregator::Write2d);
-        m_collectors.ConnectToAggregator ("OutputString",
-                                          m_aggregator,
-                                          &MultiFileAggregator::AddContextHeading);
+        ConnectToScatterAggregator (m_collectors,
+                                    "OutputWithTime",
+                                    m_aggregator);
+        ConnectHeadingToScatterAggregator (m_collectors, m_aggregator);
 
         break;
       }
@@ -340,6 +338,15 @@ SatStatsFwdLinkSchedulerSymbolRateHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsFwdLinkSchedulerSymbolRateHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  DisposeCollectors (m_collectors);
+}
+
+
 void
 SatStatsFwdLinkSchedulerSymbolRateHelper::InstallProbes ()
 {
@@ -366,7 +373,7 @@ SatStatsFwdLinkSchedulerSymbolRateHelper::InstallProbes ()
           Ptr<SatFwdLinkScheduler> fwdLinkScheduler = scheduler.Get<SatFwdLinkScheduler> ();
           NS_ASSERT (fwdLinkScheduler != 0);
 
-          if (!fwdLinkScheduler->TraceConnectWithoutContext ("SymbolRate", GetTraceSinkCallback ()))
+          if (!ConnectTraceSource (fwdLinkScheduler, "SymbolRate", GetTraceSinkCallback ()))
             {
               NS_FATAL_ERROR ("Error connecting to Symbol Rate trace source"
                               << " of SatFwdLinkScheduler"
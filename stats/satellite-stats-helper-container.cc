@@ -22,8 +22,14 @@
 
 #include "satellite-stats-helper-container.h"
 #include <ns3/log.h>
+#include <ns3/abort.h>
 #include <ns3/enum.h>
 #include <ns3/string.h>
+#include <ns3/uinteger.h>
+#include <ns3/nstime.h>
+#include <ns3/simulator.h>
+#include <ns3/singleton.h>
+#include <ns3/satellite-env-variables.h>
 #include <ns3/satellite-helper.h>
 #include <ns3/satellite-stats-antenna-gain-helper.h>
 #include <ns3/satellite-stats-backlogged-request-helper.h>
@@ -45,6 +51,7 @@
 #include <ns3/satellite-stats-fwd-link-scheduler-symbol-rate-helper.h>
 #include <ns3/satellite-stats-frame-type-usage-helper.h>
 #include <ns3/satellite-stats-beam-service-time-helper.h>
+#include <fstream>
 
 NS_LOG_COMPONENT_DEFINE ("SatStatsHelperContainer");
 
@@ -56,7 +63,12 @@ NS_OBJECT_ENSURE_REGISTERED (SatStatsHelperContainer);
 
 
 SatStatsHelperContainer::SatStatsHelperContainer (Ptr<const SatHelper> satHelper)
-  : m_satHelper (satHelper)
+  : m_satHelper (satHelper),
+  m_measurementStart (Seconds (0)),
+  m_measurementStop (Seconds (0)),
+  m_profilingPeriod (0),
+  m_isProfileScheduled (false),
+  m_isConstructed (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -103,7 +115,8 @@ SatStatsHelperContainer::DoDispose ()
   MakeEnumChecker (SatStatsHelper::OUTPUT_NONE,           "NONE",             \
       SatStatsHelper::OUTPUT_SCALAR_FILE,    "SCALAR_FILE",      \
       SatStatsHelper::OUTPUT_SCATTER_FILE,   "SCATTER_FILE",     \
-      SatStatsHelper::OUTPUT_SCATTER_PLOT,   "SCATTER_PLOT"))
+      SatStatsHelper::OUTPUT_SCATTER_PLOT,   "SCATTER_PLOT",     \
+      SatStatsHelper::OUTPUT_COLUMNAR_FILE,  "COLUMNAR_FILE"))
 
 #define ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER                             \
   MakeEnumChecker (SatStatsHelper::OUTPUT_NONE,           "NONE",             \
@@ -115,7 +128,22 @@ SatStatsHelperContainer::DoDispose ()
       SatStatsHelper::OUTPUT_SCATTER_PLOT,   "SCATTER_PLOT",     \
       SatStatsHelper::OUTPUT_HISTOGRAM_PLOT, "HISTOGRAM_PLOT",   \
       SatStatsHelper::OUTPUT_PDF_PLOT,       "PDF_PLOT",         \
-      SatStatsHelper::OUTPUT_CDF_PLOT,       "CDF_PLOT"))
+      SatStatsHelper::OUTPUT_CDF_PLOT,       "CDF_PLOT",         \
+      SatStatsHelper::OUTPUT_COLUMNAR_FILE,  "COLUMNAR_FILE"))
+
+#define ADD_SAT_STATS_DELAY_OUTPUT_CHECKER                                    \
+  MakeEnumChecker (SatStatsHelper::OUTPUT_NONE,           "NONE",             \
+      SatStatsHelper::OUTPUT_SCALAR_FILE,    "SCALAR_FILE",      \
+      SatStatsHelper::OUTPUT_SCATTER_FILE,   "SCATTER_FILE",     \
+      SatStatsHelper::OUTPUT_HISTOGRAM_FILE, "HISTOGRAM_FILE",   \
+      SatStatsHelper::OUTPUT_PDF_FILE,       "PDF_FILE",         \
+      SatStatsHelper::OUTPUT_CDF_FILE,       "CDF_FILE",         \
+      SatStatsHelper::OUTPUT_SCATTER_PLOT,   "SCATTER_PLOT",     \
+      SatStatsHelper::OUTPUT_HISTOGRAM_PLOT, "HISTOGRAM_PLOT",   \
+      SatStatsHelper::OUTPUT_PDF_PLOT,       "PDF_PLOT",         \
+      SatStatsHelper::OUTPUT_CDF_PLOT,       "CDF_PLOT",         \
+      SatStatsHelper::OUTPUT_QUANTILE_FILE,  "QUANTILE_FILE",    \
+      SatStatsHelper::OUTPUT_COLUMNAR_FILE,  "COLUMNAR_FILE"))
 
 #define ADD_SAT_STATS_AVERAGED_DISTRIBUTION_OUTPUT_CHECKER                    \
   MakeEnumChecker (SatStatsHelper::OUTPUT_NONE,           "NONE",             \
@@ -160,6 +188,20 @@ SatStatsHelperContainer::DoDispose ()
                     std::string ("per UT ") + desc)               \
                     ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
 
+#define ADD_SAT_STATS_ATTRIBUTES_DELAY_SET(id, desc)                          \
+  ADD_SAT_STATS_ATTRIBUTE_HEAD (Global ## id,                                 \
+      std::string ("global ") + desc)               \
+      ADD_SAT_STATS_DELAY_OUTPUT_CHECKER                                          \
+      ADD_SAT_STATS_ATTRIBUTE_HEAD (PerGw ## id,                                  \
+          std::string ("per GW ") + desc)               \
+          ADD_SAT_STATS_DELAY_OUTPUT_CHECKER                                          \
+          ADD_SAT_STATS_ATTRIBUTE_HEAD (PerBeam ## id,                                \
+              std::string ("per beam ") + desc)             \
+              ADD_SAT_STATS_DELAY_OUTPUT_CHECKER                                          \
+              ADD_SAT_STATS_ATTRIBUTE_HEAD (PerUt ## id,                                  \
+                  std::string ("per UT ") + desc)               \
+                  ADD_SAT_STATS_DELAY_OUTPUT_CHECKER
+
 #define ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET(id, desc)          \
   ADD_SAT_STATS_ATTRIBUTE_HEAD (AverageBeam ## id,                            \
       std::string ("average beam ") + desc)         \
@@ -180,13 +222,34 @@ SatStatsHelperContainer::GetTypeId ()
         MakeStringAccessor (&SatStatsHelperContainer::SetName,
           &SatStatsHelperContainer::GetName),
         MakeStringChecker ())
+    .AddAttribute ("MeasurementStart",
+        "Time at which the statistics are installed. If strictly positive, "
+        "the probes are connected only at this time, so that the warm-up "
+        "period before it runs without statistics overhead.",
+        TimeValue (Seconds (0)),
+        MakeTimeAccessor (&SatStatsHelperContainer::m_measurementStart),
+        MakeTimeChecker ())
+    .AddAttribute ("MeasurementStop",
+        "Time at which the statistics are uninstalled, i.e., their trace "
+        "sources are disconnected and their probes disabled. Zero to keep "
+        "them until the end of the simulation.",
+        TimeValue (Seconds (0)),
+        MakeTimeAccessor (&SatStatsHelperContainer::m_measurementStop),
+        MakeTimeChecker ())
+    .AddAttribute ("ProfilingPeriod",
+        "If not zero, count the callbacks of every statistics, time one "
+        "callback out of this period, and write the profile of every "
+        "statistics at the end of the simulation.",
+        UintegerValue (0),
+        MakeUintegerAccessor (&SatStatsHelperContainer::m_profilingPeriod),
+        MakeUintegerChecker<uint32_t> ())
 
     // Forward link application-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (FwdAppDelay,
+    ADD_SAT_STATS_ATTRIBUTES_DELAY_SET (FwdAppDelay,
         "forward link application-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTE_HEAD (PerUtUserFwdAppDelay,
         "per UT user forward link application-level delay statistics")
-    ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
+    ADD_SAT_STATS_DELAY_OUTPUT_CHECKER
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (FwdAppDelay,
         "forward link application-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTE_HEAD (AverageUtUserFwdAppDelay,
@@ -194,19 +257,19 @@ SatStatsHelperContainer::GetTypeId ()
     ADD_SAT_STATS_AVERAGED_DISTRIBUTION_OUTPUT_CHECKER
 
     // Forward link device-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (FwdDevDelay,
+    ADD_SAT_STATS_ATTRIBUTES_DELAY_SET (FwdDevDelay,
         "forward link device-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (FwdDevDelay,
         "forward link device-level delay statistics")
 
     // Forward link MAC-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (FwdMacDelay,
+    ADD_SAT_STATS_ATTRIBUTES_DELAY_SET (FwdMacDelay,
         "forward link MAC-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (FwdMacDelay,
         "forward link MAC-level delay statistics")
 
     // Forward link PHY-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (FwdPhyDelay,
+    ADD_SAT_STATS_ATTRIBUTES_DELAY_SET (FwdPhyDelay,
         "forward link PHY-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (FwdPhyDelay,
         "forward link PHY-level delay statistics")
@@ -258,11 +321,11 @@ SatStatsHelperContainer::GetTypeId ()
         "forward link PHY-level throughput statistics")
 
     // Return link application-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (RtnAppDelay,
+    ADD_SAT_STATS_ATTRIBUTES_DELAY_SET (RtnAppDelay,
         "return link application-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTE_HEAD (PerUtUserRtnAppDelay,
         "per UT user return link application-level delay statistics")
-    ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
+    ADD_SAT_STATS_DELAY_OUTPUT_CHECKER
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (RtnAppDelay,
         "return link application-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTE_HEAD (AverageUtUserRtnAppDelay,
@@ -270,19 +333,19 @@ SatStatsHelperContainer::GetTypeId ()
     ADD_SAT_STATS_AVERAGED_DISTRIBUTION_OUTPUT_CHECKER
 
     // Return link device-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (RtnDevDelay,
+    ADD_SAT_STATS_ATTRIBUTES_DELAY_SET (RtnDevDelay,
         "return link device-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (RtnDevDelay,
         "return link device-level delay statistics")
 
     // Return link MAC-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (RtnMacDelay,
+    ADD_SAT_STATS_ATTRIBUTES_DELAY_SET (RtnMacDelay,
         "return link MAC-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (RtnMacDelay,
         "return link MAC-level delay statistics")
 
     // Return link PHY-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (RtnPhyDelay,
+    ADD_SAT_STATS_ATTRIBUTES_DELAY_SET (RtnPhyDelay,
         "return link PHY-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (RtnPhyDelay,
         "return link PHY-level delay statistics")
@@ -509,6 +572,99 @@ SatStatsHelperContainer::GetName () const
 }
 
 
+void
+SatStatsHelperContainer::NotifyConstructionCompleted ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Object::NotifyConstructionCompleted ();
+  m_isConstructed = true;
+
+  for (std::list<Ptr<SatStatsHelper> >::const_iterator it = m_pendingStats.begin ();
+       it != m_pendingStats.end (); ++it)
+    {
+      InstallStat (*it);
+    }
+
+  m_pendingStats.clear ();
+}
+
+
+void
+SatStatsHelperContainer::InstallStat (Ptr<SatStatsHelper> stat)
+{
+  NS_LOG_FUNCTION (this << stat->GetName ());
+
+  // The attributes may be set in any order, the measurement window included
+  if (!m_isConstructed)
+    {
+      m_pendingStats.push_back (stat);
+      return;
+    }
+
+  const Time now = Simulator::Now ();
+  NS_ABORT_MSG_IF (m_measurementStop.IsStrictlyPositive ()
+                   && (m_measurementStop <= m_measurementStart || m_measurementStop < now),
+                   "SatStatsHelperContainer - Invalid measurement window from "
+                   << m_measurementStart.GetSeconds () << "s to "
+                   << m_measurementStop.GetSeconds () << "s");
+
+  stat->SetProfilingPeriod (m_profilingPeriod);
+
+  if (m_measurementStart > now)
+    {
+      Simulator::Schedule (m_measurementStart - now, &SatStatsHelper::Install, stat);
+    }
+  else
+    {
+      stat->Install ();
+    }
+
+  if (m_measurementStop.IsStrictlyPositive ())
+    {
+      Simulator::Schedule (m_measurementStop - now, &SatStatsHelper::Uninstall, stat);
+    }
+
+  if (m_profilingPeriod > 0 && !m_isProfileScheduled)
+    {
+      Simulator::ScheduleDestroy (&SatStatsHelperContainer::WriteProfile,
+                                  Ptr<SatStatsHelperContainer> (this));
+      m_isProfileScheduled = true;
+    }
+
+  m_stats.push_back (stat);
+}
+
+
+void
+SatStatsHelperContainer::WriteProfile () const
+{
+  NS_LOG_FUNCTION (this);
+
+  const std::string fileName = Singleton<SatEnvVariables>::Get ()->GetOutputPath ()
+    + "/" + m_name + "-profile.txt";
+  std::ofstream output (fileName.c_str (), std::ios::out);
+  if (!output.is_open ())
+    {
+      NS_FATAL_ERROR ("SatStatsHelperContainer - Unable to open " << fileName);
+    }
+
+  output << "% name install_sec connections callbacks callback_sec\n";
+
+  for (std::list<Ptr<const SatStatsHelper> >::const_iterator it = m_stats.begin ();
+       it != m_stats.end (); ++it)
+    {
+      output << (*it)->GetName () << " "
+             << (*it)->GetInstallWallTime () << " "
+             << (*it)->GetNumOfConnections () << " "
+             << (*it)->GetNumOfCallbacks () << " "
+             << (*it)->GetCallbackWallTime () << "\n";
+    }
+
+  output.close ();
+}
+
+
 /*
  * The macro definitions following this comment block are used to declare the
  * majority of methods in this class. Below is the list of the class methods
@@ -552,8 +708,7 @@ SatStatsHelperContainer::GetName () const
         + GetOutputTypeSuffix (type));                             \
     stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_GLOBAL);              \
     stat->SetOutputType (type);                                               \
-    stat->Install ();                                                         \
-    m_stats.push_back (stat);                                                 \
+    InstallStat (stat);                                                       \
   }                                                                           \
 }
 
@@ -570,8 +725,7 @@ SatStatsHelperContainer::GetName () const
         + GetOutputTypeSuffix (type));                             \
     stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_GW);                  \
     stat->SetOutputType (type);                                               \
-    stat->Install ();                                                         \
-    m_stats.push_back (stat);                                                 \
+    InstallStat (stat);                                                       \
   }                                                                           \
 }
 
@@ -588,8 +742,7 @@ SatStatsHelperContainer::GetName () const
         + GetOutputTypeSuffix (type));                             \
     stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_BEAM);                \
     stat->SetOutputType (type);                                               \
-    stat->Install ();                                                         \
-    m_stats.push_back (stat);                                                 \
+    InstallStat (stat);                                                       \
   }                                                                           \
 }
 
@@ -606,8 +759,7 @@ SatStatsHelperContainer::GetName () const
         + GetOutputTypeSuffix (type));                             \
     stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_UT);                  \
     stat->SetOutputType (type);                                               \
-    stat->Install ();                                                         \
-    m_stats.push_back (stat);                                                 \
+    InstallStat (stat);                                                       \
   }                                                                           \
 }
 
@@ -624,8 +776,7 @@ SatStatsHelperContainer::GetName () const
         + GetOutputTypeSuffix (type));                               \
     stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_UT_USER);               \
     stat->SetOutputType (type);                                                 \
-    stat->Install ();                                                           \
-    m_stats.push_back (stat);                                                   \
+    InstallStat (stat);                                                         \
   }                                                                             \
 }
 
@@ -643,8 +794,7 @@ SatStatsHelperContainer::GetName () const
     stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_BEAM);                    \
     stat->SetOutputType (type);                                                   \
     stat->SetAveragingMode (true);                                                \
-    stat->Install ();                                                             \
-    m_stats.push_back (stat);                                                     \
+    InstallStat (stat);                                                           \
   }                                                                               \
 }
 
@@ -662,8 +812,7 @@ SatStatsHelperContainer::GetName () const
     stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_UT);                    \
     stat->SetOutputType (type);                                                 \
     stat->SetAveragingMode (true);                                              \
-    stat->Install ();                                                           \
-    m_stats.push_back (stat);                                                   \
+    InstallStat (stat);                                                         \
   }                                                                             \
 }
 
@@ -681,8 +830,7 @@ SatStatsHelperContainer::GetName () const
     stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_UT_USER);                   \
     stat->SetOutputType (type);                                                     \
     stat->SetAveragingMode (true);                                                  \
-    stat->Install ();                                                               \
-    m_stats.push_back (stat);                                                       \
+    InstallStat (stat);                                                             \
   }                                                                                 \
 }
 
@@ -699,8 +847,7 @@ SatStatsHelperContainer::GetName () const
                      + GetOutputTypeSuffix (type));                                     \
       stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_SLICE);                       \
       stat->SetOutputType (type);                                                       \
-      stat->Install ();                                                                 \
-      m_stats.push_back (stat);                                                         \
+      InstallStat (stat);                                                               \
     }                                                                                   \
   }
 
@@ -1015,6 +1162,7 @@ SatStatsHelperContainer::GetOutputTypeSuffix (SatStatsHelper::OutputType_t outpu
 
   case SatStatsHelper::OUTPUT_SCATTER_FILE:
   case SatStatsHelper::OUTPUT_SCATTER_PLOT:
+  case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
     return "-scatter";
 
   case SatStatsHelper::OUTPUT_HISTOGRAM_FILE:
@@ -1029,6 +1177,9 @@ SatStatsHelperContainer::GetOutputTypeSuffix (SatStatsHelper::OutputType_t outpu
   case SatStatsHelper::OUTPUT_CDF_PLOT:
     return "-cdf";
 
+  case SatStatsHelper::OUTPUT_QUANTILE_FILE:
+    return "-quantile";
+
   default:
     NS_FATAL_ERROR ("SatStatsHelperContainer - Invalid output type");
     break;
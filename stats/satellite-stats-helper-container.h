@@ -25,6 +25,7 @@
 
 #include <ns3/object.h>
 #include <ns3/ptr.h>
+#include <ns3/nstime.h>
 #include <ns3/satellite-stats-helper.h>
 #include <list>
 
@@ -102,6 +103,35 @@ class SatHelper;
  * which will produce output files with the names such as
  * `stat-per-ut-fwd-app-delay-scalar.txt`,
  * `stat-per-ut-fwd-app-delay-cdf-ut-1.txt`, etc.
+ *
+ * The delay statistics also accept the OUTPUT_QUANTILE_FILE output type,
+ * which writes the quantiles in e.g. `stat-per-ut-fwd-app-delay-quantile.txt`
+ * and saves the mergeable quantile sketches in
+ * `stat-per-ut-fwd-app-delay-quantile-sketch.txt`.
+ *
+ * The statistics accepting OUTPUT_SCATTER_FILE also accept the
+ * OUTPUT_COLUMNAR_FILE output type, which writes the samples of all the
+ * identifiers in a single binary file, e.g.,
+ * `stat-per-ut-fwd-app-delay-scatter.bin`, instead of one text file per
+ * identifier. SatColumnarFileReader converts it back to the text files.
+ *
+ * The `MeasurementStart` and `MeasurementStop` attributes restrict the
+ * statistics to a measurement window. The statistics added with a strictly
+ * positive start time are installed only at that time, so that a warm-up
+ * period runs without any probe connected, and they are uninstalled at the
+ * stop time, if any. At the stop time, every output type stops with the
+ * samples of the window, e.g., the scalar averages per second are computed
+ * over the window. When set with the statistics attributes, e.g., with
+ * Config::SetDefault(), both attributes apply to all the statistics,
+ * otherwise they must be set before adding statistics.
+ *
+ * If the `ProfilingPeriod` attribute is not zero, the callbacks of every
+ * statistics are counted, and one callback out of `ProfilingPeriod` is timed.
+ * At the end of the simulation, the install time, the number of connected
+ * trace sources and probes, the number of callbacks and their estimated
+ * wall clock time are written per statistics in e.g. `stat-profile.txt`.
+ * Only the callbacks going through the helpers are counted, the samples
+ * passed by probes directly to collectors are not.
  */
 class SatStatsHelperContainer : public Object
 {
@@ -310,12 +340,26 @@ public:
    */
   static std::string GetOutputTypeSuffix (SatStatsHelper::OutputType_t outputType);
 
+  /**
+   * \brief Write the profile of every statistics, as enabled by the
+   *        `ProfilingPeriod` attribute.
+   *
+   * Invoked at Simulator::Destroy().
+   */
+  void WriteProfile () const;
+
 protected:
   /**
    * Inherited from Object base class
    */
   virtual void DoDispose ();
 
+  /**
+   * \brief Install the statistics added by the attributes, once the
+   *        measurement window attributes are set.
+   */
+  virtual void NotifyConstructionCompleted ();
+
 private:
   /// Satellite module helper for reference.
   Ptr<const SatHelper> m_satHelper;
@@ -326,6 +370,32 @@ private:
   /// Maintains the active SatStatsHelper instances which have created.
   std::list<Ptr<const SatStatsHelper> > m_stats;
 
+  /// `MeasurementStart` attribute.
+  Time m_measurementStart;
+
+  /// `MeasurementStop` attribute.
+  Time m_measurementStop;
+
+  /// `ProfilingPeriod` attribute.
+  uint32_t m_profilingPeriod;
+
+  /// Whether WriteProfile() has been scheduled.
+  bool m_isProfileScheduled;
+
+  /// Whether the attributes have been set at construction.
+  bool m_isConstructed;
+
+  /// Statistics added by the attributes, installed once they are all set.
+  std::list<Ptr<SatStatsHelper> > m_pendingStats;
+
+  /**
+   * \brief Install a new statistics within the measurement window, and keep
+   *        it in the container.
+   * \param stat the statistics, whose name, identifier type and output type
+   *             are already set.
+   */
+  void InstallStat (Ptr<SatStatsHelper> stat);
+
 }; // end of class StatStatsHelperContainer
 
 
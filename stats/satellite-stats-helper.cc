@@ -31,12 +31,17 @@
 #include <ns3/node-container.h>
 #include <ns3/collector-map.h>
 #include <ns3/data-collection-object.h>
+#include <ns3/probe.h>
+#include <ns3/multi-file-aggregator.h>
+#include <ns3/satellite-columnar-file-aggregator.h>
 #include <ns3/log.h>
 #include <ns3/type-id.h>
 #include <ns3/object-factory.h>
 #include <ns3/string.h>
 #include <ns3/enum.h>
+#include <ns3/nstime.h>
 #include <sstream>
+#include <limits>
 
 NS_LOG_COMPONENT_DEFINE ("SatStatsHelper");
 
@@ -99,6 +104,10 @@ SatStatsHelper::GetOutputTypeName (SatStatsHelper::OutputType_t outputType)
       return "OUTPUT_PDF_PLOT";
     case SatStatsHelper::OUTPUT_CDF_PLOT:
       return "OUTPUT_CDF_PLOT";
+    case SatStatsHelper::OUTPUT_QUANTILE_FILE:
+      return "OUTPUT_QUANTILE_FILE";
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
+      return "OUTPUT_COLUMNAR_FILE";
     default:
       NS_FATAL_ERROR ("SatStatsHelper - Invalid output type");
       break;
@@ -114,7 +123,15 @@ SatStatsHelper::SatStatsHelper (Ptr<const SatHelper> satHelper)
   m_identifierType (SatStatsHelper::IDENTIFIER_GLOBAL),
   m_outputType (SatStatsHelper::OUTPUT_SCATTER_FILE),
   m_isInstalled (false),
-  m_satHelper (satHelper)
+  m_satHelper (satHelper),
+  m_aggregationInterval (Seconds (0)),
+  m_isUninstalled (false),
+  m_profilingPeriod (0),
+  m_installWallTime (0.0),
+  m_numOfCallbacks (0),
+  m_numOfMeasuredCallbacks (0),
+  m_measuredCallbackWallTime (0.0),
+  m_minAddressKey (0)
 {
   NS_LOG_FUNCTION (this << satHelper);
 }
@@ -162,7 +179,20 @@ SatStatsHelper::GetTypeId ()
                                     SatStatsHelper::OUTPUT_SCATTER_PLOT,   "SCATTER_PLOT",
                                     SatStatsHelper::OUTPUT_HISTOGRAM_PLOT, "HISTOGRAM_PLOT",
                                     SatStatsHelper::OUTPUT_PDF_PLOT,       "PDF_PLOT",
-                                    SatStatsHelper::OUTPUT_CDF_PLOT,       "CDF_PLOT"))
+                                    SatStatsHelper::OUTPUT_CDF_PLOT,       "CDF_PLOT",
+                                    SatStatsHelper::OUTPUT_QUANTILE_FILE,  "QUANTILE_FILE",
+                                    SatStatsHelper::OUTPUT_COLUMNAR_FILE,  "COLUMNAR_FILE"))
+    .AddAttribute ("AggregationInterval",
+                   "If strictly positive, the throughput, signalling load, packet "
+                   "error and packet collision statistics count their samples in "
+                   "plain counters instead of collectors. The scatter file outputs "
+                   "are then written once per interval, and the scalar file outputs "
+                   "once at the end of the simulation. Other statistics and output "
+                   "types are not affected.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&SatStatsHelper::SetAggregationInterval,
+                                     &SatStatsHelper::GetAggregationInterval),
+                   MakeTimeChecker ())
   ;
   return tid;
 }
@@ -180,12 +210,63 @@ SatStatsHelper::Install ()
     }
   else
     {
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
       DoInstall (); // this method is supposed to be implemented by the child class
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+      m_installWallTime += elapsed.count ();
       m_isInstalled = true;
     }
 }
 
 
+void
+SatStatsHelper::Uninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_isInstalled || m_isUninstalled)
+    {
+      return;
+    }
+
+  for (std::vector<TraceConnection>::iterator it = m_traceConnections.begin ();
+       it != m_traceConnections.end (); ++it)
+    {
+      bool ret;
+      if (it->hasContext)
+        {
+          ret = it->object->TraceDisconnect (it->traceSourceName, it->context, it->callback);
+        }
+      else
+        {
+          ret = it->object->TraceDisconnectWithoutContext (it->traceSourceName, it->callback);
+        }
+
+      if (!ret)
+        {
+          NS_LOG_WARN (this << " unable to disconnect " << it->traceSourceName
+                            << " of object " << it->object);
+        }
+    }
+
+  for (std::vector<Ptr<Probe> >::iterator it = m_connectedProbes.begin ();
+       it != m_connectedProbes.end (); ++it)
+    {
+      (*it)->Disable ();
+    }
+
+  m_isUninstalled = true;
+  DoUninstall ();
+}
+
+
+void
+SatStatsHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+
 void
 SatStatsHelper::SetName (std::string name)
 {
@@ -260,6 +341,46 @@ SatStatsHelper::GetOutputType () const
 }
 
 
+void
+SatStatsHelper::SetAggregationInterval (Time aggregationInterval)
+{
+  NS_LOG_FUNCTION (this << aggregationInterval.GetSeconds ());
+
+  if (m_isInstalled && (m_aggregationInterval != aggregationInterval))
+    {
+      NS_LOG_WARN (this << " cannot modify the current aggregation interval"
+                        << " (" << m_aggregationInterval.GetSeconds () << "s)"
+                        << " because this instance have already been installed");
+    }
+  else
+    {
+      m_aggregationInterval = aggregationInterval;
+    }
+}
+
+
+Time
+SatStatsHelper::GetAggregationInterval () const
+{
+  return m_aggregationInterval;
+}
+
+
+void
+SatStatsHelper::SetProfilingPeriod (uint32_t profilingPeriod)
+{
+  NS_LOG_FUNCTION (this << profilingPeriod);
+  m_profilingPeriod = profilingPeriod;
+}
+
+
+uint32_t
+SatStatsHelper::GetProfilingPeriod () const
+{
+  return m_profilingPeriod;
+}
+
+
 bool
 SatStatsHelper::IsInstalled () const
 {
@@ -267,6 +388,117 @@ SatStatsHelper::IsInstalled () const
 }
 
 
+bool
+SatStatsHelper::IsUninstalled () const
+{
+  return m_isUninstalled;
+}
+
+
+double
+SatStatsHelper::GetInstallWallTime () const
+{
+  return m_installWallTime;
+}
+
+
+uint32_t
+SatStatsHelper::GetNumOfConnections () const
+{
+  return m_traceConnections.size () + m_connectedProbes.size ();
+}
+
+
+uint64_t
+SatStatsHelper::GetNumOfCallbacks () const
+{
+  return m_numOfCallbacks;
+}
+
+
+double
+SatStatsHelper::GetCallbackWallTime () const
+{
+  if (m_numOfMeasuredCallbacks == 0)
+    {
+      return 0.0;
+    }
+
+  return m_measuredCallbackWallTime * m_numOfCallbacks / m_numOfMeasuredCallbacks;
+}
+
+
+bool
+SatStatsHelper::ConnectTraceSource (Ptr<Object> object,
+                                    std::string traceSourceName,
+                                    const CallbackBase &callback)
+{
+  NS_LOG_FUNCTION (this << object << traceSourceName);
+
+  if (!object->TraceConnectWithoutContext (traceSourceName, callback))
+    {
+      return false;
+    }
+
+  TraceConnection connection;
+  connection.object = object;
+  connection.traceSourceName = traceSourceName;
+  connection.hasContext = false;
+  connection.callback = callback;
+  m_traceConnections.push_back (connection);
+  return true;
+}
+
+
+bool
+SatStatsHelper::ConnectTraceSource (Ptr<Object> object,
+                                    std::string traceSourceName,
+                                    std::string context,
+                                    const CallbackBase &callback)
+{
+  NS_LOG_FUNCTION (this << object << traceSourceName << context);
+
+  if (!object->TraceConnect (traceSourceName, context, callback))
+    {
+      return false;
+    }
+
+  TraceConnection connection;
+  connection.object = object;
+  connection.traceSourceName = traceSourceName;
+  connection.hasContext = true;
+  connection.context = context;
+  connection.callback = callback;
+  m_traceConnections.push_back (connection);
+  return true;
+}
+
+
+bool
+SatStatsHelper::ConnectProbe (Ptr<Probe> probe,
+                              std::string traceSourceName,
+                              Ptr<Object> object)
+{
+  NS_LOG_FUNCTION (this << probe << traceSourceName << object);
+
+  if (!probe->ConnectByObject (traceSourceName, object))
+    {
+      return false;
+    }
+
+  m_connectedProbes.push_back (probe);
+  return true;
+}
+
+
+void
+SatStatsHelper::AddConnectedProbe (Ptr<Probe> probe)
+{
+  NS_LOG_FUNCTION (this << probe);
+  m_connectedProbes.push_back (probe);
+}
+
+
 Ptr<const SatHelper>
 SatStatsHelper::GetSatHelper () const
 {
@@ -296,64 +528,38 @@ SatStatsHelper::CreateAggregator (std::string aggregatorTypeId,
 }
 
 
-uint32_t
-SatStatsHelper::CreateCollectorPerIdentifier (CollectorMap &collectorMap) const
+std::list<uint32_t>
+SatStatsHelper::GetIdentifiers () const
 {
   NS_LOG_FUNCTION (this);
-  uint32_t n = 0;
+  std::list<uint32_t> identifiers;
 
   switch (GetIdentifierType ())
     {
     case SatStatsHelper::IDENTIFIER_GLOBAL:
-      {
-        collectorMap.SetAttribute ("Name", StringValue ("0"));
-        collectorMap.Create (0);
-        n++;
-        break;
-      }
+      identifiers.push_back (0);
+      break;
 
     case SatStatsHelper::IDENTIFIER_GW:
       {
         NodeContainer gws = m_satHelper->GetBeamHelper ()->GetGwNodes ();
         for (NodeContainer::Iterator it = gws.Begin (); it != gws.End (); ++it)
           {
-            const uint32_t gwId = GetGwId (*it);
-            std::ostringstream name;
-            name << gwId;
-            collectorMap.SetAttribute ("Name", StringValue (name.str ()));
-            collectorMap.Create (gwId);
-            n++;
+            identifiers.push_back (GetGwId (*it));
           }
         break;
       }
 
     case SatStatsHelper::IDENTIFIER_BEAM:
-      {
-        std::list<uint32_t> beams = m_satHelper->GetBeamHelper ()->GetBeams ();
-        for (std::list<uint32_t>::const_iterator it = beams.begin ();
-             it != beams.end (); ++it)
-          {
-            const uint32_t beamId = (*it);
-            std::ostringstream name;
-            name << beamId;
-            collectorMap.SetAttribute ("Name", StringValue (name.str ()));
-            collectorMap.Create (beamId);
-            n++;
-          }
-        break;
-      }
+      identifiers = m_satHelper->GetBeamHelper ()->GetBeams ();
+      break;
 
     case SatStatsHelper::IDENTIFIER_UT:
       {
         NodeContainer uts = m_satHelper->GetBeamHelper ()->GetUtNodes ();
         for (NodeContainer::Iterator it = uts.Begin (); it != uts.End (); ++it)
           {
-            const uint32_t utId = GetUtId (*it);
-            std::ostringstream name;
-            name << utId;
-            collectorMap.SetAttribute ("Name", StringValue (name.str ()));
-            collectorMap.Create (utId);
-            n++;
+            identifiers.push_back (GetUtId (*it));
           }
         break;
       }
@@ -364,12 +570,7 @@ SatStatsHelper::CreateCollectorPerIdentifier (CollectorMap &collectorMap) const
         for (NodeContainer::Iterator it = utUsers.Begin ();
              it != utUsers.End (); ++it)
           {
-            const uint32_t utUserId = GetUtUserId (*it);
-            std::ostringstream name;
-            name << utUserId;
-            collectorMap.SetAttribute ("Name", StringValue (name.str ()));
-            collectorMap.Create (utUserId);
-            n++;
+            identifiers.push_back (GetUtUserId (*it));
           }
         break;
       }
@@ -378,21 +579,38 @@ SatStatsHelper::CreateCollectorPerIdentifier (CollectorMap &collectorMap) const
       {
         for (uint32_t sliceId = 0; sliceId < 256; sliceId++)
           {
-            std::ostringstream name;
-            name << sliceId;
-            collectorMap.SetAttribute ("Name", StringValue (name.str ()));
-            collectorMap.Create (sliceId);
-            n++;
+            identifiers.push_back (sliceId);
           }
         break;
       }
 
-
     default:
       NS_FATAL_ERROR ("SatStatsHelper - Invalid identifier type");
       break;
     }
 
+  return identifiers;
+
+} // end of `std::list<uint32_t> GetIdentifiers ();`
+
+
+uint32_t
+SatStatsHelper::CreateCollectorPerIdentifier (CollectorMap &collectorMap) const
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t n = 0;
+
+  const std::list<uint32_t> identifiers = GetIdentifiers ();
+  for (std::list<uint32_t>::const_iterator it = identifiers.begin ();
+       it != identifiers.end (); ++it)
+    {
+      std::ostringstream name;
+      name << *it;
+      collectorMap.SetAttribute ("Name", StringValue (name.str ()));
+      collectorMap.Create (*it);
+      n++;
+    }
+
   NS_LOG_INFO (this << " created " << n << " instance(s)"
                     << " of " << collectorMap.GetType ().GetName ()
                     << " for " << GetIdentifierTypeName (GetIdentifierType ()));
@@ -402,6 +620,171 @@ SatStatsHelper::CreateCollectorPerIdentifier (CollectorMap &collectorMap) const
 } // end of `uint32_t CreateCollectorPerIdentifier (CollectorMap &);`
 
 
+bool
+SatStatsHelper::IsIntervalAggregationEnabled () const
+{
+  if (!m_aggregationInterval.IsStrictlyPositive ())
+    {
+      return false;
+    }
+
+  switch (GetOutputType ())
+    {
+    case SatStatsHelper::OUTPUT_SCALAR_FILE:
+    case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
+      return true;
+
+    default:
+      return false;
+    }
+}
+
+
+Ptr<SatIntervalCounter>
+SatStatsHelper::CreateIntervalCounter (Ptr<DataCollectionObject> aggregator,
+                                       SatIntervalCounter::OutputType_t outputType,
+                                       double conversionFactor) const
+{
+  NS_LOG_FUNCTION (this << aggregator << outputType << conversionFactor);
+  NS_ASSERT (IsIntervalAggregationEnabled ());
+
+  Ptr<SatIntervalCounter> counter = Create<SatIntervalCounter> (outputType,
+                                                                conversionFactor);
+
+  const std::list<uint32_t> identifiers = GetIdentifiers ();
+  for (std::list<uint32_t>::const_iterator it = identifiers.begin ();
+       it != identifiers.end (); ++it)
+    {
+      std::ostringstream name;
+      name << *it;
+      counter->AddIdentifier (*it, name.str ());
+    }
+
+  if (GetOutputType () == SatStatsHelper::OUTPUT_SCALAR_FILE)
+    {
+      Ptr<MultiFileAggregator> fileAggregator = aggregator->GetObject<MultiFileAggregator> ();
+      NS_ASSERT (fileAggregator != 0);
+      counter->SetScalarSink (MakeCallback (&MultiFileAggregator::Write1d, fileAggregator));
+    }
+  else
+    {
+      counter->SetScatterSink (GetScatterAggregatorSink (aggregator),
+                               m_aggregationInterval);
+    }
+
+  counter->Start ();
+
+  NS_LOG_INFO (this << " created interval counters"
+                    << " for " << identifiers.size () << " identifier(s)"
+                    << " of " << GetIdentifierTypeName (GetIdentifierType ()));
+
+  return counter;
+
+} // end of `Ptr<SatIntervalCounter> CreateIntervalCounter (...);`
+
+
+Ptr<DataCollectionObject>
+SatStatsHelper::CreateScatterAggregator (std::string dataLabel)
+{
+  NS_LOG_FUNCTION (this << dataLabel);
+
+  switch (GetOutputType ())
+    {
+    case SatStatsHelper::OUTPUT_SCATTER_FILE:
+      return CreateAggregator ("ns3::MultiFileAggregator",
+                               "OutputFileName", StringValue (GetOutputFileName ()),
+                               "GeneralHeading", StringValue (GetTimeHeading (dataLabel)));
+
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
+      return CreateAggregator ("ns3::SatColumnarFileAggregator",
+                               "OutputFileName", StringValue (GetOutputFileName ()),
+                               "GeneralHeading", StringValue (GetTimeHeading (dataLabel)));
+
+    default:
+      NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a scatter file output type.");
+      break;
+    }
+
+  return 0;
+}
+
+
+void
+SatStatsHelper::ConnectToScatterAggregator (CollectorMap &collectorMap,
+                                            std::string traceSourceName,
+                                            Ptr<DataCollectionObject> aggregator) const
+{
+  NS_LOG_FUNCTION (this << traceSourceName << aggregator);
+
+  if (GetOutputType () == SatStatsHelper::OUTPUT_COLUMNAR_FILE)
+    {
+      collectorMap.ConnectToAggregator (traceSourceName,
+                                        aggregator,
+                                        &SatColumnarFileAggregator::Write2d);
+    }
+  else
+    {
+      collectorMap.ConnectToAggregator (traceSourceName,
+                                        aggregator,
+                                        &MultiFileAggregator::Write2d);
+    }
+}
+
+
+void
+SatStatsHelper::ConnectHeadingToScatterAggregator (CollectorMap &collectorMap,
+                                                   Ptr<DataCollectionObject> aggregator) const
+{
+  NS_LOG_FUNCTION (this << aggregator);
+
+  if (GetOutputType () == SatStatsHelper::OUTPUT_COLUMNAR_FILE)
+    {
+      collectorMap.ConnectToAggregator ("OutputString",
+                                        aggregator,
+                                        &SatColumnarFileAggregator::AddContextHeading);
+    }
+  else
+    {
+      collectorMap.ConnectToAggregator ("OutputString",
+                                        aggregator,
+                                        &MultiFileAggregator::AddContextHeading);
+    }
+}
+
+
+void
+SatStatsHelper::DisposeCollectors (CollectorMap &collectorMap) const
+{
+  NS_LOG_FUNCTION (this);
+
+  for (CollectorMap::Iterator it = collectorMap.Begin ();
+       it != collectorMap.End (); ++it)
+    {
+      it->second->Dispose ();
+    }
+}
+
+
+Callback<void, std::string, double, double>
+SatStatsHelper::GetScatterAggregatorSink (Ptr<DataCollectionObject> aggregator) const
+{
+  NS_LOG_FUNCTION (this << aggregator);
+
+  if (GetOutputType () == SatStatsHelper::OUTPUT_COLUMNAR_FILE)
+    {
+      Ptr<SatColumnarFileAggregator> columnarAggregator
+        = aggregator->GetObject<SatColumnarFileAggregator> ();
+      NS_ASSERT (columnarAggregator != 0);
+      return MakeCallback (&SatColumnarFileAggregator::Write2d, columnarAggregator);
+    }
+
+  Ptr<MultiFileAggregator> fileAggregator = aggregator->GetObject<MultiFileAggregator> ();
+  NS_ASSERT (fileAggregator != 0);
+  return MakeCallback (&MultiFileAggregator::Write2d, fileAggregator);
+}
+
+
 std::string
 SatStatsHelper::GetOutputPath () const
 {
@@ -781,6 +1164,78 @@ SatStatsHelper::GetIdentifierForGw (Ptr<Node> gwNode) const
 }
 
 
+uint64_t // static
+SatStatsHelper::GetAddressKey (const Address &address)
+{
+  uint8_t buffer[Address::MAX_SIZE];
+  const uint32_t length = address.CopyTo (buffer);
+  NS_ASSERT_MSG (length < sizeof (uint64_t),
+                 "Address " << address << " is too long to be converted to a key");
+
+  // The length is kept above the address bytes, so that keys of addresses
+  // of different lengths differ.
+  uint64_t key = length;
+  for (uint32_t i = 0; i < length; i++)
+    {
+      key = (key << 8) | buffer[i];
+    }
+  return key;
+}
+
+
+void
+SatStatsHelper::SetAddressTerminalIndex (const Address &address, uint32_t terminalIndex)
+{
+  NS_LOG_FUNCTION (this << address << terminalIndex);
+
+  const uint32_t noTerminalIndex = std::numeric_limits<uint32_t>::max ();
+  const uint64_t key = GetAddressKey (address);
+
+  if (m_addressTerminalIndices.empty ())
+    {
+      m_minAddressKey = key;
+    }
+  else if (key < m_minAddressKey)
+    {
+      m_addressTerminalIndices.insert (m_addressTerminalIndices.begin (),
+                                       m_minAddressKey - key, noTerminalIndex);
+      m_minAddressKey = key;
+    }
+
+  const uint64_t offset = key - m_minAddressKey;
+
+  // Guard against addresses of different types, whose keys are far apart
+  if (offset >= (1 << 24))
+    {
+      NS_FATAL_ERROR ("Address " << address << " is too far from the other sender addresses"
+                                 << " of the statistics");
+    }
+
+  if (offset >= m_addressTerminalIndices.size ())
+    {
+      m_addressTerminalIndices.resize (offset + 1, noTerminalIndex);
+    }
+
+  m_addressTerminalIndices[offset] = terminalIndex;
+}
+
+
+bool
+SatStatsHelper::GetAddressTerminalIndex (const Address &address, uint32_t &terminalIndex) const
+{
+  // Keys below the lowest one wrap around to large offsets
+  const uint64_t offset = GetAddressKey (address) - m_minAddressKey;
+
+  if (offset >= m_addressTerminalIndices.size ())
+    {
+      return false;
+    }
+
+  terminalIndex = m_addressTerminalIndices[offset];
+  return terminalIndex != std::numeric_limits<uint32_t>::max ();
+}
+
+
 NetDeviceContainer // static
 SatStatsHelper::GetGwSatNetDevice (Ptr<Node> gwNode)
 {
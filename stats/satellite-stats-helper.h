@@ -26,7 +26,13 @@
 #include <ns3/object.h>
 #include <ns3/attribute.h>
 #include <ns3/net-device-container.h>
+#include <ns3/callback.h>
+#include <ns3/nstime.h>
+#include <ns3/satellite-interval-counter.h>
+#include <list>
 #include <map>
+#include <vector>
+#include <chrono>
 
 
 namespace ns3 {
@@ -34,8 +40,10 @@ namespace ns3 {
 
 class SatHelper;
 class Node;
+class Address;
 class CollectorMap;
 class DataCollectionObject;
+class Probe;
 
 /**
  * \ingroup satellite
@@ -126,6 +134,8 @@ public:
     OUTPUT_HISTOGRAM_PLOT,
     OUTPUT_PDF_PLOT,        // probability distribution function
     OUTPUT_CDF_PLOT,        // cumulative distribution function
+    OUTPUT_QUANTILE_FILE,   // quantiles estimated by a quantile sketch
+    OUTPUT_COLUMNAR_FILE,   // scatter samples of all identifiers in a binary file
   } OutputType_t;
 
   /**
@@ -165,6 +175,19 @@ public:
    */
   void Install ();
 
+  /**
+   * \brief Stop producing samples.
+   *
+   * Disconnect the trace sources connected by ConnectTraceSource() and
+   * disable the probes connected by ConnectProbe(), so that the simulation
+   * runs afterwards as if the statistics were not installed. Child classes
+   * then pass the outputs of their collectors or interval counters to the
+   * aggregators in DoUninstall(), so that every output type covers the
+   * samples until this time only. The aggregators still write their files at
+   * the end of the simulation as usual.
+   */
+  void Uninstall ();
+
   // SETTER AND GETTER METHODS ////////////////////////////////////////////////
 
   /**
@@ -199,11 +222,66 @@ public:
    */
   OutputType_t GetOutputType () const;
 
+  /**
+   * \param aggregationInterval interval between two writes of the scatter
+   *                            outputs in interval aggregation mode, or zero
+   *                            to disable this mode.
+   * \warning Does not have any effect if invoked after Install().
+   */
+  void SetAggregationInterval (Time aggregationInterval);
+
+  /**
+   * \return the interval of the interval aggregation mode, zero if disabled.
+   */
+  Time GetAggregationInterval () const;
+
+  /**
+   * \param profilingPeriod if not zero, count the callbacks of the
+   *                        statistics and measure the wall clock time of one
+   *                        callback out of `profilingPeriod`.
+   */
+  void SetProfilingPeriod (uint32_t profilingPeriod);
+
+  /**
+   * \return the period of the measured callbacks, zero if disabled.
+   */
+  uint32_t GetProfilingPeriod () const;
+
   /**
    * \return true if Install() has been invoked, otherwise false.
    */
   bool IsInstalled () const;
 
+  /**
+   * \return true if Uninstall() has been invoked, otherwise false.
+   */
+  bool IsUninstalled () const;
+
+  // PROFILING METHODS ////////////////////////////////////////////////////////
+
+  /**
+   * \return the wall clock time spent in Install(), in seconds.
+   */
+  double GetInstallWallTime () const;
+
+  /**
+   * \return the number of trace sources connected by ConnectTraceSource()
+   *         and of probes connected by ConnectProbe().
+   */
+  uint32_t GetNumOfConnections () const;
+
+  /**
+   * \return the number of callbacks of the statistics, counted only while
+   *         the profiling period is not zero.
+   */
+  uint64_t GetNumOfCallbacks () const;
+
+  /**
+   * \return the wall clock time spent in the callbacks of the statistics, in
+   *         seconds, extrapolated from the measured callbacks.
+   */
+  double GetCallbackWallTime () const;
+
   /**
    * \return a pointer to the the SatHelper instance used as a reference by
    *         this helper instance.
@@ -220,6 +298,107 @@ protected:
    */
   virtual void DoInstall () = 0;
 
+  /**
+   * \brief Write the outputs which depend on the end of the measurement,
+   *        after the samples have stopped in Uninstall(), e.g., by disposing
+   *        the collectors with DisposeCollectors().
+   *
+   * Does nothing by default.
+   */
+  virtual void DoUninstall ();
+
+  /**
+   * \brief Measure one callback of the statistics, if the profiling period
+   *        is not zero.
+   *
+   * Declared at the beginning of a trace sink of the statistics, e.g.:
+   * \code
+   *     CallbackProfiler profiler (this);
+   * \endcode
+   * it counts the callback and, once every profiling period, measures the
+   * wall clock time until the end of its scope.
+   */
+  class CallbackProfiler
+  {
+  public:
+    /**
+     * \brief Count a callback and start its measurement if needed.
+     * \param helper the statistics receiving the callback.
+     */
+    inline CallbackProfiler (SatStatsHelper *helper)
+      : m_helper (0)
+    {
+      if (helper->m_profilingPeriod > 0
+          && ++helper->m_numOfCallbacks % helper->m_profilingPeriod == 0)
+        {
+          m_helper = helper;
+          m_start = std::chrono::steady_clock::now ();
+        }
+    }
+
+    /**
+     * \brief Add the measured wall clock time to the statistics, if any.
+     */
+    inline ~CallbackProfiler ()
+    {
+      if (m_helper != 0)
+        {
+          const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - m_start;
+          m_helper->m_measuredCallbackWallTime += elapsed.count ();
+          m_helper->m_numOfMeasuredCallbacks++;
+        }
+    }
+
+  private:
+    SatStatsHelper *m_helper;  ///< Measured statistics, or 0.
+    std::chrono::steady_clock::time_point m_start;  ///< Start of the measurement.
+  };
+
+  /**
+   * \brief Connect a trace source, and remember the connection so that
+   *        Uninstall() disconnects it.
+   * \param object the object owning the trace source.
+   * \param traceSourceName the name of the trace source.
+   * \param callback the trace sink.
+   * \return true if the connection succeeded.
+   */
+  bool ConnectTraceSource (Ptr<Object> object,
+                           std::string traceSourceName,
+                           const CallbackBase &callback);
+
+  /**
+   * \brief Connect a trace source with a context, and remember the
+   *        connection so that Uninstall() disconnects it.
+   * \param object the object owning the trace source.
+   * \param traceSourceName the name of the trace source.
+   * \param context the context passed to the trace sink.
+   * \param callback the trace sink.
+   * \return true if the connection succeeded.
+   */
+  bool ConnectTraceSource (Ptr<Object> object,
+                           std::string traceSourceName,
+                           std::string context,
+                           const CallbackBase &callback);
+
+  /**
+   * \brief Connect a probe to a trace source, and remember the probe so that
+   *        Uninstall() disables it.
+   * \param probe the probe.
+   * \param traceSourceName the name of the trace source.
+   * \param object the object owning the trace source.
+   * \return true if the connection succeeded.
+   */
+  bool ConnectProbe (Ptr<Probe> probe,
+                     std::string traceSourceName,
+                     Ptr<Object> object);
+
+  /**
+   * \brief Remember a probe already connected by the child class, so that
+   *        Uninstall() disables it.
+   * \param probe the probe.
+   */
+  void AddConnectedProbe (Ptr<Probe> probe);
+
   /**
    * \return the path where statistics output should be written to.
    *
@@ -299,6 +478,88 @@ protected:
    */
   uint32_t CreateCollectorPerIdentifier (CollectorMap &collectorMap) const;
 
+  /**
+   * \return the identifiers in the simulation, as found by
+   *         CreateCollectorPerIdentifier().
+   */
+  std::list<uint32_t> GetIdentifiers () const;
+
+  /**
+   * \return true if the `AggregationInterval` attribute is strictly positive
+   *         and the output type is a scalar or scatter file, i.e., if the
+   *         helpers supporting it should use CreateIntervalCounter() instead
+   *         of collectors.
+   */
+  bool IsIntervalAggregationEnabled () const;
+
+  /**
+   * \brief Create the counters of every identifier in the simulation, and
+   *        connect them to the aggregator.
+   * \param aggregator a MultiFileAggregator for OUTPUT_SCALAR_FILE, or the
+   *                   aggregator created by CreateScatterAggregator().
+   * \param outputType type of the written values.
+   * \param conversionFactor factor applied to the sums written per second.
+   * \return the counters, already started.
+   *
+   * The scalar values are written at the end of the simulation, and the
+   * scatter values every `AggregationInterval`.
+   */
+  Ptr<SatIntervalCounter> CreateIntervalCounter (Ptr<DataCollectionObject> aggregator,
+                                                 SatIntervalCounter::OutputType_t outputType,
+                                                 double conversionFactor) const;
+
+  /**
+   * \brief Create the aggregator of the scatter samples, according to the
+   *        output type.
+   * \param dataLabel the short name of the main data of this statistics.
+   * \return a MultiFileAggregator for OUTPUT_SCATTER_FILE, or a
+   *         SatColumnarFileAggregator for OUTPUT_COLUMNAR_FILE.
+   *
+   * The scatter samples are then passed to the aggregator through
+   * ConnectToScatterAggregator() or GetScatterAggregatorSink(), so that the
+   * same code serves both output types.
+   */
+  Ptr<DataCollectionObject> CreateScatterAggregator (std::string dataLabel);
+
+  /**
+   * \brief Connect the time-value samples of the collectors to the
+   *        aggregator created by CreateScatterAggregator().
+   * \param collectorMap the collectors, whose names are used as contexts.
+   * \param traceSourceName the name of the trace source of the collectors.
+   * \param aggregator the aggregator.
+   */
+  void ConnectToScatterAggregator (CollectorMap &collectorMap,
+                                   std::string traceSourceName,
+                                   Ptr<DataCollectionObject> aggregator) const;
+
+  /**
+   * \brief Connect the `OutputString` trace source of the collectors to the
+   *        context headings of the aggregator created by
+   *        CreateScatterAggregator().
+   * \param collectorMap the collectors, whose names are used as contexts.
+   * \param aggregator the aggregator.
+   */
+  void ConnectHeadingToScatterAggregator (CollectorMap &collectorMap,
+                                          Ptr<DataCollectionObject> aggregator) const;
+
+  /**
+   * \brief Dispose the collectors, so that they pass their outputs to their
+   *        aggregator or next-level collectors at once, instead of at the
+   *        end of the simulation.
+   * \param collectorMap the collectors.
+   *
+   * Used by DoUninstall(). The first-level collectors must be disposed
+   * before the collectors they are connected to.
+   */
+  void DisposeCollectors (CollectorMap &collectorMap) const;
+
+  /**
+   * \param aggregator the aggregator created by CreateScatterAggregator().
+   * \return a callback passing a time-value sample of a context to the
+   *         aggregator.
+   */
+  Callback<void, std::string, double, double> GetScatterAggregatorSink (Ptr<DataCollectionObject> aggregator) const;
+
   // IDENTIFIER RELATED METHODS ///////////////////////////////////////////////
 
   /**
@@ -349,6 +610,36 @@ protected:
    */
   uint32_t GetIdentifierForGw (Ptr<Node> gwNode) const;
 
+  /**
+   * \brief Convert an address to an integer key, cheaper to look up per
+   *        packet than the address itself.
+   * \param address a MAC or IPv4 address, i.e., at most 7 bytes long.
+   * \return the key, unique among the addresses of the same type.
+   */
+  static uint64_t GetAddressKey (const Address &address);
+
+  /**
+   * \brief Associate the address of a sender with a terminal index, when
+   *        installing the probes of return link statistics.
+   * \param address a MAC or IPv4 address of a UT or UT user.
+   * \param terminalIndex the terminal index of its identifier.
+   *
+   * The terminal indices are kept in a table indexed by the offset of the
+   * address key from the lowest one, so that GetAddressTerminalIndex()
+   * resolves the sender of a sample without any search. The table stays
+   * compact because the UT MAC addresses and the UT user IPv4 addresses are
+   * allocated sequentially. The addresses must all be of the same type.
+   */
+  void SetAddressTerminalIndex (const Address &address, uint32_t terminalIndex);
+
+  /**
+   * \param address the address of the sender of a sample.
+   * \param terminalIndex the terminal index associated with the address by
+   *                      SetAddressTerminalIndex().
+   * \return true if the address is associated with a terminal index.
+   */
+  bool GetAddressTerminalIndex (const Address &address, uint32_t &terminalIndex) const;
+
   // DEVICE RETRIEVAL METHODS /////////////////////////////////////////////////
 
   /**
@@ -367,6 +658,30 @@ private:
   OutputType_t          m_outputType;      ///<
   bool                  m_isInstalled;     ///<
   Ptr<const SatHelper>  m_satHelper;       ///<
+  Time                  m_aggregationInterval;  ///< `AggregationInterval` attribute.
+  bool                  m_isUninstalled;   ///< Whether Uninstall() has been invoked.
+
+  /// Trace source connected by ConnectTraceSource().
+  struct TraceConnection
+  {
+    Ptr<Object> object;           ///< Object owning the trace source.
+    std::string traceSourceName;  ///< Name of the trace source.
+    bool hasContext;              ///< Whether connected with a context.
+    std::string context;          ///< Context passed to the trace sink.
+    CallbackBase callback;        ///< Trace sink.
+  };
+
+  std::vector<TraceConnection> m_traceConnections;  ///< Connected trace sources.
+  std::vector<Ptr<Probe> > m_connectedProbes;       ///< Connected probes.
+
+  uint32_t m_profilingPeriod;            ///< Period of the measured callbacks.
+  double   m_installWallTime;            ///< Wall clock time of Install().
+  uint64_t m_numOfCallbacks;             ///< Number of counted callbacks.
+  uint64_t m_numOfMeasuredCallbacks;     ///< Number of measured callbacks.
+  double   m_measuredCallbackWallTime;   ///< Wall clock time of the measured callbacks.
+
+  std::vector<uint32_t> m_addressTerminalIndices;  ///< Terminal indices of the senders, indexed by address key offset.
+  uint64_t m_minAddressKey;              ///< Address key of the first entry of #m_addressTerminalIndices.
 
 }; // end of class SatStatsHelper
 
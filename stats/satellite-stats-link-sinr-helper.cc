@@ -78,6 +78,7 @@ void
 SatStatsLinkSinrHelper::SinrCallback (double sinrDb)
 {
   NS_LOG_FUNCTION (this << sinrDb);
+  CallbackProfiler profiler (this);
 
   switch (GetOutputType ())
     {
@@ -91,6 +92,7 @@ SatStatsLinkSinrHelper::SinrCallback (double sinrDb)
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
     case SatStatsHelper::OUTPUT_SCATTER_PLOT:
       {
         Ptr<UnitConversionCollector> c = m_collector->GetObject<UnitConversionCollector> ();
@@ -163,20 +165,17 @@ SatStatsLinkSinrHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading ("sinr_db")));
-        Ptr<MultiFileAggregator> aggregator = m_aggregator->GetObject<MultiFileAggregator> ();
+        m_aggregator = CreateScatterAggregator ("sinr_db");
 
         // Setup collector.
         Ptr<UnitConversionCollector> collector = CreateObject<UnitConversionCollector> ();
         collector->SetName ("0");
         collector->SetConversionType (UnitConversionCollector::TRANSPARENT);
         collector->TraceConnect ("OutputTimeValue", "0",
-                                 MakeCallback (&MultiFileAggregator::Write2d,
-                                               aggregator));
+                                 GetScatterAggregatorSink (m_aggregator));
         m_collector = collector->GetObject<DataCollectionObject> ();
 
         break;
@@ -304,6 +303,18 @@ SatStatsLinkSinrHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsLinkSinrHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_collector != 0)
+    {
+      m_collector->Dispose ();
+    }
+}
+
+
 void
 SatStatsLinkSinrHelper::InstallProbes ()
 {
@@ -371,8 +382,7 @@ SatStatsFwdFeederLinkSinrHelper::DoInstallProbes ()
            itCarrier != carriers.End (); ++itCarrier)
         {
           //NS_ASSERT (itCarrier->second->m_channelType == SatEnums::FORWARD_FEEDER_CH)
-          if (!itCarrier->second->TraceConnectWithoutContext ("LinkSinr",
-                                                              GetTraceSinkCallback ()))
+          if (!ConnectTraceSource (itCarrier->second, "LinkSinr", GetTraceSinkCallback ()))
             {
               NS_FATAL_ERROR ("Error connecting to LinkSinr trace source"
                               << " of SatPhyRxCarrier"
@@ -445,8 +455,7 @@ SatStatsFwdUserLinkSinrHelper::DoInstallProbes ()
            itCarrier != carriers.End (); ++itCarrier)
         {
           //NS_ASSERT (itCarrier->second->m_channelType == SatEnums::FORWARD_USER_CH)
-          if (!itCarrier->second->TraceConnectWithoutContext ("LinkSinr",
-                                                              GetTraceSinkCallback ()))
+          if (!ConnectTraceSource (itCarrier->second, "LinkSinr", GetTraceSinkCallback ()))
             {
               NS_FATAL_ERROR ("Error connecting to LinkSinr trace source"
                               << " of SatPhyRxCarrier"
@@ -518,8 +527,7 @@ SatStatsRtnFeederLinkSinrHelper::DoInstallProbes ()
                itCarrier != carriers.End (); ++itCarrier)
             {
               //NS_ASSERT (itCarrier->second->m_channelType == SatEnums::RETURN_FEEDER_CH)
-              if (!itCarrier->second->TraceConnectWithoutContext ("LinkSinr",
-                                                                  GetTraceSinkCallback ()))
+              if (!ConnectTraceSource (itCarrier->second, "LinkSinr", GetTraceSinkCallback ()))
                 {
                   NS_FATAL_ERROR ("Error connecting to LinkSinr trace source"
                                   << " of SatPhyRxCarrier"
@@ -596,8 +604,7 @@ SatStatsRtnUserLinkSinrHelper::DoInstallProbes ()
            itCarrier != carriers.End (); ++itCarrier)
         {
           //NS_ASSERT (itCarrier->second->m_channelType == SatEnums::RETURN_USER_CH)
-          if (!itCarrier->second->TraceConnectWithoutContext ("LinkSinr",
-                                                              GetTraceSinkCallback ()))
+          if (!ConnectTraceSource (itCarrier->second, "LinkSinr", GetTraceSinkCallback ()))
             {
               NS_FATAL_ERROR ("Error connecting to LinkSinr trace source"
                               << " of SatPhyRxCarrier"
@@ -130,11 +130,10 @@ SatStatsMarsalaCorrelationHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading ("correlations")));
+        m_aggregator = CreateScatterAggregator ("correlations");
 
         // Setup collectors.
         m_terminalCollectors.SetType ("ns3::IntervalRateCollector");
@@ -143,12 +142,10 @@ SatStatsMarsalaCorrelationHelper::DoInstall ()
         m_terminalCollectors.SetAttribute ("OutputType",
                                            EnumValue (IntervalRateCollector::OUTPUT_TYPE_AVERAGE_PER_SAMPLE));
         CreateCollectorPerIdentifier (m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator ("OutputWithTime",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::Write2d);
-        m_terminalCollectors.ConnectToAggregator ("OutputString",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::AddContextHeading);
+        ConnectToScatterAggregator (m_terminalCollectors,
+                                    "OutputWithTime",
+                                    m_aggregator);
+        ConnectHeadingToScatterAggregator (m_terminalCollectors, m_aggregator);
         break;
       }
 
@@ -255,8 +252,8 @@ SatStatsMarsalaCorrelationHelper::DoInstall ()
                   continue;
                 }
 
-              const bool ret = itCarrier->second->TraceConnectWithoutContext (
-                  GetTraceSourceName (), callback);
+              const bool ret = ConnectTraceSource (itCarrier->second,
+                                                   GetTraceSourceName (), callback);
               if (ret)
                 {
                   NS_LOG_INFO (this << " successfully connected with node ID "
@@ -283,12 +280,22 @@ SatStatsMarsalaCorrelationHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsMarsalaCorrelationHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  DisposeCollectors (m_terminalCollectors);
+}
+
+
 void
 SatStatsMarsalaCorrelationHelper::CorrelationRxCallback (uint32_t nCorrelations,
                                                          const Address & from,
                                                          bool isCollided)
 {
   NS_LOG_FUNCTION (this << nCorrelations << from << isCollided);
+  CallbackProfiler profiler (this);
 
   if (from.IsInvalid ())
     {
@@ -326,6 +333,7 @@ SatStatsMarsalaCorrelationHelper::CorrelationRxCallback (uint32_t nCorrelations,
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
     case SatStatsHelper::OUTPUT_SCATTER_PLOT:
       {
         Ptr<IntervalRateCollector> c = collector->GetObject<IntervalRateCollector> ();
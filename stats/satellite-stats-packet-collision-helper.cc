@@ -114,6 +114,15 @@ SatStatsPacketCollisionHelper::DoInstall ()
                                          "EnableContextPrinting", BooleanValue (true),
                                          "GeneralHeading", StringValue (GetIdentifierHeading ("collision_rate")));
 
+        if (IsIntervalAggregationEnabled ())
+          {
+            // Setup counters.
+            m_counter = CreateIntervalCounter (m_aggregator,
+                                               SatIntervalCounter::OUTPUT_TYPE_AVERAGE_PER_SAMPLE,
+                                               1.0);
+            break;
+          }
+
         // Setup collectors.
         m_terminalCollectors.SetType ("ns3::ScalarCollector");
         m_terminalCollectors.SetAttribute ("InputDataType",
@@ -128,11 +137,19 @@ SatStatsPacketCollisionHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading ("collision_rate")));
+        m_aggregator = CreateScatterAggregator ("collision_rate");
+
+        if (IsIntervalAggregationEnabled ())
+          {
+            // Setup counters.
+            m_counter = CreateIntervalCounter (m_aggregator,
+                                               SatIntervalCounter::OUTPUT_TYPE_AVERAGE_PER_SAMPLE,
+                                               1.0);
+            break;
+          }
 
         // Setup collectors.
         m_terminalCollectors.SetType ("ns3::IntervalRateCollector");
@@ -141,12 +158,10 @@ SatStatsPacketCollisionHelper::DoInstall ()
         m_terminalCollectors.SetAttribute ("OutputType",
                                            EnumValue (IntervalRateCollector::OUTPUT_TYPE_AVERAGE_PER_SAMPLE));
         CreateCollectorPerIdentifier (m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator ("OutputWithTime",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::Write2d);
-        m_terminalCollectors.ConnectToAggregator ("OutputString",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::AddContextHeading);
+        ConnectToScatterAggregator (m_terminalCollectors,
+                                    "OutputWithTime",
+                                    m_aggregator);
+        ConnectHeadingToScatterAggregator (m_terminalCollectors, m_aggregator);
         break;
       }
 
@@ -247,7 +262,7 @@ SatStatsPacketCollisionHelper::DoInstall ()
                   continue;
                 }
 
-              const bool ret = itCarrier->second->TraceConnectWithoutContext (GetTraceSourceName (), callback);
+              const bool ret = ConnectTraceSource (itCarrier->second, GetTraceSourceName (), callback);
               if (ret)
                 {
                   NS_LOG_INFO (this << " successfully connected with node ID "
@@ -274,12 +289,27 @@ SatStatsPacketCollisionHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsPacketCollisionHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_counter != 0)
+    {
+      m_counter->Flush ();
+    }
+
+  DisposeCollectors (m_terminalCollectors);
+}
+
+
 void
 SatStatsPacketCollisionHelper::CollisionRxCallback (uint32_t nPackets,
                                                     const Address & from,
                                                     bool isCollided)
 {
   NS_LOG_FUNCTION (this << nPackets << from << isCollided);
+  CallbackProfiler profiler (this);
 
   if (from.IsInvalid ())
     {
@@ -298,6 +328,10 @@ SatStatsPacketCollisionHelper::CollisionRxCallback (uint32_t nPackets,
                             << " from statistics collection because of"
                             << " unknown sender address " << from);
         }
+      else if (m_counter != 0)
+        {
+          m_counter->AddBoolean (it->second, isCollided);
+        }
       else
         {
           // Find the first-level collector with the right identifier.
@@ -317,6 +351,7 @@ SatStatsPacketCollisionHelper::CollisionRxCallback (uint32_t nPackets,
               }
 
             case SatStatsHelper::OUTPUT_SCATTER_FILE:
+            case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
             case SatStatsHelper::OUTPUT_SCATTER_PLOT:
               {
                 Ptr<IntervalRateCollector> c = collector->GetObject<IntervalRateCollector> ();
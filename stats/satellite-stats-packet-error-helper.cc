@@ -132,6 +132,15 @@ SatStatsPacketErrorHelper::DoInstall ()
                                          "EnableContextPrinting", BooleanValue (true),
                                          "GeneralHeading", StringValue (GetIdentifierHeading ("error_rate")));
 
+        if (IsIntervalAggregationEnabled ())
+          {
+            // Setup counters.
+            m_counter = CreateIntervalCounter (m_aggregator,
+                                               SatIntervalCounter::OUTPUT_TYPE_AVERAGE_PER_SAMPLE,
+                                               1.0);
+            break;
+          }
+
         // Setup collectors.
         m_terminalCollectors.SetType ("ns3::ScalarCollector");
         m_terminalCollectors.SetAttribute ("InputDataType",
@@ -146,11 +155,19 @@ SatStatsPacketErrorHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading ("error_rate")));
+        m_aggregator = CreateScatterAggregator ("error_rate");
+
+        if (IsIntervalAggregationEnabled ())
+          {
+            // Setup counters.
+            m_counter = CreateIntervalCounter (m_aggregator,
+                                               SatIntervalCounter::OUTPUT_TYPE_AVERAGE_PER_SAMPLE,
+                                               1.0);
+            break;
+          }
 
         // Setup collectors.
         m_terminalCollectors.SetType ("ns3::IntervalRateCollector");
@@ -159,12 +176,10 @@ SatStatsPacketErrorHelper::DoInstall ()
         m_terminalCollectors.SetAttribute ("OutputType",
                                            EnumValue (IntervalRateCollector::OUTPUT_TYPE_AVERAGE_PER_SAMPLE));
         CreateCollectorPerIdentifier (m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator ("OutputWithTime",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::Write2d);
-        m_terminalCollectors.ConnectToAggregator ("OutputString",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::AddContextHeading);
+        ConnectToScatterAggregator (m_terminalCollectors,
+                                    "OutputWithTime",
+                                    m_aggregator);
+        ConnectHeadingToScatterAggregator (m_terminalCollectors, m_aggregator);
         break;
       }
 
@@ -264,12 +279,27 @@ SatStatsPacketErrorHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsPacketErrorHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_counter != 0)
+    {
+      m_counter->Flush ();
+    }
+
+  DisposeCollectors (m_terminalCollectors);
+}
+
+
 void
 SatStatsPacketErrorHelper::ErrorRxCallback (uint32_t nPackets,
                                             const Address & from,
                                             bool isError)
 {
   //NS_LOG_FUNCTION (this << nPackets << from << isError);
+  CallbackProfiler profiler (this);
 
   if (from.IsInvalid ())
     {
@@ -288,6 +318,10 @@ SatStatsPacketErrorHelper::ErrorRxCallback (uint32_t nPackets,
                             << " from statistics collection because of"
                             << " unknown sender address " << from);
         }
+      else if (m_counter != 0)
+        {
+          m_counter->AddBoolean (it->second, isError);
+        }
       else
         {
           // Find the first-level collector with the right identifier.
@@ -307,6 +341,7 @@ SatStatsPacketErrorHelper::ErrorRxCallback (uint32_t nPackets,
               }
 
             case SatStatsHelper::OUTPUT_SCATTER_FILE:
+            case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
             case SatStatsHelper::OUTPUT_SCATTER_PLOT:
               {
                 Ptr<IntervalRateCollector> c = collector->GetObject<IntervalRateCollector> ();
@@ -383,7 +418,7 @@ SatStatsPacketErrorHelper::InstallProbeOnGw (Ptr<Node> gwNode)
             {
               continue;
             }
-          const bool ret = itCarrier->second->TraceConnectWithoutContext (GetTraceSourceName (), callback);
+          const bool ret = ConnectTraceSource (itCarrier->second, GetTraceSourceName (), callback);
           if (ret)
             {
               NS_LOG_INFO (this << " successfully connected with node ID "
@@ -445,33 +480,42 @@ SatStatsPacketErrorHelper::InstallProbeOnUt (Ptr<Node> utNode)
           continue;
         }
       // Connect the object to the probe.
-      if (probe->ConnectByObject (GetTraceSourceName (), itCarrier->second))
+      if (ConnectProbe (probe, GetTraceSourceName (), itCarrier->second))
         {
           // Connect the probe to the right collector.
           bool ret = false;
-          switch (GetOutputType ())
+          if (m_counter != 0)
             {
-            case SatStatsHelper::OUTPUT_SCALAR_FILE:
-            case SatStatsHelper::OUTPUT_SCALAR_PLOT:
-              ret = m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                           "OutputBool",
-                                                           identifier,
-                                                           &ScalarCollector::TraceSinkBoolean);
-              break;
-
-            case SatStatsHelper::OUTPUT_SCATTER_FILE:
-            case SatStatsHelper::OUTPUT_SCATTER_PLOT:
-              ret = m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                           "OutputBool",
-                                                           identifier,
-                                                           &IntervalRateCollector::TraceSinkBoolean);
-              break;
-
-            default:
-              NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for this statistics.");
-              break;
-
-            } // end of `switch (GetOutputType ())`
+              ret = probe->TraceConnectWithoutContext ("OutputBool",
+                                                       m_counter->GetBooleanSink (identifier));
+            }
+          else
+            {
+              switch (GetOutputType ())
+                {
+                case SatStatsHelper::OUTPUT_SCALAR_FILE:
+                case SatStatsHelper::OUTPUT_SCALAR_PLOT:
+                  ret = m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
+                                                               "OutputBool",
+                                                               identifier,
+                                                               &ScalarCollector::TraceSinkBoolean);
+                  break;
+
+                case SatStatsHelper::OUTPUT_SCATTER_FILE:
+                case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
+                case SatStatsHelper::OUTPUT_SCATTER_PLOT:
+                  ret = m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
+                                                               "OutputBool",
+                                                               identifier,
+                                                               &IntervalRateCollector::TraceSinkBoolean);
+                  break;
+
+                default:
+                  NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for this statistics.");
+                  break;
+
+                } // end of `switch (GetOutputType ())`
+            }
 
           if (ret)
             {
@@ -485,7 +529,7 @@ SatStatsPacketErrorHelper::InstallProbeOnUt (Ptr<Node> utNode)
                                 << " to collector " << identifier);
             }
 
-        } // end of `if (probe->ConnectByObject (GetTraceSourceName (), itCarrier->second))`
+        } // end of `if (ConnectProbe (probe, GetTraceSourceName (), itCarrier->second))`
       else
         {
           NS_FATAL_ERROR ("Error connecting to "
@@ -107,6 +107,12 @@ protected:
   // inherited from SatStatsHelper base class
   void DoInstall ();
 
+  /**
+   * \brief Write the outputs of the collectors or of the interval counters
+   *        at the end of the measurement.
+   */
+  void DoUninstall ();
+
   /**
    * \brief Set valid carrier type for this statistics helper type.
    * \param carrierType
@@ -149,6 +155,9 @@ private:
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
+  /// Counters used instead of the collectors in interval aggregation mode.
+  Ptr<SatIntervalCounter> m_counter;
+
   /// Map of address and the identifier associated with it (for return link).
   std::map<const Address, uint32_t> m_identifierMap;
 
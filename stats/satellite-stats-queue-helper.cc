@@ -190,23 +190,20 @@ SatStatsQueueHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading (m_shortLabel)));
+        m_aggregator = CreateScatterAggregator (m_shortLabel);
 
         // Setup second-level collectors.
         m_terminalCollectors.SetType ("ns3::IntervalRateCollector");
         m_terminalCollectors.SetAttribute ("InputDataType",
                                            EnumValue (IntervalRateCollector::INPUT_DATA_TYPE_UINTEGER));
         CreateCollectorPerIdentifier (m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator ("OutputWithTime",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::Write2d);
-        m_terminalCollectors.ConnectToAggregator ("OutputString",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::AddContextHeading);
+        ConnectToScatterAggregator (m_terminalCollectors,
+                                    "OutputWithTime",
+                                    m_aggregator);
+        ConnectHeadingToScatterAggregator (m_terminalCollectors, m_aggregator);
 
         break;
       }
@@ -333,11 +330,20 @@ SatStatsQueueHelper::DoInstall ()
   EnlistSource ();
 
   // Schedule the first polling session.
-  Simulator::Schedule (m_pollInterval, &SatStatsQueueHelper::Poll, this);
+  m_pollEvent = Simulator::Schedule (m_pollInterval, &SatStatsQueueHelper::Poll, this);
 
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsQueueHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+  m_pollEvent.Cancel ();
+  DisposeCollectors (m_terminalCollectors);
+}
+
+
 void
 SatStatsQueueHelper::EnlistSource ()
 {
@@ -352,12 +358,13 @@ void
 SatStatsQueueHelper::Poll ()
 {
   NS_LOG_FUNCTION (this);
+  CallbackProfiler profiler (this);
 
   // The method below is supposed to be implemented by the child class.
   DoPoll ();
 
   // Schedule the next polling session.
-  Simulator::Schedule (m_pollInterval, &SatStatsQueueHelper::Poll, this);
+  m_pollEvent = Simulator::Schedule (m_pollInterval, &SatStatsQueueHelper::Poll, this);
 }
 
 
@@ -383,6 +390,7 @@ SatStatsQueueHelper::PushToCollector (uint32_t identifier, uint32_t value)
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
     case SatStatsHelper::OUTPUT_SCATTER_PLOT:
       {
         Ptr<IntervalRateCollector> c = collector->GetObject<IntervalRateCollector> ();
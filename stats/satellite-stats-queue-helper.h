@@ -24,6 +24,7 @@
 
 #include <ns3/ptr.h>
 #include <ns3/nstime.h>
+#include <ns3/event-id.h>
 #include <ns3/satellite-stats-helper.h>
 #include <ns3/collector-map.h>
 #include <list>
@@ -112,6 +113,12 @@ protected:
   // inherited from SatStatsHelper base class
   void DoInstall ();
 
+  /**
+   * \brief Stop the polling sessions and write the outputs of the
+   *        collectors.
+   */
+  void DoUninstall ();
+
   /**
    * \brief
    */
@@ -137,6 +144,7 @@ protected:
 
 private:
   Time         m_pollInterval;  ///< `PollInterval` attribute.
+  EventId      m_pollEvent;     ///< Next polling session.
   UnitType_t   m_unitType;      ///<
   std::string  m_shortLabel;    ///<
   std::string  m_longLabel;     ///<
@@ -100,6 +100,8 @@ SatStatsRbdcRequestHelper::GetAveragingMode () const
 void
 SatStatsRbdcRequestHelper::RbdcRateCallback (std::string identifier, uint32_t rbdcTraceKbps)
 {
+  CallbackProfiler profiler (this);
+
   std::stringstream ss (identifier);
   uint32_t identifierNum;
   if (!(ss >> identifierNum))
@@ -122,6 +124,7 @@ SatStatsRbdcRequestHelper::RbdcRateCallback (std::string identifier, uint32_t rb
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
     case SatStatsHelper::OUTPUT_SCATTER_PLOT:
       {
         Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
@@ -191,20 +194,19 @@ SatStatsRbdcRequestHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading ("rbdc_Kbps")));
+        m_aggregator = CreateScatterAggregator ("rbdc_Kbps");
 
         // Setup collectors.
         m_terminalCollectors.SetType ("ns3::UnitConversionCollector");
         m_terminalCollectors.SetAttribute ("ConversionType",
                                            EnumValue (UnitConversionCollector::TRANSPARENT));
         CreateCollectorPerIdentifier (m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator ("OutputTimeValue",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::Write2d);
+        ConnectToScatterAggregator (m_terminalCollectors,
+                                    "OutputTimeValue",
+                                    m_aggregator);
         break;
       }
 
@@ -442,6 +444,21 @@ SatStatsRbdcRequestHelper::DoInstall ()
 }
 
 
+void
+SatStatsRbdcRequestHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  DisposeCollectors (m_terminalCollectors);
+
+  // The averaging collector receives the outputs of the terminal collectors
+  if (m_averagingCollector != 0)
+    {
+      m_averagingCollector->Dispose ();
+    }
+}
+
+
 void
 SatStatsRbdcRequestHelper::InstallProbes ()
 {
@@ -478,7 +495,7 @@ SatStatsRbdcRequestHelper::InstallProbes ()
       NS_ASSERT (utLlc != 0);
       Ptr<SatRequestManager> requestManager = utLlc->GetRequestManager ();
 
-      const bool ret = requestManager->TraceConnect ("RbdcTrace", context.str (), callback);
+      const bool ret = ConnectTraceSource (requestManager, "RbdcTrace", context.str (), callback);
       NS_ASSERT_MSG (ret, "Error connecting to CrTraceLog of node " << (*it)->GetId ());
       NS_UNUSED (ret);
       NS_LOG_INFO (this << " successfully connected"
@@ -114,20 +114,19 @@ SatStatsResourcesGrantedHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading ("resources_bytes")));
+        m_aggregator = CreateScatterAggregator ("resources_bytes");
 
         // Setup collectors.
         m_terminalCollectors.SetType ("ns3::UnitConversionCollector");
         m_terminalCollectors.SetAttribute ("ConversionType",
                                            EnumValue (UnitConversionCollector::TRANSPARENT));
         CreateCollectorPerIdentifier (m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator ("OutputTimeValue",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::Write2d);
+        ConnectToScatterAggregator (m_terminalCollectors,
+                                    "OutputTimeValue",
+                                    m_aggregator);
 
         // Setup a probe in each UT MAC.
         NodeContainer uts = GetSatHelper ()->GetBeamHelper ()->GetUtNodes ();
@@ -284,6 +283,15 @@ SatStatsResourcesGrantedHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsResourcesGrantedHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  DisposeCollectors (m_terminalCollectors);
+}
+
+
 template<typename R, typename C, typename P>
 void
 SatStatsResourcesGrantedHelper::InstallProbe (Ptr<Node> utNode,
@@ -311,7 +319,7 @@ SatStatsResourcesGrantedHelper::InstallProbe (Ptr<Node> utNode,
   NS_ASSERT (satUtMac != 0);
 
   // Connect the object to the probe.
-  if (probe->ConnectByObject ("DaResourcesTrace", satUtMac))
+  if (ConnectProbe (probe, "DaResourcesTrace", satUtMac))
     {
       // Connect the probe to the right collector.
       if (m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
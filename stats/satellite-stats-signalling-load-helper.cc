@@ -97,6 +97,15 @@ SatStatsSignallingLoadHelper::DoInstall ()
                                          "EnableContextPrinting", BooleanValue (true),
                                          "GeneralHeading", StringValue (GetIdentifierHeading ("signalling_kbps")));
 
+        if (IsIntervalAggregationEnabled ())
+          {
+            // Setup counters, converting bytes into kilobits.
+            m_counter = CreateIntervalCounter (m_aggregator,
+                                               SatIntervalCounter::OUTPUT_TYPE_AVERAGE_PER_SECOND,
+                                               8.0 / 1000.0);
+            break;
+          }
+
         // Setup second-level collectors.
         m_terminalCollectors.SetType ("ns3::ScalarCollector");
         m_terminalCollectors.SetAttribute ("InputDataType",
@@ -120,23 +129,29 @@ SatStatsSignallingLoadHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading ("signalling_kbps")));
+        m_aggregator = CreateScatterAggregator ("signalling_kbps");
+
+        if (IsIntervalAggregationEnabled ())
+          {
+            // Setup counters, converting bytes into kilobits.
+            m_counter = CreateIntervalCounter (m_aggregator,
+                                               SatIntervalCounter::OUTPUT_TYPE_AVERAGE_PER_SECOND,
+                                               8.0 / 1000.0);
+            break;
+          }
 
         // Setup second-level collectors.
         m_terminalCollectors.SetType ("ns3::IntervalRateCollector");
         m_terminalCollectors.SetAttribute ("InputDataType",
                                            EnumValue (IntervalRateCollector::INPUT_DATA_TYPE_DOUBLE));
         CreateCollectorPerIdentifier (m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator ("OutputWithTime",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::Write2d);
-        m_terminalCollectors.ConnectToAggregator ("OutputString",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::AddContextHeading);
+        ConnectToScatterAggregator (m_terminalCollectors,
+                                    "OutputWithTime",
+                                    m_aggregator);
+        ConnectHeadingToScatterAggregator (m_terminalCollectors, m_aggregator);
 
         // Setup first-level collectors.
         m_conversionCollectors.SetType ("ns3::UnitConversionCollector");
@@ -217,6 +232,21 @@ SatStatsSignallingLoadHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsSignallingLoadHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_counter != 0)
+    {
+      m_counter->Flush ();
+    }
+
+  DisposeCollectors (m_conversionCollectors);
+  DisposeCollectors (m_terminalCollectors);
+}
+
+
 void
 SatStatsSignallingLoadHelper::InstallProbes ()
 {
@@ -232,6 +262,7 @@ SatStatsSignallingLoadHelper::SignallingTxCallback (Ptr<const Packet> packet,
                                                     const Address &to)
 {
   //NS_LOG_FUNCTION (this << packet->GetSize () << from);
+  CallbackProfiler profiler (this);
 
   if (to.IsInvalid ())
     {
@@ -248,6 +279,12 @@ SatStatsSignallingLoadHelper::SignallingTxCallback (Ptr<const Packet> packet,
         {
           NS_LOG_INFO (this << " broadcast control message packet");
 
+          if (m_counter != 0)
+            {
+              m_counter->AddToAll (packet->GetSize ());
+              return;
+            }
+
           // Pass the sample to every first-level collectors.
           for (CollectorMap::Iterator it = m_conversionCollectors.Begin ();
                it != m_conversionCollectors.End (); ++it)
@@ -269,6 +306,10 @@ SatStatsSignallingLoadHelper::SignallingTxCallback (Ptr<const Packet> packet,
                                 << " from statistics collection because of"
                                 << " unknown sender address " << addr);
             }
+          else if (m_counter != 0)
+            {
+              m_counter->Add (it->second, packet->GetSize ());
+            }
           else
             {
               // Find the first-level collector with the right identifier.
@@ -366,7 +407,7 @@ SatStatsFwdSignallingLoadHelper::DoInstallProbes ()
         {
           NS_ASSERT ((*itDev)->GetObject<SatNetDevice> () != 0);
 
-          if ((*itDev)->TraceConnectWithoutContext ("SignallingTx", callback))
+          if (ConnectTraceSource (*itDev, "SignallingTx", callback))
             {
               NS_LOG_INFO (this << " successfully connected with node ID "
                                 << (*it)->GetId ()
@@ -436,13 +477,24 @@ SatStatsRtnSignallingLoadHelper::DoInstallProbes ()
       Ptr<NetDevice> dev = GetUtSatNetDevice (*it);
 
       // Connect the object to the probe.
-      if (probe->ConnectByObject ("SignallingTx", dev))
+      if (ConnectProbe (probe, "SignallingTx", dev))
         {
-          // Connect the probe to the right collector.
-          if (m_conversionCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                       "OutputBytes",
-                                                       identifier,
-                                                       &UnitConversionCollector::TraceSinkUinteger32))
+          // Connect the probe to the right collector, or counter.
+          bool ret = false;
+          if (m_counter != 0)
+            {
+              ret = probe->TraceConnectWithoutContext ("OutputBytes",
+                                                       m_counter->GetUinteger32Sink (identifier));
+            }
+          else
+            {
+              ret = m_conversionCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
+                                                             "OutputBytes",
+                                                             identifier,
+                                                             &UnitConversionCollector::TraceSinkUinteger32);
+            }
+
+          if (ret)
             {
               NS_LOG_INFO (this << " created probe " << probeName.str ()
                                 << ", connected to collector " << identifier);
@@ -454,7 +506,7 @@ SatStatsRtnSignallingLoadHelper::DoInstallProbes ()
                                 << " to collector " << identifier);
             }
 
-        } // end of `if (probe->ConnectByObject ("SignallingTx", dev))`
+        } // end of `if (ConnectProbe (probe, "SignallingTx", dev))`
       else
         {
           NS_FATAL_ERROR ("Error connecting to SignallingTx trace source of SatNetDevice"
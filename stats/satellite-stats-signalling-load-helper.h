@@ -83,6 +83,12 @@ protected:
   // inherited from SatStatsHelper base class
   void DoInstall ();
 
+  /**
+   * \brief Write the outputs of the collectors or of the interval counters
+   *        at the end of the measurement.
+   */
+  void DoUninstall ();
+
   /**
    * \brief
    */
@@ -109,6 +115,9 @@ protected:
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
+  /// Counters used instead of the collectors in interval aggregation mode.
+  Ptr<SatIntervalCounter> m_counter;
+
   /// Map of address and the identifier associated with it (for forward link).
   std::map<const Address, uint32_t> m_identifierMap;
 
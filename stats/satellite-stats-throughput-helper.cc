@@ -127,6 +127,15 @@ SatStatsThroughputHelper::DoInstall ()
                                          "EnableContextPrinting", BooleanValue (true),
                                          "GeneralHeading", StringValue (GetIdentifierHeading ("throughput_kbps")));
 
+        if (IsIntervalAggregationEnabled ())
+          {
+            // Setup counters, converting bytes into kilobits.
+            m_counter = CreateIntervalCounter (m_aggregator,
+                                               SatIntervalCounter::OUTPUT_TYPE_AVERAGE_PER_SECOND,
+                                               8.0 / 1000.0);
+            break;
+          }
+
         // Setup second-level collectors.
         m_terminalCollectors.SetType ("ns3::ScalarCollector");
         m_terminalCollectors.SetAttribute ("InputDataType",
@@ -150,23 +159,29 @@ SatStatsThroughputHelper::DoInstall ()
       }
 
     case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_COLUMNAR_FILE:
       {
         // Setup aggregator.
-        m_aggregator = CreateAggregator ("ns3::MultiFileAggregator",
-                                         "OutputFileName", StringValue (GetOutputFileName ()),
-                                         "GeneralHeading", StringValue (GetTimeHeading ("throughput_kbps")));
+        m_aggregator = CreateScatterAggregator ("throughput_kbps");
+
+        if (IsIntervalAggregationEnabled ())
+          {
+            // Setup counters, converting bytes into kilobits.
+            m_counter = CreateIntervalCounter (m_aggregator,
+                                               SatIntervalCounter::OUTPUT_TYPE_AVERAGE_PER_SECOND,
+                                               8.0 / 1000.0);
+            break;
+          }
 
         // Setup second-level collectors.
         m_terminalCollectors.SetType ("ns3::IntervalRateCollector");
         m_terminalCollectors.SetAttribute ("InputDataType",
                                            EnumValue (IntervalRateCollector::INPUT_DATA_TYPE_DOUBLE));
         CreateCollectorPerIdentifier (m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator ("OutputWithTime",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::Write2d);
-        m_terminalCollectors.ConnectToAggregator ("OutputString",
-                                                  m_aggregator,
-                                                  &MultiFileAggregator::AddContextHeading);
+        ConnectToScatterAggregator (m_terminalCollectors,
+                                    "OutputWithTime",
+                                    m_aggregator);
+        ConnectHeadingToScatterAggregator (m_terminalCollectors, m_aggregator);
 
         // Setup first-level collectors.
         m_conversionCollectors.SetType ("ns3::UnitConversionCollector");
@@ -374,6 +389,27 @@ SatStatsThroughputHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsThroughputHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_counter != 0)
+    {
+      m_counter->Flush ();
+    }
+
+  DisposeCollectors (m_conversionCollectors);
+  DisposeCollectors (m_terminalCollectors);
+
+  // The averaging collector receives the outputs of the terminal collectors
+  if (m_averagingCollector != 0)
+    {
+      m_averagingCollector->Dispose ();
+    }
+}
+
+
 void
 SatStatsThroughputHelper::InstallProbes ()
 {
@@ -389,6 +425,7 @@ SatStatsThroughputHelper::RxCallback (Ptr<const Packet> packet,
                                       const Address &from)
 {
   //NS_LOG_FUNCTION (this << packet->GetSize () << from);
+  CallbackProfiler profiler (this);
 
   if (from.IsInvalid ())
     {
@@ -399,10 +436,10 @@ SatStatsThroughputHelper::RxCallback (Ptr<const Packet> packet,
     }
   else
     {
-      // Determine the identifier associated with the sender address.
-      std::map<const Address, uint32_t>::const_iterator it = m_identifierMap.find (from);
+      // Determine the terminal index associated with the sender address.
+      uint32_t terminalIndex;
 
-      if (it == m_identifierMap.end ())
+      if (!GetAddressTerminalIndex (from, terminalIndex))
         {
           NS_LOG_WARN (this << " discarding packet " << packet
                             << " (" << packet->GetSize () << " bytes)"
@@ -411,15 +448,8 @@ SatStatsThroughputHelper::RxCallback (Ptr<const Packet> packet,
         }
       else
         {
-          // Find the first-level collector with the right identifier.
-          Ptr<DataCollectionObject> collector = m_conversionCollectors.Get (it->second);
-          NS_ASSERT_MSG (collector != 0,
-                         "Unable to find collector with identifier " << it->second);
-          Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
-          NS_ASSERT (c != 0);
-
-          // Pass the sample to the collector.
-          c->TraceSinkUinteger32 (0, packet->GetSize ());
+          // Pass the sample to the first-level collector of the terminal.
+          m_terminalSinks[terminalIndex] (0, packet->GetSize ());
         }
     }
 
@@ -442,7 +472,7 @@ SatStatsThroughputHelper::SaveAddressAndIdentifier (Ptr<Node> utNode)
   else
     {
       const uint32_t identifier = GetIdentifierForUt (utNode);
-      m_identifierMap[addr] = identifier;
+      SetAddressTerminalIndex (addr, GetTerminalIndex (identifier));
       NS_LOG_INFO (this << " associated address " << addr
                         << " with identifier " << identifier);
 
@@ -450,6 +480,49 @@ SatStatsThroughputHelper::SaveAddressAndIdentifier (Ptr<Node> utNode)
 }
 
 
+uint32_t
+SatStatsThroughputHelper::GetTerminalIndex (uint32_t identifier)
+{
+  NS_LOG_FUNCTION (this << identifier);
+
+  std::map<uint32_t, uint32_t>::const_iterator it = m_terminalIndices.find (identifier);
+  if (it != m_terminalIndices.end ())
+    {
+      return it->second;
+    }
+
+  const uint32_t terminalIndex = m_terminalSinks.size ();
+
+  if (m_counter != 0)
+    {
+      m_terminalSinks.push_back (m_counter->GetUinteger32Sink (identifier));
+    }
+  else
+    {
+      // Find the first-level collector with the right identifier.
+      Ptr<DataCollectionObject> collector = m_conversionCollectors.Get (identifier);
+      NS_ASSERT_MSG (collector != 0,
+                     "Unable to find collector with identifier " << identifier);
+      Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
+      NS_ASSERT (c != 0);
+      m_terminalSinks.push_back (MakeCallback (&UnitConversionCollector::TraceSinkUinteger32, c));
+    }
+
+  m_terminalIndices[identifier] = terminalIndex;
+  return terminalIndex;
+}
+
+
+bool
+SatStatsThroughputHelper::ConnectProbeToTerminal (Ptr<Probe> probe, uint32_t identifier)
+{
+  NS_LOG_FUNCTION (this << probe->GetName () << identifier);
+
+  return probe->TraceConnectWithoutContext ("OutputBytes",
+                                            m_terminalSinks[GetTerminalIndex (identifier)]);
+}
+
+
 // FORWARD LINK APPLICATION-LEVEL /////////////////////////////////////////////
 
 NS_OBJECT_ENSURE_REGISTERED (SatStatsFwdAppThroughputHelper);
@@ -499,13 +572,10 @@ SatStatsFwdAppThroughputHelper::DoInstallProbes ()
           probe->SetName (probeName.str ());
 
           // Connect the object to the probe.
-          if (probe->ConnectByObject ("Rx", (*it)->GetApplication (i)))
+          if (ConnectProbe (probe, "Rx", (*it)->GetApplication (i)))
             {
               // Connect the probe to the right collector.
-              if (m_conversionCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                           "OutputBytes",
-                                                           identifier,
-                                                           &UnitConversionCollector::TraceSinkUinteger32))
+              if (ConnectProbeToTerminal (probe->GetObject<Probe> (), identifier))
                 {
                   NS_LOG_INFO (this << " created probe " << probeName.str ()
                                     << ", connected to collector " << identifier);
@@ -585,13 +655,10 @@ SatStatsFwdDevThroughputHelper::DoInstallProbes ()
       Ptr<NetDevice> dev = GetUtSatNetDevice (*it);
 
       // Connect the object to the probe.
-      if (probe->ConnectByObject ("Rx", dev))
+      if (ConnectProbe (probe, "Rx", dev))
         {
           // Connect the probe to the right collector.
-          if (m_conversionCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                       "OutputBytes",
-                                                       identifier,
-                                                       &UnitConversionCollector::TraceSinkUinteger32))
+          if (ConnectProbeToTerminal (probe->GetObject<Probe> (), identifier))
             {
               NS_LOG_INFO (this << " created probe " << probeName.str ()
                                 << ", connected to collector " << identifier);
@@ -606,7 +673,7 @@ SatStatsFwdDevThroughputHelper::DoInstallProbes ()
                                 << " to collector " << identifier);
             }
 
-        } // end of `if (probe->ConnectByObject ("Rx", dev))`
+        } // end of `if (ConnectProbe (probe, "Rx", dev))`
       else
         {
           NS_FATAL_ERROR ("Error connecting to Rx trace source of SatNetDevice"
@@ -685,13 +752,10 @@ SatStatsFwdMacThroughputHelper::DoInstallProbes ()
       NS_ASSERT (satMac != 0);
 
       // Connect the object to the probe.
-      if (probe->ConnectByObject ("Rx", satMac))
+      if (ConnectProbe (probe, "Rx", satMac))
         {
           // Connect the probe to the right collector.
-          if (m_conversionCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                       "OutputBytes",
-                                                       identifier,
-                                                       &UnitConversionCollector::TraceSinkUinteger32))
+          if (ConnectProbeToTerminal (probe->GetObject<Probe> (), identifier))
             {
               NS_LOG_INFO (this << " created probe " << probeName.str ()
                                 << ", connected to collector " << identifier);
@@ -707,7 +771,7 @@ SatStatsFwdMacThroughputHelper::DoInstallProbes ()
                                 << " to collector " << identifier);
             }
 
-        } // end of `if (probe->ConnectByObject ("Rx", satMac))`
+        } // end of `if (ConnectProbe (probe, "Rx", satMac))`
       else
         {
           NS_FATAL_ERROR ("Error connecting to Rx trace source of SatMac"
@@ -791,13 +855,10 @@ SatStatsFwdPhyThroughputHelper::DoInstallProbes ()
       NS_ASSERT (satPhy != 0);
 
       // Connect the object to the probe.
-      if (probe->ConnectByObject ("Rx", satPhy))
+      if (ConnectProbe (probe, "Rx", satPhy))
         {
           // Connect the probe to the right collector.
-          if (m_conversionCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                       "OutputBytes",
-                                                       identifier,
-                                                       &UnitConversionCollector::TraceSinkUinteger32))
+          if (ConnectProbeToTerminal (probe->GetObject<Probe> (), identifier))
             {
               NS_LOG_INFO (this << " created probe " << probeName.str ()
                                 << ", connected to collector " << identifier);
@@ -813,7 +874,7 @@ SatStatsFwdPhyThroughputHelper::DoInstallProbes ()
                                 << " to collector " << identifier);
             }
 
-        } // end of `if (probe->ConnectByObject ("Rx", satPhy))`
+        } // end of `if (ConnectProbe (probe, "Rx", satPhy))`
       else
         {
           NS_FATAL_ERROR ("Error connecting to Rx trace source of SatPhy"
@@ -897,7 +958,7 @@ SatStatsRtnAppThroughputHelper::DoInstallProbes ()
         {
           Ptr<Application> app = (*it)->GetApplication (i);
 
-          if (app->TraceConnectWithoutContext ("Rx", callback))
+          if (ConnectTraceSource (app, "Rx", callback))
             {
               NS_LOG_INFO (this << " successfully connected with node ID " << (*it)->GetId ()
                                 << " application #" << i);
@@ -923,14 +984,15 @@ SatStatsRtnAppThroughputHelper::Ipv4Callback (Ptr<const Packet> packet,
                                               const Address &from)
 {
   //NS_LOG_FUNCTION (this << packet->GetSize () << from);
+  CallbackProfiler profiler (this);
 
   if (InetSocketAddress::IsMatchingType (from))
     {
-      // Determine the identifier associated with the sender address.
+      // Determine the terminal index associated with the sender address.
       const Address ipv4Addr = InetSocketAddress::ConvertFrom (from).GetIpv4 ();
-      std::map<const Address, uint32_t>::const_iterator it1 = m_identifierMap.find (ipv4Addr);
+      uint32_t terminalIndex;
 
-      if (it1 == m_identifierMap.end ())
+      if (!GetAddressTerminalIndex (ipv4Addr, terminalIndex))
         {
           NS_LOG_WARN (this << " discarding packet " << packet
                             << " (" << packet->GetSize () << " bytes)"
@@ -939,15 +1001,8 @@ SatStatsRtnAppThroughputHelper::Ipv4Callback (Ptr<const Packet> packet,
         }
       else
         {
-          // Find the collector with the right identifier.
-          Ptr<DataCollectionObject> collector = m_conversionCollectors.Get (it1->second);
-          NS_ASSERT_MSG (collector != 0,
-                         "Unable to find collector with identifier " << it1->second);
-          Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
-          NS_ASSERT (c != 0);
-
-          // Pass the sample to the collector.
-          c->TraceSinkUinteger32 (0, packet->GetSize ());
+          // Pass the sample to the first-level collector of the terminal.
+          m_terminalSinks[terminalIndex] (0, packet->GetSize ());
         }
     }
   else
@@ -977,6 +1032,7 @@ SatStatsRtnAppThroughputHelper::SaveIpv4AddressAndIdentifier (Ptr<Node> utUserNo
   else if (ipv4->GetNInterfaces () >= 2)
     {
       const uint32_t identifier = GetIdentifierForUtUser (utUserNode);
+      const uint32_t terminalIndex = GetTerminalIndex (identifier);
 
       /*
        * Assuming that #0 is for loopback interface and #1 is for subscriber
@@ -985,7 +1041,7 @@ SatStatsRtnAppThroughputHelper::SaveIpv4AddressAndIdentifier (Ptr<Node> utUserNo
       for (uint32_t i = 0; i < ipv4->GetNAddresses (1); i++)
         {
           const Address addr = ipv4->GetAddress (1, i).GetLocal ();
-          m_identifierMap[addr] = identifier;
+          SetAddressTerminalIndex (addr, terminalIndex);
           NS_LOG_INFO (this << " associated address " << addr
                             << " with identifier " << identifier);
         }
@@ -1056,7 +1112,7 @@ SatStatsRtnDevThroughputHelper::DoInstallProbes ()
         {
           NS_ASSERT ((*itDev)->GetObject<SatNetDevice> () != 0);
 
-          if ((*itDev)->TraceConnectWithoutContext ("Rx", callback))
+          if (ConnectTraceSource (*itDev, "Rx", callback))
             {
               NS_LOG_INFO (this << " successfully connected with node ID "
                                 << (*it)->GetId ()
@@ -1147,7 +1203,7 @@ SatStatsRtnMacThroughputHelper::DoInstallProbes ()
           NS_ASSERT (satMac != 0);
 
           // Connect the object to the probe.
-          if (satMac->TraceConnectWithoutContext ("Rx", callback))
+          if (ConnectTraceSource (satMac, "Rx", callback))
             {
               NS_LOG_INFO (this << " successfully connected with node ID "
                                 << (*it)->GetId ()
@@ -1238,7 +1294,7 @@ SatStatsRtnPhyThroughputHelper::DoInstallProbes ()
           NS_ASSERT (satPhy != 0);
 
           // Connect the object to the probe.
-          if (satPhy->TraceConnectWithoutContext ("Rx", callback))
+          if (ConnectTraceSource (satPhy, "Rx", callback))
             {
               NS_LOG_INFO (this << " successfully connected with node ID "
                                 << (*it)->GetId ()
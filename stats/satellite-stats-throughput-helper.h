@@ -26,8 +26,10 @@
 #include <ns3/ptr.h>
 #include <ns3/address.h>
 #include <ns3/collector-map.h>
+#include <ns3/callback.h>
 #include <list>
 #include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -40,6 +42,7 @@ class Node;
 class Packet;
 class DataCollectionObject;
 class DistributionCollector;
+class Probe;
 
 /**
  * \ingroup satstats
@@ -94,6 +97,12 @@ protected:
   // inherited from SatStatsHelper base class
   void DoInstall ();
 
+  /**
+   * \brief Write the outputs of the collectors or of the interval counters
+   *        at the end of the measurement.
+   */
+  void DoUninstall ();
+
   /**
    * \brief
    */
@@ -103,14 +112,34 @@ protected:
    * \brief Save the address and the proper identifier from the given UT node.
    * \param utNode a UT node.
    *
-   * The address of the given node will be saved in the #m_identifierMap
-   * member variable.
+   * The address of the given node will be associated with the terminal index
+   * of the identifier by SetAddressTerminalIndex().
    *
    * Used in return link statistics. DoInstallProbes() is expected to pass the
    * the UT node of interest into this method.
    */
   void SaveAddressAndIdentifier (Ptr<Node> utNode);
 
+  /**
+   * \brief Get the terminal index of an identifier, binding the sample sink
+   *        of its first-level collector, or counter, on first use.
+   * \param identifier
+   * \return the index of the sample sink in #m_terminalSinks.
+   *
+   * Terminal indices are dense, and assigned when installing the probes, so
+   * that passing a sample does not look up the collector.
+   */
+  uint32_t GetTerminalIndex (uint32_t identifier);
+
+  /**
+   * \brief Connect the `OutputBytes` trace source of a probe to the sample
+   *        sink of an identifier.
+   * \param probe an ApplicationPacketProbe.
+   * \param identifier
+   * \return true if the connection is successful.
+   */
+  bool ConnectProbeToTerminal (Ptr<Probe> probe, uint32_t identifier);
+
   /// Maintains a list of first-level collectors created by this helper.
   CollectorMap m_conversionCollectors;
 
@@ -123,8 +152,14 @@ protected:
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
-  /// Map of address and the identifier associated with it (for return link).
-  std::map<const Address, uint32_t> m_identifierMap;
+  /// Counters used instead of the collectors in interval aggregation mode.
+  Ptr<SatIntervalCounter> m_counter;
+
+  /// Sample sinks of the first-level collectors, or of the counters, indexed by terminal index.
+  std::vector<Callback<void, uint32_t, uint32_t> > m_terminalSinks;
+
+  /// Map of identifier and the terminal index associated with it.
+  std::map<uint32_t, uint32_t> m_terminalIndices;
 
 private:
   bool m_averagingMode;  ///< `AveragingMode` attribute.
@@ -134,8 +169,6 @@ private:
 
 // FORWARD LINK APPLICATION-LEVEL /////////////////////////////////////////////
 
-class Probe;
-
 /**
  * \ingroup satstats
  * \brief Produce forward link application-level throughput statistics from a
@@ -385,8 +418,8 @@ private:
    *        UT user node.
    * \param utUserNode a UT user node.
    *
-   * Any addresses found in the given node will be saved in the
-   * #m_identifierMap member variable.
+   * Any addresses found in the given node will be associated with the
+   * terminal index of the identifier by SetAddressTerminalIndex().
    */
   void SaveIpv4AddressAndIdentifier (Ptr<Node> utUserNode);
 
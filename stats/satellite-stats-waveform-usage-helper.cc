@@ -114,8 +114,8 @@ SatStatsWaveformUsageHelper::DoInstall ()
 
       Ptr<SatBeamScheduler> s = ncc->GetBeamScheduler (*it);
       NS_ASSERT_MSG (s != 0, "Error finding beam " << *it);
-      const bool ret = s->TraceConnect ("WaveformTrace",
-                                        context.str (), waveformUsageCallback);
+      const bool ret = ConnectTraceSource (s, "WaveformTrace",
+                                           context.str (), waveformUsageCallback);
       NS_ASSERT_MSG (ret,
                      "Error connecting to WaveformTrace of beam " << *it);
       NS_UNUSED (ret);
@@ -126,6 +126,19 @@ SatStatsWaveformUsageHelper::DoInstall ()
 } // end of `void DoInstall ();`
 
 
+void
+SatStatsWaveformUsageHelper::DoUninstall ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (std::map<uint32_t, CollectorMap>::iterator it = m_collectors.begin ();
+       it != m_collectors.end (); ++it)
+    {
+      DisposeCollectors (it->second);
+    }
+}
+
+
 std::string
 SatStatsWaveformUsageHelper::GetIdentifierHeading (std::string dataLabel) const
 {
@@ -153,6 +166,7 @@ SatStatsWaveformUsageHelper::WaveformUsageCallback (std::string context,
                                                     uint32_t waveformId)
 {
   NS_LOG_FUNCTION (this << context << waveformId);
+  CallbackProfiler profiler (this);
 
   // convert context to number
   std::stringstream ss (context);
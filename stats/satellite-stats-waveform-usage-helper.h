@@ -59,6 +59,7 @@ public:
 protected:
   // inherited from SatStatsHelper base class
   void DoInstall ();
+  void DoUninstall ();
   std::string GetIdentifierHeading (std::string dataLabel) const;
 
 private:
@@ -21,8 +21,13 @@
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
 #include "../model/satellite-antenna-gain-pattern.h"
 #include "../model/satellite-antenna-gain-pattern-container.h"
+#include "../model/satellite-position-allocator.h"
+#include "../model/satellite-constant-position-mobility-model.h"
+#include "../model/satellite-mobility-observer.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
 
@@ -120,6 +125,83 @@ SatAntennaPatternTestCase::DoRun (void)
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
+/**
+ * \ingroup satellite
+ * \brief Test case to check the positions sampled by the spot-beam position allocator.
+ *
+ *   1.  Create spot-beam position allocators for a few beams of the 72 beam
+ *       reference system.
+ *   2.  Sample UT positions from each allocator.
+ *   3.  Raise the minimum elevation angle of the allocators and sample again.
+ *
+ *   Expected result:
+ *     The best beam of every sampled position is the beam of its allocator,
+ *     and its elevation angle is above the minimum elevation angle set
+ *     at the time of the sampling.
+ *
+ */
+class SatSpotBeamPositionAllocatorTestCase : public TestCase
+{
+public:
+  SatSpotBeamPositionAllocatorTestCase ();
+  virtual ~SatSpotBeamPositionAllocatorTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatSpotBeamPositionAllocatorTestCase::SatSpotBeamPositionAllocatorTestCase ()
+  : TestCase ("Test satellite spot-beam position allocator.")
+{
+}
+
+SatSpotBeamPositionAllocatorTestCase::~SatSpotBeamPositionAllocatorTestCase ()
+{
+}
+
+void
+SatSpotBeamPositionAllocatorTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-spot-beam-position-allocator", "", true);
+
+  const uint32_t numOfSamples = 200;
+  const uint32_t beamIds[3] = {6, 12, 58};
+  const double minElevationAngles[2] = {5.0, 30.0};
+  const GeoCoordinate geoPos (0.0, 33.0, 35786000.0);
+
+  Ptr<SatAntennaGainPatternContainer> gpContainer = CreateObject<SatAntennaGainPatternContainer> ();
+
+  Ptr<SatConstantPositionMobilityModel> utMob = CreateObject<SatConstantPositionMobilityModel> ();
+  Ptr<SatConstantPositionMobilityModel> geoMob = CreateObject<SatConstantPositionMobilityModel> ();
+  utMob->SetGeoPosition (GeoCoordinate (0.0, 0.0, 0.0));
+  geoMob->SetGeoPosition (geoPos);
+  Ptr<SatMobilityObserver> utObserver = CreateObject<SatMobilityObserver> (utMob, geoMob);
+
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      Ptr<SatSpotBeamPositionAllocator> allocator = CreateObject<SatSpotBeamPositionAllocator> (beamIds[i], gpContainer, geoPos);
+      allocator->SetAttribute ("Altitude", StringValue ("ns3::ConstantRandomVariable[Constant=0.0]"));
+
+      for (uint32_t j = 0; j < 2; ++j)
+        {
+          allocator->SetAttribute ("MinElevationAngleInDegForUT", DoubleValue (minElevationAngles[j]));
+
+          for (uint32_t k = 0; k < numOfSamples; ++k)
+            {
+              GeoCoordinate pos = allocator->GetNextGeoPosition ();
+              utMob->SetGeoPosition (pos);
+
+              NS_TEST_ASSERT_MSG_EQ (gpContainer->GetBestBeamId (pos), beamIds[i], "Position sampled outside of beam " << beamIds[i]);
+              NS_TEST_ASSERT_MSG_EQ ((utObserver->GetElevationAngle () >= minElevationAngles[j]), true, "Position sampled below the minimum elevation angle");
+            }
+        }
+    }
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
 /**
  * \ingroup satellite
  * \brief Satellite antenna pattern test suite
@@ -134,6 +216,7 @@ SatAntennaPatternTestSuite::SatAntennaPatternTestSuite ()
   : TestSuite ("sat-antenna-gain-pattern-test", UNIT)
 {
   AddTestCase (new SatAntennaPatternTestCase, TestCase::QUICK);
+  AddTestCase (new SatSpotBeamPositionAllocatorTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
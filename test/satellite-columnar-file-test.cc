@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+
+/**
+ * \file satellite-columnar-file-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test Satellite columnar statistics files.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "../stats/satellite-columnar-file-aggregator.h"
+#include "../stats/satellite-columnar-file-reader.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the writing and the reading of columnar files.
+ *
+ *   1.  Write samples of three contexts, and a context heading, with blocks
+ *       smaller than the number of samples.
+ *   2.  Read the samples back block by block.
+ *   3.  Convert the file to one text file per context.
+ *
+ *   Expected result:
+ *     The samples, contexts and headings read back are the ones written, and
+ *     the text file of a context holds the general heading, its samples and
+ *     its heading.
+ *
+ */
+class SatColumnarFileTestCase : public TestCase
+{
+public:
+  SatColumnarFileTestCase ();
+  virtual ~SatColumnarFileTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatColumnarFileTestCase::SatColumnarFileTestCase ()
+  : TestCase ("Test satellite columnar statistics files.")
+{
+}
+
+SatColumnarFileTestCase::~SatColumnarFileTestCase ()
+{
+}
+
+void
+SatColumnarFileTestCase::DoRun (void)
+{
+  const uint32_t numOfSamples = 10;
+  const std::string contexts[] = { "1", "2", "10" };
+  const std::string fileName = CreateTempDirFilename ("columnar");
+
+  Ptr<SatColumnarFileAggregator> aggregator = CreateObject<SatColumnarFileAggregator> ();
+  aggregator->SetAttribute ("OutputFileName", StringValue (fileName));
+  aggregator->SetAttribute ("GeneralHeading", StringValue ("% time_sec delay_sec"));
+  aggregator->SetAttribute ("BlockSize", UintegerValue (4));
+
+  for (uint32_t i = 0; i < numOfSamples; i++)
+    {
+      aggregator->Write2d (contexts[i % 3], 0.5 * i, 0.001 * i);
+    }
+  aggregator->AddContextHeading ("2", "% average 0.004");
+  aggregator->Dispose ();
+
+  SatColumnarFileReader reader (fileName + ".bin");
+  std::vector<double> times;
+  std::vector<uint32_t> contextIndices;
+  std::vector<double> values;
+  uint32_t numOfBlocks = 0;
+  uint32_t n = 0;
+
+  while (reader.ReadBlock (times, contextIndices, values))
+    {
+      numOfBlocks++;
+      for (uint32_t i = 0; i < times.size (); i++, n++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (reader.GetContext (contextIndices[i]), contexts[n % 3], "Wrong context of sample " << n);
+          NS_TEST_ASSERT_MSG_EQ (times[i], 0.5 * n, "Wrong time of sample " << n);
+          NS_TEST_ASSERT_MSG_EQ (values[i], 0.001 * n, "Wrong value of sample " << n);
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (n, numOfSamples, "Wrong number of samples read");
+  NS_TEST_ASSERT_MSG_EQ (numOfBlocks, 3, "Wrong number of blocks read");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetNumOfContexts (), 3, "Wrong number of contexts read");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetGeneralHeading (), "% time_sec delay_sec", "Wrong general heading");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetContextHeadings (1).size (), 1, "Wrong number of headings of context 2");
+
+  SatColumnarFileReader::ConvertToText (fileName + ".bin", fileName, true);
+
+  std::ifstream text ((fileName + "-2.txt").c_str ());
+  std::ostringstream content;
+  content << text.rdbuf ();
+  NS_TEST_ASSERT_MSG_EQ (content.str (),
+                         "% time_sec delay_sec\n0.5 0.001\n2 0.004\n3.5 0.007\n% average 0.004\n",
+                         "Wrong text file of context 2");
+}
+
+/**
+ * \brief Test suite for Satellite columnar statistics file unit test cases.
+ */
+class SatColumnarFileTestSuite : public TestSuite
+{
+public:
+  SatColumnarFileTestSuite ();
+};
+
+SatColumnarFileTestSuite::SatColumnarFileTestSuite ()
+  : TestSuite ("sat-columnar-file-test", UNIT)
+{
+  AddTestCase (new SatColumnarFileTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatColumnarFileTestSuite satColumnarFileTestSuite;
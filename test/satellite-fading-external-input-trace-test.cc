@@ -24,12 +24,16 @@
  * \brief Test cases to unit test external fading traces
  */
 
+#include <cmath>
+#include <fstream>
 #include <vector>
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/timer.h"
 #include "ns3/simulator.h"
 #include "../model/satellite-fading-external-input-trace-container.h"
+#include "../model/satellite-fading-external-input-trace.h"
+#include "../model/satellite-fading-trace-prefetcher.h"
 #include "../model/satellite-channel.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
@@ -108,6 +112,132 @@ SatFadingExternalInputTraceTestCase::DoRun (void)
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
+/**
+ * \ingroup satellite
+ * \brief Test case to check the streaming of external fading traces.
+ *
+ *   1.  Write a two column fading trace at constant interval, and another
+ *       one whose interval changes in its fourth chunk.
+ *   2.  Load the first trace at once, and stream it with small chunks
+ *       loaded by a prefetcher.
+ *   3.  Get the fading of both traces while the simulation time goes through
+ *       the trace, then at times skipping over chunks and going backwards.
+ *   4.  Stream the second trace and test it.
+ *
+ *   Expected result:
+ *     The streamed trace gives the same fading values as the loaded trace,
+ *     both traces pass their test, and the second streamed trace does not.
+ *
+ */
+class SatFadingTraceStreamingTestCase : public TestCase
+{
+public:
+  SatFadingTraceStreamingTestCase ();
+  virtual ~SatFadingTraceStreamingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Write a two column fading trace.
+   * \param fileName Name of the file to write
+   * \param irregularRow First row from which the time interval is changed
+   */
+  void WriteTrace (std::string fileName, uint32_t irregularRow) const;
+
+  /**
+   * \brief Compare the current fading of the loaded and the streamed traces.
+   */
+  void CompareFading ();
+
+  Ptr<SatFadingExternalInputTrace> m_loadedTrace;
+  Ptr<SatFadingExternalInputTrace> m_streamedTrace;
+  uint32_t m_numOfComparisons;
+};
+
+SatFadingTraceStreamingTestCase::SatFadingTraceStreamingTestCase ()
+  : TestCase ("Test satellite fading external input trace streaming."),
+  m_numOfComparisons (0)
+{
+}
+
+SatFadingTraceStreamingTestCase::~SatFadingTraceStreamingTestCase ()
+{
+}
+
+void
+SatFadingTraceStreamingTestCase::WriteTrace (std::string fileName, uint32_t irregularRow) const
+{
+  std::ofstream ofs (fileName.c_str (), std::ios::out | std::ios::binary);
+
+  for (uint32_t i = 0; i < 200; i++)
+    {
+      float sample[2];
+      sample[0] = 0.01 * i + (i >= irregularRow ? 0.005 : 0.0);
+      sample[1] = 3.0 * std::sin (0.1 * i);
+      ofs.write ((const char*)sample, sizeof (sample));
+    }
+
+  ofs.close ();
+}
+
+void
+SatFadingTraceStreamingTestCase::CompareFading ()
+{
+  m_numOfComparisons++;
+
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_streamedTrace->GetFading (), m_loadedTrace->GetFading (), 1e-6,
+                             "Streamed fading differs at " << Simulator::Now ().GetSeconds () << " s");
+}
+
+void
+SatFadingTraceStreamingTestCase::DoRun (void)
+{
+  const std::string fileName = CreateTempDirFilename ("fading.bin");
+  const std::string irregularFileName = CreateTempDirFilename ("irregular-fading.bin");
+  const uint32_t chunkLength = 16;
+
+  WriteTrace (fileName, 200);
+  WriteTrace (irregularFileName, 3 * chunkLength + 5);
+
+  Ptr<SatFadingTracePrefetcher> prefetcher = Create<SatFadingTracePrefetcher> ();
+  m_loadedTrace = Create<SatFadingExternalInputTrace> (SatFadingExternalInputTrace::FT_TWO_COLUMN, fileName);
+  m_streamedTrace = Create<SatFadingExternalInputTrace> (SatFadingExternalInputTrace::FT_TWO_COLUMN, fileName, chunkLength, prefetcher);
+
+  NS_TEST_ASSERT_MSG_EQ (m_loadedTrace->TestFadingTrace (), true, "Loaded trace test failed");
+  NS_TEST_ASSERT_MSG_EQ (m_streamedTrace->TestFadingTrace (), true, "Streamed trace test failed");
+
+  uint32_t numOfSchedules = 0;
+
+  for (double time = 0.0; time < 1.99; time += 0.013, numOfSchedules++)
+    {
+      Simulator::Schedule (Seconds (time), &SatFadingTraceStreamingTestCase::CompareFading, this);
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // Each simulation restarts from time zero, so the streamed trace jumps
+  // over chunks, forwards and backwards
+  const double jumps[5] = {1.5, 0.1, 1.95, 0.7, 0.0};
+
+  for (uint32_t i = 0; i < 5; i++, numOfSchedules++)
+    {
+      Simulator::Schedule (Seconds (jumps[i]), &SatFadingTraceStreamingTestCase::CompareFading, this);
+      Simulator::Run ();
+      Simulator::Destroy ();
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (m_numOfComparisons, numOfSchedules, "Wrong number of fading comparisons");
+
+  Ptr<SatFadingExternalInputTrace> irregularTrace = Create<SatFadingExternalInputTrace> (SatFadingExternalInputTrace::FT_TWO_COLUMN, irregularFileName, chunkLength, prefetcher);
+  NS_TEST_ASSERT_MSG_EQ (irregularTrace->TestFadingTrace (), false, "Streamed trace with irregular time samples passed its test");
+
+  irregularTrace = NULL;
+  m_streamedTrace = NULL;
+  m_loadedTrace = NULL;
+}
+
 /**
  * \ingroup satellite
  * \brief Test suite for satellite fading external input trace
@@ -122,6 +252,7 @@ SatFadingExternalInputTraceTestSuite::SatFadingExternalInputTraceTestSuite ()
   : TestSuite ("sat-fading-external-input-trace-test", UNIT)
 {
   AddTestCase (new SatFadingExternalInputTraceTestCase, TestCase::QUICK);
+  AddTestCase (new SatFadingTraceStreamingTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
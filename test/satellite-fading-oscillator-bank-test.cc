@@ -0,0 +1,233 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-fading-oscillator-bank-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test Satellite fading oscillator bank.
+ */
+
+#include <vector>
+#include <complex>
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "../model/satellite-fading-oscillator.h"
+#include "../model/satellite-fading-oscillator-bank.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the fading oscillator bank is statistically
+ * equivalent to the sum of individual fading oscillators.
+ *
+ *   1.  Create a set of oscillators in the same way as Rayleigh fader (complex amplitude)
+ *       or Loo's direct signal (real amplitude) and the oscillator bank with the same parameters.
+ *   2.  Sample both at irregular time intervals, including long gaps and going back in time.
+ *   3.  Calculate mean, variance and autocorrelation of the channel gains.
+ *
+ *   Expected result:
+ *     Mean, variance and autocorrelation of the bank channel gains are equal (in tolerance)
+ *     to the ones of the individual oscillators.
+ *
+ */
+class SatFadingOscillatorBankTestCase : public TestCase
+{
+public:
+  SatFadingOscillatorBankTestCase (bool cosineWave);
+  virtual ~SatFadingOscillatorBankTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Calculate mean, variance and autocorrelation of the samples
+   * \param samples channel gain samples
+   * \param lag autocorrelation lag in samples
+   * \param mean sample mean
+   * \param variance sample variance
+   * \param autocorrelation normalized autocorrelation at the given lag
+   */
+  void CalculateStatistics (const std::vector<double>& samples, uint32_t lag, double& mean, double& variance, double& autocorrelation);
+
+  bool m_cosineWave;
+};
+
+SatFadingOscillatorBankTestCase::SatFadingOscillatorBankTestCase (bool cosineWave)
+  : TestCase (cosineWave ? "Test satellite fading oscillator bank with cosine wave oscillators."
+              : "Test satellite fading oscillator bank with complex oscillators."),
+  m_cosineWave (cosineWave)
+{
+}
+
+SatFadingOscillatorBankTestCase::~SatFadingOscillatorBankTestCase ()
+{
+}
+
+void
+SatFadingOscillatorBankTestCase::CalculateStatistics (const std::vector<double>& samples, uint32_t lag, double& mean, double& variance, double& autocorrelation)
+{
+  mean = 0.0;
+  for (uint32_t i = 0; i < samples.size (); i++)
+    {
+      mean += samples[i];
+    }
+  mean /= samples.size ();
+
+  variance = 0.0;
+  for (uint32_t i = 0; i < samples.size (); i++)
+    {
+      variance += (samples[i] - mean) * (samples[i] - mean);
+    }
+  variance /= samples.size ();
+
+  double covariance = 0.0;
+  for (uint32_t i = lag; i < samples.size (); i++)
+    {
+      covariance += (samples[i] - mean) * (samples[i - lag] - mean);
+    }
+  covariance /= (samples.size () - lag);
+
+  autocorrelation = covariance / variance;
+}
+
+void
+SatFadingOscillatorBankTestCase::DoRun (void)
+{
+  const uint32_t numOfOscillators = 10;
+  const uint32_t numOfSamples = 20000;
+  const double dopplerFrequency = 30.0;
+  const double cooldownPeriod = 0.0001;
+
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uniform->SetAttribute ("Min", DoubleValue (-1.0 * M_PI));
+  uniform->SetAttribute ("Max", DoubleValue (M_PI));
+
+  std::vector< Ptr<SatFadingOscillator> > oscillators;
+  Ptr<SatFadingOscillatorBank> bank = CreateObject<SatFadingOscillatorBank> ();
+
+  // construct the oscillators as SatRayleighModel and SatLooModel do
+  double phi = uniform->GetValue ();
+  double theta = uniform->GetValue ();
+  for (uint32_t i = 0; i < numOfOscillators; i++)
+    {
+      uint32_t n = i + 1;
+      double alpha = (2.0 * M_PI * n - M_PI + theta) / (4.0 * numOfOscillators);
+      double omega = 2.0 * M_PI * dopplerFrequency * std::cos (alpha);
+
+      if (m_cosineWave)
+        {
+          double amplitude = (uniform->GetValue () + M_PI) / (2.0 * M_PI * numOfOscillators);
+          oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+          bank->AddOscillator (amplitude, phi, omega);
+        }
+      else
+        {
+          double psi = uniform->GetValue ();
+          std::complex<double> amplitude = std::complex<double> (std::cos (psi), std::sin (psi)) * 2.0 / std::sqrt (numOfOscillators);
+          oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+          bank->AddOscillator (amplitude, phi, omega);
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (bank->GetNOscillators (), numOfOscillators, "Wrong number of oscillators in the bank");
+
+  // sample times: mostly cooldown period steps, with some irregular steps,
+  // long gaps and steps backwards in time
+  Ptr<UniformRandomVariable> step = CreateObject<UniformRandomVariable> ();
+  std::vector<double> referenceGains;
+  std::vector<double> bankGains;
+  double timeInSeconds = 0.0;
+
+  for (uint32_t k = 0; k < numOfSamples; k++)
+    {
+      double selector = step->GetValue ();
+
+      if (selector < 0.7)
+        {
+          timeInSeconds += cooldownPeriod;
+        }
+      else if (selector < 0.95)
+        {
+          timeInSeconds += step->GetValue (0.0, 0.01);
+        }
+      else if (selector < 0.99)
+        {
+          timeInSeconds += step->GetValue (0.0, 5.0);
+        }
+      else
+        {
+          timeInSeconds = std::max (0.0, timeInSeconds - step->GetValue (0.0, 1.0));
+        }
+
+      std::complex<double> referenceSum (0, 0);
+      std::complex<double> bankSum;
+
+      for (uint32_t i = 0; i < oscillators.size (); i++)
+        {
+          referenceSum += m_cosineWave ? oscillators[i]->GetCosineWaveValueAt (timeInSeconds)
+            : oscillators[i]->GetComplexValueAt (timeInSeconds);
+        }
+
+      bankSum = m_cosineWave ? bank->GetCosineWaveSumAt (timeInSeconds) : bank->GetComplexSumAt (timeInSeconds);
+
+      referenceGains.push_back (std::norm (referenceSum));
+      bankGains.push_back (std::norm (bankSum));
+    }
+
+  uint32_t lags[] = { 1, 10, 100 };
+
+  for (uint32_t l = 0; l < 3; l++)
+    {
+      double referenceMean, referenceVariance, referenceAutocorrelation;
+      double bankMean, bankVariance, bankAutocorrelation;
+
+      CalculateStatistics (referenceGains, lags[l], referenceMean, referenceVariance, referenceAutocorrelation);
+      CalculateStatistics (bankGains, lags[l], bankMean, bankVariance, bankAutocorrelation);
+
+      NS_TEST_ASSERT_MSG_EQ_TOL (bankMean, referenceMean, 1e-6 * referenceMean, "Channel gain mean differs");
+      NS_TEST_ASSERT_MSG_EQ_TOL (bankVariance, referenceVariance, 1e-6 * referenceVariance, "Channel gain variance differs");
+      NS_TEST_ASSERT_MSG_EQ_TOL (bankAutocorrelation, referenceAutocorrelation, 1e-6, "Channel gain autocorrelation differs at lag " << lags[l]);
+    }
+
+  bank->Dispose ();
+}
+
+/**
+ * \brief Test suite for Satellite fading oscillator bank unit test cases.
+ */
+class SatFadingOscillatorBankTestSuite : public TestSuite
+{
+public:
+  SatFadingOscillatorBankTestSuite ();
+};
+
+SatFadingOscillatorBankTestSuite::SatFadingOscillatorBankTestSuite ()
+  : TestSuite ("sat-fading-oscillator-bank-test", UNIT)
+{
+  AddTestCase (new SatFadingOscillatorBankTestCase (false), TestCase::QUICK);
+  AddTestCase (new SatFadingOscillatorBankTestCase (true), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatFadingOscillatorBankTestSuite satFadingOscillatorBankTestSuite;
@@ -24,11 +24,13 @@
  * \brief Test cases to unit test Satellite Free Space Loss model.
  */
 
+#include <vector>
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/simulator.h"
 #include "../model/satellite-mobility-model.h"
 #include "../model/satellite-free-space-loss.h"
+#include "../model/satellite-constant-position-mobility-model.h"
 #include "../helper/satellite-helper.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
@@ -123,6 +125,70 @@ SatFreeSpaceLossTestCase::DoRun (void)
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
+/**
+ * \ingroup satellite
+ * \brief Test case to check the free space loss of a set of frequencies.
+ *
+ *   1.  Create the mobilities of a UT and of the satellite.
+ *   2.  Get the FSL of a set of carrier frequencies at once, then of each
+ *       carrier frequency.
+ *
+ *   Expected result:
+ *     The FSL of each frequency of the set is the FSL of the single frequency.
+ *
+ */
+class SatFreeSpaceLossBatchTestCase : public TestCase
+{
+public:
+  SatFreeSpaceLossBatchTestCase ();
+  virtual ~SatFreeSpaceLossBatchTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatFreeSpaceLossBatchTestCase::SatFreeSpaceLossBatchTestCase ()
+  : TestCase ("Test satellite free space loss of a set of frequencies.")
+{
+}
+
+SatFreeSpaceLossBatchTestCase::~SatFreeSpaceLossBatchTestCase ()
+{
+}
+
+void
+SatFreeSpaceLossBatchTestCase::DoRun (void)
+{
+  Ptr<SatFreeSpaceLoss> fsl = CreateObject<SatFreeSpaceLoss> ();
+
+  Ptr<SatMobilityModel> utMob = CreateObject<SatConstantPositionMobilityModel> ();
+  Ptr<SatMobilityModel> geoMob = CreateObject<SatConstantPositionMobilityModel> ();
+
+  utMob->SetGeoPosition (GeoCoordinate (25.00, -26.20, 230.0));
+  geoMob->SetGeoPosition (GeoCoordinate (0.0, 33.0, 35786000.0));
+
+  std::vector<double> frequencies;
+
+  for (uint32_t i = 0; i < 16; i++)
+    {
+      frequencies.push_back (17.7e9 + i * 125.0e6);
+    }
+
+  std::vector<double> batchFsl;
+  fsl->GetFslBatch (utMob, geoMob, frequencies, batchFsl);
+
+  NS_TEST_ASSERT_MSG_EQ (batchFsl.size (), frequencies.size (), "Wrong number of FSL values");
+
+  for (uint32_t i = 0; i < frequencies.size () && i < batchFsl.size (); i++)
+    {
+      double carrierFsl = fsl->GetFsl (utMob, geoMob, frequencies[i]);
+
+      NS_TEST_ASSERT_MSG_EQ_TOL (batchFsl[i] / carrierFsl, 1.0, 1e-12, "FSL of carrier " << i << " incorrect");
+    }
+
+  Simulator::Destroy ();
+}
+
 /**
  * \brief Test suite for Satellite free space loss unit test cases.
  */
@@ -136,6 +202,7 @@ SatFreeSpaceLossTestSuite::SatFreeSpaceLossTestSuite ()
   : TestSuite ("sat-fsl-test", UNIT)
 {
   AddTestCase (new SatFreeSpaceLossTestCase, TestCase::QUICK);
+  AddTestCase (new SatFreeSpaceLossBatchTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
@@ -29,6 +29,7 @@
 #include "ns3/test.h"
 #include "ns3/simulator.h"
 #include "ns3/singleton.h"
+#include "../model/satellite-utils.h"
 #include "../utils/satellite-env-variables.h"
 
 using namespace ns3;
@@ -137,6 +138,125 @@ GeoCoordinateTestCase::Validate (GeoCoordinate& position1, GeoCoordinate& positi
   NS_TEST_ASSERT_MSG_EQ ( latSignSame, true, "Latitude signs are different.");
 }
 
+/**
+ * \brief Test case to validate closed-form Cartesian to geodetic conversion of GeoCoordinate
+ * against the iterative reference method used earlier by GeoCoordinate.
+ *
+ *   1.  Create Cartesian positions from geodetic positions around the globe with terrestrial,
+ *       airborne and GEO altitudes for each reference ellipsoid.
+ *   2.  Convert positions back to geodetic coordinates with GeoCoordinate and with reference method.
+ *
+ *   Expected result:
+ *     For terrestrial and airborne altitudes GeoCoordinate matches the reference method in tolerance.
+ *     For all altitudes GeoCoordinate matches the original geodetic position in tolerance
+ *     and consecutive ToVector calls return the same (cached) Cartesian position.
+ */
+class GeoCoordinateConversionTestCase : public TestCase
+{
+public:
+  GeoCoordinateConversionTestCase ();
+  virtual ~GeoCoordinateConversionTestCase ();
+
+private:
+  virtual void DoRun (void);
+  static GeoCoordinate ReferenceConversion (const Vector &v, GeoCoordinate::ReferenceEllipsoid_t refEllipsoid);
+};
+
+GeoCoordinateConversionTestCase::GeoCoordinateConversionTestCase ()
+  : TestCase ("Test Geo Coordinate conversion against reference method")
+{
+}
+
+GeoCoordinateConversionTestCase::~GeoCoordinateConversionTestCase ()
+{
+}
+
+GeoCoordinate
+GeoCoordinateConversionTestCase::ReferenceConversion (const Vector &v, GeoCoordinate::ReferenceEllipsoid_t refEllipsoid)
+{
+  double polarRadius = GeoCoordinate::polarRadius_sphere;
+
+  if (refEllipsoid == GeoCoordinate::WGS84)
+    {
+      polarRadius = GeoCoordinate::polarRadius_wgs84;
+    }
+  else if (refEllipsoid == GeoCoordinate::GRS80)
+    {
+      polarRadius = GeoCoordinate::polarRadius_grs80;
+    }
+
+  double a = GeoCoordinate::equatorRadius;
+  double e2 = ( (a * a) - (polarRadius * polarRadius) ) / (a * a);
+
+  double op = std::sqrt ( v.x * v.x + v.y * v.y + v.z * v.z );
+  double rho = std::sqrt ( v.x * v.x + v.y * v.y );
+  double lon = std::atan2 (v.y, v.x);
+
+  double latG = std::atan (v.z / rho);
+  double latQ = std::atan (v.z / ( (1 - e2 ) * rho ) );
+  double rCurvature = a / std::sqrt (1 - e2 * std::sin (latQ) * std::sin (latQ));
+
+  double xQ = rCurvature * std::cos (latQ) * std::cos (lon);
+  double yQ = rCurvature * std::cos (latQ) * std::sin (lon);
+  double zQ = rCurvature * (1 - e2) * std::sin (latQ);
+  double oq = std::sqrt ( xQ * xQ + yQ * yQ + zQ * zQ );
+  double pq = op - oq;
+  double tp = pq * std::sin (latG - latQ);
+
+  return GeoCoordinate (SatUtils::RadiansToDegrees (latQ + tp / op * std::cos (latQ - latG)),
+                        SatUtils::RadiansToDegrees (lon),
+                        pq * std::cos (latQ - latG),
+                        refEllipsoid);
+}
+
+void
+GeoCoordinateConversionTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-geo-coordinate-conversion", "", true);
+
+  GeoCoordinate::ReferenceEllipsoid_t ellipsoids[] = { GeoCoordinate::SPHERE, GeoCoordinate::WGS84, GeoCoordinate::GRS80 };
+  double altitudes[] = { -5000.0, 0.0, 250.0, 12000.0, 35786000.0 };
+
+  for (uint32_t e = 0; e < 3; e++)
+    {
+      for (uint32_t h = 0; h < 5; h++)
+        {
+          for (int lat = -85; lat <= 85; lat += 17)
+            {
+              for (int lon = -175; lon <= 175; lon += 25)
+                {
+                  GeoCoordinate original (lat + 0.25, lon + 0.5, altitudes[h], ellipsoids[e]);
+                  Vector cartesian = original.ToVector ();
+                  Vector cached = original.ToVector ();
+
+                  NS_TEST_ASSERT_MSG_EQ ( (cartesian.x == cached.x && cartesian.y == cached.y && cartesian.z == cached.z),
+                                          true, "Cached Cartesian position differs.");
+
+                  GeoCoordinate converted (cartesian, ellipsoids[e]);
+
+                  NS_TEST_ASSERT_MSG_EQ_TOL (converted.GetLatitude (), original.GetLatitude (), 1e-9, "Latitude difference too big!");
+                  NS_TEST_ASSERT_MSG_EQ_TOL (converted.GetLongitude (), original.GetLongitude (), 1e-9, "Longitude difference too big!");
+                  NS_TEST_ASSERT_MSG_EQ_TOL (converted.GetAltitude (), original.GetAltitude (), 1e-5, "Altitude difference too big!");
+
+                  // reference method loses accuracy at high altitudes, so compare only below GEO altitude
+                  if (altitudes[h] < 100000.0)
+                    {
+                      GeoCoordinate reference = ReferenceConversion (cartesian, ellipsoids[e]);
+
+                      NS_TEST_ASSERT_MSG_EQ_TOL (converted.GetLatitude (), reference.GetLatitude (), 1e-5, "Latitude differs from reference!");
+                      NS_TEST_ASSERT_MSG_EQ_TOL (converted.GetLongitude (), reference.GetLongitude (), 1e-9, "Longitude differs from reference!");
+                      NS_TEST_ASSERT_MSG_EQ_TOL (converted.GetAltitude (), reference.GetAltitude (), 0.001, "Altitude differs from reference!");
+                    }
+                }
+            }
+        }
+    }
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
 /**
  * \brief Test suite for GeoCoordinate unit test cases.
  */
@@ -150,6 +270,7 @@ GeoCoordinateTestSuite::GeoCoordinateTestSuite ()
   : TestSuite ("geo-coordinate-test", UNIT)
 {
   AddTestCase (new GeoCoordinateTestCase, TestCase::QUICK);
+  AddTestCase (new GeoCoordinateConversionTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-input-fstream-time-container-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the Satellite time input file stream containers.
+ */
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "../utils/satellite-input-fstream-time-double-container.h"
+#include "../utils/satellite-input-fstream-time-long-double-container.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Time sample selection of the time input file stream containers,
+ * scanning the samples one by one from the last selected one.
+ */
+template <typename T>
+class SatTimeSampleSelection
+{
+public:
+  /**
+   * \brief Constructor
+   * \param times time samples
+   */
+  SatTimeSampleSelection (const std::vector<T>& times)
+    : m_times (times),
+    m_lastValidPosition (0),
+    m_numOfPasses (0),
+    m_timeShiftValue (0)
+  {
+  }
+
+  /**
+   * \brief Select the time sample closest to the given time, looping the
+   * samples if needed
+   * \param time time to find
+   * \return position of the selected time sample
+   */
+  uint32_t ProceedToNextClosest (T time)
+  {
+    while (!FindNextClosest (m_lastValidPosition, m_timeShiftValue, time))
+      {
+        m_lastValidPosition = 0;
+        m_numOfPasses++;
+        m_timeShiftValue = m_numOfPasses * m_times.back ();
+      }
+    return m_lastValidPosition;
+  }
+
+  /**
+   * \brief Get the number of times the samples were looped
+   * \return number of passes
+   */
+  uint32_t GetNumOfPasses () const
+  {
+    return m_numOfPasses;
+  }
+
+private:
+  bool FindNextClosest (uint32_t lastValidPosition, T timeShiftValue, T comparisonTimeValue)
+  {
+    bool valueFound = false;
+
+    for (uint32_t i = lastValidPosition; i < m_times.size (); i++)
+      {
+        if (m_times[i] + timeShiftValue >= comparisonTimeValue)
+          {
+            T difference1 = std::abs (m_times[lastValidPosition] + timeShiftValue - comparisonTimeValue);
+            T difference2 = std::abs (m_times[i] + timeShiftValue - comparisonTimeValue);
+
+            m_lastValidPosition = (difference1 < difference2) ? lastValidPosition : i;
+            valueFound = true;
+            break;
+          }
+        lastValidPosition = i;
+      }
+
+    if (valueFound && m_numOfPasses > 0 && m_lastValidPosition == 0)
+      {
+        T difference1 = std::abs (m_times[m_lastValidPosition] + timeShiftValue - comparisonTimeValue);
+        T difference2 = std::abs (m_times.back () + ((m_numOfPasses - 1) * m_times.back ()) - comparisonTimeValue);
+
+        if (difference1 > difference2)
+          {
+            m_lastValidPosition = m_times.size () - 1;
+            m_numOfPasses--;
+            m_timeShiftValue = m_numOfPasses * m_times.back ();
+          }
+      }
+
+    return valueFound;
+  }
+
+  std::vector<T> m_times;
+  uint32_t m_lastValidPosition;
+  uint32_t m_numOfPasses;
+  T m_timeShiftValue;
+};
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the time sample selection of the time input
+ * file stream containers.
+ *
+ *   1.  Write a trace with irregular time samples, whose second column is
+ *       the row number.
+ *   2.  Read it with the double and long double containers.
+ *   3.  Get the closest time samples of the containers while the simulation
+ *       time moves forward by small steps and by jumps over many samples,
+ *       until the samples are looped twice.
+ *   4.  Select the time samples by scanning them one by one from the last
+ *       selected sample.
+ *
+ *   Expected result:
+ *     The containers select the same time samples as the scan, including
+ *     when the samples are looped.
+ *
+ */
+class SatInputFileStreamTimeContainerTestCase : public TestCase
+{
+public:
+  SatInputFileStreamTimeContainerTestCase ();
+  virtual ~SatInputFileStreamTimeContainerTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Compare the time samples selected by the containers and by the scans
+   */
+  void CompareSelections ();
+
+  Ptr<SatInputFileStreamTimeDoubleContainer> m_doubleContainer;
+  Ptr<SatInputFileStreamTimeLongDoubleContainer> m_longDoubleContainer;
+  SatTimeSampleSelection<double> *m_doubleSelection;
+  SatTimeSampleSelection<long double> *m_longDoubleSelection;
+  uint32_t m_numOfComparisons;
+};
+
+SatInputFileStreamTimeContainerTestCase::SatInputFileStreamTimeContainerTestCase ()
+  : TestCase ("Test satellite time input file stream containers sample selection."),
+  m_doubleSelection (NULL),
+  m_longDoubleSelection (NULL),
+  m_numOfComparisons (0)
+{
+}
+
+SatInputFileStreamTimeContainerTestCase::~SatInputFileStreamTimeContainerTestCase ()
+{
+}
+
+void
+SatInputFileStreamTimeContainerTestCase::CompareSelections ()
+{
+  m_numOfComparisons++;
+
+  uint32_t row = m_doubleSelection->ProceedToNextClosest (Simulator::Now ().GetSeconds ());
+  NS_TEST_ASSERT_MSG_EQ (m_doubleContainer->ProceedToNextClosestTimeSample (1), row,
+                         "Wrong double sample at " << Simulator::Now ().GetSeconds () << " s");
+
+  row = m_longDoubleSelection->ProceedToNextClosest (Simulator::Now ().GetSeconds ());
+  NS_TEST_ASSERT_MSG_EQ (m_longDoubleContainer->ProceedToNextClosestTimeSample (1), row,
+                         "Wrong long double sample at " << Simulator::Now ().GetSeconds () << " s");
+}
+
+void
+SatInputFileStreamTimeContainerTestCase::DoRun (void)
+{
+  const std::string fileName = CreateTempDirFilename ("time-samples.txt");
+  const uint32_t numOfRows = 100;
+
+  std::ofstream ofs (fileName.c_str ());
+  ofs << std::setprecision (10);
+
+  for (uint32_t i = 0; i < numOfRows; i++)
+    {
+      double time = 0.01 * (i + 1) + 0.001 * (i % 3);
+      ofs << time << " " << i << std::endl;
+    }
+  ofs.close ();
+
+  m_doubleContainer = CreateObject<SatInputFileStreamTimeDoubleContainer> (fileName, std::ios::in, 2);
+  m_longDoubleContainer = CreateObject<SatInputFileStreamTimeLongDoubleContainer> (fileName, std::ios::in, 2);
+
+  NS_TEST_ASSERT_MSG_EQ (m_doubleContainer->GetNumOfRows (), numOfRows, "Wrong number of rows read");
+
+  std::vector<double> doubleTimes;
+  std::vector<long double> longDoubleTimes;
+
+  // the scans use the time samples as read by the containers
+  const double *doubleColumn = m_doubleContainer->GetColumn (0);
+  const long double *longDoubleColumn = m_longDoubleContainer->GetColumn (0);
+  doubleTimes.assign (doubleColumn, doubleColumn + numOfRows);
+  longDoubleTimes.assign (longDoubleColumn, longDoubleColumn + numOfRows);
+
+  m_doubleSelection = new SatTimeSampleSelection<double> (doubleTimes);
+  m_longDoubleSelection = new SatTimeSampleSelection<long double> (longDoubleTimes);
+
+  // small steps, and a jump over more samples than scanned by the containers every ten steps
+  uint32_t numOfSchedules = 0;
+  double queryTime = 0.0;
+
+  for (uint32_t k = 0; queryTime < 2.6; k++, numOfSchedules++)
+    {
+      queryTime += (k % 10 == 9) ? 0.137 : 0.004;
+      Simulator::Schedule (Seconds (queryTime), &SatInputFileStreamTimeContainerTestCase::CompareSelections, this);
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_numOfComparisons, numOfSchedules, "Wrong number of comparisons");
+  NS_TEST_ASSERT_MSG_EQ (m_doubleSelection->GetNumOfPasses (), 2, "Samples not looped twice");
+
+  delete m_doubleSelection;
+  delete m_longDoubleSelection;
+  m_doubleSelection = NULL;
+  m_longDoubleSelection = NULL;
+  m_doubleContainer = NULL;
+  m_longDoubleContainer = NULL;
+}
+
+/**
+ * \brief Test suite for Satellite time input file stream container unit test cases.
+ */
+class SatInputFileStreamTimeContainerTestSuite : public TestSuite
+{
+public:
+  SatInputFileStreamTimeContainerTestSuite ();
+};
+
+SatInputFileStreamTimeContainerTestSuite::SatInputFileStreamTimeContainerTestSuite ()
+  : TestSuite ("sat-input-fstream-time-container-test", UNIT)
+{
+  AddTestCase (new SatInputFileStreamTimeContainerTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatInputFileStreamTimeContainerTestSuite satInputFileStreamTimeContainerTestSuite;
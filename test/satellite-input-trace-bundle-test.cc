@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+
+/**
+ * \file satellite-input-trace-bundle-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test Satellite input trace bundles.
+ */
+
+#include <fstream>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/system-path.h"
+#include "../model/satellite-input-trace-bundle.h"
+#include "../utils/satellite-input-fstream-time-double-container.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the creation and the reading of trace bundles.
+ *
+ *   1.  Write text traces of a GW and of two UTs, and a file which is not a
+ *       trace, to a directory.
+ *   2.  Create a bundle of the directory and map it.
+ *   3.  Find the traces of the nodes, and of a node without trace.
+ *
+ *   Expected result:
+ *     The bundle holds the three traces, the columns found are the ones of
+ *     the text traces, and the node without trace is not found.
+ *
+ */
+class SatInputTraceBundleTestCase : public TestCase
+{
+public:
+  SatInputTraceBundleTestCase ();
+  virtual ~SatInputTraceBundleTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatInputTraceBundleTestCase::SatInputTraceBundleTestCase ()
+  : TestCase ("Test satellite input trace bundles.")
+{
+}
+
+SatInputTraceBundleTestCase::~SatInputTraceBundleTestCase ()
+{
+}
+
+void
+SatInputTraceBundleTestCase::DoRun (void)
+{
+  const std::string directory = CreateTempDirFilename ("traces");
+  const std::string fileName = CreateTempDirFilename ("bundle.bin");
+  SystemPath::MakeDirectories (directory);
+
+  const std::string names[] = { SatInputTraceBundle::GetTraceName (2, 10, -1, SatEnums::RETURN_USER_CH),
+                                SatInputTraceBundle::GetTraceName (1, -1, 1, SatEnums::FORWARD_FEEDER_CH),
+                                SatInputTraceBundle::GetTraceName (1, 3, -1, SatEnums::FORWARD_USER_CH),
+                                "notes.txt" };
+
+  for (uint32_t f = 0; f < 4; f++)
+    {
+      std::ofstream trace ((directory + "/" + names[f]).c_str ());
+      for (uint32_t i = 0; i < 5 + f; i++)
+        {
+          trace << 0.5 * i << " " << 100 * f + i << "\n";
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (SatInputTraceBundle::CreateBundle (directory, fileName, 2), 3, "Wrong number of traces bundled");
+
+  Ptr<SatInputTraceBundle> bundle = Create<SatInputTraceBundle> (fileName, 2);
+  const double* columns;
+  uint32_t numOfRows;
+
+  NS_TEST_ASSERT_MSG_EQ (bundle->GetNumOfTraces (), 3, "Wrong number of traces mapped");
+
+  NS_TEST_ASSERT_MSG_EQ (bundle->FindTrace (1, 3, -1, SatEnums::FORWARD_USER_CH, columns, numOfRows), true, "UT trace not found");
+  NS_TEST_ASSERT_MSG_EQ (numOfRows, 7, "Wrong number of rows of the UT trace");
+  NS_TEST_ASSERT_MSG_EQ (columns[2], 1.0, "Wrong time of the UT trace");
+  NS_TEST_ASSERT_MSG_EQ (columns[numOfRows + 2], 202.0, "Wrong value of the UT trace");
+
+  Ptr<SatInputFileStreamTimeDoubleContainer> trace = CreateObject<SatInputFileStreamTimeDoubleContainer> (names[2], columns, numOfRows, 2);
+  NS_TEST_ASSERT_MSG_EQ (trace->ProceedToNextClosestTimeSample (1), 200.0, "Wrong value of the mapped UT trace");
+
+  NS_TEST_ASSERT_MSG_EQ (bundle->FindTrace (1, -1, 1, SatEnums::FORWARD_FEEDER_CH, columns, numOfRows), true, "GW trace not found");
+  NS_TEST_ASSERT_MSG_EQ (numOfRows, 6, "Wrong number of rows of the GW trace");
+  NS_TEST_ASSERT_MSG_EQ (columns[numOfRows + 5], 105.0, "Wrong value of the GW trace");
+
+  NS_TEST_ASSERT_MSG_EQ (bundle->FindTrace (2, 10, -1, SatEnums::RETURN_USER_CH, columns, numOfRows), true, "Second UT trace not found");
+  NS_TEST_ASSERT_MSG_EQ (bundle->FindTrace (2, 10, -1, SatEnums::FORWARD_USER_CH, columns, numOfRows), false, "Unexpected channel type found");
+  NS_TEST_ASSERT_MSG_EQ (bundle->FindTrace (1, 4, -1, SatEnums::FORWARD_USER_CH, columns, numOfRows), false, "Unexpected UT found");
+}
+
+/**
+ * \brief Test suite for Satellite input trace bundle unit test cases.
+ */
+class SatInputTraceBundleTestSuite : public TestSuite
+{
+public:
+  SatInputTraceBundleTestSuite ();
+};
+
+SatInputTraceBundleTestSuite::SatInputTraceBundleTestSuite ()
+  : TestSuite ("sat-input-trace-bundle-test", UNIT)
+{
+  AddTestCase (new SatInputTraceBundleTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatInputTraceBundleTestSuite satInputTraceBundleTestSuite;
+
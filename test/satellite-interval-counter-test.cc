@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+
+/**
+ * \file satellite-interval-counter-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test Satellite interval counters.
+ */
+
+#include <map>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/callback.h"
+#include "../stats/satellite-interval-counter.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the outputs of interval counters.
+ *
+ *   1.  Sum packet sizes of two identifiers, written every second as
+ *       kilobits per second, and stop the simulation in the middle of an
+ *       interval.
+ *   2.  Count boolean samples of one identifier, written once as a ratio.
+ *
+ *   Expected result:
+ *     Every identifier is written every interval, the last partial interval
+ *     is written at Simulator::Destroy(), and the values multiplied by the
+ *     interval durations give the sums of the samples. The ratio is the one
+ *     of the true samples.
+ *
+ */
+class SatIntervalCounterTestCase : public TestCase
+{
+public:
+  SatIntervalCounterTestCase ();
+  virtual ~SatIntervalCounterTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void ScatterSink (std::string context, double time, double value);
+  void ScalarSink (std::string context, double value);
+  void SendBytes (uint32_t bytes);
+  void SendBoolean (bool value);
+
+  std::map<std::string, std::vector<double> > m_times;
+  std::map<std::string, std::vector<double> > m_values;
+  std::map<std::string, double> m_scalars;
+  Callback<void, uint32_t, uint32_t> m_bytesSink;
+  Callback<void, bool, bool> m_booleanSink;
+};
+
+SatIntervalCounterTestCase::SatIntervalCounterTestCase ()
+  : TestCase ("Test interval counters.")
+{
+}
+
+SatIntervalCounterTestCase::~SatIntervalCounterTestCase ()
+{
+}
+
+void
+SatIntervalCounterTestCase::ScatterSink (std::string context, double time, double value)
+{
+  m_times[context].push_back (time);
+  m_values[context].push_back (value);
+}
+
+void
+SatIntervalCounterTestCase::ScalarSink (std::string context, double value)
+{
+  m_scalars[context] = value;
+}
+
+void
+SatIntervalCounterTestCase::SendBytes (uint32_t bytes)
+{
+  m_bytesSink (0, bytes);
+}
+
+void
+SatIntervalCounterTestCase::SendBoolean (bool value)
+{
+  m_booleanSink (false, value);
+}
+
+void
+SatIntervalCounterTestCase::DoRun (void)
+{
+  Ptr<SatIntervalCounter> rates = Create<SatIntervalCounter> (SatIntervalCounter::OUTPUT_TYPE_AVERAGE_PER_SECOND,
+                                                              8.0 / 1000.0);
+  rates->AddIdentifier (1, "1");
+  rates->AddIdentifier (3, "3");
+  rates->SetScatterSink (MakeCallback (&SatIntervalCounterTestCase::ScatterSink, this),
+                         Seconds (1));
+  rates->Start ();
+
+  m_bytesSink = rates->GetUinteger32Sink (3);
+  Simulator::Schedule (Seconds (0.5), &SatIntervalCounter::Add, rates, 1, 1000.0);
+  Simulator::Schedule (Seconds (1.5), &SatIntervalCounter::Add, rates, 1, 500.0);
+  Simulator::Schedule (Seconds (1.5), &SatIntervalCounter::Add, rates, 3, 2000.0);
+  Simulator::Schedule (Seconds (3.2), &SatIntervalCounterTestCase::SendBytes, this, 1000);
+
+  Ptr<SatIntervalCounter> ratios = Create<SatIntervalCounter> (SatIntervalCounter::OUTPUT_TYPE_AVERAGE_PER_SAMPLE,
+                                                               1.0);
+  ratios->AddIdentifier (0, "0");
+  ratios->SetScalarSink (MakeCallback (&SatIntervalCounterTestCase::ScalarSink, this));
+  ratios->Start ();
+
+  m_booleanSink = ratios->GetBooleanSink (0);
+  Simulator::Schedule (Seconds (0.1), &SatIntervalCounterTestCase::SendBoolean, this, true);
+  Simulator::Schedule (Seconds (0.2), &SatIntervalCounterTestCase::SendBoolean, this, false);
+  Simulator::Schedule (Seconds (2.1), &SatIntervalCounterTestCase::SendBoolean, this, false);
+  Simulator::Schedule (Seconds (3.3), &SatIntervalCounterTestCase::SendBoolean, this, true);
+
+  Simulator::Stop (Seconds (3.5));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_scalars.size (), 0, "Scalar written before the end of the simulation");
+  Simulator::Destroy ();
+
+  // Release the counters held by the sinks.
+  m_bytesSink = MakeNullCallback<void, uint32_t, uint32_t> ();
+  m_booleanSink = MakeNullCallback<void, bool, bool> ();
+
+  const double expected1[] = { 8.0, 4.0, 0.0, 0.0 };
+  const double expected3[] = { 0.0, 16.0, 0.0, 16.0 };
+  const double times[] = { 1.0, 2.0, 3.0, 3.5 };
+
+  NS_TEST_ASSERT_MSG_EQ (m_values["1"].size (), 4, "Wrong number of intervals of identifier 1");
+  NS_TEST_ASSERT_MSG_EQ (m_values["3"].size (), 4, "Wrong number of intervals of identifier 3");
+
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_times["1"][i], times[i], 1e-9, "Wrong time of interval " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_times["3"][i], times[i], 1e-9, "Wrong time of interval " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_values["1"][i], expected1[i], 1e-9, "Wrong rate of identifier 1 in interval " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_values["3"][i], expected3[i], 1e-9, "Wrong rate of identifier 3 in interval " << i);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (m_scalars.size (), 1, "Wrong number of scalars");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_scalars["0"], 0.5, 1e-9, "Wrong ratio of true samples");
+}
+
+/**
+ * \brief Test suite for Satellite interval counter unit test cases.
+ */
+class SatIntervalCounterTestSuite : public TestSuite
+{
+public:
+  SatIntervalCounterTestSuite ();
+};
+
+SatIntervalCounterTestSuite::SatIntervalCounterTestSuite ()
+  : TestSuite ("sat-interval-counter-test", UNIT)
+{
+  AddTestCase (new SatIntervalCounterTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatIntervalCounterTestSuite satIntervalCounterTestSuite;
+
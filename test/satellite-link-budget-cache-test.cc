@@ -0,0 +1,281 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-link-budget-cache-test.cc
+ * \ingroup satellite
+ * \brief Test cases to check the link budget cache of the satellite channel.
+ */
+
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/string.h"
+#include "ns3/singleton.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/cbr-helper.h"
+#include "../helper/satellite-helper.h"
+#include "../model/satellite-channel.h"
+#include "../model/satellite-net-device.h"
+#include "../model/satellite-mobility-model.h"
+#include "../utils/satellite-env-variables.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the cached link budgets give the Rx powers
+ * of the uncached calculation.
+ *
+ *   1.  Simple test scenario set with helper, without fading.
+ *   2.  Packets are sent from the GW user to the UT user and back, the UT
+ *       is moved in the middle of the transmissions.
+ *   3.  The Rx power of each received unicast packet is recorded, once with
+ *       the link budget cache disabled and once with it enabled.
+ *
+ *   Expected result:
+ *     Both simulations give the same Rx powers. Without the cache no link
+ *     budget is cached, with the cache the link budgets are reused, and
+ *     computed again once the UT has moved.
+ *
+ */
+class SatLinkBudgetCacheTestCase : public TestCase
+{
+public:
+  SatLinkBudgetCacheTestCase ();
+  virtual ~SatLinkBudgetCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Run the scenario and record the Rx powers
+   * \param enableCache Whether the link budget cache is enabled
+   * \param rxPowers Rx powers of the received unicast packets
+   * \param hits Number of link budget cache hits of the UT and GW channels
+   * \param misses Number of link budget cache misses of the UT and GW channels
+   * \param missesBeforeMove Number of misses when the UT was moved
+   */
+  void RunScenario (bool enableCache, std::vector<double>& rxPowers,
+                    uint64_t& hits, uint64_t& misses, uint64_t& missesBeforeMove);
+
+  /**
+   * \brief Callback of the link budget traces, recording the Rx power of unicast packets
+   */
+  void LinkBudgetTraceCb (std::string context, Ptr<SatSignalParameters> params,
+                          Mac48Address ownAdd, Mac48Address destAdd,
+                          double ifPower, double cSinr);
+
+  /**
+   * \brief Move the UT a bit, recording the link budget cache misses
+   * \param mobility Mobility of the UT
+   */
+  void MoveUt (Ptr<SatMobilityModel> mobility);
+
+  /**
+   * \brief Get the link budget cache hits and misses of the transmitters of a node
+   * \param node Node whose satellite devices are used
+   * \param hits Number of hits to increment
+   * \param misses Number of misses to increment
+   */
+  void AddCacheCounters (Ptr<Node> node, uint64_t& hits, uint64_t& misses) const;
+
+  std::vector<double> *m_rxPowers;
+  std::vector<Ptr<Node> > m_nodes;
+  uint64_t m_missesBeforeMove;
+};
+
+SatLinkBudgetCacheTestCase::SatLinkBudgetCacheTestCase ()
+  : TestCase ("Test that the cached link budgets give the uncached Rx powers."),
+  m_rxPowers (NULL),
+  m_missesBeforeMove (0)
+{
+}
+
+SatLinkBudgetCacheTestCase::~SatLinkBudgetCacheTestCase ()
+{
+}
+
+void
+SatLinkBudgetCacheTestCase::LinkBudgetTraceCb (std::string context, Ptr<SatSignalParameters> params,
+                                               Mac48Address ownAdd, Mac48Address destAdd,
+                                               double ifPower, double cSinr)
+{
+  // only unicast messages, the control messages are not sent the same way in both runs
+  if (!destAdd.IsBroadcast ())
+    {
+      m_rxPowers->push_back (params->m_rxPower_W);
+    }
+}
+
+void
+SatLinkBudgetCacheTestCase::AddCacheCounters (Ptr<Node> node, uint64_t& hits, uint64_t& misses) const
+{
+  for (uint32_t i = 0; i < node->GetNDevices (); i++)
+    {
+      Ptr<SatNetDevice> device = DynamicCast<SatNetDevice> (node->GetDevice (i));
+
+      if (device != NULL)
+        {
+          Ptr<SatChannel> channel = device->GetPhy ()->GetPhyTx ()->GetChannel ();
+          hits += channel->GetLinkBudgetCacheHits ();
+          misses += channel->GetLinkBudgetCacheMisses ();
+        }
+    }
+}
+
+void
+SatLinkBudgetCacheTestCase::MoveUt (Ptr<SatMobilityModel> mobility)
+{
+  uint64_t hits = 0;
+  m_missesBeforeMove = 0;
+
+  for (std::vector<Ptr<Node> >::const_iterator it = m_nodes.begin (); it != m_nodes.end (); ++it)
+    {
+      AddCacheCounters (*it, hits, m_missesBeforeMove);
+    }
+
+  GeoCoordinate position = mobility->GetGeoPosition ();
+  mobility->SetGeoPosition (GeoCoordinate (position.GetLatitude () + 0.1, position.GetLongitude () + 0.1, position.GetAltitude ()));
+}
+
+void
+SatLinkBudgetCacheTestCase::RunScenario (bool enableCache, std::vector<double>& rxPowers,
+                                         uint64_t& hits, uint64_t& misses, uint64_t& missesBeforeMove)
+{
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-link-budget-cache", enableCache ? "cache" : "no-cache", true);
+
+  SatPhyRxCarrierConf::ErrorModel em (SatPhyRxCarrierConf::EM_NONE);
+  Config::SetDefault ("ns3::SatUtHelper::FwdLinkErrorModel", EnumValue (em));
+  Config::SetDefault ("ns3::SatGwHelper::RtnLinkErrorModel", EnumValue (em));
+  Config::SetDefault ("ns3::SatBeamHelper::FadingModel", EnumValue (SatEnums::FADING_OFF));
+  Config::SetDefault ("ns3::SatChannel::EnableLinkBudgetCache", BooleanValue (enableCache));
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+  helper->CreatePredefinedScenario (SatHelper::SIMPLE);
+
+  NodeContainer utUsers = helper->GetUtUsers ();
+  NodeContainer gwUsers = helper->GetGwUsers ();
+
+  uint16_t port = 9;
+  CbrHelper cbr ("ns3::UdpSocketFactory", Address (InetSocketAddress (helper->GetUserAddress (utUsers.Get (0)), port)));
+  cbr.SetAttribute ("Interval", StringValue ("100ms"));
+
+  ApplicationContainer gwApps = cbr.Install (gwUsers);
+  gwApps.Start (Seconds (1.0));
+  gwApps.Stop (Seconds (3.0));
+
+  cbr.SetAttribute ("Remote", AddressValue (Address (InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port))));
+
+  ApplicationContainer utApps = cbr.Install (utUsers);
+  utApps.Start (Seconds (1.0));
+  utApps.Stop (Seconds (3.0));
+
+  PacketSinkHelper sink ("ns3::UdpSocketFactory", Address (InetSocketAddress (Ipv4Address::GetAny (), port)));
+  ApplicationContainer sinkApps = sink.Install (utUsers);
+  sinkApps.Add (sink.Install (gwUsers));
+  sinkApps.Start (Seconds (1.0));
+  sinkApps.Stop (Seconds (4.0));
+
+  m_rxPowers = &rxPowers;
+  Config::Connect ("/NodeList/*/DeviceList/*/SatPhy/PhyRx/RxCarrierList/*/LinkBudgetTrace",
+                   MakeCallback (&SatLinkBudgetCacheTestCase::LinkBudgetTraceCb, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/UserPhy/*/PhyRx/RxCarrierList/*/LinkBudgetTrace",
+                   MakeCallback (&SatLinkBudgetCacheTestCase::LinkBudgetTraceCb, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/FeederPhy/*/PhyRx/RxCarrierList/*/LinkBudgetTrace",
+                   MakeCallback (&SatLinkBudgetCacheTestCase::LinkBudgetTraceCb, this));
+
+  m_nodes.clear ();
+  m_nodes.push_back (helper->UtNodes ().Get (0));
+  m_nodes.push_back (helper->GwNodes ().Get (0));
+
+  Simulator::Schedule (Seconds (2.0), &SatLinkBudgetCacheTestCase::MoveUt, this,
+                       helper->UtNodes ().Get (0)->GetObject<SatMobilityModel> ());
+
+  Simulator::Stop (Seconds (5.0));
+  Simulator::Run ();
+
+  hits = 0;
+  misses = 0;
+  missesBeforeMove = m_missesBeforeMove;
+
+  for (std::vector<Ptr<Node> >::const_iterator it = m_nodes.begin (); it != m_nodes.end (); ++it)
+    {
+      AddCacheCounters (*it, hits, misses);
+    }
+
+  m_nodes.clear ();
+  m_rxPowers = NULL;
+
+  Simulator::Destroy ();
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+void
+SatLinkBudgetCacheTestCase::DoRun (void)
+{
+  std::vector<double> uncachedRxPowers;
+  std::vector<double> cachedRxPowers;
+  uint64_t hits, misses, missesBeforeMove;
+
+  RunScenario (false, uncachedRxPowers, hits, misses, missesBeforeMove);
+
+  NS_TEST_ASSERT_MSG_EQ (hits, 0, "Link budgets cached with the cache disabled");
+  NS_TEST_ASSERT_MSG_EQ (misses, 0, "Link budgets cached with the cache disabled");
+
+  RunScenario (true, cachedRxPowers, hits, misses, missesBeforeMove);
+
+  NS_TEST_ASSERT_MSG_NE (hits, 0, "Link budgets not reused");
+  NS_TEST_ASSERT_MSG_NE (missesBeforeMove, 0, "Link budgets not computed before the move");
+  NS_TEST_ASSERT_MSG_EQ ((misses > missesBeforeMove), true, "Link budgets not computed again after the move");
+
+  NS_TEST_ASSERT_MSG_NE (uncachedRxPowers.size (), 0, "No packet received");
+  NS_TEST_ASSERT_MSG_EQ (cachedRxPowers.size (), uncachedRxPowers.size (), "Different number of packets received");
+
+  for (uint32_t i = 0; i < uncachedRxPowers.size () && i < cachedRxPowers.size (); i++)
+    {
+      // the cached product is rounded differently from the uncached expression
+      NS_TEST_ASSERT_MSG_EQ_TOL (cachedRxPowers[i] / uncachedRxPowers[i], 1.0, 1e-9,
+                                 "Different Rx power of packet " << i);
+    }
+}
+
+/**
+ * \brief Test suite for the link budget cache of the satellite channel.
+ */
+class SatLinkBudgetCacheTestSuite : public TestSuite
+{
+public:
+  SatLinkBudgetCacheTestSuite ();
+};
+
+SatLinkBudgetCacheTestSuite::SatLinkBudgetCacheTestSuite ()
+  : TestSuite ("sat-link-budget-cache-test", SYSTEM)
+{
+  AddTestCase (new SatLinkBudgetCacheTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatLinkBudgetCacheTestSuite satLinkBudgetCacheTestSuite;
@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-log-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the Satellite log.
+ */
+
+#include <fstream>
+#include <sstream>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/enum.h"
+#include "ns3/uinteger.h"
+#include "ns3/singleton.h"
+#include "../model/satellite-log.h"
+#include "../utils/satellite-env-variables.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the bounded logs and the severity filter.
+ *
+ *   1.  Create a log keeping at most four messages per log and only the
+ *       warning and error messages.
+ *   2.  Add ten warning messages, two error messages, four custom messages
+ *       and three info messages.
+ *   3.  Dispose the log to write the files.
+ *
+ *   Expected result:
+ *     The warning log holds a note of the six dropped messages followed by
+ *     the last four messages, oldest first. The error and custom logs hold
+ *     all their messages without note, and no info log is written.
+ *
+ */
+class SatLogTestCase : public TestCase
+{
+public:
+  SatLogTestCase ();
+  virtual ~SatLogTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Add numbered messages to a log
+   * \param log the log
+   * \param logType log type
+   * \param fileTag file tag for the filename
+   * \param first number of the first message
+   * \param numOfMessages number of messages
+   */
+  static void AddMessages (Ptr<SatLog> log, SatLog::LogType_t logType, std::string fileTag,
+                           uint32_t first, uint32_t numOfMessages);
+
+  /**
+   * \brief Build the text of numbered messages
+   * \param first number of the first message
+   * \param numOfMessages number of messages
+   * \return one line per message
+   */
+  static std::string GetMessages (uint32_t first, uint32_t numOfMessages);
+
+  /**
+   * \brief Read a whole file
+   * \param fileName file name
+   * \return contents of the file
+   */
+  static std::string ReadFile (std::string fileName);
+};
+
+SatLogTestCase::SatLogTestCase ()
+  : TestCase ("Test satellite log ring buffer and severity filter.")
+{
+}
+
+SatLogTestCase::~SatLogTestCase ()
+{
+}
+
+void
+SatLogTestCase::AddMessages (Ptr<SatLog> log, SatLog::LogType_t logType, std::string fileTag,
+                             uint32_t first, uint32_t numOfMessages)
+{
+  for (uint32_t i = first; i < first + numOfMessages; i++)
+    {
+      std::ostringstream message;
+      message << "message " << i;
+      log->AddToLog (logType, fileTag, message.str ());
+    }
+}
+
+std::string
+SatLogTestCase::GetMessages (uint32_t first, uint32_t numOfMessages)
+{
+  std::ostringstream lines;
+
+  for (uint32_t i = first; i < first + numOfMessages; i++)
+    {
+      lines << "message " << i << std::endl;
+    }
+
+  return lines.str ();
+}
+
+std::string
+SatLogTestCase::ReadFile (std::string fileName)
+{
+  std::ifstream file (fileName.c_str ());
+  std::ostringstream contents;
+  contents << file.rdbuf ();
+  return contents.str ();
+}
+
+void
+SatLogTestCase::DoRun (void)
+{
+  const std::string outputPath = CreateTempDirFilename ("log");
+
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->CreateDirectory (outputPath);
+  Singleton<SatEnvVariables>::Get ()->SetOutputPath (outputPath);
+
+  Ptr<SatLog> log = CreateObject<SatLog> ();
+  log->SetAttribute ("MaxMessages", UintegerValue (4));
+  log->SetAttribute ("MinSeverity", EnumValue (SatLog::LOG_WARNING));
+
+  NS_TEST_ASSERT_MSG_EQ (log->IsEnabled (SatLog::LOG_INFO), false, "Info messages not filtered");
+  NS_TEST_ASSERT_MSG_EQ (log->IsEnabled (SatLog::LOG_WARNING), true, "Warning messages filtered");
+  NS_TEST_ASSERT_MSG_EQ (log->IsEnabled (SatLog::LOG_ERROR), true, "Error messages filtered");
+
+  AddMessages (log, SatLog::LOG_WARNING, "", 0, 10);
+  AddMessages (log, SatLog::LOG_ERROR, "", 0, 2);
+  AddMessages (log, SatLog::LOG_CUSTOM, "_custom", 0, 4);
+  AddMessages (log, SatLog::LOG_INFO, "", 0, 3);
+
+  NS_TEST_ASSERT_MSG_EQ (log->GetNumOfDroppedMessages (SatLog::LOG_WARNING, ""), 6, "Wrong number of dropped warning messages");
+  NS_TEST_ASSERT_MSG_EQ (log->GetNumOfDroppedMessages (SatLog::LOG_ERROR, ""), 0, "Error messages dropped");
+  NS_TEST_ASSERT_MSG_EQ (log->GetNumOfDroppedMessages (SatLog::LOG_CUSTOM, "_custom"), 0, "Custom messages dropped");
+  NS_TEST_ASSERT_MSG_EQ (log->GetNumOfDroppedMessages (SatLog::LOG_INFO, ""), 0, "Info messages dropped");
+
+  log->Dispose ();
+
+  NS_TEST_ASSERT_MSG_EQ (ReadFile (outputPath + "/log_warning"),
+                         "SatLog: 6 earlier messages dropped, the last 4 messages follow\n" + GetMessages (6, 4),
+                         "Wrong warning log");
+  NS_TEST_ASSERT_MSG_EQ (ReadFile (outputPath + "/log_error"), GetMessages (0, 2), "Wrong error log");
+  NS_TEST_ASSERT_MSG_EQ (ReadFile (outputPath + "/log_custom"), GetMessages (0, 4), "Wrong custom log");
+
+  std::ifstream infoLog ((outputPath + "/log_info").c_str ());
+  NS_TEST_ASSERT_MSG_EQ (infoLog.is_open (), false, "Filtered info log written");
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \brief Test suite for Satellite log unit test cases.
+ */
+class SatLogTestSuite : public TestSuite
+{
+public:
+  SatLogTestSuite ();
+};
+
+SatLogTestSuite::SatLogTestSuite ()
+  : TestSuite ("sat-log-test", UNIT)
+{
+  AddTestCase (new SatLogTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatLogTestSuite satLogTestSuite;
@@ -0,0 +1,577 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-markov-fading-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the Markov fading.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/nstime.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/mac48-address.h"
+#include "../model/satellite-markov-conf.h"
+#include "../model/satellite-markov-model.h"
+#include "../model/satellite-markov-fading-manager.h"
+#include "../model/satellite-markov-container.h"
+#include "../model/satellite-loo-model.h"
+
+using namespace ns3;
+
+static double
+SatMarkovTestElevation ()
+{
+  return 30.0;
+}
+
+static double
+SatMarkovTestVelocity ()
+{
+  return 0.0;
+}
+
+static double
+SatMarkovTestMovingVelocity ()
+{
+  return 500.0;
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the Markov state transition tables.
+ *
+ *   1.  Build the default Markov configuration, whose last state is
+ *       unreachable and has no transition probabilities.
+ *   2.  Do transitions from the reachable states of the default configuration.
+ *   3.  Build a transition table large enough for the alias method, with an
+ *       unreachable state without transition probabilities, and do
+ *       transitions from its reachable states.
+ *
+ *   Expected result:
+ *     The tables are built, and the transitions follow the probabilities of
+ *     the reachable states.
+ *
+ */
+class SatMarkovTransitionTableTestCase : public TestCase
+{
+public:
+  SatMarkovTransitionTableTestCase ();
+  virtual ~SatMarkovTransitionTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatMarkovTransitionTableTestCase::SatMarkovTransitionTableTestCase ()
+  : TestCase ("Test satellite Markov state transition tables.")
+{
+}
+
+SatMarkovTransitionTableTestCase::~SatMarkovTransitionTableTestCase ()
+{
+}
+
+void
+SatMarkovTransitionTableTestCase::DoRun (void)
+{
+  Ptr<SatMarkovConf> markovConf = CreateObject<SatMarkovConf> ();
+
+  NS_TEST_ASSERT_MSG_EQ (markovConf->GetNumOfSets (), SatMarkovConf::DEFAULT_ELEVATION_COUNT, "Wrong number of sets");
+  NS_TEST_ASSERT_MSG_EQ (markovConf->GetStateCount (), SatMarkovConf::DEFAULT_STATE_COUNT, "Wrong number of states");
+
+  Ptr<const SatMarkovTransitionTable> table = markovConf->GetTransitionTable (0);
+
+  NS_TEST_ASSERT_MSG_EQ (table->GetNumOfStates (), SatMarkovConf::DEFAULT_STATE_COUNT, "Wrong number of states in the table");
+  NS_TEST_ASSERT_MSG_EQ (table->GetNextState (0, 0.5), 0, "Wrong transition from state 0");
+  NS_TEST_ASSERT_MSG_EQ (table->GetNextState (0, 0.99), 1, "Wrong transition from state 0");
+  NS_TEST_ASSERT_MSG_EQ (table->GetNextState (1, 0.3), 0, "Wrong transition from state 1");
+  NS_TEST_ASSERT_MSG_EQ (table->GetNextState (1, 0.9), 1, "Wrong transition from state 1");
+
+  // each reachable state moves to the next one, the last state is unreachable
+  const uint32_t numOfStates = SatMarkovTransitionTable::ALIAS_METHOD_MIN_STATES;
+  std::vector<std::vector<double> > probabilities (numOfStates, std::vector<double> (numOfStates, 0.0));
+
+  for (uint32_t i = 0; i < numOfStates - 1; ++i)
+    {
+      probabilities[i][(i + 1) % (numOfStates - 1)] = 1.0;
+    }
+
+  Ptr<SatMarkovTransitionTable> aliasTable = Create<SatMarkovTransitionTable> (probabilities);
+
+  for (uint32_t i = 0; i < numOfStates - 1; ++i)
+    {
+      for (double random = 0.0; random <= 1.0; random += 0.05)
+        {
+          NS_TEST_ASSERT_MSG_EQ (aliasTable->GetNextState (i, random), (i + 1) % (numOfStates - 1), "Wrong transition from state " << i);
+        }
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the pre-tabulated Markov fading against the fading
+ * calculated on each request.
+ *
+ *   1.  Create a Markov fading manager calculating the fading on each request,
+ *       and another one, with the same random number streams, using fading
+ *       tables with a small time step.
+ *   2.  Get the uplink and downlink fading of a terminal from both managers at
+ *       the same times, in linear units and in decibels.
+ *
+ *   Expected result:
+ *     The tabulated fading values match the calculated ones, on both links
+ *     and in both units.
+ *
+ */
+class SatMarkovTabulatedFadingTestCase : public TestCase
+{
+public:
+  SatMarkovTabulatedFadingTestCase ();
+  virtual ~SatMarkovTabulatedFadingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Get the uplink and downlink fading of a terminal.
+   * \param manager Markov fading manager
+   * \param terminal terminal id
+   * \param fadings fading values are appended here
+   */
+  void GetFadings (Ptr<SatMarkovFadingManager> manager, uint32_t terminal, std::vector<double> *fadings);
+};
+
+SatMarkovTabulatedFadingTestCase::SatMarkovTabulatedFadingTestCase ()
+  : TestCase ("Test satellite pre-tabulated Markov fading.")
+{
+}
+
+SatMarkovTabulatedFadingTestCase::~SatMarkovTabulatedFadingTestCase ()
+{
+}
+
+void
+SatMarkovTabulatedFadingTestCase::GetFadings (Ptr<SatMarkovFadingManager> manager, uint32_t terminal, std::vector<double> *fadings)
+{
+  fadings->push_back (manager->GetFading (terminal, SatEnums::RETURN_USER_CH));
+  fadings->push_back (manager->GetFading (terminal, SatEnums::FORWARD_USER_CH));
+}
+
+void
+SatMarkovTabulatedFadingTestCase::DoRun (void)
+{
+  const uint32_t numOfSamples = 100;
+
+  for (uint32_t decibels = 0; decibels < 2; decibels++)
+    {
+      std::vector<double> fadings[2];
+
+      for (uint32_t tabulated = 0; tabulated < 2; tabulated++)
+        {
+          // same random number streams and initial state for both managers
+          RngSeedManager::ResetNextStreamIndex ();
+          std::srand (1);
+
+          Ptr<SatMarkovConf> markovConf = CreateObject<SatMarkovConf> ();
+          markovConf->SetAttribute ("UseDecibels", BooleanValue (decibels == 1));
+          markovConf->SetAttribute ("UsePreTabulatedFading", BooleanValue (tabulated == 1));
+          markovConf->SetAttribute ("PreTabulationStep", TimeValue (MicroSeconds (10)));
+
+          Ptr<SatMarkovFadingManager> manager = CreateObject<SatMarkovFadingManager> (markovConf);
+          uint32_t terminal = manager->AddTerminal (MakeCallback (&SatMarkovTestElevation), MakeCallback (&SatMarkovTestVelocity));
+
+          for (uint32_t i = 1; i <= numOfSamples; i++)
+            {
+              Simulator::Schedule (Seconds (0.0123 * i), &SatMarkovTabulatedFadingTestCase::GetFadings, this, manager, terminal, &fadings[tabulated]);
+            }
+
+          Simulator::Run ();
+          Simulator::Destroy ();
+          manager->Dispose ();
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (fadings[0].size (), 2 * numOfSamples, "Wrong number of calculated fading values");
+      NS_TEST_ASSERT_MSG_EQ (fadings[1].size (), 2 * numOfSamples, "Wrong number of tabulated fading values");
+
+      for (uint32_t i = 0; i < fadings[0].size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (fadings[1][i], fadings[0][i], (decibels == 1 ? 0.01 : 0.001),
+                                     "Tabulated fading differs from calculated fading, " << (i % 2 ? "downlink" : "uplink") << " sample " << i / 2);
+        }
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the Markov fading of the shared manager against
+ * the fading of a Markov model and Loo faders owned by the terminal.
+ *
+ *   1.  Create a Markov container using the fading manager, for a moving
+ *       terminal.
+ *   2.  With the same random number streams, create a Markov model and two
+ *       Loo faders, and do the state transitions and fading calculations of
+ *       a terminal owning them.
+ *   3.  Get the uplink and downlink fading of both at the same times.
+ *   4.  Repeat with the uplink fader enabled.
+ *
+ *   Expected result:
+ *     The fading values of the manager are the ones of the terminal owning
+ *     its model and faders, whose downlink fader gives the fading of both
+ *     links by default, and whose uplink fader gives the uplink fading when
+ *     enabled.
+ *
+ */
+class SatMarkovFadingManagerTestCase : public TestCase
+{
+public:
+  SatMarkovFadingManagerTestCase ();
+  virtual ~SatMarkovFadingManagerTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Get the uplink and downlink fading of the container.
+   * \param container Markov container
+   */
+  void GetManagerFadings (Ptr<SatMarkovContainer> container);
+
+  /**
+   * \brief Get the uplink and downlink fading of the terminal owning its
+   * Markov model and faders.
+   */
+  void GetReferenceFadings ();
+
+  /**
+   * \brief Get the fading of a channel of the terminal owning its Markov
+   * model and faders, as SatMarkovContainer did before the fading manager.
+   * \param fader Fader of the channel, whose parameters are updated
+   * \param gainFader Fader calculating the channel gain
+   * \param latestCalculationTime Latest calculation time of the channel
+   * \param latestFading Latest fading value of the channel
+   * \return fading value
+   */
+  double GetReferenceFading (Ptr<SatBaseFader> fader, Ptr<SatBaseFader> gainFader, Time& latestCalculationTime, double& latestFading);
+
+  Ptr<SatMarkovConf> m_markovConf;
+  Ptr<SatMarkovModel> m_markovModel;
+  bool m_useUplinkFader;
+  Ptr<SatBaseFader> m_faderUp;
+  Ptr<SatBaseFader> m_faderDown;
+  uint32_t m_currentSet;
+  Time m_latestStateChangeTime;
+  Time m_latestCalculationTimeUp;
+  Time m_latestCalculationTimeDown;
+  double m_latestFadingUp;
+  double m_latestFadingDown;
+  std::vector<double> m_managerFadings;
+  std::vector<double> m_referenceFadings;
+};
+
+SatMarkovFadingManagerTestCase::SatMarkovFadingManagerTestCase ()
+  : TestCase ("Test satellite Markov fading manager against per terminal models."),
+  m_useUplinkFader (false),
+  m_currentSet (0),
+  m_latestFadingUp (0.0),
+  m_latestFadingDown (0.0)
+{
+}
+
+SatMarkovFadingManagerTestCase::~SatMarkovFadingManagerTestCase ()
+{
+}
+
+void
+SatMarkovFadingManagerTestCase::GetManagerFadings (Ptr<SatMarkovContainer> container)
+{
+  m_managerFadings.push_back (container->GetFading (Mac48Address (), SatEnums::RETURN_USER_CH));
+  m_managerFadings.push_back (container->GetFading (Mac48Address (), SatEnums::FORWARD_USER_CH));
+}
+
+double
+SatMarkovFadingManagerTestCase::GetReferenceFading (Ptr<SatBaseFader> fader, Ptr<SatBaseFader> gainFader, Time& latestCalculationTime, double& latestFading)
+{
+  if ((Now () - latestCalculationTime).GetSeconds () <= m_markovConf->GetCooldownPeriod ().GetSeconds ())
+    {
+      return latestFading;
+    }
+
+  // the elevation does not change, so neither does the parameter set
+  double distance = (Now () - m_latestStateChangeTime).GetSeconds () * SatMarkovTestMovingVelocity ();
+
+  if (distance > m_markovConf->GetMinimumPositionChange ())
+    {
+      m_latestStateChangeTime = Now ();
+      m_markovModel->DoTransition ();
+    }
+
+  fader->UpdateParameters (m_currentSet, m_markovModel->GetState ());
+  latestFading = gainFader->GetChannelGain ();
+  latestCalculationTime = Now ();
+
+  return latestFading;
+}
+
+void
+SatMarkovFadingManagerTestCase::GetReferenceFadings ()
+{
+  // by default both links use the downlink fader gain, the uplink fader only follows the state
+  m_referenceFadings.push_back (GetReferenceFading (m_faderUp, m_useUplinkFader ? m_faderUp : m_faderDown, m_latestCalculationTimeUp, m_latestFadingUp));
+  m_referenceFadings.push_back (GetReferenceFading (m_faderDown, m_faderDown, m_latestCalculationTimeDown, m_latestFadingDown));
+}
+
+void
+SatMarkovFadingManagerTestCase::DoRun (void)
+{
+  const uint32_t numOfSamples = 200;
+
+  for (uint32_t uplinkFader = 0; uplinkFader < 2; uplinkFader++)
+    {
+      m_useUplinkFader = (uplinkFader == 1);
+      m_managerFadings.clear ();
+      m_referenceFadings.clear ();
+
+      // same random number streams and initial state for both runs
+      RngSeedManager::ResetNextStreamIndex ();
+      std::srand (1);
+
+      m_markovConf = CreateObject<SatMarkovConf> ();
+      m_markovConf->SetAttribute ("UseUplinkFader", BooleanValue (m_useUplinkFader));
+      Ptr<SatMarkovContainer> container = CreateObject<SatMarkovContainer> (m_markovConf, MakeCallback (&SatMarkovTestElevation), MakeCallback (&SatMarkovTestMovingVelocity));
+
+      for (uint32_t i = 1; i <= numOfSamples; i++)
+        {
+          Simulator::Schedule (Seconds (0.15 * i), &SatMarkovFadingManagerTestCase::GetManagerFadings, this, container);
+        }
+
+      Simulator::Run ();
+      Simulator::Destroy ();
+      container->Dispose ();
+
+      RngSeedManager::ResetNextStreamIndex ();
+      std::srand (1);
+
+      m_markovConf = CreateObject<SatMarkovConf> ();
+      uint32_t numOfStates = m_markovConf->GetStateCount ();
+      double lowerElevation = NAN;
+      double upperElevation = NAN;
+
+      // construction of a terminal: Markov model, first transition, faders, then fading values
+      m_currentSet = m_markovConf->GetProbabilitySetID (SatMarkovTestElevation (), lowerElevation, upperElevation);
+      m_markovModel = CreateObject<SatMarkovModel> (numOfStates, m_markovConf->GetInitialState ());
+      m_markovModel->SetTransitionTable (m_markovConf->GetTransitionTable (m_currentSet));
+      m_markovModel->DoTransition ();
+      m_faderUp = CreateObject<SatLooModel> (m_markovConf->GetLooConf (), numOfStates, m_currentSet, m_markovModel->GetState ());
+      m_faderDown = CreateObject<SatLooModel> (m_markovConf->GetLooConf (), numOfStates, m_currentSet, m_markovModel->GetState ());
+      m_latestStateChangeTime = Now ();
+      m_latestCalculationTimeUp = Now ();
+      m_latestCalculationTimeDown = Now ();
+      m_faderUp->UpdateParameters (m_currentSet, m_markovModel->GetState ());
+      m_latestFadingUp = (m_useUplinkFader ? m_faderUp : m_faderDown)->GetChannelGain ();
+      m_faderDown->UpdateParameters (m_currentSet, m_markovModel->GetState ());
+      m_latestFadingDown = m_faderDown->GetChannelGain ();
+
+      for (uint32_t i = 1; i <= numOfSamples; i++)
+        {
+          Simulator::Schedule (Seconds (0.15 * i), &SatMarkovFadingManagerTestCase::GetReferenceFadings, this);
+        }
+
+      Simulator::Run ();
+      Simulator::Destroy ();
+
+      NS_TEST_ASSERT_MSG_EQ (m_managerFadings.size (), 2 * numOfSamples, "Wrong number of manager fading values");
+      NS_TEST_ASSERT_MSG_EQ (m_referenceFadings.size (), 2 * numOfSamples, "Wrong number of reference fading values");
+
+      for (uint32_t i = 0; i < m_managerFadings.size () && i < m_referenceFadings.size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (m_managerFadings[i], m_referenceFadings[i], 1e-9 * m_referenceFadings[i],
+                                     "Manager fading differs from reference fading, " << (i % 2 ? "downlink" : "uplink")
+                                     << " sample " << i / 2 << (m_useUplinkFader ? " with the uplink fader" : ""));
+        }
+
+      m_faderUp = NULL;
+      m_faderDown = NULL;
+      m_markovModel = NULL;
+      m_markovConf = NULL;
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check when the elevation parameter sets of the
+ * terminals are updated.
+ *
+ *   1.  Create two Markov fading managers for a fast moving terminal, one
+ *       resolving the parameter set on each state change evaluation, the
+ *       other one with decoupled set updates every second.
+ *   2.  Get the fading of the terminal ten times per second during 2.5 s,
+ *       and notify a mobility change to the second manager at 0.55 s.
+ *   3.  Count the elevation requests of each manager.
+ *
+ *   Expected result:
+ *     The first manager requests the elevation on each state change
+ *     evaluation. The second one requests it only on the mobility change and
+ *     on the periodic updates at 1 s and 2 s, and its fading requests do not.
+ *
+ */
+class SatMarkovSetUpdateTestCase : public TestCase
+{
+public:
+  SatMarkovSetUpdateTestCase ();
+  virtual ~SatMarkovSetUpdateTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Elevation callback of the terminal, counting the requests
+   * \return elevation of the terminal
+   */
+  double GetElevation ();
+
+  /**
+   * \brief Get the fading of a terminal on both links.
+   * \param manager Markov fading manager
+   * \param terminal terminal id
+   */
+  void GetFadings (Ptr<SatMarkovFadingManager> manager, uint32_t terminal);
+
+  /**
+   * \brief Save the number of elevation requests.
+   * \param requests where the number of requests is saved
+   */
+  void SaveElevationRequests (uint32_t *requests);
+
+  uint32_t m_elevationRequests;
+};
+
+SatMarkovSetUpdateTestCase::SatMarkovSetUpdateTestCase ()
+  : TestCase ("Test satellite Markov elevation parameter set updates."),
+  m_elevationRequests (0)
+{
+}
+
+SatMarkovSetUpdateTestCase::~SatMarkovSetUpdateTestCase ()
+{
+}
+
+double
+SatMarkovSetUpdateTestCase::GetElevation ()
+{
+  m_elevationRequests++;
+  return SatMarkovTestElevation ();
+}
+
+void
+SatMarkovSetUpdateTestCase::GetFadings (Ptr<SatMarkovFadingManager> manager, uint32_t terminal)
+{
+  manager->GetFading (terminal, SatEnums::RETURN_USER_CH);
+  manager->GetFading (terminal, SatEnums::FORWARD_USER_CH);
+}
+
+void
+SatMarkovSetUpdateTestCase::SaveElevationRequests (uint32_t *requests)
+{
+  *requests = m_elevationRequests;
+}
+
+void
+SatMarkovSetUpdateTestCase::DoRun (void)
+{
+  const uint32_t numOfSamples = 25;
+
+  for (uint32_t decoupled = 0; decoupled < 2; decoupled++)
+    {
+      Ptr<SatMarkovConf> markovConf = CreateObject<SatMarkovConf> ();
+      markovConf->SetAttribute ("DecoupledSetUpdates", BooleanValue (decoupled == 1));
+      markovConf->SetAttribute ("SetUpdateInterval", TimeValue (Seconds (1)));
+      // a state change evaluation on every fading request of the moving terminal
+      markovConf->SetAttribute ("MinimumPositionChangeInMeters", DoubleValue (1.0));
+
+      Ptr<SatMarkovFadingManager> manager = CreateObject<SatMarkovFadingManager> (markovConf);
+      uint32_t terminal = manager->AddTerminal (MakeCallback (&SatMarkovSetUpdateTestCase::GetElevation, this),
+                                                MakeCallback (&SatMarkovTestMovingVelocity));
+
+      uint32_t requestsAtStart = m_elevationRequests;
+      uint32_t requestsBeforeChange = 0;
+      uint32_t requestsAfterChange = 0;
+      uint32_t requestsAfterFirstUpdate = 0;
+
+      for (uint32_t i = 1; i <= numOfSamples; i++)
+        {
+          Simulator::Schedule (Seconds (0.1 * i), &SatMarkovSetUpdateTestCase::GetFadings, this, manager, terminal);
+        }
+
+      Simulator::Schedule (Seconds (0.55), &SatMarkovSetUpdateTestCase::SaveElevationRequests, this, &requestsBeforeChange);
+      Simulator::Schedule (Seconds (0.55), &SatMarkovFadingManager::UpdateActiveSet, manager, terminal);
+      Simulator::Schedule (Seconds (0.95), &SatMarkovSetUpdateTestCase::SaveElevationRequests, this, &requestsAfterChange);
+      Simulator::Schedule (Seconds (1.95), &SatMarkovSetUpdateTestCase::SaveElevationRequests, this, &requestsAfterFirstUpdate);
+
+      Simulator::Stop (Seconds (2.55));
+      Simulator::Run ();
+      Simulator::Destroy ();
+
+      if (decoupled == 1)
+        {
+          NS_TEST_ASSERT_MSG_EQ (requestsBeforeChange, requestsAtStart, "Elevation requested by the fading requests");
+          NS_TEST_ASSERT_MSG_EQ (requestsAfterChange, requestsAtStart + 1, "Elevation not requested on the mobility change");
+          NS_TEST_ASSERT_MSG_EQ (requestsAfterFirstUpdate, requestsAtStart + 2, "Elevation not requested on the periodic update");
+          NS_TEST_ASSERT_MSG_EQ (m_elevationRequests, requestsAtStart + 3, "Elevation not requested on the periodic update");
+        }
+      else
+        {
+          // one evaluation per fading request, the second link sees no position change
+          NS_TEST_ASSERT_MSG_EQ (requestsBeforeChange, requestsAtStart + 5, "Elevation not requested by the fading requests");
+          NS_TEST_ASSERT_MSG_EQ (m_elevationRequests, requestsAtStart + numOfSamples, "Elevation not requested by the fading requests");
+        }
+
+      manager->Dispose ();
+      m_elevationRequests = 0;
+    }
+}
+
+/**
+ * \brief Test suite for Satellite Markov fading unit test cases.
+ */
+class SatMarkovFadingTestSuite : public TestSuite
+{
+public:
+  SatMarkovFadingTestSuite ();
+};
+
+SatMarkovFadingTestSuite::SatMarkovFadingTestSuite ()
+  : TestSuite ("sat-markov-fading-test", UNIT)
+{
+  AddTestCase (new SatMarkovTransitionTableTestCase (), TestCase::QUICK);
+  AddTestCase (new SatMarkovTabulatedFadingTestCase (), TestCase::QUICK);
+  AddTestCase (new SatMarkovFadingManagerTestCase (), TestCase::QUICK);
+  AddTestCase (new SatMarkovSetUpdateTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatMarkovFadingTestSuite satMarkovFadingTestSuite;
@@ -229,6 +229,13 @@ static const double g_refElAngles[g_latitudeCount][g_longitudeCount] =
     -8.6018742e+00, -8.6018742e+00, }
 };
 
+static uint32_t g_avoidedRecalculations = 0;
+
+static void AvoidedRecalculationsChanged (uint32_t oldValue, uint32_t newValue)
+{
+  g_avoidedRecalculations = newValue;
+}
+
 /**
  * \ingroup satellite
  * \brief Test case to unit test Satellite Mobility Observer.
@@ -314,6 +321,20 @@ SatMobilityObserverTestCase::DoRun (void)
   // check that timing advance is correct
   NS_TEST_ASSERT_MSG_EQ ( timingAdvance, 500, "Timing Advance incorrect");
 
+  // check that cached values are used until some of the observed mobilities changes its course
+  utObserver->TraceConnectWithoutContext ("AvoidedRecalculations", MakeCallback (&AvoidedRecalculationsChanged));
+  utObserver->GetElevationAngle ();
+  utObserver->GetElevationAngle ();
+  utObserver->GetTimingAdvance ();
+
+  NS_TEST_ASSERT_MSG_EQ ( g_avoidedRecalculations, 2, "Cached values not used");
+
+  gwMob->SetGeoPosition (GeoCoordinate (0.00, 10.00, 0.00));
+  utObserver->GetElevationAngle ();
+  utObserver->GetTimingAdvance ();
+
+  NS_TEST_ASSERT_MSG_EQ ( g_avoidedRecalculations, 3, "Cached values not updated by course change");
+
 
   // Test that we get 0 degrees elevation angle at range points, where we stop seeing satellite
   gwMob->SetGeoPosition (GeoCoordinate (60.00, 0.00, 0.00));
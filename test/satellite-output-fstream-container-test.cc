@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-output-fstream-container-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the streaming mode of Satellite output file stream containers.
+ */
+
+#include <sstream>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "../utils/satellite-output-fstream-double-container.h"
+#include "../utils/satellite-output-fstream-string-container.h"
+#include "../utils/satellite-output-fstream-writer.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the streamed output of the containers is
+ * the one written by the containers storing their values.
+ *
+ *   1.  Create a storing double container, several streaming double
+ *       containers and a streaming string container, with blocks much smaller
+ *       than the output so that the writers share the writer thread during
+ *       the whole test.
+ *   2.  Add the same rows to all the containers, interleaved.
+ *   3.  Write the containers and read the files back.
+ *   4.  Repeat with compressed output, if zlib is available.
+ *
+ *   Expected result:
+ *     The files of the streaming containers have the same contents as the
+ *     file of the storing container.
+ *
+ */
+class SatOutputFileStreamContainerTestCase : public TestCase
+{
+public:
+  SatOutputFileStreamContainerTestCase ();
+  virtual ~SatOutputFileStreamContainerTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Write the rows through the containers and compare the outputs
+   * \param compress compress the output of the streaming containers
+   */
+  void RunRoundTrip (bool compress);
+};
+
+SatOutputFileStreamContainerTestCase::SatOutputFileStreamContainerTestCase ()
+  : TestCase ("Test satellite output file stream containers in streaming mode.")
+{
+}
+
+SatOutputFileStreamContainerTestCase::~SatOutputFileStreamContainerTestCase ()
+{
+}
+
+void
+SatOutputFileStreamContainerTestCase::RunRoundTrip (bool compress)
+{
+  const uint32_t numOfContainers = 8;
+  const uint32_t numOfRows = 5000;
+  const std::string prefix = CreateTempDirFilename (compress ? "compressed" : "streamed");
+
+  Ptr<SatOutputFileStreamDoubleContainer> reference =
+    CreateObject<SatOutputFileStreamDoubleContainer> (prefix + "-reference", std::ios::out, 3);
+
+  std::vector<Ptr<SatOutputFileStreamDoubleContainer> > containers;
+
+  for (uint32_t i = 0; i < numOfContainers; i++)
+    {
+      std::stringstream fileName;
+      fileName << prefix << "-" << i;
+
+      Ptr<SatOutputFileStreamDoubleContainer> container =
+        CreateObject<SatOutputFileStreamDoubleContainer> (fileName.str (), std::ios::out, 3);
+      container->SetAttribute ("StreamingOutput", BooleanValue (true));
+      container->SetAttribute ("StreamingBlockSize", UintegerValue (256 + 64 * i));
+      container->SetAttribute ("CompressOutput", BooleanValue (compress));
+      containers.push_back (container);
+    }
+
+  Ptr<SatOutputFileStreamStringContainer> lines =
+    CreateObject<SatOutputFileStreamStringContainer> (prefix + "-lines", std::ios::out);
+  lines->SetAttribute ("StreamingOutput", BooleanValue (true));
+  lines->SetAttribute ("StreamingBlockSize", UintegerValue (512));
+  lines->SetAttribute ("CompressOutput", BooleanValue (compress));
+
+  std::string expectedLines;
+
+  for (uint32_t n = 0; n < numOfRows; n++)
+    {
+      std::vector<double> row;
+      row.push_back (0.001 * n);
+      row.push_back (-1.0 / (n + 1));
+      row.push_back (1e6 * n + 0.5);
+
+      reference->AddToContainer (row);
+
+      for (uint32_t i = 0; i < numOfContainers; i++)
+        {
+          containers[i]->AddToContainer (row);
+        }
+
+      std::stringstream line;
+      line << "line " << n;
+      lines->AddToContainer (line.str ());
+      expectedLines += line.str () + "\n";
+    }
+
+  reference->WriteContainerToFile ();
+  lines->WriteContainerToFile ();
+
+  for (uint32_t i = 0; i < numOfContainers; i++)
+    {
+      containers[i]->WriteContainerToFile ();
+    }
+
+  const std::string suffix = compress ? ".gz" : "";
+  const std::string expected = SatOutputFileStreamWriter::ReadFile (prefix + "-reference", false);
+
+  NS_TEST_ASSERT_MSG_EQ (expected.empty (), false, "Empty reference output");
+
+  for (uint32_t i = 0; i < numOfContainers; i++)
+    {
+      std::stringstream fileName;
+      fileName << prefix << "-" << i << suffix;
+
+      NS_TEST_ASSERT_MSG_EQ ((SatOutputFileStreamWriter::ReadFile (fileName.str (), compress) == expected), true,
+                             "Wrong streamed output of container " << i << (compress ? " (compressed)" : ""));
+    }
+
+  NS_TEST_ASSERT_MSG_EQ ((SatOutputFileStreamWriter::ReadFile (prefix + "-lines" + suffix, compress) == expectedLines), true,
+                         "Wrong streamed output of the string container" << (compress ? " (compressed)" : ""));
+}
+
+void
+SatOutputFileStreamContainerTestCase::DoRun (void)
+{
+  RunRoundTrip (false);
+
+  if (SatOutputFileStreamWriter::IsCompressionSupported ())
+    {
+      RunRoundTrip (true);
+    }
+}
+
+/**
+ * \brief Test suite for Satellite output file stream container unit test cases.
+ */
+class SatOutputFileStreamContainerTestSuite : public TestSuite
+{
+public:
+  SatOutputFileStreamContainerTestSuite ();
+};
+
+SatOutputFileStreamContainerTestSuite::SatOutputFileStreamContainerTestSuite ()
+  : TestSuite ("sat-output-fstream-container-test", UNIT)
+{
+  AddTestCase (new SatOutputFileStreamContainerTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatOutputFileStreamContainerTestSuite satOutputFileStreamContainerTestSuite;
@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-output-trace-recorder-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the Satellite bounded output trace recorder.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/nstime.h"
+#include "../utils/satellite-output-trace-recorder.h"
+
+using namespace ns3;
+
+/**
+ * \brief Read the text output of a recorder
+ * \param fileName Name of the text output
+ * \param times Times of the rows
+ * \param values Values of the rows
+ * \return true if every row has two columns
+ */
+static bool
+SatReadRecorderTextOutput (std::string fileName, std::vector<double>& times, std::vector<double>& values)
+{
+  std::ifstream ifs (fileName.c_str ());
+  std::string line;
+
+  while (std::getline (ifs, line))
+    {
+      std::istringstream row (line);
+      double time, value;
+      std::string extra;
+
+      if (!(row >> time >> value) || (row >> extra))
+        {
+          return false;
+        }
+
+      times.push_back (time);
+      values.push_back (value);
+    }
+
+  return true;
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the decimation and the buffer of the recorder.
+ *
+ *   1.  Create a recorder keeping one sample out of three, with a buffer of
+ *       two records, and export its output to text.
+ *   2.  Add 20 samples, then close the recorder.
+ *
+ *   Expected result:
+ *     No more than two records are ever buffered, and the text output has
+ *     the two columns time and value of the samples 0, 3, 6, ... 18.
+ *
+ */
+class SatOutputTraceRecorderDecimationTestCase : public TestCase
+{
+public:
+  SatOutputTraceRecorderDecimationTestCase ();
+  virtual ~SatOutputTraceRecorderDecimationTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatOutputTraceRecorderDecimationTestCase::SatOutputTraceRecorderDecimationTestCase ()
+  : TestCase ("Test satellite output trace recorder decimation and buffer.")
+{
+}
+
+SatOutputTraceRecorderDecimationTestCase::~SatOutputTraceRecorderDecimationTestCase ()
+{
+}
+
+void
+SatOutputTraceRecorderDecimationTestCase::DoRun (void)
+{
+  std::string textFileName = CreateTempDirFilename ("decimated.txt");
+
+  Ptr<SatOutputTraceRecorder> recorder = CreateObject<SatOutputTraceRecorder> (textFileName + ".bin", Seconds (0), 3, 2);
+  recorder->EnableTextOutput (textFileName);
+
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      recorder->AddSample (0.1 * i, 10.0 + i);
+
+      NS_TEST_ASSERT_MSG_EQ ((recorder->GetNumOfBufferedRecords () < 2), true, "Too many records buffered after sample " << i);
+    }
+
+  recorder->Close ();
+
+  std::vector<double> times;
+  std::vector<double> values;
+
+  NS_TEST_ASSERT_MSG_EQ (SatReadRecorderTextOutput (textFileName, times, values), true, "Text output is not in two columns");
+  NS_TEST_ASSERT_MSG_EQ (times.size (), 7, "Wrong number of recorded samples");
+
+  for (uint32_t i = 0; i < times.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (times[i], 0.3 * i, 1e-9, "Wrong time of record " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (values[i], 10.0 + 3 * i, 1e-9, "Wrong value of record " << i);
+    }
+
+  recorder->Dispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the aggregation of the recorder.
+ *
+ *   1.  Create a recorder aggregating the samples over one second, with a
+ *       buffer of one record, and export its output to text.
+ *   2.  Add four samples per second during three seconds, then close the
+ *       recorder.
+ *
+ *   Expected result:
+ *     The buffer is written as soon as an interval is closed, and the text
+ *     output has the two columns start time and mean of each interval.
+ *
+ */
+class SatOutputTraceRecorderAggregationTestCase : public TestCase
+{
+public:
+  SatOutputTraceRecorderAggregationTestCase ();
+  virtual ~SatOutputTraceRecorderAggregationTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatOutputTraceRecorderAggregationTestCase::SatOutputTraceRecorderAggregationTestCase ()
+  : TestCase ("Test satellite output trace recorder aggregation.")
+{
+}
+
+SatOutputTraceRecorderAggregationTestCase::~SatOutputTraceRecorderAggregationTestCase ()
+{
+}
+
+void
+SatOutputTraceRecorderAggregationTestCase::DoRun (void)
+{
+  std::string textFileName = CreateTempDirFilename ("aggregated.txt");
+
+  Ptr<SatOutputTraceRecorder> recorder = CreateObject<SatOutputTraceRecorder> (textFileName + ".bin", Seconds (1), 1, 1);
+  recorder->EnableTextOutput (textFileName);
+
+  for (uint32_t i = 0; i < 12; i++)
+    {
+      recorder->AddSample (0.25 * i, i);
+
+      NS_TEST_ASSERT_MSG_EQ (recorder->GetNumOfBufferedRecords (), 0, "Records buffered after sample " << i);
+    }
+
+  recorder->Close ();
+
+  std::vector<double> times;
+  std::vector<double> values;
+
+  NS_TEST_ASSERT_MSG_EQ (SatReadRecorderTextOutput (textFileName, times, values), true, "Text output is not in two columns");
+  NS_TEST_ASSERT_MSG_EQ (times.size (), 3, "Wrong number of intervals");
+
+  for (uint32_t i = 0; i < times.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (times[i], 1.0 * i, 1e-9, "Wrong time of interval " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (values[i], 4.0 * i + 1.5, 1e-9, "Wrong mean of interval " << i);
+    }
+
+  recorder->Dispose ();
+}
+
+/**
+ * \brief Test suite for Satellite output trace recorder unit test cases.
+ */
+class SatOutputTraceRecorderTestSuite : public TestSuite
+{
+public:
+  SatOutputTraceRecorderTestSuite ();
+};
+
+SatOutputTraceRecorderTestSuite::SatOutputTraceRecorderTestSuite ()
+  : TestSuite ("sat-output-trace-recorder-test", UNIT)
+{
+  AddTestCase (new SatOutputTraceRecorderDecimationTestCase (), TestCase::QUICK);
+  AddTestCase (new SatOutputTraceRecorderAggregationTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatOutputTraceRecorderTestSuite satOutputTraceRecorderTestSuite;
@@ -0,0 +1,235 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-packet-trace-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the Satellite packet trace.
+ */
+
+#include <fstream>
+#include <sstream>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+#include "ns3/singleton.h"
+#include "../model/satellite-packet-trace.h"
+#include "../utils/satellite-env-variables.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the filters of the packet trace and the binary
+ * output.
+ *
+ *   1.  Set filters on all the packet event, node type, log level, link
+ *       direction, node id and time window attributes, and a block size
+ *       smaller than the trace.
+ *   2.  Add entries of all the combinations of node type, node id, log
+ *       level and link direction at several times to a text packet trace.
+ *   3.  Add the same entries to a binary packet trace and convert it to text.
+ *
+ *   Expected result:
+ *     The text trace holds the entries passing all the filters, in order,
+ *     and the converted binary trace is identical to the text trace.
+ *
+ */
+class SatPacketTraceTestCase : public TestCase
+{
+public:
+  SatPacketTraceTestCase ();
+  virtual ~SatPacketTraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Create a packet trace with the current defaults and add the entries
+   * \param fileName file name of the packet trace
+   * \param binaryOutput write binary records
+   * \param expected text expected for the traced entries
+   * \return number of traced entries
+   */
+  uint32_t WriteTrace (std::string fileName, bool binaryOutput, std::string& expected);
+
+  /**
+   * \brief Read a whole file
+   * \param fileName file name
+   * \return contents of the file
+   */
+  static std::string ReadFile (std::string fileName);
+};
+
+SatPacketTraceTestCase::SatPacketTraceTestCase ()
+  : TestCase ("Test satellite packet trace filters and binary output.")
+{
+}
+
+SatPacketTraceTestCase::~SatPacketTraceTestCase ()
+{
+}
+
+uint32_t
+SatPacketTraceTestCase::WriteTrace (std::string fileName, bool binaryOutput, std::string& expected)
+{
+  Config::SetDefault ("ns3::SatPacketTrace::FileName", StringValue (fileName));
+  Config::SetDefault ("ns3::SatPacketTrace::BinaryOutput", BooleanValue (binaryOutput));
+
+  Ptr<SatPacketTrace> trace = CreateObject<SatPacketTrace> ();
+
+  NS_TEST_EXPECT_MSG_EQ (trace->IsLogLevelTraced (SatEnums::LL_MAC), true, "MAC log level not traced");
+  NS_TEST_EXPECT_MSG_EQ (trace->IsLogLevelTraced (SatEnums::LL_ND), false, "ND log level traced");
+
+  const SatEnums::SatNodeType_t nodeTypes[] = { SatEnums::NT_UT, SatEnums::NT_SAT, SatEnums::NT_GW };
+  const SatEnums::SatLinkDir_t linkDirs[] = { SatEnums::LD_FORWARD, SatEnums::LD_RETURN };
+  std::ostringstream lines;
+  uint32_t numOfEntries = 0;
+
+  for (uint32_t k = 0; k <= 16; k++)
+    {
+      double time = 0.25 * k;
+      SatEnums::SatPacketEvent_t packetEvent = static_cast<SatEnums::SatPacketEvent_t> (k % 4);
+
+      for (uint32_t t = 0; t < 3; t++)
+        {
+          for (uint32_t nodeId = 1; nodeId <= 3; nodeId++)
+            {
+              std::ostringstream address;
+              address << "00:00:00:00:0" << t << ":0" << nodeId;
+              Mac48Address macAddress (address.str ().c_str ());
+
+              for (uint32_t logLevel = SatEnums::LL_ND; logLevel <= SatEnums::LL_CH; logLevel++)
+                {
+                  for (uint32_t d = 0; d < 2; d++)
+                    {
+                      // Packet info of varying length, empty for some entries
+                      std::ostringstream packetInfo;
+                      for (uint32_t i = 0; i < (k + logLevel) % 3; i++)
+                        {
+                          packetInfo << (i > 0 ? " " : "") << 100 * k + i << " " << macAddress;
+                        }
+
+                      trace->AddTraceEntry (Seconds (time), packetEvent, nodeTypes[t], nodeId, macAddress,
+                                            static_cast<SatEnums::SatLogLevel_t> (logLevel), linkDirs[d],
+                                            packetInfo.str ());
+
+                      if (packetEvent != SatEnums::PACKET_ENQUE
+                          && nodeTypes[t] != SatEnums::NT_SAT
+                          && (nodeId == 1 || nodeId == 3)
+                          && (logLevel == SatEnums::LL_MAC || logLevel == SatEnums::LL_PHY)
+                          && linkDirs[d] == SatEnums::LD_RETURN
+                          && time >= 1.0 && time <= 3.0)
+                        {
+                          lines << time << " " << SatEnums::GetPacketEventName (packetEvent)
+                                << " " << SatEnums::GetNodeTypeName (nodeTypes[t])
+                                << " " << nodeId << " " << macAddress
+                                << " " << SatEnums::GetLogLevelName (static_cast<SatEnums::SatLogLevel_t> (logLevel))
+                                << " " << SatEnums::GetLinkDirName (linkDirs[d])
+                                << " " << packetInfo.str () << "\n";
+                          numOfEntries++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+  trace->Dispose ();
+  expected = lines.str ();
+
+  return numOfEntries;
+}
+
+std::string
+SatPacketTraceTestCase::ReadFile (std::string fileName)
+{
+  std::ifstream file (fileName.c_str ());
+  std::ostringstream contents;
+  contents << file.rdbuf ();
+  return contents.str ();
+}
+
+void
+SatPacketTraceTestCase::DoRun (void)
+{
+  const std::string outputPath = CreateTempDirFilename ("packet-trace");
+
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->CreateDirectory (outputPath);
+  Singleton<SatEnvVariables>::Get ()->SetOutputPath (outputPath);
+
+  Config::SetDefault ("ns3::SatPacketTrace::BlockSize", UintegerValue (256));
+  Config::SetDefault ("ns3::SatPacketTrace::TracedPacketEvents", StringValue ("SND RCV,DRP"));
+  Config::SetDefault ("ns3::SatPacketTrace::TracedNodeTypes", StringValue ("UT GW"));
+  Config::SetDefault ("ns3::SatPacketTrace::TracedLogLevels", StringValue ("MAC,PHY"));
+  Config::SetDefault ("ns3::SatPacketTrace::TracedLinkDirections", StringValue ("RTN"));
+  Config::SetDefault ("ns3::SatPacketTrace::TracedNodeIds", StringValue ("1, 3"));
+  Config::SetDefault ("ns3::SatPacketTrace::StartTime", TimeValue (Seconds (1.0)));
+  Config::SetDefault ("ns3::SatPacketTrace::StopTime", TimeValue (Seconds (3.0)));
+
+  std::string expected;
+  std::string expectedBinary;
+
+  uint32_t numOfEntries = WriteTrace ("text-trace", false, expected);
+  uint32_t numOfBinaryEntries = WriteTrace ("binary-trace", true, expectedBinary);
+
+  Config::Reset ();
+
+  // 7 times of the window without the ENQ events, 2 node types, 2 node ids
+  // and 2 log levels
+  NS_TEST_ASSERT_MSG_EQ (numOfEntries, 56, "Wrong number of expected entries");
+  NS_TEST_ASSERT_MSG_EQ (numOfBinaryEntries, numOfEntries, "Different entries added to the binary trace");
+
+  std::string text = ReadFile (outputPath + "/text-trace.log");
+  std::string::size_type headerEnd = text.rfind ("-------------------\n\n");
+
+  NS_TEST_ASSERT_MSG_EQ (text.compare (0, 19, "COLUMN DESCRIPTIONS"), 0, "Missing header in the text trace");
+  NS_TEST_ASSERT_MSG_EQ ((headerEnd != std::string::npos), true, "Missing end of header in the text trace");
+  NS_TEST_ASSERT_MSG_EQ (text.substr (headerEnd + 21), expected, "Wrong entries in the text trace");
+
+  SatPacketTrace::ConvertToText (outputPath + "/binary-trace.bin", outputPath + "/binary-trace.log");
+
+  NS_TEST_ASSERT_MSG_EQ (ReadFile (outputPath + "/binary-trace.log"), text, "Converted binary trace differs from the text trace");
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \brief Test suite for Satellite packet trace unit test cases.
+ */
+class SatPacketTraceTestSuite : public TestSuite
+{
+public:
+  SatPacketTraceTestSuite ();
+};
+
+SatPacketTraceTestSuite::SatPacketTraceTestSuite ()
+  : TestSuite ("sat-packet-trace-test", UNIT)
+{
+  AddTestCase (new SatPacketTraceTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatPacketTraceTestSuite satPacketTraceTestSuite;
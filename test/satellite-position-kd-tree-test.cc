@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-position-kd-tree-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the k-d tree of positions.
+ */
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/vector.h"
+#include "ns3/random-variable-stream.h"
+#include "../model/geo-coordinate.h"
+#include "../model/satellite-position-kd-tree.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the nearest positions found with the k-d tree
+ * against a linear scan.
+ *
+ *   1.  Create random positions on the Earth surface, the way trace sources
+ *       of an index file are, and add duplicates of some of them.
+ *   2.  Build the k-d tree of the positions.
+ *   3.  Find the nearest position of random query positions, and of the
+ *       indexed positions themselves, with the tree and with a linear scan
+ *       keeping the first nearest position.
+ *
+ *   Expected result:
+ *     The tree finds the same position and distance as the linear scan,
+ *     including for equally distant positions.
+ *
+ */
+class SatPositionKdTreeTestCase : public TestCase
+{
+public:
+  SatPositionKdTreeTestCase ();
+  virtual ~SatPositionKdTreeTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Find the nearest position with a linear scan.
+   * \param positions Positions to scan
+   * \param position Position to find the nearest position for
+   * \param distance Distance to the nearest position is stored here
+   * \return index of the first nearest position
+   */
+  uint32_t FindNearest (const std::vector<Vector>& positions, const Vector& position, double& distance) const;
+};
+
+SatPositionKdTreeTestCase::SatPositionKdTreeTestCase ()
+  : TestCase ("Test satellite k-d tree of positions.")
+{
+}
+
+SatPositionKdTreeTestCase::~SatPositionKdTreeTestCase ()
+{
+}
+
+uint32_t
+SatPositionKdTreeTestCase::FindNearest (const std::vector<Vector>& positions, const Vector& position, double& distance) const
+{
+  uint32_t nearest (0);
+  distance = std::numeric_limits<double>::max ();
+
+  for (uint32_t i = 0; i < positions.size (); i++)
+    {
+      Vector d = position - positions[i];
+      double distanceSquared = d.x * d.x + d.y * d.y + d.z * d.z;
+
+      if (distanceSquared < distance)
+        {
+          distance = distanceSquared;
+          nearest = i;
+        }
+    }
+
+  distance = std::sqrt (distance);
+  return nearest;
+}
+
+void
+SatPositionKdTreeTestCase::DoRun (void)
+{
+  const uint32_t numOfPositions = 500;
+  const uint32_t numOfQueries = 1000;
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  std::vector<Vector> positions;
+
+  for (uint32_t i = 0; i < numOfPositions; i++)
+    {
+      positions.push_back (GeoCoordinate (random->GetValue (30.0, 70.0), random->GetValue (-20.0, 40.0), 0.0).ToVector ());
+    }
+
+  // duplicated sources have to resolve to the first one
+  for (uint32_t i = 0; i < numOfPositions; i += 10)
+    {
+      positions.push_back (positions[i]);
+    }
+
+  SatPositionKdTree tree;
+  uint32_t item (0);
+  double distance (0.0);
+
+  NS_TEST_ASSERT_MSG_EQ (tree.FindNearest (positions[0], item, distance), false, "Position found from an empty tree");
+
+  tree.Build (positions);
+  NS_TEST_ASSERT_MSG_EQ (tree.GetSize (), positions.size (), "Wrong number of indexed positions");
+
+  std::vector<Vector> queries (positions);
+
+  for (uint32_t i = 0; i < numOfQueries; i++)
+    {
+      queries.push_back (GeoCoordinate (random->GetValue (25.0, 75.0), random->GetValue (-25.0, 45.0), random->GetValue (0.0, 1000.0)).ToVector ());
+    }
+
+  for (uint32_t i = 0; i < queries.size (); i++)
+    {
+      double expectedDistance (0.0);
+      uint32_t expectedItem = FindNearest (positions, queries[i], expectedDistance);
+
+      NS_TEST_ASSERT_MSG_EQ (tree.FindNearest (queries[i], item, distance), true, "No position found for query " << i);
+      NS_TEST_ASSERT_MSG_EQ (item, expectedItem, "Wrong nearest position for query " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (distance, expectedDistance, 1e-6, "Wrong distance to the nearest position for query " << i);
+    }
+}
+
+/**
+ * \brief Test suite for Satellite k-d tree of positions unit test cases.
+ */
+class SatPositionKdTreeTestSuite : public TestSuite
+{
+public:
+  SatPositionKdTreeTestSuite ();
+};
+
+SatPositionKdTreeTestSuite::SatPositionKdTreeTestSuite ()
+  : TestSuite ("sat-position-kd-tree-test", UNIT)
+{
+  AddTestCase (new SatPositionKdTreeTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatPositionKdTreeTestSuite satPositionKdTreeTestSuite;
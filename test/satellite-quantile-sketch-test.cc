@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-quantile-sketch-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test Satellite quantile sketch.
+ */
+
+#include <cmath>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "../stats/satellite-quantile-sketch.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the accuracy and the merging of the quantile sketch.
+ *
+ *   1.  Add log-normally distributed samples, some of them negative or zero,
+ *       to two sketches and keep all the samples.
+ *   2.  Merge the sketches, and print and read back the merged sketch.
+ *   3.  Compare the estimated quantiles with the exact ones.
+ *   4.  Add the same samples to a sketch with few buckets.
+ *
+ *   Expected result:
+ *     The quantiles of the merged sketch are within the relative accuracy of
+ *     the exact quantiles, and identical after reading the sketch back. The
+ *     sketch with few buckets does not exceed its number of buckets and keeps
+ *     the accuracy of the upper quantiles.
+ *
+ */
+class SatQuantileSketchTestCase : public TestCase
+{
+public:
+  SatQuantileSketchTestCase ();
+  virtual ~SatQuantileSketchTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Get the exact quantile of sorted samples, with the rank used by the sketch
+   * \param samples sorted samples
+   * \param quantile quantile between 0 and 1
+   * \return the sample at the rank of the quantile
+   */
+  double GetExactQuantile (const std::vector<double>& samples, double quantile);
+};
+
+SatQuantileSketchTestCase::SatQuantileSketchTestCase ()
+  : TestCase ("Test satellite quantile sketch accuracy and merging.")
+{
+}
+
+SatQuantileSketchTestCase::~SatQuantileSketchTestCase ()
+{
+}
+
+double
+SatQuantileSketchTestCase::GetExactQuantile (const std::vector<double>& samples, double quantile)
+{
+  return samples[static_cast<uint32_t> (quantile * (samples.size () - 1))];
+}
+
+void
+SatQuantileSketchTestCase::DoRun (void)
+{
+  const uint32_t numOfSamples = 100000;
+  const double relativeAccuracy = 0.01;
+  const double quantiles[] = { 0.01, 0.1, 0.5, 0.9, 0.99, 0.999 };
+
+  Ptr<LogNormalRandomVariable> delay = CreateObject<LogNormalRandomVariable> ();
+  delay->SetAttribute ("Mu", DoubleValue (-3.0));
+  delay->SetAttribute ("Sigma", DoubleValue (1.5));
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+
+  SatQuantileSketch first (relativeAccuracy);
+  SatQuantileSketch second (relativeAccuracy);
+  SatQuantileSketch bounded (relativeAccuracy, 300);
+  std::vector<double> samples;
+
+  for (uint32_t i = 0; i < numOfSamples; i++)
+    {
+      double selector = uniform->GetValue ();
+      double value = delay->GetValue ();
+
+      if (selector < 0.02)
+        {
+          value = -value;
+        }
+      else if (selector < 0.03)
+        {
+          value = 0.0;
+        }
+
+      samples.push_back (value);
+      bounded.Add (value);
+      if (i % 3 == 0)
+        {
+          first.Add (value);
+        }
+      else
+        {
+          second.Add (value);
+        }
+    }
+
+  std::sort (samples.begin (), samples.end ());
+
+  first.Merge (second);
+  NS_TEST_ASSERT_MSG_EQ (first.GetCount (), numOfSamples, "Wrong number of samples in the merged sketch");
+  NS_TEST_ASSERT_MSG_EQ (first.GetMin (), samples.front (), "Wrong minimum of the merged sketch");
+  NS_TEST_ASSERT_MSG_EQ (first.GetMax (), samples.back (), "Wrong maximum of the merged sketch");
+
+  std::ostringstream oss;
+  first.Print (oss);
+  std::istringstream iss (oss.str ());
+  SatQuantileSketch read;
+  NS_TEST_ASSERT_MSG_EQ (read.Read (iss), true, "Cannot read back the printed sketch");
+  NS_TEST_ASSERT_MSG_EQ (read.GetCount (), first.GetCount (), "Wrong number of samples in the read sketch");
+
+  for (uint32_t i = 0; i < sizeof (quantiles) / sizeof (quantiles[0]); i++)
+    {
+      double exact = GetExactQuantile (samples, quantiles[i]);
+      double estimated = first.GetQuantile (quantiles[i]);
+
+      NS_TEST_ASSERT_MSG_EQ_TOL (estimated, exact, relativeAccuracy * std::fabs (exact),
+                                 "Quantile " << quantiles[i] << " out of the relative accuracy");
+      NS_TEST_ASSERT_MSG_EQ (read.GetQuantile (quantiles[i]), estimated,
+                             "Quantile " << quantiles[i] << " differs after reading the sketch back");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ ((bounded.GetNumOfBuckets () <= 600), true, "Too many buckets in the bounded sketch");
+
+  for (uint32_t i = 0; i < sizeof (quantiles) / sizeof (quantiles[0]); i++)
+    {
+      if (quantiles[i] >= 0.9)
+        {
+          double exact = GetExactQuantile (samples, quantiles[i]);
+          NS_TEST_ASSERT_MSG_EQ_TOL (bounded.GetQuantile (quantiles[i]), exact, relativeAccuracy * std::fabs (exact),
+                                     "Quantile " << quantiles[i] << " of the bounded sketch out of the relative accuracy");
+        }
+    }
+}
+
+/**
+ * \brief Test suite for Satellite quantile sketch unit test cases.
+ */
+class SatQuantileSketchTestSuite : public TestSuite
+{
+public:
+  SatQuantileSketchTestSuite ();
+};
+
+SatQuantileSketchTestSuite::SatQuantileSketchTestSuite ()
+  : TestSuite ("sat-quantile-sketch-test", UNIT)
+{
+  AddTestCase (new SatQuantileSketchTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatQuantileSketchTestSuite satQuantileSketchTestSuite;
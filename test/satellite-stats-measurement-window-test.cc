@@ -0,0 +1,427 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-stats-measurement-window-test.cc
+ * \ingroup satellite
+ * \brief Test cases to check that the statistics only measure their
+ * measurement window.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/enum.h"
+#include "ns3/nstime.h"
+#include "ns3/string.h"
+#include "ns3/singleton.h"
+#include "ns3/data-rate.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/packet-sink-helper.h"
+#include "../helper/satellite-helper.h"
+#include "../helper/satellite-on-off-helper.h"
+#include "../stats/satellite-columnar-file-reader.h"
+#include "../stats/satellite-stats-helper-container.h"
+#include "../utils/satellite-env-variables.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the statistics installed with a measurement
+ * window only measure the packets received within it.
+ *
+ *   1.  Simple test scenario set with helper, with one UT user sending
+ *       packets to the GW user from 1 to 5 seconds.
+ *   2.  A statistics container with a measurement window from 2 to 4 seconds
+ *       and an aggregation interval of 0.5 seconds installs global return
+ *       link application throughput statistics, as scalar and columnar
+ *       files, and global return link application delay statistics, as a
+ *       columnar file.
+ *   3.  The bytes received by the GW user within the window are counted.
+ *   4.  The output files are read once the simulation is destroyed.
+ *
+ *   Expected result:
+ *     The delay samples and the throughput intervals all lie within the
+ *     window, the throughput intervals sum up to the bytes received within
+ *     the window, and the scalar throughput is these bytes averaged over the
+ *     duration of the window.
+ *
+ */
+class SatStatsMeasurementWindowTestCase : public TestCase
+{
+public:
+  SatStatsMeasurementWindowTestCase ();
+  virtual ~SatStatsMeasurementWindowTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Callback of the packets received by the GW user
+   * \param packet Received packet
+   * \param from Address of the sender
+   */
+  void RxCb (Ptr<const Packet> packet, const Address &from);
+
+  /**
+   * \brief Read the samples of a columnar statistics file
+   * \param fileName Name of the file, without extension
+   * \param times Times of the samples
+   * \param values Values of the samples
+   */
+  void ReadColumnarFile (std::string fileName, std::vector<double> &times, std::vector<double> &values);
+
+  /// Start of the measurement window
+  Time m_measurementStart;
+
+  /// Stop of the measurement window
+  Time m_measurementStop;
+
+  /// Number of packets received within the measurement window
+  uint32_t m_numOfPackets;
+
+  /// Number of bytes received within the measurement window
+  uint32_t m_numOfBytes;
+};
+
+SatStatsMeasurementWindowTestCase::SatStatsMeasurementWindowTestCase ()
+  : TestCase ("Test that the statistics only measure their measurement window."),
+  m_measurementStart (Seconds (2.0)),
+  m_measurementStop (Seconds (4.0)),
+  m_numOfPackets (0),
+  m_numOfBytes (0)
+{
+}
+
+SatStatsMeasurementWindowTestCase::~SatStatsMeasurementWindowTestCase ()
+{
+}
+
+void
+SatStatsMeasurementWindowTestCase::RxCb (Ptr<const Packet> packet, const Address &from)
+{
+  const Time now = Simulator::Now ();
+
+  if (now >= m_measurementStart && now < m_measurementStop)
+    {
+      m_numOfPackets++;
+      m_numOfBytes += packet->GetSize ();
+    }
+}
+
+void
+SatStatsMeasurementWindowTestCase::ReadColumnarFile (std::string fileName, std::vector<double> &times, std::vector<double> &values)
+{
+  SatColumnarFileReader reader (fileName + ".bin");
+  std::vector<double> blockTimes;
+  std::vector<uint32_t> blockContextIndices;
+  std::vector<double> blockValues;
+
+  while (reader.ReadBlock (blockTimes, blockContextIndices, blockValues))
+    {
+      times.insert (times.end (), blockTimes.begin (), blockTimes.end ());
+      values.insert (values.end (), blockValues.begin (), blockValues.end ());
+    }
+}
+
+void
+SatStatsMeasurementWindowTestCase::DoRun (void)
+{
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-stats-measurement-window", "", true);
+
+  Config::SetDefault ("ns3::SatBeamHelper::FadingModel", EnumValue (SatEnums::FADING_OFF));
+  Config::SetDefault ("ns3::SatStatsHelper::AggregationInterval", TimeValue (Seconds (0.5)));
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+  helper->CreatePredefinedScenario (SatHelper::SIMPLE);
+
+  Ptr<Node> utUser = helper->GetUtUsers ().Get (0);
+  Ptr<Node> gwUser = helper->GetGwUsers ().Get (0);
+  uint16_t port = 9;
+
+  PacketSinkHelper sink ("ns3::UdpSocketFactory", Address (InetSocketAddress (Ipv4Address::GetAny (), port)));
+  ApplicationContainer gwSink = sink.Install (gwUser);
+  gwSink.Start (Seconds (0.5));
+  gwSink.Stop (Seconds (6.0));
+  gwSink.Get (0)->TraceConnectWithoutContext ("Rx", MakeCallback (&SatStatsMeasurementWindowTestCase::RxCb, this));
+
+  SatOnOffHelper onOff ("ns3::UdpSocketFactory", Address (InetSocketAddress (helper->GetUserAddress (gwUser), port)));
+  onOff.SetConstantRate (DataRate ("16kbps"), 100);
+  ApplicationContainer utApp = onOff.Install (utUser);
+  utApp.Start (Seconds (1.001));
+  utApp.Stop (Seconds (5.0));
+
+  Ptr<SatStatsHelperContainer> stats = CreateObject<SatStatsHelperContainer> (helper);
+  stats->SetAttribute ("Name", StringValue ("window"));
+  stats->SetAttribute ("MeasurementStart", TimeValue (m_measurementStart));
+  stats->SetAttribute ("MeasurementStop", TimeValue (m_measurementStop));
+  stats->AddGlobalRtnAppThroughput (SatStatsHelper::OUTPUT_SCALAR_FILE);
+  stats->AddGlobalRtnAppThroughput (SatStatsHelper::OUTPUT_COLUMNAR_FILE);
+  stats->AddGlobalRtnAppDelay (SatStatsHelper::OUTPUT_COLUMNAR_FILE);
+
+  Simulator::Stop (Seconds (6.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // Releasing the statistics closes their output files
+  stats = 0;
+
+  NS_TEST_ASSERT_MSG_GT (m_numOfPackets, 0, "No packet received within the measurement window");
+
+  const std::string outputPath = Singleton<SatEnvVariables>::Get ()->GetOutputPath ();
+  const double window = (m_measurementStop - m_measurementStart).GetSeconds ();
+  const double windowKbits = m_numOfBytes * 8.0 / 1000.0;
+
+  // Each delay sample is written when its packet is received
+  std::vector<double> delayTimes;
+  std::vector<double> delays;
+  ReadColumnarFile (outputPath + "/window-global-rtn-app-delay-scatter", delayTimes, delays);
+
+  NS_TEST_ASSERT_MSG_GT (delayTimes.size (), 0, "No delay sample within the measurement window");
+  NS_TEST_ASSERT_MSG_EQ ((delayTimes.size () <= m_numOfPackets), true, "Delay samples outside of the measurement window");
+
+  for (uint32_t i = 0; i < delayTimes.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((delayTimes[i] >= m_measurementStart.GetSeconds ()), true, "Delay sample " << i << " before the measurement window");
+      NS_TEST_ASSERT_MSG_EQ ((delayTimes[i] <= m_measurementStop.GetSeconds ()), true, "Delay sample " << i << " after the measurement window");
+    }
+
+  // Each throughput interval is written at its end
+  std::vector<double> intervalTimes;
+  std::vector<double> throughputs;
+  ReadColumnarFile (outputPath + "/window-global-rtn-app-throughput-scatter", intervalTimes, throughputs);
+
+  NS_TEST_ASSERT_MSG_EQ (intervalTimes.size (), 4, "Wrong number of throughput intervals");
+
+  double intervalKbits = 0.0;
+
+  for (uint32_t i = 0; i < intervalTimes.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (intervalTimes[i], m_measurementStart.GetSeconds () + 0.5 * (i + 1), 1e-9,
+                                 "Wrong end time of throughput interval " << i);
+      intervalKbits += throughputs[i] * 0.5;
+    }
+
+  NS_TEST_ASSERT_MSG_EQ_TOL (intervalKbits, windowKbits, 1e-9, "Wrong sum of the throughput intervals");
+
+  // The scalar file holds the heading and one line per identifier
+  std::ifstream scalarFile ((outputPath + "/window-global-rtn-app-throughput-scalar.txt").c_str ());
+  NS_TEST_ASSERT_MSG_EQ (scalarFile.is_open (), true, "Scalar throughput file not written");
+
+  std::string line;
+  uint32_t numOfScalars = 0;
+  double scalar = 0.0;
+
+  while (std::getline (scalarFile, line))
+    {
+      if (line.empty () || line[0] == '%')
+        {
+          continue;
+        }
+
+      std::istringstream fields (line);
+      std::string context;
+      fields >> context >> scalar;
+      NS_TEST_ASSERT_MSG_EQ (fields.fail (), false, "Invalid scalar throughput line " << line);
+      numOfScalars++;
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (numOfScalars, 1, "Wrong number of scalar throughputs");
+
+  // The scalar is written with the default precision of the streams
+  NS_TEST_ASSERT_MSG_EQ_TOL (scalar, windowKbits / window, 1e-3, "Wrong scalar throughput");
+
+  Config::Reset ();
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the measurement window applies to the
+ * scalar statistics written by their collectors, i.e., without aggregation
+ * interval.
+ *
+ *   1.  Simple test scenario set with helper, with one UT user sending
+ *       packets to the GW user from 1 to 5 seconds.
+ *   2.  The statistics container is configured with default values only,
+ *       so that the global return link application throughput statistics,
+ *       as a scalar file, is added before the measurement window from 2 to
+ *       4 seconds is set.
+ *   3.  The bytes received by the GW user within the window are counted.
+ *   4.  The scalar file is read once the simulation is destroyed.
+ *
+ *   Expected result:
+ *     The scalar throughput is the bytes received within the window averaged
+ *     over the window, and not over the rest of the simulation.
+ *
+ */
+class SatStatsMeasurementWindowScalarTestCase : public TestCase
+{
+public:
+  SatStatsMeasurementWindowScalarTestCase ();
+  virtual ~SatStatsMeasurementWindowScalarTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Callback of the packets received by the GW user
+   * \param packet Received packet
+   * \param from Address of the sender
+   */
+  void RxCb (Ptr<const Packet> packet, const Address &from);
+
+  /// Start of the measurement window
+  Time m_measurementStart;
+
+  /// Stop of the measurement window
+  Time m_measurementStop;
+
+  /// Number of bytes received within the measurement window
+  uint32_t m_numOfBytes;
+};
+
+SatStatsMeasurementWindowScalarTestCase::SatStatsMeasurementWindowScalarTestCase ()
+  : TestCase ("Test that the measurement window applies to the scalar statistics without aggregation interval."),
+  m_measurementStart (Seconds (2.0)),
+  m_measurementStop (Seconds (4.0)),
+  m_numOfBytes (0)
+{
+}
+
+SatStatsMeasurementWindowScalarTestCase::~SatStatsMeasurementWindowScalarTestCase ()
+{
+}
+
+void
+SatStatsMeasurementWindowScalarTestCase::RxCb (Ptr<const Packet> packet, const Address &from)
+{
+  const Time now = Simulator::Now ();
+
+  if (now >= m_measurementStart && now < m_measurementStop)
+    {
+      m_numOfBytes += packet->GetSize ();
+    }
+}
+
+void
+SatStatsMeasurementWindowScalarTestCase::DoRun (void)
+{
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-stats-measurement-window-scalar", "", true);
+
+  Config::SetDefault ("ns3::SatBeamHelper::FadingModel", EnumValue (SatEnums::FADING_OFF));
+
+  // The statistics attribute is declared before the window attributes
+  Config::SetDefault ("ns3::SatStatsHelperContainer::Name", StringValue ("window"));
+  Config::SetDefault ("ns3::SatStatsHelperContainer::GlobalRtnAppThroughput", EnumValue (SatStatsHelper::OUTPUT_SCALAR_FILE));
+  Config::SetDefault ("ns3::SatStatsHelperContainer::MeasurementStart", TimeValue (m_measurementStart));
+  Config::SetDefault ("ns3::SatStatsHelperContainer::MeasurementStop", TimeValue (m_measurementStop));
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+  helper->CreatePredefinedScenario (SatHelper::SIMPLE);
+
+  Ptr<Node> utUser = helper->GetUtUsers ().Get (0);
+  Ptr<Node> gwUser = helper->GetGwUsers ().Get (0);
+  uint16_t port = 9;
+
+  PacketSinkHelper sink ("ns3::UdpSocketFactory", Address (InetSocketAddress (Ipv4Address::GetAny (), port)));
+  ApplicationContainer gwSink = sink.Install (gwUser);
+  gwSink.Start (Seconds (0.5));
+  gwSink.Stop (Seconds (6.0));
+  gwSink.Get (0)->TraceConnectWithoutContext ("Rx", MakeCallback (&SatStatsMeasurementWindowScalarTestCase::RxCb, this));
+
+  SatOnOffHelper onOff ("ns3::UdpSocketFactory", Address (InetSocketAddress (helper->GetUserAddress (gwUser), port)));
+  onOff.SetConstantRate (DataRate ("16kbps"), 100);
+  ApplicationContainer utApp = onOff.Install (utUser);
+  utApp.Start (Seconds (1.001));
+  utApp.Stop (Seconds (5.0));
+
+  Ptr<SatStatsHelperContainer> stats = CreateObject<SatStatsHelperContainer> (helper);
+
+  Simulator::Stop (Seconds (6.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // Releasing the statistics closes their output files
+  stats = 0;
+
+  NS_TEST_ASSERT_MSG_GT (m_numOfBytes, 0, "No packet received within the measurement window");
+
+  const std::string outputPath = Singleton<SatEnvVariables>::Get ()->GetOutputPath ();
+  const double window = (m_measurementStop - m_measurementStart).GetSeconds ();
+  const double windowKbits = m_numOfBytes * 8.0 / 1000.0;
+
+  // The scalar file holds the heading and one line per identifier
+  std::ifstream scalarFile ((outputPath + "/window-global-rtn-app-throughput-scalar.txt").c_str ());
+  NS_TEST_ASSERT_MSG_EQ (scalarFile.is_open (), true, "Scalar throughput file not written");
+
+  std::string line;
+  uint32_t numOfScalars = 0;
+  double scalar = 0.0;
+
+  while (std::getline (scalarFile, line))
+    {
+      if (line.empty () || line[0] == '%')
+        {
+          continue;
+        }
+
+      std::istringstream fields (line);
+      std::string context;
+      fields >> context >> scalar;
+      NS_TEST_ASSERT_MSG_EQ (fields.fail (), false, "Invalid scalar throughput line " << line);
+      numOfScalars++;
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (numOfScalars, 1, "Wrong number of scalar throughputs");
+
+  // The collector may average from its first sample instead of the start
+  // of the window, which is at most one packet interval later
+  NS_TEST_ASSERT_MSG_EQ_TOL (scalar, windowKbits / window, 0.05 * windowKbits / window, "Wrong scalar throughput");
+
+  Config::Reset ();
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \brief Test suite for the measurement window of the statistics.
+ */
+class SatStatsMeasurementWindowTestSuite : public TestSuite
+{
+public:
+  SatStatsMeasurementWindowTestSuite ();
+};
+
+SatStatsMeasurementWindowTestSuite::SatStatsMeasurementWindowTestSuite ()
+  : TestSuite ("sat-stats-measurement-window-test", SYSTEM)
+{
+  AddTestCase (new SatStatsMeasurementWindowTestCase (), TestCase::QUICK);
+  AddTestCase (new SatStatsMeasurementWindowScalarTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatStatsMeasurementWindowTestSuite satStatsMeasurementWindowTestSuite;
@@ -0,0 +1,379 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-stats-terminal-index-test.cc
+ * \ingroup satellite
+ * \brief Test cases to check that the statistics pass the samples of each
+ * terminal to the collector of its identifier.
+ */
+
+#include <map>
+#include <sstream>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/enum.h"
+#include "ns3/singleton.h"
+#include "ns3/data-rate.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/packet-sink-helper.h"
+#include "../helper/satellite-helper.h"
+#include "../helper/satellite-on-off-helper.h"
+#include "../model/satellite-id-mapper.h"
+#include "../stats/satellite-stats-delay-helper.h"
+#include "../stats/satellite-stats-throughput-helper.h"
+#include "../utils/satellite-env-variables.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Return link application delay statistics giving access to their
+ * collectors.
+ */
+class SatStatsTestRtnAppDelayHelper : public SatStatsRtnAppDelayHelper
+{
+public:
+  /**
+   * \brief Constructor
+   * \param satHelper Satellite helper of the scenario
+   */
+  SatStatsTestRtnAppDelayHelper (Ptr<const SatHelper> satHelper)
+    : SatStatsRtnAppDelayHelper (satHelper)
+  {
+  }
+
+  /**
+   * \return the collectors receiving the samples of the identifiers
+   */
+  CollectorMap& GetSampleCollectors ()
+  {
+    return m_terminalCollectors;
+  }
+};
+
+/**
+ * \ingroup satellite
+ * \brief Forward link application delay statistics giving access to their
+ * collectors.
+ */
+class SatStatsTestFwdAppDelayHelper : public SatStatsFwdAppDelayHelper
+{
+public:
+  /**
+   * \brief Constructor
+   * \param satHelper Satellite helper of the scenario
+   */
+  SatStatsTestFwdAppDelayHelper (Ptr<const SatHelper> satHelper)
+    : SatStatsFwdAppDelayHelper (satHelper)
+  {
+  }
+
+  /**
+   * \return the collectors receiving the samples of the identifiers
+   */
+  CollectorMap& GetSampleCollectors ()
+  {
+    return m_terminalCollectors;
+  }
+};
+
+/**
+ * \ingroup satellite
+ * \brief Return link application throughput statistics giving access to
+ * their first-level collectors.
+ */
+class SatStatsTestRtnAppThroughputHelper : public SatStatsRtnAppThroughputHelper
+{
+public:
+  /**
+   * \brief Constructor
+   * \param satHelper Satellite helper of the scenario
+   */
+  SatStatsTestRtnAppThroughputHelper (Ptr<const SatHelper> satHelper)
+    : SatStatsRtnAppThroughputHelper (satHelper)
+  {
+  }
+
+  /**
+   * \return the collectors receiving the samples of the identifiers
+   */
+  CollectorMap& GetSampleCollectors ()
+  {
+    return m_conversionCollectors;
+  }
+};
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the samples of each UT user reach the
+ * collector of its identifier.
+ *
+ *   1.  Larger test scenario set with helper, with five UT users.
+ *   2.  Each UT user sends packets of its own size to the GW user, and the
+ *       GW user sends packets of another size to each UT user.
+ *   3.  Per UT user forward and return link application delay statistics
+ *       and return link application throughput statistics are installed.
+ *   4.  The packets received by the sinks are assigned to the UT users with a
+ *       map of the user addresses, as the statistics did before the terminal
+ *       indices, and the samples reaching the collectors are counted.
+ *
+ *   Expected result:
+ *     The collector of each UT user receives one delay sample per packet
+ *     received from or by the user, and the return link throughput samples
+ *     of the user sum up to the bytes received from it.
+ *
+ */
+class SatStatsTerminalIndexTestCase : public TestCase
+{
+public:
+  SatStatsTerminalIndexTestCase ();
+  virtual ~SatStatsTerminalIndexTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Connect the collectors of a statistics to the sample counters
+   * \param name Name of the statistics, used as context prefix
+   * \param collectors Collectors of the statistics
+   */
+  void ConnectCollectors (std::string name, CollectorMap& collectors);
+
+  /**
+   * \brief Callback of the collector outputs
+   * \param context Name of the statistics and identifier of the collector
+   * \param oldValue Previous output of the collector
+   * \param newValue Output of the collector
+   */
+  void SampleCb (std::string context, double oldValue, double newValue);
+
+  /**
+   * \brief Callback of the packets received by the GW user
+   * \param packet Received packet
+   * \param from Address of the sender
+   */
+  void RtnRxCb (Ptr<const Packet> packet, const Address &from);
+
+  /**
+   * \brief Callback of the packets received by a UT user
+   * \param context Identifier of the UT user
+   * \param packet Received packet
+   * \param from Address of the sender
+   */
+  void FwdRxCb (std::string context, Ptr<const Packet> packet, const Address &from);
+
+  /// Identifiers of the UT users by address, the map used before the terminal indices
+  std::map<const Address, uint32_t> m_identifierMap;
+
+  /// Number of samples per context
+  std::map<std::string, uint32_t> m_numOfSamples;
+
+  /// Sum of the samples per context
+  std::map<std::string, double> m_sumOfSamples;
+
+  /// Number of packets received from each UT user
+  std::map<uint32_t, uint32_t> m_numOfRtnPackets;
+
+  /// Number of bytes received from each UT user
+  std::map<uint32_t, uint32_t> m_numOfRtnBytes;
+
+  /// Number of packets received by each UT user
+  std::map<uint32_t, uint32_t> m_numOfFwdPackets;
+};
+
+SatStatsTerminalIndexTestCase::SatStatsTerminalIndexTestCase ()
+  : TestCase ("Test that the statistics pass the samples of each UT user to its collector.")
+{
+}
+
+SatStatsTerminalIndexTestCase::~SatStatsTerminalIndexTestCase ()
+{
+}
+
+void
+SatStatsTerminalIndexTestCase::ConnectCollectors (std::string name, CollectorMap& collectors)
+{
+  for (CollectorMap::Iterator it = collectors.Begin (); it != collectors.End (); ++it)
+    {
+      std::ostringstream context;
+      context << name << "-" << it->first;
+      it->second->TraceConnect ("Output", context.str (),
+                                MakeCallback (&SatStatsTerminalIndexTestCase::SampleCb, this));
+    }
+}
+
+void
+SatStatsTerminalIndexTestCase::SampleCb (std::string context, double oldValue, double newValue)
+{
+  m_numOfSamples[context]++;
+  m_sumOfSamples[context] += newValue;
+}
+
+void
+SatStatsTerminalIndexTestCase::RtnRxCb (Ptr<const Packet> packet, const Address &from)
+{
+  const Address ipv4Addr = InetSocketAddress::ConvertFrom (from).GetIpv4 ();
+  std::map<const Address, uint32_t>::const_iterator it = m_identifierMap.find (ipv4Addr);
+
+  if (it == m_identifierMap.end ())
+    {
+      NS_TEST_EXPECT_MSG_EQ (true, false, "Packet received from unknown address " << ipv4Addr);
+      return;
+    }
+
+  m_numOfRtnPackets[it->second]++;
+  m_numOfRtnBytes[it->second] += packet->GetSize ();
+}
+
+void
+SatStatsTerminalIndexTestCase::FwdRxCb (std::string context, Ptr<const Packet> packet, const Address &from)
+{
+  std::istringstream identifier (context);
+  uint32_t utUserId;
+  identifier >> utUserId;
+
+  m_numOfFwdPackets[utUserId]++;
+}
+
+void
+SatStatsTerminalIndexTestCase::DoRun (void)
+{
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-stats-terminal-index", "", true);
+
+  Config::SetDefault ("ns3::SatBeamHelper::FadingModel", EnumValue (SatEnums::FADING_OFF));
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+  helper->CreatePredefinedScenario (SatHelper::LARGER);
+
+  NodeContainer utUsers = helper->GetUtUsers ();
+  Ptr<Node> gwUser = helper->GetGwUsers ().Get (0);
+  uint16_t port = 9;
+
+  NS_TEST_ASSERT_MSG_EQ (utUsers.GetN (), 5, "Wrong number of UT users in the larger scenario");
+
+  PacketSinkHelper sink ("ns3::UdpSocketFactory", Address (InetSocketAddress (Ipv4Address::GetAny (), port)));
+  ApplicationContainer gwSinks = sink.Install (gwUser);
+  gwSinks.Start (Seconds (0.5));
+  gwSinks.Stop (Seconds (5.0));
+  gwSinks.Get (0)->TraceConnectWithoutContext ("Rx", MakeCallback (&SatStatsTerminalIndexTestCase::RtnRxCb, this));
+
+  const SatIdMapper *satIdMapper = Singleton<SatIdMapper>::Get ();
+
+  for (uint32_t i = 0; i < utUsers.GetN (); i++)
+    {
+      Ptr<Node> utUser = utUsers.Get (i);
+      const int32_t utUserId = satIdMapper->GetUtUserIdWithMac (satIdMapper->GetUtUserMacWithNode (utUser));
+
+      NS_TEST_ASSERT_MSG_EQ ((utUserId > 0), true, "UT user " << i << " has no identifier");
+      m_identifierMap[helper->GetUserAddress (utUser)] = utUserId;
+
+      std::ostringstream context;
+      context << utUserId;
+
+      ApplicationContainer utSink = sink.Install (utUser);
+      utSink.Start (Seconds (0.5));
+      utSink.Stop (Seconds (5.0));
+      utSink.Get (0)->TraceConnect ("Rx", context.str (), MakeCallback (&SatStatsTerminalIndexTestCase::FwdRxCb, this));
+
+      // Each user sends and receives its own amount of traffic
+      SatOnOffHelper rtnOnOff ("ns3::UdpSocketFactory", Address (InetSocketAddress (helper->GetUserAddress (gwUser), port)));
+      rtnOnOff.SetConstantRate (DataRate ("16kbps"), 100 + 60 * i);
+      ApplicationContainer rtnApp = rtnOnOff.Install (utUser);
+      rtnApp.Start (Seconds (1.0 + 0.01 * i));
+      rtnApp.Stop (Seconds (3.0));
+
+      SatOnOffHelper fwdOnOff ("ns3::UdpSocketFactory", Address (InetSocketAddress (helper->GetUserAddress (utUser), port)));
+      fwdOnOff.SetConstantRate (DataRate ("16kbps"), 400 - 60 * i);
+      ApplicationContainer fwdApp = fwdOnOff.Install (gwUser);
+      fwdApp.Start (Seconds (1.0 + 0.01 * i));
+      fwdApp.Stop (Seconds (3.0));
+    }
+
+  // The statistics enable the statistics tags of the installed applications
+  Ptr<SatStatsTestRtnAppDelayHelper> rtnDelay = CreateObject<SatStatsTestRtnAppDelayHelper> (helper);
+  Ptr<SatStatsTestFwdAppDelayHelper> fwdDelay = CreateObject<SatStatsTestFwdAppDelayHelper> (helper);
+  Ptr<SatStatsTestRtnAppThroughputHelper> rtnThroughput = CreateObject<SatStatsTestRtnAppThroughputHelper> (helper);
+
+  rtnDelay->SetName ("rtn-app-delay");
+  fwdDelay->SetName ("fwd-app-delay");
+  rtnThroughput->SetName ("rtn-app-throughput");
+
+  Ptr<SatStatsHelper> stats[] = { rtnDelay, fwdDelay, rtnThroughput };
+
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      stats[i]->SetIdentifierType (SatStatsHelper::IDENTIFIER_UT_USER);
+      stats[i]->SetOutputType (SatStatsHelper::OUTPUT_COLUMNAR_FILE);
+      stats[i]->Install ();
+    }
+
+  ConnectCollectors ("rtn-app-delay", rtnDelay->GetSampleCollectors ());
+  ConnectCollectors ("fwd-app-delay", fwdDelay->GetSampleCollectors ());
+  ConnectCollectors ("rtn-app-throughput", rtnThroughput->GetSampleCollectors ());
+
+  Simulator::Stop (Seconds (5.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_numOfRtnPackets.size (), utUsers.GetN (), "Packets not received from all the UT users");
+  NS_TEST_ASSERT_MSG_EQ (m_numOfFwdPackets.size (), utUsers.GetN (), "Packets not received by all the UT users");
+
+  for (std::map<const Address, uint32_t>::const_iterator it = m_identifierMap.begin (); it != m_identifierMap.end (); ++it)
+    {
+      std::ostringstream identifier;
+      identifier << it->second;
+
+      NS_TEST_ASSERT_MSG_EQ (m_numOfSamples["rtn-app-delay-" + identifier.str ()], m_numOfRtnPackets[it->second],
+                             "Wrong number of return link delay samples of UT user " << it->second);
+      NS_TEST_ASSERT_MSG_EQ (m_numOfSamples["fwd-app-delay-" + identifier.str ()], m_numOfFwdPackets[it->second],
+                             "Wrong number of forward link delay samples of UT user " << it->second);
+      NS_TEST_ASSERT_MSG_EQ (m_numOfSamples["rtn-app-throughput-" + identifier.str ()], m_numOfRtnPackets[it->second],
+                             "Wrong number of return link throughput samples of UT user " << it->second);
+
+      // The first-level throughput collectors convert the bytes into kilobits
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_sumOfSamples["rtn-app-throughput-" + identifier.str ()],
+                                 m_numOfRtnBytes[it->second] * 8.0 / 1000.0, 1e-9,
+                                 "Wrong return link throughput of UT user " << it->second);
+    }
+
+  Simulator::Destroy ();
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \brief Test suite for the terminal indices of the statistics.
+ */
+class SatStatsTerminalIndexTestSuite : public TestSuite
+{
+public:
+  SatStatsTerminalIndexTestSuite ();
+};
+
+SatStatsTerminalIndexTestSuite::SatStatsTerminalIndexTestSuite ()
+  : TestSuite ("sat-stats-terminal-index-test", SYSTEM)
+{
+  AddTestCase (new SatStatsTerminalIndexTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatStatsTerminalIndexTestSuite satStatsTerminalIndexTestSuite;
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+/**
+ * \file satellite-traced-mobility-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test Satellite traced mobility updates.
+ */
+
+#include <fstream>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/singleton.h"
+#include "../model/satellite-traced-mobility-model.h"
+#include "../model/satellite-traced-mobility-manager.h"
+
+using namespace ns3;
+
+static void
+SatCountCourseChanges (uint32_t *counter, Ptr<const SatMobilityModel> position)
+{
+  (*counter)++;
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check the shared update events of traced mobilities.
+ *
+ *   1.  Create three traced mobilities reading the same position trace.
+ *   2.  Change the update interval of the mobilities after their construction,
+ *       two of them to 1 second and the last one to 2 seconds.
+ *   3.  Run the simulation for 3.5 seconds.
+ *
+ *   Expected result:
+ *     The mobilities are moved to the update groups of their new interval,
+ *     the mobilities of the 1 second group are updated 3 times and the one of
+ *     the 2 seconds group once, and the positions are the ones of the trace
+ *     at the last update.
+ *
+ */
+class SatTracedMobilityTestCase : public TestCase
+{
+public:
+  SatTracedMobilityTestCase ();
+  virtual ~SatTracedMobilityTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatTracedMobilityTestCase::SatTracedMobilityTestCase ()
+  : TestCase ("Test satellite traced mobility shared updates.")
+{
+}
+
+SatTracedMobilityTestCase::~SatTracedMobilityTestCase ()
+{
+}
+
+void
+SatTracedMobilityTestCase::DoRun (void)
+{
+  const uint32_t numOfMobilities = 3;
+  const std::string fileName = CreateTempDirFilename ("positions.txt");
+
+  std::ofstream trace (fileName.c_str ());
+  for (uint32_t i = 0; i <= 10; i++)
+    {
+      trace << i << " " << i << " 10.0 0.0" << std::endl;
+    }
+  trace.close ();
+
+  SatTracedMobilityManager *manager = Singleton<SatTracedMobilityManager>::Get ();
+  Ptr<SatTracedMobilityModel> mobilities[numOfMobilities];
+  uint32_t courseChanges[numOfMobilities];
+
+  for (uint32_t i = 0; i < numOfMobilities; i++)
+    {
+      mobilities[i] = CreateObject<SatTracedMobilityModel> (fileName, Ptr<SatAntennaGainPatternContainer> ());
+      courseChanges[i] = 0;
+      mobilities[i]->TraceConnectWithoutContext ("SatCourseChange", MakeBoundCallback (&SatCountCourseChanges, &courseChanges[i]));
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (manager->GetNumOfMobilities (MilliSeconds (1)), numOfMobilities, "Mobilities not registered with the default interval");
+
+  mobilities[0]->SetAttribute ("UpdateInterval", TimeValue (Seconds (1)));
+  mobilities[1]->SetAttribute ("UpdateInterval", TimeValue (Seconds (1)));
+  mobilities[2]->SetAttribute ("UpdateInterval", TimeValue (Seconds (2)));
+
+  NS_TEST_ASSERT_MSG_EQ (manager->GetNumOfMobilities (MilliSeconds (1)), 0, "Mobilities left in the default interval group");
+  NS_TEST_ASSERT_MSG_EQ (manager->GetNumOfMobilities (Seconds (1)), 2, "Wrong number of mobilities updated every second");
+  NS_TEST_ASSERT_MSG_EQ (manager->GetNumOfMobilities (Seconds (2)), 1, "Wrong number of mobilities updated every 2 seconds");
+
+  Simulator::Stop (Seconds (3.5));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (courseChanges[0], 3, "Wrong number of updates of the first mobility");
+  NS_TEST_ASSERT_MSG_EQ (courseChanges[1], 3, "Wrong number of updates of the second mobility");
+  NS_TEST_ASSERT_MSG_EQ (courseChanges[2], 1, "Wrong number of updates of the third mobility");
+  NS_TEST_ASSERT_MSG_EQ_TOL (mobilities[0]->GetGeoPosition ().GetLatitude (), 3.0, 1e-9, "Wrong latitude of the first mobility");
+  NS_TEST_ASSERT_MSG_EQ_TOL (mobilities[2]->GetGeoPosition ().GetLatitude (), 2.0, 1e-9, "Wrong latitude of the third mobility");
+
+  for (uint32_t i = 0; i < numOfMobilities; i++)
+    {
+      mobilities[i]->Dispose ();
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (manager->GetNumOfMobilities (Seconds (1)), 0, "Disposed mobilities still updated");
+  NS_TEST_ASSERT_MSG_EQ (manager->GetNumOfMobilities (Seconds (2)), 0, "Disposed mobilities still updated");
+
+  Ptr<SatTracedMobilityModel> leftover = CreateObject<SatTracedMobilityModel> (fileName, Ptr<SatAntennaGainPatternContainer> ());
+  NS_TEST_ASSERT_MSG_EQ (manager->GetNumOfMobilities (MilliSeconds (1)), 1, "Mobility not registered with the default interval");
+
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (manager->GetNumOfMobilities (MilliSeconds (1)), 0, "Update group kept after the simulator destruction");
+}
+
+/**
+ * \brief Test suite for Satellite traced mobility unit test cases.
+ */
+class SatTracedMobilityTestSuite : public TestSuite
+{
+public:
+  SatTracedMobilityTestSuite ();
+};
+
+SatTracedMobilityTestSuite::SatTracedMobilityTestSuite ()
+  : TestSuite ("sat-traced-mobility-test", UNIT)
+{
+  AddTestCase (new SatTracedMobilityTestCase (), TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatTracedMobilityTestSuite satTracedMobilityTestSuite;
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "satellite-background-worker.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatBackgroundWorker");
+
+namespace ns3 {
+
+SatBackgroundWorker::Job::Job ()
+  : m_pending (false)
+{
+}
+
+SatBackgroundWorker::Job::~Job ()
+{
+}
+
+SatBackgroundWorker::SatBackgroundWorker ()
+  : m_stop (false)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_thread = std::thread (&SatBackgroundWorker::Run, this);
+}
+
+SatBackgroundWorker::~SatBackgroundWorker ()
+{
+  NS_LOG_FUNCTION (this);
+
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    m_stop = true;
+  }
+
+  m_jobQueued.notify_one ();
+  m_thread.join ();
+}
+
+void
+SatBackgroundWorker::Queue (Job *job)
+{
+  NS_LOG_FUNCTION (this << job);
+
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    NS_ASSERT_MSG (!job->m_pending, "Job already pending");
+    job->m_pending = true;
+    m_queue.push_back (job);
+  }
+
+  m_jobQueued.notify_one ();
+}
+
+void
+SatBackgroundWorker::WaitFor (Job *job)
+{
+  NS_LOG_FUNCTION (this << job);
+
+  std::unique_lock<std::mutex> lock (m_mutex);
+  m_jobDone.wait (lock, [job] { return !job->m_pending; });
+}
+
+void
+SatBackgroundWorker::Cancel (Job *job)
+{
+  NS_LOG_FUNCTION (this << job);
+
+  std::unique_lock<std::mutex> lock (m_mutex);
+  std::deque<Job*>::iterator it = std::find (m_queue.begin (), m_queue.end (), job);
+
+  if (it != m_queue.end ())
+    {
+      m_queue.erase (it);
+      job->m_pending = false;
+      return;
+    }
+
+  // Wait for the job if the worker thread has already taken it
+  m_jobDone.wait (lock, [job] { return !job->m_pending; });
+}
+
+void
+SatBackgroundWorker::Run ()
+{
+  NS_LOG_FUNCTION (this);
+
+  std::unique_lock<std::mutex> lock (m_mutex);
+
+  while (true)
+    {
+      m_jobQueued.wait (lock, [this] { return m_stop || !m_queue.empty (); });
+
+      if (m_queue.empty ())
+        {
+          break;
+        }
+
+      Job *job = m_queue.front ();
+      m_queue.pop_front ();
+
+      // The simulation thread does not touch the job until it is done
+      lock.unlock ();
+      job->Process ();
+      lock.lock ();
+
+      job->m_pending = false;
+      m_jobDone.notify_all ();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SAT_BACKGROUND_WORKER_H
+#define SAT_BACKGROUND_WORKER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * \brief Worker thread processing jobs queued by the simulation thread, in
+ * order. A job is queued with Queue, and the simulation thread synchronizes
+ * with WaitFor before using its results, or drops it with Cancel.
+ *
+ * Only one request per job may be pending at a time. The pending flag of a
+ * job is protected by the mutex of the worker, and the waits re-check it
+ * under this mutex, so that no notification is missed.
+ */
+class SatBackgroundWorker : public SimpleRefCount<SatBackgroundWorker>
+{
+public:
+  /**
+   * \brief Interface of the jobs processed by the worker thread
+   */
+  class Job
+  {
+  public:
+    /**
+     * \brief Constructor
+     */
+    Job ();
+
+    /**
+     * \brief Destructor
+     */
+    virtual ~Job ();
+
+    /**
+     * \brief Process the job, called on the worker thread
+     */
+    virtual void Process () = 0;
+
+  private:
+    friend class SatBackgroundWorker;
+
+    /**
+     * \brief Flag telling whether the job is queued or being processed
+     */
+    bool m_pending;
+  };
+
+  /**
+   * \brief Constructor, starts the worker thread
+   */
+  SatBackgroundWorker ();
+
+  /**
+   * \brief Destructor, stops the worker thread once the queued jobs are
+   * processed
+   */
+  ~SatBackgroundWorker ();
+
+  /**
+   * \brief Queue a job
+   * \param job job to process, which must not be pending
+   */
+  void Queue (Job *job);
+
+  /**
+   * \brief Block until the job, if pending, is processed
+   * \param job job to wait for
+   */
+  void WaitFor (Job *job);
+
+  /**
+   * \brief Drop the job if it is queued, or wait for it if it is being
+   * processed
+   * \param job job to drop
+   */
+  void Cancel (Job *job);
+
+private:
+  /**
+   * \brief Main loop of the worker thread
+   */
+  void Run ();
+
+  /**
+   * \brief Worker thread
+   */
+  std::thread m_thread;
+
+  /**
+   * \brief Mutex protecting the queue, the pending flags of the jobs and the
+   * stop flag
+   */
+  std::mutex m_mutex;
+
+  /**
+   * \brief Condition notified when a job is queued or the thread is stopped
+   */
+  std::condition_variable m_jobQueued;
+
+  /**
+   * \brief Condition notified when a job is processed
+   */
+  std::condition_variable m_jobDone;
+
+  /**
+   * \brief Jobs waiting for the worker thread
+   */
+  std::deque<Job*> m_queue;
+
+  /**
+   * \brief Flag telling the worker thread to stop
+   */
+  bool m_stop;
+};
+
+} // namespace ns3
+
+#endif /* SAT_BACKGROUND_WORKER_H */
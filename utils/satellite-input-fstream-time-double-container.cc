@@ -18,6 +18,8 @@
  * Author: Frans Laakso <frans.laakso@magister.fi>
  */
 
+#include <algorithm>
+#include <cmath>
 #include "satellite-input-fstream-time-double-container.h"
 #include "ns3/log.h"
 #include "ns3/abort.h"
@@ -39,7 +41,9 @@ SatInputFileStreamTimeDoubleContainer::GetTypeId (void)
 SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer (std::string filename, std::ios::openmode filemode, uint32_t valuesInRow)
   : m_inputFileStreamWrapper (),
   m_inputFileStream (),
-  m_container (),
+  m_columns (),
+  m_columnData (),
+  m_numOfRows (0),
   m_fileName (filename),
   m_fileMode (filemode),
   m_valuesInRow (valuesInRow),
@@ -53,10 +57,36 @@ SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer (st
   UpdateContainer (m_fileName, m_fileMode, m_valuesInRow);
 }
 
+SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer (std::string name, const double* columns, uint32_t numOfRows, uint32_t valuesInRow)
+  : m_inputFileStreamWrapper (),
+  m_inputFileStream (),
+  m_columns (),
+  m_columnData (valuesInRow),
+  m_numOfRows (numOfRows),
+  m_fileName (name),
+  m_fileMode (std::ios::in),
+  m_valuesInRow (valuesInRow),
+  m_lastValidPosition (0),
+  m_numOfPasses (0),
+  m_timeShiftValue (0),
+  m_timeColumn (0)
+{
+  NS_LOG_FUNCTION (this << m_fileName << m_numOfRows << m_valuesInRow);
+
+  for (uint32_t i = 0; i < m_valuesInRow; i++)
+    {
+      m_columnData[i] = columns + i * m_numOfRows;
+    }
+
+  CheckContainerSanity ();
+}
+
 SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer ()
   : m_inputFileStreamWrapper (),
   m_inputFileStream (),
-  m_container (),
+  m_columns (),
+  m_columnData (),
+  m_numOfRows (),
   m_fileName (),
   m_fileMode (),
   m_valuesInRow (),
@@ -95,18 +125,24 @@ SatInputFileStreamTimeDoubleContainer::UpdateContainer (std::string filename, st
   m_fileName = filename;
   m_fileMode = filemode;
   m_valuesInRow = valuesInRow;
+  m_columns.resize (m_valuesInRow);
 
   m_inputFileStreamWrapper = new SatInputFileStreamWrapper (filename, filemode);
   m_inputFileStream = m_inputFileStreamWrapper->GetStream ();
 
   if (m_inputFileStream->is_open ())
     {
-      std::vector<double> tempVector = ReadRow ();
+      std::vector<double> row (m_valuesInRow);
+      ReadRow (row);
 
       while (!m_inputFileStream->eof ())
         {
-          m_container.push_back (tempVector);
-          tempVector = ReadRow ();
+          for (uint32_t i = 0; i < m_valuesInRow; i++)
+            {
+              m_columns[i].push_back (row[i]);
+            }
+          m_numOfRows++;
+          ReadRow (row);
         }
       m_inputFileStream->close ();
     }
@@ -115,25 +151,26 @@ SatInputFileStreamTimeDoubleContainer::UpdateContainer (std::string filename, st
       NS_ABORT_MSG ("Input stream is not valid for reading.");
     }
 
+  m_columnData.resize (m_valuesInRow);
+  for (uint32_t i = 0; i < m_valuesInRow; i++)
+    {
+      m_columnData[i] = m_columns[i].empty () ? NULL : &m_columns[i][0];
+    }
+
   CheckContainerSanity ();
 
   ResetStream ();
 }
 
-std::vector<double>
-SatInputFileStreamTimeDoubleContainer::ReadRow ()
+void
+SatInputFileStreamTimeDoubleContainer::ReadRow (std::vector<double>& row)
 {
   NS_LOG_FUNCTION (this);
 
-  double tempValue;
-  std::vector<double> tempVector;
-
   for ( uint32_t i = 0; i < m_valuesInRow; i++ )
     {
-      *m_inputFileStream >> tempValue;
-      tempVector.push_back (tempValue);
+      *m_inputFileStream >> row[i];
     }
-  return tempVector;
 }
 
 void
@@ -142,34 +179,55 @@ SatInputFileStreamTimeDoubleContainer::CheckContainerSanity ()
   NS_LOG_FUNCTION (this);
 
   /// check time sample sanity
-  if (m_container.size () < 1)
+  if (m_numOfRows < 1)
     {
       NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Empty file");
     }
-  else if (m_container.size () == 1)
+  else if (m_numOfRows == 1)
     {
-      if (m_container[m_container.size () - 1].at (m_timeColumn) == 0)
+      if (GetValue (m_numOfRows - 1, m_timeColumn) == 0)
         {
           NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Invalid input file format (time sample error)");
         }
     }
   else
     {
-      double tempValue1 = m_container[0].at (m_timeColumn);
+      const double* times = GetColumn (m_timeColumn);
 
-      for (uint32_t i = 1; i < m_container.size (); i++)
+      for (uint32_t i = 1; i < m_numOfRows; i++)
         {
-          if (tempValue1 > m_container[i].at (m_timeColumn))
+          if (times[i - 1] > times[i])
             {
               NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Invalid input file format (time sample error)");
             }
-          tempValue1 = m_container[i].at (m_timeColumn);
         }
     }
 }
 
-std::vector<double>
-SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample ()
+uint32_t
+SatInputFileStreamTimeDoubleContainer::GetNumOfRows () const
+{
+  return m_numOfRows;
+}
+
+const double*
+SatInputFileStreamTimeDoubleContainer::GetColumn (uint32_t column) const
+{
+  NS_ASSERT (column < m_valuesInRow);
+
+  return m_columnData[column];
+}
+
+double
+SatInputFileStreamTimeDoubleContainer::GetValue (uint32_t row, uint32_t column) const
+{
+  NS_ASSERT (column < m_valuesInRow && row < m_numOfRows);
+
+  return m_columnData[column][row];
+}
+
+void
+SatInputFileStreamTimeDoubleContainer::ProceedToNextClosest ()
 {
   NS_LOG_FUNCTION (this);
 
@@ -177,7 +235,7 @@ SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample ()
     {
       m_lastValidPosition = 0;
       m_numOfPasses++;
-      m_timeShiftValue = m_numOfPasses * m_container[m_container.size () - 1].at (m_timeColumn);
+      m_timeShiftValue = m_numOfPasses * GetValue (m_numOfRows - 1, m_timeColumn);
 
       NS_LOG_INFO ("Looping samples again with shift value: " << m_timeShiftValue);
     }
@@ -187,110 +245,190 @@ SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample ()
       std::cout << "WARNING! - SatInputFileStreamDoubleContainer::ProceedToNextClosestTimeSample for " << m_fileName << " is out of samples @ time sample " << Now ().GetSeconds () << " (passes " << m_numOfPasses << ")" << std::endl;
       std::cout << "The container will loop samples from the beginning." << std::endl;
     }
-
-  return m_container[m_lastValidPosition];
 }
 
 std::vector<double>
-SatInputFileStreamTimeDoubleContainer::InterpolateBetweenClosestTimeSamples ()
+SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample ()
+{
+  NS_LOG_FUNCTION (this);
+
+  ProceedToNextClosest ();
+
+  std::vector<double> row (m_valuesInRow);
+  for (uint32_t i = 0; i < m_valuesInRow; i++)
+    {
+      row[i] = GetValue (m_lastValidPosition, i);
+    }
+  return row;
+}
+
+double
+SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample (uint32_t column)
+{
+  NS_LOG_FUNCTION (this << column);
+
+  ProceedToNextClosest ();
+
+  return GetValue (m_lastValidPosition, column);
+}
+
+double
+SatInputFileStreamTimeDoubleContainer::LocateInterpolationSamples (uint32_t& closestPosition)
 {
   NS_LOG_FUNCTION (this);
 
   double currentTime = Now ().GetSeconds ();
   FindNextClosest (m_lastValidPosition, m_timeShiftValue, currentTime);
 
-  std::vector<double> selectedPosition = m_container[m_lastValidPosition];
-  double selectedTime = selectedPosition.at (m_timeColumn);
+  double selectedTime = GetValue (m_lastValidPosition, m_timeColumn);
+  closestPosition = m_lastValidPosition;
 
   // Easy case: a time sample for the current time exist
   if (selectedTime == currentTime)
     {
-      return selectedPosition;
+      return 0.0;
     }
 
   // Fetch the second position to perform linear interpolation
-  std::vector<double> closestPosition;
   if (selectedTime > currentTime)
     {
       if (m_lastValidPosition == 0)
         {
           // No previous position available, abort
-          return selectedPosition;
+          return 0.0;
         }
-      closestPosition = m_container[m_lastValidPosition - 1];
+      closestPosition = m_lastValidPosition - 1;
     }
   else
     {
-      if (m_lastValidPosition == m_container.size () - 1)
+      if (m_lastValidPosition == m_numOfRows - 1)
         {
           // No next position available, abort
-          return selectedPosition;
+          return 0.0;
         }
-      closestPosition = m_container[m_lastValidPosition + 1];
+      closestPosition = m_lastValidPosition + 1;
     }
 
-  double linearCoefficient = (currentTime - selectedTime) / (closestPosition.at (m_timeColumn) - selectedTime);
-  std::size_t rowSize = selectedPosition.size ();
-  std::vector<double> interpolatedPosition (rowSize);
-  for (std::size_t i = 0; i < rowSize; ++i)
+  return (currentTime - selectedTime) / (GetValue (closestPosition, m_timeColumn) - selectedTime);
+}
+
+std::vector<double>
+SatInputFileStreamTimeDoubleContainer::InterpolateBetweenClosestTimeSamples ()
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t closestPosition;
+  double linearCoefficient = LocateInterpolationSamples (closestPosition);
+
+  std::vector<double> interpolatedPosition (m_valuesInRow);
+  for (uint32_t i = 0; i < m_valuesInRow; ++i)
     {
-      interpolatedPosition[i] = selectedPosition[i] + linearCoefficient * (closestPosition[i] - selectedPosition[i]);
+      double selectedValue = GetValue (m_lastValidPosition, i);
+      interpolatedPosition[i] = selectedValue + linearCoefficient * (GetValue (closestPosition, i) - selectedValue);
     }
 
   return interpolatedPosition;
 }
 
+double
+SatInputFileStreamTimeDoubleContainer::InterpolateBetweenClosestTimeSamples (uint32_t column)
+{
+  NS_LOG_FUNCTION (this << column);
+
+  uint32_t closestPosition;
+  double linearCoefficient = LocateInterpolationSamples (closestPosition);
+
+  double selectedValue = GetValue (m_lastValidPosition, column);
+  return selectedValue + linearCoefficient * (GetValue (closestPosition, column) - selectedValue);
+}
+
+uint32_t
+SatInputFileStreamTimeDoubleContainer::FindFirstNotBefore (uint32_t position, double timeShiftValue, double comparisonTimeValue) const
+{
+  NS_LOG_FUNCTION (this << position << timeShiftValue << comparisonTimeValue);
+
+  const double* times = GetColumn (m_timeColumn);
+  uint32_t last = std::min (m_numOfRows, position + MAX_SCANNED_SAMPLES);
+
+  /// simulation time moves forward by small steps, so the sample is usually close
+  for (uint32_t i = position; i < last; i++)
+    {
+      if (times[i] + timeShiftValue >= comparisonTimeValue)
+        {
+          return i;
+        }
+    }
+
+  uint32_t first = last;
+  uint32_t count = m_numOfRows - last;
+
+  while (count > 0)
+    {
+      uint32_t step = count / 2;
+
+      if (times[first + step] + timeShiftValue < comparisonTimeValue)
+        {
+          first += step + 1;
+          count -= step + 1;
+        }
+      else
+        {
+          count = step;
+        }
+    }
+
+  return first;
+}
+
 bool
 SatInputFileStreamTimeDoubleContainer::FindNextClosest (uint32_t lastValidPosition, double timeShiftValue, double comparisonTimeValue)
 {
   NS_LOG_FUNCTION (this);
 
   NS_ASSERT (m_timeColumn < m_valuesInRow);
-  NS_ASSERT (m_container.size () > 0);
-  NS_ASSERT (lastValidPosition >= 0 && lastValidPosition < m_container.size ());
+  NS_ASSERT (m_numOfRows > 0);
+  NS_ASSERT (lastValidPosition >= 0 && lastValidPosition < m_numOfRows);
 
   NS_LOG_INFO ("LastValidPosition " << lastValidPosition <<
                " column " << m_timeColumn <<
                " timeShiftValue " << timeShiftValue <<
                " comparisonTimeValue " << comparisonTimeValue);
 
-  bool valueFound = false;
+  const double* times = GetColumn (m_timeColumn);
 
-  for (uint32_t i = lastValidPosition; i < m_container.size (); i++)
+  uint32_t i = FindFirstNotBefore (lastValidPosition, timeShiftValue, comparisonTimeValue);
+  bool valueFound = (i < m_numOfRows);
+
+  if (valueFound)
     {
-      if (m_container[i].at (m_timeColumn) + timeShiftValue >= comparisonTimeValue)
-        {
-          double difference1 = std::abs (m_container[lastValidPosition].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
-          double difference2 = std::abs (m_container[i].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
+      uint32_t previous = (i > lastValidPosition) ? i - 1 : i;
+      double difference1 = std::abs (times[previous] + timeShiftValue - comparisonTimeValue);
+      double difference2 = std::abs (times[i] + timeShiftValue - comparisonTimeValue);
 
-          if (difference1 < difference2)
-            {
-              m_lastValidPosition = lastValidPosition;
-            }
-          else
-            {
-              m_lastValidPosition = i;
-            }
-          valueFound = true;
-          break;
+      if (difference1 < difference2)
+        {
+          m_lastValidPosition = previous;
+        }
+      else
+        {
+          m_lastValidPosition = i;
         }
-      lastValidPosition = i;
     }
 
   if (valueFound && m_numOfPasses > 0 && m_lastValidPosition == 0)
     {
-      double difference1 = std::abs (m_container[m_lastValidPosition].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
-      double difference2 = std::abs (m_container[m_container.size () - 1].at (m_timeColumn) + ((m_numOfPasses - 1) * m_container[m_container.size () - 1].at (m_timeColumn)) - comparisonTimeValue);
+      double difference1 = std::abs (times[m_lastValidPosition] + timeShiftValue - comparisonTimeValue);
+      double difference2 = std::abs (times[m_numOfRows - 1] + ((m_numOfPasses - 1) * times[m_numOfRows - 1]) - comparisonTimeValue);
 
       if (difference1 > difference2)
         {
-          m_lastValidPosition = m_container.size () - 1;
+          m_lastValidPosition = m_numOfRows - 1;
           m_numOfPasses--;
-          m_timeShiftValue = m_numOfPasses * m_container[m_container.size () - 1].at (m_timeColumn);
+          m_timeShiftValue = m_numOfPasses * times[m_numOfRows - 1];
         }
     }
 
-  NS_LOG_INFO ("Done: " << valueFound << " value: " << m_container[m_lastValidPosition].at (m_timeColumn) << " @ line: " << m_lastValidPosition + 1 << " comparison time value: " << comparisonTimeValue << " passes: " << m_numOfPasses);
+  NS_LOG_INFO ("Done: " << valueFound << " value: " << times[m_lastValidPosition] << " @ line: " << m_lastValidPosition + 1 << " comparison time value: " << comparisonTimeValue << " passes: " << m_numOfPasses);
 
   return valueFound;
 }
@@ -322,17 +460,9 @@ SatInputFileStreamTimeDoubleContainer::ClearContainer ()
 {
   NS_LOG_FUNCTION (this);
 
-  if (!m_container.empty ())
-    {
-      for (uint32_t i = 0; i < m_container.size (); i++)
-        {
-          if (!m_container[i].empty ())
-            {
-              m_container[i].clear ();
-            }
-        }
-      m_container.clear ();
-    }
+  m_columns.clear ();
+  m_columnData.clear ();
+  m_numOfRows = 0;
 
   m_valuesInRow = 0;
   m_lastValidPosition = 0;
@@ -18,6 +18,8 @@
  * Author: Frans Laakso <frans.laakso@magister.fi>
  */
 
+#include <algorithm>
+#include <cmath>
 #include "satellite-input-fstream-time-long-double-container.h"
 #include "ns3/log.h"
 #include "ns3/abort.h"
@@ -39,7 +41,8 @@ SatInputFileStreamTimeLongDoubleContainer::GetTypeId (void)
 SatInputFileStreamTimeLongDoubleContainer::SatInputFileStreamTimeLongDoubleContainer (std::string filename, std::ios::openmode filemode, uint32_t valuesInRow)
   : m_inputFileStreamWrapper (),
   m_inputFileStream (),
-  m_container (),
+  m_columns (),
+  m_numOfRows (0),
   m_fileName (filename),
   m_fileMode (filemode),
   m_valuesInRow (valuesInRow),
@@ -56,7 +59,8 @@ SatInputFileStreamTimeLongDoubleContainer::SatInputFileStreamTimeLongDoubleConta
 SatInputFileStreamTimeLongDoubleContainer::SatInputFileStreamTimeLongDoubleContainer ()
   : m_inputFileStreamWrapper (),
   m_inputFileStream (),
-  m_container (),
+  m_columns (),
+  m_numOfRows (),
   m_fileName (),
   m_fileMode (),
   m_valuesInRow (),
@@ -95,18 +99,24 @@ SatInputFileStreamTimeLongDoubleContainer::UpdateContainer (std::string filename
   m_fileName = filename;
   m_fileMode = filemode;
   m_valuesInRow = valuesInRow;
+  m_columns.resize (m_valuesInRow);
 
   m_inputFileStreamWrapper = new SatInputFileStreamWrapper (filename, filemode);
   m_inputFileStream = m_inputFileStreamWrapper->GetStream ();
 
   if (m_inputFileStream->is_open ())
     {
-      std::vector<long double> tempVector = ReadRow ();
+      std::vector<long double> row (m_valuesInRow);
+      ReadRow (row);
 
       while (!m_inputFileStream->eof ())
         {
-          m_container.push_back (tempVector);
-          tempVector = ReadRow ();
+          for (uint32_t i = 0; i < m_valuesInRow; i++)
+            {
+              m_columns[i].push_back (row[i]);
+            }
+          m_numOfRows++;
+          ReadRow (row);
         }
       m_inputFileStream->close ();
     }
@@ -120,20 +130,15 @@ SatInputFileStreamTimeLongDoubleContainer::UpdateContainer (std::string filename
   ResetStream ();
 }
 
-std::vector<long double>
-SatInputFileStreamTimeLongDoubleContainer::ReadRow ()
+void
+SatInputFileStreamTimeLongDoubleContainer::ReadRow (std::vector<long double>& row)
 {
   NS_LOG_FUNCTION (this);
 
-  long double tempValue;
-  std::vector<long double> tempVector;
-
   for ( uint32_t i = 0; i < m_valuesInRow; i++ )
     {
-      *m_inputFileStream >> tempValue;
-      tempVector.push_back (tempValue);
+      *m_inputFileStream >> row[i];
     }
-  return tempVector;
 }
 
 void
@@ -142,34 +147,55 @@ SatInputFileStreamTimeLongDoubleContainer::CheckContainerSanity ()
   NS_LOG_FUNCTION (this);
 
   /// check time sample sanity
-  if (m_container.size () < 1)
+  if (m_numOfRows < 1)
     {
       NS_FATAL_ERROR ("SatInputFileStreamTimeLongDoubleContainer::UpdateContainer - Empty file");
     }
-  else if (m_container.size () == 1)
+  else if (m_numOfRows == 1)
     {
-      if (m_container[m_container.size () - 1].at (m_timeColumn) == 0)
+      if (GetValue (m_numOfRows - 1, m_timeColumn) == 0)
         {
           NS_FATAL_ERROR ("SatInputFileStreamTimeLongDoubleContainer::UpdateContainer - Invalid input file format (time sample error)");
         }
     }
   else
     {
-      double tempValue1 = m_container[0].at (m_timeColumn);
+      const long double* times = GetColumn (m_timeColumn);
 
-      for (uint32_t i = 1; i < m_container.size (); i++)
+      for (uint32_t i = 1; i < m_numOfRows; i++)
         {
-          if (tempValue1 > m_container[i].at (m_timeColumn))
+          if (times[i - 1] > times[i])
             {
               NS_FATAL_ERROR ("SatInputFileStreamTimeLongDoubleContainer::UpdateContainer - Invalid input file format (time sample error)");
             }
-          tempValue1 = m_container[i].at (m_timeColumn);
         }
     }
 }
 
-std::vector<long double>
-SatInputFileStreamTimeLongDoubleContainer::ProceedToNextClosestTimeSample ()
+uint32_t
+SatInputFileStreamTimeLongDoubleContainer::GetNumOfRows () const
+{
+  return m_numOfRows;
+}
+
+const long double*
+SatInputFileStreamTimeLongDoubleContainer::GetColumn (uint32_t column) const
+{
+  NS_ASSERT (column < m_valuesInRow);
+
+  return &m_columns[column][0];
+}
+
+long double
+SatInputFileStreamTimeLongDoubleContainer::GetValue (uint32_t row, uint32_t column) const
+{
+  NS_ASSERT (column < m_valuesInRow && row < m_numOfRows);
+
+  return m_columns[column][row];
+}
+
+void
+SatInputFileStreamTimeLongDoubleContainer::ProceedToNextClosest ()
 {
   NS_LOG_FUNCTION (this);
 
@@ -177,7 +203,7 @@ SatInputFileStreamTimeLongDoubleContainer::ProceedToNextClosestTimeSample ()
     {
       m_lastValidPosition = 0;
       m_numOfPasses++;
-      m_timeShiftValue = m_numOfPasses * m_container[m_container.size () - 1].at (m_timeColumn);
+      m_timeShiftValue = m_numOfPasses * GetValue (m_numOfRows - 1, m_timeColumn);
 
       NS_LOG_INFO ("Looping samples again with shift value: " << m_timeShiftValue);
     }
@@ -187,110 +213,190 @@ SatInputFileStreamTimeLongDoubleContainer::ProceedToNextClosestTimeSample ()
       std::cout << "WARNING! - SatInputFileStreamTimeLongDoubleContainer::ProceedToNextClosestTimeSample for " << m_fileName << " is out of samples @ time sample " << Now ().GetSeconds () << " (passes " << m_numOfPasses << ")" << std::endl;
       std::cout << "The container will loop samples from the beginning." << std::endl;
     }
-
-  return m_container[m_lastValidPosition];
 }
 
 std::vector<long double>
-SatInputFileStreamTimeLongDoubleContainer::InterpolateBetweenClosestTimeSamples ()
+SatInputFileStreamTimeLongDoubleContainer::ProceedToNextClosestTimeSample ()
+{
+  NS_LOG_FUNCTION (this);
+
+  ProceedToNextClosest ();
+
+  std::vector<long double> row (m_valuesInRow);
+  for (uint32_t i = 0; i < m_valuesInRow; i++)
+    {
+      row[i] = GetValue (m_lastValidPosition, i);
+    }
+  return row;
+}
+
+long double
+SatInputFileStreamTimeLongDoubleContainer::ProceedToNextClosestTimeSample (uint32_t column)
+{
+  NS_LOG_FUNCTION (this << column);
+
+  ProceedToNextClosest ();
+
+  return GetValue (m_lastValidPosition, column);
+}
+
+long double
+SatInputFileStreamTimeLongDoubleContainer::LocateInterpolationSamples (uint32_t& closestPosition)
 {
   NS_LOG_FUNCTION (this);
 
   long double currentTime = Now ().GetSeconds ();
   FindNextClosest (m_lastValidPosition, m_timeShiftValue, currentTime);
 
-  std::vector<long double> selectedPosition = m_container[m_lastValidPosition];
-  long double selectedTime = selectedPosition.at (m_timeColumn);
+  long double selectedTime = GetValue (m_lastValidPosition, m_timeColumn);
+  closestPosition = m_lastValidPosition;
 
   // Easy case: a time sample for the current time exist
   if (selectedTime == currentTime)
     {
-      return selectedPosition;
+      return 0.0;
     }
 
   // Fetch the second position to perform linear interpolation
-  std::vector<long double> closestPosition;
   if (selectedTime > currentTime)
     {
       if (m_lastValidPosition == 0)
         {
           // No previous position available, abort
-          return selectedPosition;
+          return 0.0;
         }
-      closestPosition = m_container[m_lastValidPosition - 1];
+      closestPosition = m_lastValidPosition - 1;
     }
   else
     {
-      if (m_lastValidPosition == m_container.size () - 1)
+      if (m_lastValidPosition == m_numOfRows - 1)
         {
           // No next position available, abort
-          return selectedPosition;
+          return 0.0;
         }
-      closestPosition = m_container[m_lastValidPosition + 1];
+      closestPosition = m_lastValidPosition + 1;
     }
 
-  long double linearCoefficient = (currentTime - selectedTime) / (closestPosition.at (m_timeColumn) - selectedTime);
-  std::size_t rowSize = selectedPosition.size ();
-  std::vector<long double> interpolatedPosition (rowSize);
-  for (std::size_t i = 0; i < rowSize; ++i)
+  return (currentTime - selectedTime) / (GetValue (closestPosition, m_timeColumn) - selectedTime);
+}
+
+std::vector<long double>
+SatInputFileStreamTimeLongDoubleContainer::InterpolateBetweenClosestTimeSamples ()
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t closestPosition;
+  long double linearCoefficient = LocateInterpolationSamples (closestPosition);
+
+  std::vector<long double> interpolatedPosition (m_valuesInRow);
+  for (uint32_t i = 0; i < m_valuesInRow; ++i)
     {
-      interpolatedPosition[i] = selectedPosition[i] + linearCoefficient * (closestPosition[i] - selectedPosition[i]);
+      long double selectedValue = GetValue (m_lastValidPosition, i);
+      interpolatedPosition[i] = selectedValue + linearCoefficient * (GetValue (closestPosition, i) - selectedValue);
     }
 
   return interpolatedPosition;
 }
 
+long double
+SatInputFileStreamTimeLongDoubleContainer::InterpolateBetweenClosestTimeSamples (uint32_t column)
+{
+  NS_LOG_FUNCTION (this << column);
+
+  uint32_t closestPosition;
+  long double linearCoefficient = LocateInterpolationSamples (closestPosition);
+
+  long double selectedValue = GetValue (m_lastValidPosition, column);
+  return selectedValue + linearCoefficient * (GetValue (closestPosition, column) - selectedValue);
+}
+
+uint32_t
+SatInputFileStreamTimeLongDoubleContainer::FindFirstNotBefore (uint32_t position, long double timeShiftValue, long double comparisonTimeValue) const
+{
+  NS_LOG_FUNCTION (this << position << timeShiftValue << comparisonTimeValue);
+
+  const long double* times = GetColumn (m_timeColumn);
+  uint32_t last = std::min (m_numOfRows, position + MAX_SCANNED_SAMPLES);
+
+  /// simulation time moves forward by small steps, so the sample is usually close
+  for (uint32_t i = position; i < last; i++)
+    {
+      if (times[i] + timeShiftValue >= comparisonTimeValue)
+        {
+          return i;
+        }
+    }
+
+  uint32_t first = last;
+  uint32_t count = m_numOfRows - last;
+
+  while (count > 0)
+    {
+      uint32_t step = count / 2;
+
+      if (times[first + step] + timeShiftValue < comparisonTimeValue)
+        {
+          first += step + 1;
+          count -= step + 1;
+        }
+      else
+        {
+          count = step;
+        }
+    }
+
+  return first;
+}
+
 bool
 SatInputFileStreamTimeLongDoubleContainer::FindNextClosest (uint32_t lastValidPosition, long double timeShiftValue, long double comparisonTimeValue)
 {
   NS_LOG_FUNCTION (this);
 
   NS_ASSERT (m_timeColumn < m_valuesInRow);
-  NS_ASSERT (m_container.size () > 0);
-  NS_ASSERT (lastValidPosition >= 0 && lastValidPosition < m_container.size ());
+  NS_ASSERT (m_numOfRows > 0);
+  NS_ASSERT (lastValidPosition >= 0 && lastValidPosition < m_numOfRows);
 
   NS_LOG_INFO ("LastValidPosition " << lastValidPosition <<
                " column " << m_timeColumn <<
                " timeShiftValue " << timeShiftValue <<
                " comparisonTimeValue " << comparisonTimeValue);
 
-  bool valueFound = false;
+  const long double* times = GetColumn (m_timeColumn);
 
-  for (uint32_t i = lastValidPosition; i < m_container.size (); i++)
+  uint32_t i = FindFirstNotBefore (lastValidPosition, timeShiftValue, comparisonTimeValue);
+  bool valueFound = (i < m_numOfRows);
+
+  if (valueFound)
     {
-      if (m_container[i].at (m_timeColumn) + timeShiftValue >= comparisonTimeValue)
-        {
-          long double difference1 = std::abs (m_container[lastValidPosition].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
-          long double difference2 = std::abs (m_container[i].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
+      uint32_t previous = (i > lastValidPosition) ? i - 1 : i;
+      long double difference1 = std::abs (times[previous] + timeShiftValue - comparisonTimeValue);
+      long double difference2 = std::abs (times[i] + timeShiftValue - comparisonTimeValue);
 
-          if (difference1 < difference2)
-            {
-              m_lastValidPosition = lastValidPosition;
-            }
-          else
-            {
-              m_lastValidPosition = i;
-            }
-          valueFound = true;
-          break;
+      if (difference1 < difference2)
+        {
+          m_lastValidPosition = previous;
+        }
+      else
+        {
+          m_lastValidPosition = i;
         }
-      lastValidPosition = i;
     }
 
   if (valueFound && m_numOfPasses > 0 && m_lastValidPosition == 0)
     {
-      long double difference1 = std::abs (m_container[m_lastValidPosition].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
-      long double difference2 = std::abs (m_container[m_container.size () - 1].at (m_timeColumn) + ((m_numOfPasses - 1) * m_container[m_container.size () - 1].at (m_timeColumn)) - comparisonTimeValue);
+      long double difference1 = std::abs (times[m_lastValidPosition] + timeShiftValue - comparisonTimeValue);
+      long double difference2 = std::abs (times[m_numOfRows - 1] + ((m_numOfPasses - 1) * times[m_numOfRows - 1]) - comparisonTimeValue);
 
       if (difference1 > difference2)
         {
-          m_lastValidPosition = m_container.size () - 1;
+          m_lastValidPosition = m_numOfRows - 1;
           m_numOfPasses--;
-          m_timeShiftValue = m_numOfPasses * m_container[m_container.size () - 1].at (m_timeColumn);
+          m_timeShiftValue = m_numOfPasses * times[m_numOfRows - 1];
         }
     }
 
-  NS_LOG_INFO ("Done: " << valueFound << " value: " << m_container[m_lastValidPosition].at (m_timeColumn) << " @ line: " << m_lastValidPosition + 1 << " comparison time value: " << comparisonTimeValue << " passes: " << m_numOfPasses);
+  NS_LOG_INFO ("Done: " << valueFound << " value: " << times[m_lastValidPosition] << " @ line: " << m_lastValidPosition + 1 << " comparison time value: " << comparisonTimeValue << " passes: " << m_numOfPasses);
 
   return valueFound;
 }
@@ -322,17 +428,8 @@ SatInputFileStreamTimeLongDoubleContainer::ClearContainer ()
 {
   NS_LOG_FUNCTION (this);
 
-  if (!m_container.empty ())
-    {
-      for (uint32_t i = 0; i < m_container.size (); i++)
-        {
-          if (!m_container[i].empty ())
-            {
-              m_container[i].clear ();
-            }
-        }
-      m_container.clear ();
-    }
+  m_columns.clear ();
+  m_numOfRows = 0;
 
   m_valuesInRow = 0;
   m_lastValidPosition = 0;
@@ -22,6 +22,7 @@
 #define SAT_INPUT_FSTREAM_TIME_LONG_DOUBLE_CONTAINER_H
 
 #include <fstream>
+#include <vector>
 #include "ns3/object.h"
 #include "satellite-input-fstream-wrapper.h"
 
@@ -34,7 +35,11 @@ namespace ns3 {
  * The class implements reading the values from a file, storing the values
  * and iterating the stored values.
  *
- * Row format is [time, value1, ..., value n].
+ * Row format is [time, value1, ..., value n]. The values are stored column
+ * by column in contiguous arrays. The time samples are located with a
+ * cursor moving forward with the simulation time, and with a binary search
+ * when the time jumps forward by more than a few samples. The cursor never
+ * moves backwards, except when the samples are looped.
  */
 class SatInputFileStreamTimeLongDoubleContainer : public Object
 {
@@ -83,6 +88,37 @@ public:
    */
   std::vector<long double> InterpolateBetweenClosestTimeSamples ();
 
+  /**
+   * \brief Function for locating the next closest time sample and returning
+   * one of the values related to it, without copying the row
+   * \param column column of the value
+   * \return matching value
+   */
+  long double ProceedToNextClosestTimeSample (uint32_t column);
+
+  /**
+   * \brief Function for locating time samples enclosing the current time and
+   * returning the linear interpolation of one of the values between these
+   * samples, without copying the rows
+   * \param column column of the value
+   * \return linear interpolation of the value at the current time
+   */
+  long double InterpolateBetweenClosestTimeSamples (uint32_t column);
+
+  /**
+   * \brief Function for getting the number of rows in the container
+   * \return number of rows
+   */
+  uint32_t GetNumOfRows () const;
+
+  /**
+   * \brief Function for getting the values of a column. The values are
+   * valid until the container is updated.
+   * \param column column
+   * \return pointer to the GetNumOfRows () values of the column
+   */
+  const long double* GetColumn (uint32_t column) const;
+
   /**
    * \brief Do needed dispose actions
    */
@@ -106,18 +142,56 @@ private:
 
   /**
    * \brief Function for reading a row from file
-   * \return the row
+   * \param row container for the values of the row
    */
-  std::vector<long double> ReadRow ();
+  void ReadRow (std::vector<long double>& row);
 
   /**
    * \brief Function for locating the next closest value index. This locator loops the samples if the container does not have enough samples. Next closest index value is saved to a separate member variable.
    * \param lastValidPosition position of last matching value
    * \param timeShiftValue value to shift the time if needed
-   * \param comparisonValue value which next closest match to find
+   * \param comparisonTimeValue value which next closest match to find
    * \return was next time sample found
    */
-  bool FindNextClosest (uint32_t lastValidPosition, long double timeShiftValue, double long comparisonTimeValue);
+  bool FindNextClosest (uint32_t lastValidPosition, long double timeShiftValue, long double comparisonTimeValue);
+
+  /**
+   * \brief Function for finding the first time sample from the given position
+   * which is not before the given time. The samples following the position
+   * are scanned first, and searched with binary search if not found.
+   * \param position first position to consider
+   * \param timeShiftValue value to shift the time
+   * \param comparisonTimeValue time to find
+   * \return position of the time sample, number of rows if not found
+   */
+  uint32_t FindFirstNotBefore (uint32_t position, long double timeShiftValue, long double comparisonTimeValue) const;
+
+  /**
+   * \brief Function for locating the next closest time sample, looping the samples if needed
+   */
+  void ProceedToNextClosest ();
+
+  /**
+   * \brief Function for locating the time sample to interpolate with the
+   * closest time sample of the current time
+   * \param closestPosition position of the time sample to interpolate with
+   * \return linear interpolation coefficient, zero if no interpolation is needed
+   */
+  long double LocateInterpolationSamples (uint32_t& closestPosition);
+
+  /**
+   * \brief Function for getting a value
+   * \param row row
+   * \param column column
+   * \return value
+   */
+  long double GetValue (uint32_t row, uint32_t column) const;
+
+  /**
+   * \brief Number of time samples scanned from the last valid position
+   * before falling back to binary search
+   */
+  static const uint32_t MAX_SCANNED_SAMPLES = 8;
 
   /**
    * \brief Check container time sample sanity
@@ -135,9 +209,14 @@ private:
   std::ifstream* m_inputFileStream;
 
   /**
-   * \brief Container for value rows
+   * \brief Container for value columns
+   */
+  std::vector<std::vector<long double> > m_columns;
+
+  /**
+   * \brief Number of rows
    */
-  std::vector<std::vector<long double> > m_container;
+  uint32_t m_numOfRows;
 
   /**
    * \brief File name
@@ -177,4 +256,4 @@ private:
 
 } // namespace ns3
 
-#endif /* SAT_INPUT_FSTREAM_TIME_DOUBLE_CONTAINER_H */
+#endif /* SAT_INPUT_FSTREAM_TIME_LONG_DOUBLE_CONTAINER_H */
@@ -22,6 +22,11 @@
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE ("SatOutputFileStreamDoubleContainer");
 
@@ -32,7 +37,22 @@ SatOutputFileStreamDoubleContainer::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatOutputFileStreamDoubleContainer")
     .SetParent<Object> ()
-    .AddConstructor<SatOutputFileStreamDoubleContainer> ();
+    .AddConstructor<SatOutputFileStreamDoubleContainer> ()
+    .AddAttribute ("StreamingOutput",
+                   "Write the values to the file during the simulation instead of storing them until the container is written.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatOutputFileStreamDoubleContainer::m_streamingOutput),
+                   MakeBooleanChecker ())
+    .AddAttribute ("StreamingBlockSize",
+                   "Size of the blocks of text handed to the writer thread in streaming mode [bytes].",
+                   UintegerValue (65536),
+                   MakeUintegerAccessor (&SatOutputFileStreamDoubleContainer::m_streamingBlockSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("CompressOutput",
+                   "Compress the output of the streaming mode with zlib.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatOutputFileStreamDoubleContainer::m_compressOutput),
+                   MakeBooleanChecker ());
   return tid;
 }
 
@@ -40,6 +60,12 @@ SatOutputFileStreamDoubleContainer::SatOutputFileStreamDoubleContainer (std::str
   : m_outputFileStreamWrapper (),
   m_outputFileStream (),
   m_container (),
+  m_streamingOutput (false),
+  m_streamingBlockSize (65536),
+  m_compressOutput (false),
+  m_writer (),
+  m_block (),
+  m_writtenFileName (),
   m_fileName (filename),
   m_fileMode (filemode),
   m_valuesInRow (valuesInRow),
@@ -59,6 +85,12 @@ SatOutputFileStreamDoubleContainer::SatOutputFileStreamDoubleContainer ()
   : m_outputFileStreamWrapper (),
   m_outputFileStream (),
   m_container (),
+  m_streamingOutput (),
+  m_streamingBlockSize (),
+  m_compressOutput (),
+  m_writer (),
+  m_block (),
+  m_writtenFileName (),
   m_fileName (),
   m_fileMode (),
   m_valuesInRow (),
@@ -91,30 +123,42 @@ SatOutputFileStreamDoubleContainer::WriteContainerToFile ()
 {
   NS_LOG_FUNCTION (this);
 
-  OpenStream ();
+  if (m_streamingOutput)
+    {
+      CloseWriter ();
 
-  if (m_outputFileStream->is_open ())
+      if (m_printFigure)
+        {
+          ReadWrittenFile ();
+        }
+    }
+  else
     {
-      for (uint32_t i = 0; i < m_container.size (); i++)
+      OpenStream ();
+
+      if (m_outputFileStream->is_open ())
         {
-          for (uint32_t j = 0; j < m_valuesInRow; j++ )
+          for (uint32_t i = 0; i < m_container.size (); i++)
             {
-              if (j + 1 == m_valuesInRow)
+              for (uint32_t j = 0; j < m_valuesInRow; j++ )
                 {
-                  *m_outputFileStream << m_container[i].at (j);
-                }
-              else
-                {
-                  *m_outputFileStream << m_container[i].at (j) << "\t";
+                  if (j + 1 == m_valuesInRow)
+                    {
+                      *m_outputFileStream << m_container[i].at (j);
+                    }
+                  else
+                    {
+                      *m_outputFileStream << m_container[i].at (j) << "\t";
+                    }
                 }
+              *m_outputFileStream << std::endl;
             }
-          *m_outputFileStream << std::endl;
+          m_outputFileStream->close ();
+        }
+      else
+        {
+          NS_ABORT_MSG ("Output stream is not valid for writing.");
         }
-      m_outputFileStream->close ();
-    }
-  else
-    {
-      NS_ABORT_MSG ("Output stream is not valid for writing.");
     }
 
   if (m_printFigure)
@@ -159,7 +203,81 @@ SatOutputFileStreamDoubleContainer::AddToContainer (std::vector<double> newItem)
       NS_FATAL_ERROR ("SatOutputFileStreamDoubleContainer::AddToContainer - Invalid vector size");
     }
 
-  m_container.push_back (newItem);
+  if (m_streamingOutput)
+    {
+      AppendToBlock (newItem);
+    }
+  else
+    {
+      m_container.push_back (newItem);
+    }
+}
+
+void
+SatOutputFileStreamDoubleContainer::AppendToBlock (const std::vector<double>& newItem)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_writer == NULL)
+    {
+      m_writer = Create<SatOutputFileStreamWriter> (m_fileName, m_fileMode, m_compressOutput);
+      m_writtenFileName = m_writer->GetFileName ();
+      m_block.reserve (m_streamingBlockSize + 256);
+    }
+
+  char value[64];
+
+  for (uint32_t j = 0; j < m_valuesInRow; j++)
+    {
+      // Same format as the default format of the output streams
+      int length = snprintf (value, sizeof (value), "%g", newItem[j]);
+      m_block.append (value, std::min<int> (length, sizeof (value) - 1));
+      m_block.push_back ((j + 1 == m_valuesInRow) ? '\n' : '\t');
+    }
+
+  if (m_block.size () >= m_streamingBlockSize)
+    {
+      m_writer->Write (m_block);
+    }
+}
+
+void
+SatOutputFileStreamDoubleContainer::CloseWriter ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_writer == NULL)
+    {
+      m_writer = Create<SatOutputFileStreamWriter> (m_fileName, m_fileMode, m_compressOutput);
+      m_writtenFileName = m_writer->GetFileName ();
+    }
+
+  m_writer->Write (m_block);
+  m_writer->Close ();
+  m_writer = 0;
+}
+
+void
+SatOutputFileStreamDoubleContainer::ReadWrittenFile ()
+{
+  NS_LOG_FUNCTION (this);
+
+  std::istringstream stream (SatOutputFileStreamWriter::ReadFile (m_writtenFileName, m_compressOutput));
+  std::vector<double> row (m_valuesInRow);
+
+  while (true)
+    {
+      for (uint32_t j = 0; j < m_valuesInRow; j++)
+        {
+          stream >> row[j];
+        }
+
+      if (!stream)
+        {
+          break;
+        }
+      m_container.push_back (row);
+    }
 }
 
 void
@@ -192,6 +310,15 @@ SatOutputFileStreamDoubleContainer::ResetStream ()
     }
   m_outputFileStream = 0;
 
+  if (m_writer != NULL)
+    {
+      m_writer->Write (m_block);
+      m_writer->Close ();
+      m_writer = 0;
+    }
+  m_block.clear ();
+  m_writtenFileName = "";
+
   m_fileName = "";
   m_fileMode = std::ofstream::out;
 }
@@ -24,6 +24,7 @@
 #include <fstream>
 #include "ns3/object.h"
 #include "satellite-output-fstream-wrapper.h"
+#include "satellite-output-fstream-writer.h"
 #include <ns3/gnuplot.h>
 
 namespace ns3 {
@@ -34,6 +35,10 @@ namespace ns3 {
  * \brief Class for output file stream container for long double values.
  * The class implements storing the values and writing the stored
  * values into a file. A figure output in two dimensions is also supported.
+ *
+ * In streaming mode, the values are not stored but formatted into blocks of
+ * text, which are written to the file by a SatOutputFileStreamWriter during
+ * the simulation. The figure is then created from the written file.
  */
 class SatOutputFileStreamLongDoubleContainer : public Object
 {
@@ -115,6 +120,25 @@ private:
    */
   void OpenStream ();
 
+  /**
+   * \brief Function for appending a row to the block of the streaming mode,
+   * handing the block to the writer when full
+   * \param newItem row
+   */
+  void AppendToBlock (const std::vector<long double>& newItem);
+
+  /**
+   * \brief Function for writing the last block of the streaming mode and
+   * closing the writer
+   */
+  void CloseWriter ();
+
+  /**
+   * \brief Function for reading the values written in streaming mode back
+   * into the container
+   */
+  void ReadWrittenFile ();
+
   /**
    * \brief Function for printing the container contents into a figure
    */
@@ -154,6 +178,36 @@ private:
    */
   std::vector<std::vector<long double> > m_container;
 
+  /**
+   * \brief Write the values during the simulation instead of storing them
+   */
+  bool m_streamingOutput;
+
+  /**
+   * \brief Size of the blocks handed to the writer in streaming mode
+   */
+  uint32_t m_streamingBlockSize;
+
+  /**
+   * \brief Compress the output of the streaming mode
+   */
+  bool m_compressOutput;
+
+  /**
+   * \brief Writer of the streaming mode, created with the first values
+   */
+  Ptr<SatOutputFileStreamWriter> m_writer;
+
+  /**
+   * \brief Block being filled in streaming mode
+   */
+  std::string m_block;
+
+  /**
+   * \brief Name of the file written in streaming mode
+   */
+  std::string m_writtenFileName;
+
   /**
    * \brief File name
    */
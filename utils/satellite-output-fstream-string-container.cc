@@ -22,6 +22,8 @@
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatOutputFileStreamStringContainer");
 
@@ -32,7 +34,22 @@ SatOutputFileStreamStringContainer::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatOutputFileStreamStringContainer")
     .SetParent<Object> ()
-    .AddConstructor<SatOutputFileStreamStringContainer> ();
+    .AddConstructor<SatOutputFileStreamStringContainer> ()
+    .AddAttribute ("StreamingOutput",
+                   "Write the lines to the file during the simulation instead of storing them until the container is written.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatOutputFileStreamStringContainer::m_streamingOutput),
+                   MakeBooleanChecker ())
+    .AddAttribute ("StreamingBlockSize",
+                   "Size of the blocks of text handed to the writer thread in streaming mode [bytes].",
+                   UintegerValue (65536),
+                   MakeUintegerAccessor (&SatOutputFileStreamStringContainer::m_streamingBlockSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("CompressOutput",
+                   "Compress the output of the streaming mode with zlib.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatOutputFileStreamStringContainer::m_compressOutput),
+                   MakeBooleanChecker ());
   return tid;
 }
 
@@ -40,6 +57,11 @@ SatOutputFileStreamStringContainer::SatOutputFileStreamStringContainer (std::str
   : m_outputFileStreamWrapper (),
   m_outputFileStream (),
   m_container (),
+  m_streamingOutput (false),
+  m_streamingBlockSize (65536),
+  m_compressOutput (false),
+  m_writer (),
+  m_block (),
   m_fileName (filename),
   m_fileMode (filemode)
 {
@@ -50,6 +72,11 @@ SatOutputFileStreamStringContainer::SatOutputFileStreamStringContainer ()
   : m_outputFileStreamWrapper (),
   m_outputFileStream (),
   m_container (),
+  m_streamingOutput (),
+  m_streamingBlockSize (),
+  m_compressOutput (),
+  m_writer (),
+  m_block (),
   m_fileName (),
   m_fileMode ()
 {
@@ -78,19 +105,26 @@ SatOutputFileStreamStringContainer::WriteContainerToFile ()
 {
   NS_LOG_FUNCTION (this);
 
-  OpenStream ();
-
-  if (m_outputFileStream->is_open ())
+  if (m_streamingOutput)
     {
-      for (uint32_t i = 0; i < m_container.size (); i++)
-        {
-          *m_outputFileStream <<  m_container[i] << std::endl;
-        }
-      m_outputFileStream->close ();
+      CloseWriter ();
     }
   else
     {
-      NS_ABORT_MSG ("Output stream is not valid for writing.");
+      OpenStream ();
+
+      if (m_outputFileStream->is_open ())
+        {
+          for (uint32_t i = 0; i < m_container.size (); i++)
+            {
+              *m_outputFileStream <<  m_container[i] << std::endl;
+            }
+          m_outputFileStream->close ();
+        }
+      else
+        {
+          NS_ABORT_MSG ("Output stream is not valid for writing.");
+        }
     }
 
   Reset ();
@@ -101,7 +135,40 @@ SatOutputFileStreamStringContainer::AddToContainer (std::string newLine)
 {
   NS_LOG_FUNCTION (this);
 
-  m_container.push_back (newLine);
+  if (!m_streamingOutput)
+    {
+      m_container.push_back (newLine);
+      return;
+    }
+
+  if (m_writer == NULL)
+    {
+      m_writer = Create<SatOutputFileStreamWriter> (m_fileName, m_fileMode, m_compressOutput);
+      m_block.reserve (m_streamingBlockSize + newLine.size () + 1);
+    }
+
+  m_block.append (newLine);
+  m_block.push_back ('\n');
+
+  if (m_block.size () >= m_streamingBlockSize)
+    {
+      m_writer->Write (m_block);
+    }
+}
+
+void
+SatOutputFileStreamStringContainer::CloseWriter ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_writer == NULL)
+    {
+      m_writer = Create<SatOutputFileStreamWriter> (m_fileName, m_fileMode, m_compressOutput);
+    }
+
+  m_writer->Write (m_block);
+  m_writer->Close ();
+  m_writer = 0;
 }
 
 void
@@ -134,6 +201,14 @@ SatOutputFileStreamStringContainer::ResetStream ()
     }
   m_outputFileStream = 0;
 
+  if (m_writer != NULL)
+    {
+      m_writer->Write (m_block);
+      m_writer->Close ();
+      m_writer = 0;
+    }
+  m_block.clear ();
+
   m_fileName = "";
   m_fileMode = std::ofstream::out;
 }
@@ -24,6 +24,7 @@
 #include <fstream>
 #include "ns3/object.h"
 #include "satellite-output-fstream-wrapper.h"
+#include "satellite-output-fstream-writer.h"
 #include <ns3/gnuplot.h>
 
 namespace ns3 {
@@ -34,6 +35,10 @@ namespace ns3 {
  * \brief Class for output file stream container for strings.
  * The class implements storing the values and writing the stored
  * values into a file.
+ *
+ * In streaming mode, the lines are not stored but collected into blocks,
+ * which are written to the file by a SatOutputFileStreamWriter during the
+ * simulation.
  */
 class SatOutputFileStreamStringContainer : public Object
 {
@@ -97,6 +102,12 @@ private:
    */
   void OpenStream ();
 
+  /**
+   * \brief Function for writing the last block of the streaming mode and
+   * closing the writer
+   */
+  void CloseWriter ();
+
   /**
    * \brief Pointer to output file stream wrapper
    */
@@ -112,6 +123,31 @@ private:
    */
   std::vector<std::string > m_container;
 
+  /**
+   * \brief Write the lines during the simulation instead of storing them
+   */
+  bool m_streamingOutput;
+
+  /**
+   * \brief Size of the blocks handed to the writer in streaming mode
+   */
+  uint32_t m_streamingBlockSize;
+
+  /**
+   * \brief Compress the output of the streaming mode
+   */
+  bool m_compressOutput;
+
+  /**
+   * \brief Writer of the streaming mode, created with the first line
+   */
+  Ptr<SatOutputFileStreamWriter> m_writer;
+
+  /**
+   * \brief Block being filled in streaming mode
+   */
+  std::string m_block;
+
   /**
    * \brief File name
    */
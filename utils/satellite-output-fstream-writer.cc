@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <sstream>
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "satellite-output-fstream-wrapper.h"
+#include "satellite-output-fstream-writer.h"
+
+#ifdef ENABLE_ZLIB
+#include <zlib.h>
+#endif
+
+NS_LOG_COMPONENT_DEFINE ("SatOutputFileStreamWriter");
+
+namespace ns3 {
+
+Ptr<SatBackgroundWorker> SatOutputFileStreamWriter::m_writerThread;
+uint32_t SatOutputFileStreamWriter::m_numOfWriters = 0;
+
+SatOutputFileStreamWriter::SatOutputFileStreamWriter (std::string fileName, std::ios::openmode fileMode, bool compress)
+  : m_pendingBlock (),
+  m_writeError (false),
+  m_closed (false),
+  m_fileName (fileName),
+  m_outputFileStreamWrapper (),
+  m_gzFile ()
+{
+  NS_LOG_FUNCTION (this << fileName << fileMode << compress);
+
+  if (compress)
+    {
+#ifdef ENABLE_ZLIB
+      m_fileName = fileName + ".gz";
+      m_gzFile = gzopen (m_fileName.c_str (), (fileMode & std::ios::app) ? "ab" : "wb");
+
+      NS_ABORT_MSG_UNLESS (m_gzFile != NULL, "SatOutputFileStreamWriter::SatOutputFileStreamWriter - Unable to open " << m_fileName);
+#else
+      NS_FATAL_ERROR ("SatOutputFileStreamWriter::SatOutputFileStreamWriter - Compressed output requires zlib");
+#endif
+    }
+  else
+    {
+      m_outputFileStreamWrapper = new SatOutputFileStreamWrapper (m_fileName, fileMode);
+    }
+
+  if (m_numOfWriters++ == 0)
+    {
+      m_writerThread = Create<SatBackgroundWorker> ();
+    }
+}
+
+SatOutputFileStreamWriter::~SatOutputFileStreamWriter ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Close ();
+}
+
+void
+SatOutputFileStreamWriter::Write (std::string& block)
+{
+  NS_LOG_FUNCTION (this << block.size ());
+
+  NS_ASSERT_MSG (!m_closed, "Writer already closed");
+
+  m_writerThread->WaitFor (this);
+  CheckWriteError ();
+
+  m_pendingBlock.swap (block);
+  m_writerThread->Queue (this);
+}
+
+void
+SatOutputFileStreamWriter::Close ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_closed)
+    {
+      return;
+    }
+
+  m_writerThread->WaitFor (this);
+  m_closed = true;
+
+  if (--m_numOfWriters == 0)
+    {
+      m_writerThread = 0;
+    }
+
+  CheckWriteError ();
+
+  if (m_outputFileStreamWrapper != NULL)
+    {
+      std::ofstream *stream = m_outputFileStreamWrapper->GetStream ();
+      stream->close ();
+      bool failed = stream->fail ();
+      delete m_outputFileStreamWrapper;
+      m_outputFileStreamWrapper = 0;
+
+      NS_ABORT_MSG_IF (failed, "SatOutputFileStreamWriter::Close - Unable to close " << m_fileName);
+    }
+
+#ifdef ENABLE_ZLIB
+  if (m_gzFile != NULL)
+    {
+      int status = gzclose (static_cast<gzFile> (m_gzFile));
+      m_gzFile = 0;
+
+      NS_ABORT_MSG_IF (status != Z_OK, "SatOutputFileStreamWriter::Close - Unable to close " << m_fileName << " (zlib error " << status << ")");
+    }
+#endif
+}
+
+std::string
+SatOutputFileStreamWriter::GetFileName () const
+{
+  return m_fileName;
+}
+
+bool
+SatOutputFileStreamWriter::IsCompressionSupported ()
+{
+#ifdef ENABLE_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::string
+SatOutputFileStreamWriter::ReadFile (std::string fileName, bool compressed)
+{
+  NS_LOG_FUNCTION (fileName << compressed);
+
+  std::string contents;
+
+  if (compressed)
+    {
+#ifdef ENABLE_ZLIB
+      gzFile file = gzopen (fileName.c_str (), "rb");
+
+      NS_ABORT_MSG_UNLESS (file != NULL, "SatOutputFileStreamWriter::ReadFile - Unable to open " << fileName);
+
+      char buffer[16384];
+      int bytes;
+
+      while ((bytes = gzread (file, buffer, sizeof (buffer))) > 0)
+        {
+          contents.append (buffer, bytes);
+        }
+      gzclose (file);
+#else
+      NS_FATAL_ERROR ("SatOutputFileStreamWriter::ReadFile - Compressed output requires zlib");
+#endif
+    }
+  else
+    {
+      std::ifstream file (fileName.c_str ());
+
+      NS_ABORT_MSG_UNLESS (file.is_open (), "SatOutputFileStreamWriter::ReadFile - Unable to open " << fileName);
+
+      std::ostringstream stream;
+      stream << file.rdbuf ();
+      contents = stream.str ();
+    }
+
+  return contents;
+}
+
+void
+SatOutputFileStreamWriter::Process ()
+{
+  if (m_outputFileStreamWrapper != NULL)
+    {
+      std::ofstream *stream = m_outputFileStreamWrapper->GetStream ();
+      stream->write (m_pendingBlock.data (), m_pendingBlock.size ());
+
+      if (!stream->good ())
+        {
+          m_writeError = true;
+        }
+    }
+
+#ifdef ENABLE_ZLIB
+  if (m_gzFile != NULL && !m_pendingBlock.empty ())
+    {
+      // gzwrite returns the number of uncompressed bytes written, or 0 on error
+      int written = gzwrite (static_cast<gzFile> (m_gzFile), m_pendingBlock.data (), m_pendingBlock.size ());
+
+      if (written != (int)m_pendingBlock.size ())
+        {
+          m_writeError = true;
+        }
+    }
+#endif
+
+  m_pendingBlock.clear ();
+}
+
+void
+SatOutputFileStreamWriter::CheckWriteError () const
+{
+  NS_ABORT_MSG_IF (m_writeError, "SatOutputFileStreamWriter - Unable to write " << m_fileName << ", the output is truncated");
+}
+
+} // namespace ns3
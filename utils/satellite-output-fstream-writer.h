@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SAT_OUTPUT_FSTREAM_WRITER_H
+#define SAT_OUTPUT_FSTREAM_WRITER_H
+
+#include <fstream>
+#include <string>
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "satellite-background-worker.h"
+
+namespace ns3 {
+
+class SatOutputFileStreamWrapper;
+
+/**
+ * \ingroup satellite
+ *
+ * \brief Background writer of output file streams. The simulation thread
+ * fills a block of text and hands it over with Write, while a writer thread
+ * writes the previous block to the file. The two blocks are swapped so that
+ * their memory is reused, and the simulation thread only waits when the
+ * writer thread has not yet written the previous block.
+ *
+ * All the writers share a single writer thread, which takes the handed over
+ * blocks from a queue in order. The thread is started with the first writer
+ * and stopped when the last one is closed, so that the number of threads
+ * does not grow with the number of written files.
+ *
+ * Write failures are detected by the writer thread and reported with a
+ * fatal error on the simulation thread by the following Write or Close.
+ *
+ * The output may be compressed with zlib, in which case ".gz" is appended
+ * to the file name. Compression is only available when the module is built
+ * with zlib.
+ */
+class SatOutputFileStreamWriter : public SimpleRefCount<SatOutputFileStreamWriter>,
+                                  private SatBackgroundWorker::Job
+{
+public:
+  /**
+   * \brief Constructor, opens the file and starts the writer thread if no
+   * other writer exists
+   * \param fileName file name
+   * \param fileMode file mode
+   * \param compress compress the output with zlib
+   */
+  SatOutputFileStreamWriter (std::string fileName, std::ios::openmode fileMode, bool compress);
+
+  /**
+   * \brief Destructor, closes the file if not already closed
+   */
+  ~SatOutputFileStreamWriter ();
+
+  /**
+   * \brief Hand a block over to the writer thread
+   * \param block block to write, replaced by an empty block
+   */
+  void Write (std::string& block);
+
+  /**
+   * \brief Wait for the pending block to be written and close the file
+   */
+  void Close ();
+
+  /**
+   * \brief Function for getting the name of the written file
+   * \return file name, including the compression suffix
+   */
+  std::string GetFileName () const;
+
+  /**
+   * \brief Function for checking whether the output can be compressed
+   * \return true if the module is built with zlib
+   */
+  static bool IsCompressionSupported ();
+
+  /**
+   * \brief Function for reading back the contents of a written file
+   * \param fileName name of the written file
+   * \param compressed whether the file is compressed
+   * \return contents of the file
+   */
+  static std::string ReadFile (std::string fileName, bool compressed);
+
+private:
+  /**
+   * \brief Write the pending block to the file, called on the writer thread
+   */
+  virtual void Process ();
+
+  /**
+   * \brief Abort the simulation if the writer thread failed to write a block
+   */
+  void CheckWriteError () const;
+
+  /**
+   * \brief Writer thread shared by all the writers, released with the last one
+   */
+  static Ptr<SatBackgroundWorker> m_writerThread;
+
+  /**
+   * \brief Number of writers not yet closed
+   */
+  static uint32_t m_numOfWriters;
+
+  /**
+   * \brief Block handed over to the writer thread. It is only accessed by
+   * the writer thread while the block is pending.
+   */
+  std::string m_pendingBlock;
+
+  /**
+   * \brief Flag telling whether a block could not be written. It is set by
+   * the writer thread while the block is pending.
+   */
+  bool m_writeError;
+
+  /**
+   * \brief Flag telling whether the file is closed
+   */
+  bool m_closed;
+
+  /**
+   * \brief Name of the written file
+   */
+  std::string m_fileName;
+
+  /**
+   * \brief Output file stream of the uncompressed output
+   */
+  SatOutputFileStreamWrapper* m_outputFileStreamWrapper;
+
+  /**
+   * \brief zlib file of the compressed output, kept opaque so that the
+   * header does not depend on zlib
+   */
+  void* m_gzFile;
+};
+
+} // namespace ns3
+
+#endif /* SAT_OUTPUT_FSTREAM_WRITER_H */
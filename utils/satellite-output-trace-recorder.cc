@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include "satellite-output-trace-recorder.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatOutputTraceRecorder");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatOutputTraceRecorder);
+
+const char SatOutputTraceRecorder::MAGIC[8] = { 'S', 'A', 'T', 'R', 'E', 'C', '1', '\0' };
+
+TypeId
+SatOutputTraceRecorder::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatOutputTraceRecorder")
+    .SetParent<Object> ()
+    .AddConstructor<SatOutputTraceRecorder> ();
+  return tid;
+}
+
+SatOutputTraceRecorder::SatOutputTraceRecorder (std::string fileName, Time interval, uint32_t decimation, uint32_t bufferedRecords)
+  : m_fileName (fileName),
+  m_textFileName (),
+  m_stream (),
+  m_interval (interval.GetSeconds ()),
+  m_decimation (std::max (decimation, (uint32_t) 1)),
+  m_samples (0),
+  m_currentInterval (-1),
+  m_current (),
+  m_buffer (),
+  m_bufferedRecords (std::max (bufferedRecords, (uint32_t) 1))
+{
+  NS_LOG_FUNCTION (this << m_fileName << m_interval << m_decimation << m_bufferedRecords);
+
+  m_stream.open (m_fileName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+
+  if (!m_stream.is_open ())
+    {
+      NS_FATAL_ERROR ("SatOutputTraceRecorder::SatOutputTraceRecorder - Unable to open " << m_fileName);
+    }
+
+  Header_t header;
+  std::memset (&header, 0, sizeof (Header_t));
+  std::copy (MAGIC, MAGIC + sizeof (MAGIC), header.m_magic);
+  header.m_interval = m_interval;
+  header.m_decimation = m_decimation;
+
+  m_stream.write ((const char*)&header, sizeof (Header_t));
+  m_buffer.reserve (m_bufferedRecords);
+}
+
+SatOutputTraceRecorder::SatOutputTraceRecorder ()
+  : m_fileName (),
+  m_textFileName (),
+  m_stream (),
+  m_interval (),
+  m_decimation (),
+  m_samples (),
+  m_currentInterval (),
+  m_current (),
+  m_buffer (),
+  m_bufferedRecords ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_FATAL_ERROR ("SatOutputTraceRecorder::SatOutputTraceRecorder - Constructor not in use");
+}
+
+SatOutputTraceRecorder::~SatOutputTraceRecorder ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Close ();
+}
+
+void
+SatOutputTraceRecorder::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Close ();
+  Object::DoDispose ();
+}
+
+void
+SatOutputTraceRecorder::EnableTextOutput (std::string textFileName)
+{
+  NS_LOG_FUNCTION (this << textFileName);
+
+  m_textFileName = textFileName;
+}
+
+void
+SatOutputTraceRecorder::AddSample (double time, double value)
+{
+  NS_LOG_FUNCTION (this << time << value);
+
+  if (m_samples++ % m_decimation != 0)
+    {
+      return;
+    }
+
+  if (m_interval <= 0.0)
+    {
+      Record_t record;
+      record.m_time = time;
+      record.m_min = value;
+      record.m_max = value;
+      record.m_mean = value;
+      record.m_count = 1;
+
+      m_buffer.push_back (record);
+    }
+  else
+    {
+      int64_t interval = (int64_t) std::floor (time / m_interval);
+
+      if (interval != m_currentInterval)
+        {
+          CloseInterval ();
+
+          m_currentInterval = interval;
+          m_current.m_time = interval * m_interval;
+          m_current.m_min = value;
+          m_current.m_max = value;
+          m_current.m_mean = 0.0;
+          m_current.m_count = 0;
+        }
+
+      // the mean field holds the sum until the interval is closed
+      m_current.m_min = std::min (m_current.m_min, value);
+      m_current.m_max = std::max (m_current.m_max, value);
+      m_current.m_mean += value;
+      m_current.m_count++;
+    }
+
+  if (m_buffer.size () >= m_bufferedRecords)
+    {
+      Flush ();
+    }
+}
+
+uint32_t
+SatOutputTraceRecorder::GetNumOfBufferedRecords () const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_buffer.size ();
+}
+
+void
+SatOutputTraceRecorder::CloseInterval ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_currentInterval >= 0 && m_current.m_count > 0)
+    {
+      Record_t record = m_current;
+      record.m_mean /= record.m_count;
+      m_buffer.push_back (record);
+    }
+
+  m_currentInterval = -1;
+}
+
+void
+SatOutputTraceRecorder::Flush ()
+{
+  NS_LOG_FUNCTION (this << m_buffer.size ());
+
+  if (!m_buffer.empty () && m_stream.is_open ())
+    {
+      m_stream.write ((const char*)&m_buffer[0], m_buffer.size () * sizeof (Record_t));
+    }
+
+  m_buffer.clear ();
+}
+
+void
+SatOutputTraceRecorder::Close ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_stream.is_open ())
+    {
+      return;
+    }
+
+  CloseInterval ();
+  Flush ();
+  m_stream.close ();
+
+  if (!m_textFileName.empty ())
+    {
+      ExportToText (m_fileName, m_textFileName);
+    }
+}
+
+void
+SatOutputTraceRecorder::ExportToText (std::string binaryFileName, std::string textFileName)
+{
+  NS_LOG_FUNCTION (binaryFileName << textFileName);
+
+  std::ifstream input (binaryFileName.c_str (), std::ios::in | std::ios::binary);
+
+  if (!input.is_open ())
+    {
+      NS_FATAL_ERROR ("SatOutputTraceRecorder::ExportToText - Unable to open " << binaryFileName);
+    }
+
+  Header_t header;
+  input.read ((char*)&header, sizeof (Header_t));
+
+  if (!input.good () || !std::equal (MAGIC, MAGIC + sizeof (MAGIC), header.m_magic))
+    {
+      NS_FATAL_ERROR ("SatOutputTraceRecorder::ExportToText - " << binaryFileName << " is not a trace recorder output");
+    }
+
+  std::ofstream output (textFileName.c_str (), std::ios::out | std::ios::trunc);
+
+  if (!output.is_open ())
+    {
+      NS_ABORT_MSG ("Output stream is not valid for writing.");
+    }
+
+  Record_t record;
+
+  // Same two columns as the other output traces, the minimum, maximum and
+  // count of the aggregated intervals are only in the binary output
+  while (input.read ((char*)&record, sizeof (Record_t)))
+    {
+      output << record.m_time << "\t" << record.m_mean << std::endl;
+    }
+
+  output.close ();
+  input.close ();
+}
+
+} // namespace ns3
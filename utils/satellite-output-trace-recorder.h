@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2018 CNES
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathias Ettinger <mettinger@toulouse.viveris.com>
+ */
+
+#ifndef SAT_OUTPUT_TRACE_RECORDER_H
+#define SAT_OUTPUT_TRACE_RECORDER_H
+
+#include <fstream>
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * \brief Fixed memory recorder for time series output traces, e.g. fading
+ * or interference. Unlike SatOutputFileStreamDoubleContainer, which stores
+ * every sample until the end of the simulation, the recorder keeps only a
+ * small buffer of records and streams them to a binary file.
+ *
+ * Samples may be decimated (only every Nth sample is recorded) and aggregated
+ * into fixed time intervals, in which case one record holding the minimum,
+ * maximum and mean of the samples is written per interval. The binary file
+ * can be converted to text with ExportToText, which is done automatically
+ * when a text file name is given. The text output has the two columns of the
+ * other output traces, time and value, the value of an aggregated interval
+ * being the mean of its samples.
+ */
+class SatOutputTraceRecorder : public Object
+{
+public:
+  /**
+   * \brief Record of the binary output. Without aggregation, the minimum,
+   * maximum and mean are the value of a single sample.
+   */
+  typedef struct
+  {
+    double m_time;
+    double m_min;
+    double m_max;
+    double m_mean;
+    uint64_t m_count;
+  } Record_t;
+
+  /**
+   * \brief NS-3 function for type id
+   * \return type id
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Constructor
+   * \param fileName binary output file name
+   * \param interval aggregation interval, zero to record the samples as such
+   * \param decimation only every decimation-th sample is recorded
+   * \param bufferedRecords number of records buffered before being written
+   */
+  SatOutputTraceRecorder (std::string fileName, Time interval, uint32_t decimation, uint32_t bufferedRecords);
+
+  /**
+   * \brief Constructor
+   */
+  SatOutputTraceRecorder ();
+
+  /**
+   * \brief Destructor
+   */
+  ~SatOutputTraceRecorder ();
+
+  /**
+   * \brief Record a sample
+   * \param time time of the sample in seconds
+   * \param value value of the sample
+   */
+  void AddSample (double time, double value);
+
+  /**
+   * \brief Export the records to a text file when the recorder is closed
+   * \param textFileName text output file name
+   */
+  void EnableTextOutput (std::string textFileName);
+
+  /**
+   * \brief Write the pending records and close the binary file, then
+   * export it to text if enabled
+   */
+  void Close ();
+
+  /**
+   * \brief Get the number of records waiting to be written
+   * \return number of buffered records
+   */
+  uint32_t GetNumOfBufferedRecords () const;
+
+  /**
+   * \brief Convert a binary file written by a recorder to text. Samples
+   * are written as "time value" rows, aggregated intervals as
+   * "time mean" rows starting at the beginning of the interval.
+   * \param binaryFileName binary file name
+   * \param textFileName text file name
+   */
+  static void ExportToText (std::string binaryFileName, std::string textFileName);
+
+  /**
+   * \brief Do needed dispose actions
+   */
+  void DoDispose ();
+
+private:
+  /**
+   * \brief Header of the binary output
+   */
+  typedef struct
+  {
+    char m_magic[8];
+    double m_interval;
+    uint32_t m_decimation;
+    uint32_t m_reserved;
+  } Header_t;
+
+  /**
+   * \brief Move the record of the current interval to the buffer
+   */
+  void CloseInterval ();
+
+  /**
+   * \brief Write the buffered records to the binary file
+   */
+  void Flush ();
+
+  /**
+   * \brief Magic string identifying the binary output
+   */
+  static const char MAGIC[8];
+
+  /**
+   * \brief Binary output file name
+   */
+  std::string m_fileName;
+
+  /**
+   * \brief Text output file name, empty if not enabled
+   */
+  std::string m_textFileName;
+
+  /**
+   * \brief Binary output stream
+   */
+  std::ofstream m_stream;
+
+  /**
+   * \brief Aggregation interval in seconds
+   */
+  double m_interval;
+
+  /**
+   * \brief Decimation factor
+   */
+  uint32_t m_decimation;
+
+  /**
+   * \brief Number of samples received
+   */
+  uint64_t m_samples;
+
+  /**
+   * \brief Index of the current aggregation interval
+   */
+  int64_t m_currentInterval;
+
+  /**
+   * \brief Record of the current aggregation interval
+   */
+  Record_t m_current;
+
+  /**
+   * \brief Records waiting to be written
+   */
+  std::vector<Record_t> m_buffer;
+
+  /**
+   * \brief Maximum number of buffered records
+   */
+  uint32_t m_bufferedRecords;
+};
+
+} // namespace ns3
+
+#endif /* SAT_OUTPUT_TRACE_RECORDER_H */